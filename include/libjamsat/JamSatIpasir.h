@@ -94,6 +94,71 @@ extern JAMSAT_PUBLIC_API int jamsat_ipasir_set_logger(void* solver,
                                                       void* state,
                                                       void(*logger)(void* state, const char* message));
 
+/*
+ Sets the failed-assumption minimization mode. If mode is 0, failed assumptions
+ are not minimized (default). If mode is 1, the failed assumptions reported by
+ ipasir_failed() are minimized via deletion-based minimization, performing nested
+ solver invocations with at most conflict_budget conflicts each.
+
+ Returns 0 on success and -1 if solver is NULL or mode or conflict_budget are invalid.
+*/
+extern JAMSAT_PUBLIC_API int jamsat_ipasir_set_failed_minimization(void* solver,
+                                                                   int mode,
+                                                                   long long conflict_budget);
+
+/*
+ Sets the branching heuristic used beginning with the next call to ipasir_solve().
+ If heuristic is 0, the VSIDS heuristic is used (default). If heuristic is 1, the
+ VMTF heuristic is used. If heuristic is 2, the LRB heuristic is used.
+
+ Returns 0 on success and -1 if solver is NULL or heuristic is invalid.
+*/
+extern JAMSAT_PUBLIC_API int jamsat_ipasir_set_branching_heuristic(void* solver, int heuristic);
+
+/*
+ Writes the variable activities and phases of the solver to the file at path
+ filename, in a compact binary format. The file can be read by
+ jamsat_ipasir_import_branching_state() to warm-start another solver.
+
+ Returns 0 on success and -1 if solver or filename is NULL or the file could not be
+ written.
+*/
+extern JAMSAT_PUBLIC_API int jamsat_ipasir_export_branching_state(void* solver,
+                                                                  const char* filename);
+
+/*
+ Reads variable activities and phases written by jamsat_ipasir_export_branching_state()
+ from the file at path filename. They are applied to the respective variables when
+ ipasir_solve() is called for the next time.
+
+ Returns 0 on success and -1 if solver or filename is NULL or the file could not be
+ read or is malformed.
+*/
+extern JAMSAT_PUBLIC_API int jamsat_ipasir_import_branching_state(void* solver,
+                                                                  const char* filename);
+
+/*
+ Sets the default phase of the variable of lit such that lit is satisfied when the
+ solver branches on the variable without having saved a different phase for it.
+ The default phase is applied when ipasir_solve() is called for the next time.
+
+ Returns 0 on success and -1 if solver is NULL or lit is invalid.
+*/
+extern JAMSAT_PUBLIC_API int jamsat_ipasir_set_default_phase(void* solver, int lit);
+
+/*
+ Sets the decision priority of the variable var. The solver branches on a variable
+ only if all variables with higher decision priorities are assigned. By default,
+ all variables have priority 0. The decision priorities are used beginning with the
+ next call to ipasir_solve().
+
+ Returns 0 on success and -1 if solver is NULL or var or priority are invalid, i.e.
+ var is not positive or priority is negative.
+*/
+extern JAMSAT_PUBLIC_API int jamsat_ipasir_set_decision_priority(void* solver,
+                                                                 int var,
+                                                                 int priority);
+
 #if defined(__cplusplus)
 }
 #endif
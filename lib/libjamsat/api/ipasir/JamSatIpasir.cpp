@@ -39,6 +39,8 @@
 #include <libjamsat/proof/DRATCertificate.h>
 
 #include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -278,6 +280,95 @@ public:
     }
   }
 
+  void setFailedAssumptionsMinimization(CDCLSatSolver::FailedAssumptionsMinimization mode,
+                                        uint64_t conflictBudget) noexcept
+  {
+    try {
+      ensureSolverExists();
+      m_solver->setFailedAssumptionsMinimization(mode, conflictBudget);
+    }
+    catch (...) {
+      // defensively catching all exceptions
+      m_failed = true;
+    }
+  }
+
+  void setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic heuristic) noexcept
+  {
+    try {
+      ensureSolverExists();
+      m_solver->setBranchingHeuristic(heuristic);
+    }
+    catch (...) {
+      // defensively catching all exceptions
+      m_failed = true;
+    }
+  }
+
+  bool exportBranchingState(char const* filename) noexcept
+  {
+    try {
+      ensureSolverExists();
+      BranchingState const state = m_solver->exportBranchingState();
+      std::ofstream output{filename, std::ios::binary};
+      output << state;
+      output.close();
+      return !output.fail();
+    }
+    catch (...) {
+      // defensively catching all exceptions
+      m_failed = true;
+      return false;
+    }
+  }
+
+  bool importBranchingState(char const* filename) noexcept
+  {
+    try {
+      ensureSolverExists();
+      std::ifstream input{filename, std::ios::binary};
+      BranchingState state;
+      input >> state;
+      if (input.fail()) {
+        return false;
+      }
+      m_solver->importBranchingState(state);
+      return true;
+    }
+    catch (...) {
+      // defensively catching all exceptions
+      m_failed = true;
+      return false;
+    }
+  }
+
+  void setDefaultPhase(int lit) noexcept
+  {
+    try {
+      ensureSolverExists();
+      CNFLit const internalLit = ipasirLitToCNFLit(lit);
+      TBool const phase = toTBool(internalLit.getSign() == CNFSign::POSITIVE);
+      m_solver->setDefaultPhase(internalLit.getVariable(), phase);
+    }
+    catch (...) {
+      // defensively catching all exceptions
+      m_failed = true;
+    }
+  }
+
+  void setDecisionPriority(int var, uint32_t priority) noexcept
+  {
+    try {
+      ensureSolverExists();
+      CNFVar const internalVar = ipasirLitToCNFLit(var).getVariable();
+      m_solver->setDecisionPriority(internalVar, priority);
+    }
+    catch (...) {
+      // defensively catching all exceptions
+      m_failed = true;
+    }
+  }
+
   ~IPASIRContext()
   {
     // Shut down the kill thread
@@ -453,4 +544,73 @@ int jamsat_ipasir_set_logger(void* solver,
   reinterpret_cast<jamsat::IPASIRContext*>(solver)->setLogger(state, logger);
   return 0;
 }
+
+int jamsat_ipasir_set_failed_minimization(void* solver, int mode, long long conflict_budget)
+{
+  using Minimization = jamsat::CDCLSatSolver::FailedAssumptionsMinimization;
+
+  if (solver == nullptr || conflict_budget < 0 || mode < 0 || mode > 1) {
+    return -1;
+  }
+
+  Minimization const minimizationMode =
+      (mode == 0 ? Minimization::NONE : Minimization::DELETION_BASED);
+  reinterpret_cast<jamsat::IPASIRContext*>(solver)->setFailedAssumptionsMinimization(
+      minimizationMode, static_cast<uint64_t>(conflict_budget));
+  return 0;
+}
+
+int jamsat_ipasir_set_branching_heuristic(void* solver, int heuristic)
+{
+  using BranchingHeuristic = jamsat::CDCLSatSolver::BranchingHeuristic;
+
+  if (solver == nullptr || heuristic < 0 || heuristic > 2) {
+    return -1;
+  }
+
+  BranchingHeuristic const heuristics[] = {
+      BranchingHeuristic::VSIDS, BranchingHeuristic::VMTF, BranchingHeuristic::LRB};
+  BranchingHeuristic const selected = heuristics[heuristic];
+  reinterpret_cast<jamsat::IPASIRContext*>(solver)->setBranchingHeuristic(selected);
+  return 0;
+}
+
+int jamsat_ipasir_export_branching_state(void* solver, const char* filename)
+{
+  if (solver == nullptr || filename == nullptr) {
+    return -1;
+  }
+  bool const success =
+      reinterpret_cast<jamsat::IPASIRContext*>(solver)->exportBranchingState(filename);
+  return success ? 0 : -1;
+}
+
+int jamsat_ipasir_import_branching_state(void* solver, const char* filename)
+{
+  if (solver == nullptr || filename == nullptr) {
+    return -1;
+  }
+  bool const success =
+      reinterpret_cast<jamsat::IPASIRContext*>(solver)->importBranchingState(filename);
+  return success ? 0 : -1;
+}
+
+int jamsat_ipasir_set_default_phase(void* solver, int lit)
+{
+  if (solver == nullptr || lit == 0 || lit == std::numeric_limits<int>::min()) {
+    return -1;
+  }
+  reinterpret_cast<jamsat::IPASIRContext*>(solver)->setDefaultPhase(lit);
+  return 0;
+}
+
+int jamsat_ipasir_set_decision_priority(void* solver, int var, int priority)
+{
+  if (solver == nullptr || var <= 0 || priority < 0) {
+    return -1;
+  }
+  reinterpret_cast<jamsat::IPASIRContext*>(solver)->setDecisionPriority(
+      var, static_cast<uint32_t>(priority));
+  return 0;
+}
 }
@@ -0,0 +1,393 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file LRBBranchingHeuristic.h
+ * \brief Learning-rate-based branching heuristic for CDCL search
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include <libjamsat/branching/BranchingHeuristicBase.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/utils/Assert.h>
+#include <libjamsat/utils/BoundedMap.h>
+#include <libjamsat/utils/Casts.h>
+#include <libjamsat/utils/DAryHeap.h>
+#include <libjamsat/utils/Truth.h>
+
+namespace jamsat {
+
+/**
+ * \ingroup JamSAT_Branching
+ *
+ * \class jamsat::LRBBranchingHeuristic
+ *
+ * \brief A LRB ("learning rate branching") heuristic implementation.
+ *
+ * Usage example: Use LRBBranchingHeuristic in a CDCL SAT solver to decide
+ * which literal to put on the solver's trail when currently no further facts
+ * can be propagated. In addition to the interface of VSIDSBranchingHeuristic
+ * (except for the VSIDS-specific activity bump delta methods), the solver
+ * needs to inform LRBBranchingHeuristic about variable assignments via
+ * assigned() and about the lemmas derived in conflict analysis via
+ * registerLemma().
+ *
+ * The activity of a variable is an exponential moving average of its learning
+ * rate, i.e. the amount of conflicts in whose analysis the variable took part
+ * while being assigned, relative to the amount of conflicts that occurred
+ * during that time. Variables occurring in the reasons of the literals of a
+ * lemma (but not in the lemma itself) additionally get rewarded ("reason side
+ * rate"). The activities are updated when variables get unassigned. (See Liang,
+ * Ganesh, Poupart, Czarnecki: "Learning Rate Based Branching Heuristic for SAT
+ * Solvers", 2016.)
+ *
+ * \tparam AssignmentProvider   A class type T having the methods TBool
+ * T::getAssignment(CNFVar x) and TBool T::getPhase(CNFVar x) which return the
+ * current assignment rsp. the phase of x.
+ */
+template <class AssignmentProvider>
+class LRBBranchingHeuristic : public BranchingHeuristicBase {
+public:
+  /**
+   * \brief Constructs a new LRBBranchingHeuristic object.
+   *
+   * \param maxVar              The largest variable occurring in the SAT
+   * problem instance to be solved. \p maxVar must be a regular variable.
+   * \param assignmentProvider  A reference to an object using which the current
+   * variable assignment can be obtained.
+   */
+  LRBBranchingHeuristic(CNFVar maxVar, AssignmentProvider const& assignmentProvider);
+
+  /**
+   * \brief Informs the branching heuristic that the given variable was
+   * contained in a clause used to obtain a learned clause during conflict
+   * resolution.
+   *
+   * This method may be called at most once per variable and conflict.
+   *
+   * \param variable  The variable as described above. \p variable must not be
+   * larger than \p maxVar passed to this object's constructor.
+   */
+  void seenInConflict(CNFVar variable) noexcept;
+
+  /**
+   * \brief Informs the branching heuristic about a lemma derived during
+   * conflict resolution.
+   *
+   * Each variable occurring in a reason of a literal of \p lemma, but not in
+   * \p lemma itself, is rewarded once for occurring on the reason side of the
+   * conflict.
+   *
+   * \param lemma           The derived lemma. The variables of the literals
+   *                        of \p lemma must be assigned.
+   * \param reasonProvider  An object R such that R.getReason(v) returns a
+   *                        pointer to the reason clause of the variable v,
+   *                        or nullptr if v has no reason clause.
+   *
+   * \tparam LiteralRange     An iterable type with value type CNFLit.
+   * \tparam ReasonProvider   The type of \p reasonProvider.
+   */
+  template <typename LiteralRange, typename ReasonProvider>
+  void registerLemma(LiteralRange const& lemma, ReasonProvider const& reasonProvider) noexcept;
+
+  /**
+   * \brief Informs the branching heuristic that the given variable has been
+   * assigned.
+   *
+   * \param variable    The assigned variable.
+   */
+  void assigned(CNFVar variable) noexcept;
+
+  /**
+   * \brief Obtains a branching literal if possible.
+   *
+   * The chosen variable \p v will not be used for branching again before
+   * reset() or reset reset(\p v) has been called.
+   *
+   * \returns If a branching decision can be performed, this method returns a
+   * literal \p L with variable \p v and sign \p s such that the solver can
+   * assign \p v to the value corresponding to \p s as a branching decision.
+   * Otherwise, CNFLit::getUndefinedLiteral() is returned.
+   */
+  auto pickBranchLiteral() noexcept -> CNFLit;
+
+  /**
+   * \brief Resets the record of branching decisions.
+   *
+   * After calling this method, all variables which are marked as possible
+   * decision variables and which are not assigned may be used for determining a
+   * branching decision literal. The assignment intervals of all variables are
+   * restarted.
+   */
+  void reset() noexcept;
+
+  /**
+   * \brief Informs the heuristic that the given variable is about to be
+   * unassigned, and resets the record of branching decisions for the given
+   * variable.
+   *
+   * The activity of \p variable is updated if \p variable is assigned and
+   * conflicts have occurred since \p variable has been assigned. Otherwise,
+   * only the record of conflicts for \p variable is restarted, without
+   * decaying its activity. After calling this method, the given
+   * variable may be used in a branching decision literal if it is marked as a
+   * possible decision variable and has no assignment.
+   *
+   * \param variable    The variable to be reset.
+   */
+  void reset(CNFVar variable) noexcept;
+
+  /**
+   * \brief Informs the heuristic that the solver is about to begin processing a
+   * conflict.
+   */
+  void beginHandlingConflict() noexcept;
+
+  /**
+   * \brief Informs the heuristic that the solver has just finished processing a
+   * conflict.
+   */
+  void endHandlingConflict() noexcept;
+
+  /**
+   * \brief Gets the learning rate activity of the given variable.
+   *
+   * \param variable    A variable not larger than the current maximum variable.
+   * \returns The activity of \p variable, which is in the range `[0, 1]`.
+   */
+  auto getActivity(CNFVar variable) const noexcept -> double;
+
+  /**
+   * \brief Sets the learning rate activity of the given variable.
+   *
+   * \param variable    A variable not larger than the current maximum variable.
+   * \param activity    An activity in the range `[0, 1]`.
+   */
+  void setActivity(CNFVar variable, double activity) noexcept;
+
+  /**
+   * \brief Increases the maximum variable known to occur in the SAT problem to be solved.
+   *
+   * \param newMaxVar     The new maximum variable. Must not be smaller than the previous
+   *                      maximum variable, and must be a regular variable.
+   */
+  void increaseMaxVarTo(CNFVar newMaxVar);
+
+private:
+  using ConflictCount = uint64_t;
+
+  using Activity = float;
+  using VariableHeap = DAryMaxHeap<CNFVar, Activity, 4>;
+  VariableHeap m_variableOrder;
+  CNFVar m_maxVar;
+
+  // The amount of conflicts that occurred before the variable has last been assigned:
+  BoundedMap<CNFVar, ConflictCount> m_assignedAt;
+
+  // The amount of conflicts the variable took part in since its last assignment:
+  BoundedMap<CNFVar, ConflictCount> m_participated;
+
+  // The amount of conflicts where the variable occurred on the reason side of the
+  // lemma since its last assignment:
+  BoundedMap<CNFVar, ConflictCount> m_reasonSide;
+
+  // Marks the variables already processed during registerLemma() with the
+  // conflict count of the conflict the lemma has been derived from:
+  BoundedMap<CNFVar, ConflictCount> m_lemmaStamps;
+
+  const AssignmentProvider& m_assignmentProvider;
+  ConflictCount m_conflictCount;
+  double m_stepSize;
+  double m_minStepSize;
+  double m_stepSizeDecrement;
+};
+
+/********** Implementation ****************************** */
+
+template <class AssignmentProvider>
+LRBBranchingHeuristic<AssignmentProvider>::LRBBranchingHeuristic(
+    CNFVar maxVar, AssignmentProvider const& assignmentProvider)
+  : BranchingHeuristicBase(maxVar)
+  , m_variableOrder(maxVar)
+  , m_maxVar(maxVar)
+  , m_assignedAt(maxVar, 0)
+  , m_participated(maxVar, 0)
+  , m_reasonSide(maxVar, 0)
+  , m_lemmaStamps(maxVar, 0)
+  , m_assignmentProvider(assignmentProvider)
+  , m_conflictCount(0)
+  , m_stepSize(0.4)
+  , m_minStepSize(0.06)
+  , m_stepSizeDecrement(1e-6)
+{
+  JAM_ASSERT(isRegular(maxVar), "Argument maxVar must be a regular variable.");
+  reset();
+}
+
+template <class AssignmentProvider>
+auto LRBBranchingHeuristic<AssignmentProvider>::pickBranchLiteral() noexcept -> CNFLit
+{
+  CNFVar branchingVar = CNFVar::getUndefinedVariable();
+  while (!m_variableOrder.empty()) {
+    branchingVar = m_variableOrder.removeMax();
+    if (!isDeterminate(m_assignmentProvider.getAssignment(branchingVar)) &&
+        isEligibleForDecisions(branchingVar)) {
+      CNFSign sign =
+          static_cast<CNFSign>(m_assignmentProvider.getPhase(branchingVar).getUnderlyingValue());
+      return CNFLit{branchingVar, sign};
+    }
+  }
+
+  return CNFLit::getUndefinedLiteral();
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::seenInConflict(CNFVar variable) noexcept
+{
+  ++m_participated[variable];
+}
+
+template <class AssignmentProvider>
+template <typename LiteralRange, typename ReasonProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::registerLemma(
+    LiteralRange const& lemma, ReasonProvider const& reasonProvider) noexcept
+{
+  // Using m_conflictCount + 1 as the stamp, since the stamps are initially 0:
+  ConflictCount const stamp = m_conflictCount + 1;
+  for (CNFLit lit : lemma) {
+    m_lemmaStamps[lit.getVariable()] = stamp;
+  }
+
+  for (CNFLit lit : lemma) {
+    auto const* reason = reasonProvider.getReason(lit.getVariable());
+    if (reason == nullptr) {
+      continue;
+    }
+    for (CNFLit reasonLit : *reason) {
+      CNFVar const reasonVar = reasonLit.getVariable();
+      if (m_lemmaStamps[reasonVar] != stamp) {
+        m_lemmaStamps[reasonVar] = stamp;
+        ++m_reasonSide[reasonVar];
+      }
+    }
+  }
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::assigned(CNFVar variable) noexcept
+{
+  m_assignedAt[variable] = m_conflictCount;
+  m_participated[variable] = 0;
+  m_reasonSide[variable] = 0;
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::reset() noexcept
+{
+  m_variableOrder.clear();
+  for (CNFVar i = CNFVar{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+    assigned(i);
+    m_variableOrder.insert(i);
+  }
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::reset(CNFVar variable) noexcept
+{
+  // Unassigned variables are reset e.g. when they become eligible for decisions
+  // again, and have no assignment interval to be rewarded for:
+  ConflictCount const interval = m_conflictCount - m_assignedAt[variable];
+  if (interval > 0 && isDeterminate(m_assignmentProvider.getAssignment(variable))) {
+    double const activity = m_variableOrder.getKey(variable);
+    double const reward =
+        static_cast<double>(m_participated[variable] + m_reasonSide[variable]) / interval;
+    double const newActivity = (1.0 - m_stepSize) * activity + m_stepSize * reward;
+    m_variableOrder.setKey(variable, static_cast<Activity>(newActivity));
+  }
+
+  // Avoiding double-counting the current assignment interval in case the
+  // variable gets reset again before getting reassigned:
+  assigned(variable);
+
+  if (!m_variableOrder.contains(variable)) {
+    m_variableOrder.insert(variable);
+  }
+}
+
+template <class AssignmentProvider>
+auto LRBBranchingHeuristic<AssignmentProvider>::getActivity(CNFVar variable) const noexcept
+    -> double
+{
+  return m_variableOrder.getKey(variable);
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::setActivity(CNFVar variable,
+                                                            double activity) noexcept
+{
+  JAM_ASSERT(activity >= 0.0 && activity <= 1.0, "Argument activity out of range");
+  m_variableOrder.setKey(variable, static_cast<Activity>(activity));
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::beginHandlingConflict() noexcept
+{
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::endHandlingConflict() noexcept
+{
+  ++m_conflictCount;
+  m_stepSize = std::max(m_stepSize - m_stepSizeDecrement, m_minStepSize);
+}
+
+template <class AssignmentProvider>
+void LRBBranchingHeuristic<AssignmentProvider>::increaseMaxVarTo(CNFVar newMaxVar)
+{
+  JAM_ASSERT(newMaxVar >= m_maxVar,
+             "Argument newMaxVar must not be smaller than the previous maximum variable");
+  JAM_ASSERT(isRegular(newMaxVar), "Argument newMaxVar must be a regular variable.");
+
+  CNFVar firstNewVar = nextCNFVar(m_maxVar);
+
+  increaseMaxDecisionVarTo(newMaxVar);
+  m_variableOrder.increaseMaxSizeTo(newMaxVar);
+  m_assignedAt.increaseSizeTo(newMaxVar);
+  m_participated.increaseSizeTo(newMaxVar);
+  m_reasonSide.increaseSizeTo(newMaxVar);
+  m_lemmaStamps.increaseSizeTo(newMaxVar);
+  m_maxVar = newMaxVar;
+
+  for (CNFVar i = firstNewVar; i <= newMaxVar; i = nextCNFVar(i)) {
+    assigned(i);
+    m_variableOrder.insert(i);
+  }
+}
+}
@@ -0,0 +1,396 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file VMTFBranchingHeuristic.h
+ * \brief Variable-move-to-front branching heuristic for CDCL search
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <libjamsat/branching/BranchingHeuristicBase.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/utils/Assert.h>
+#include <libjamsat/utils/BoundedMap.h>
+#include <libjamsat/utils/Casts.h>
+#include <libjamsat/utils/Truth.h>
+
+namespace jamsat {
+
+/**
+ * \ingroup JamSAT_Branching
+ *
+ * \class jamsat::VMTFBranchingHeuristic
+ *
+ * \brief A VMTF ("variable move-to-front") branching heuristic implementation.
+ *
+ * Usage example: Use VMTFBranchingHeuristic in a CDCL SAT solver to decide
+ * which literal to put on the solver's trail when currently no further facts
+ * can be propagated. VMTFBranchingHeuristic has the same interface as
+ * VSIDSBranchingHeuristic (except for the VSIDS-specific activity bump delta
+ * methods), so it can be used as a drop-in replacement.
+ *
+ * The variables are kept in a doubly linked list (the "queue"), ordered by the
+ * time they have last been enqueued. Variables seen in conflicts are moved to
+ * the front of the queue when the conflict has been handled, preserving their
+ * relative order. Instead of maintaining a heap, the heuristic keeps a search
+ * cursor such that all variables enqueued after the variable at the cursor are
+ * assigned or have been picked already. Thus, bumping variables and picking
+ * branching literals require amortized constant time. (See Biere, Fröhlich:
+ * "Evaluating CDCL Variable Scoring Schemes", 2015.)
+ *
+ * \tparam AssignmentProvider   A class type T having the methods TBool
+ * T::getAssignment(CNFVar x) and TBool T::getPhase(CNFVar x) which return the
+ * current assignment rsp. the phase of x.
+ */
+template <class AssignmentProvider>
+class VMTFBranchingHeuristic : public BranchingHeuristicBase {
+public:
+  /**
+   * \brief Constructs a new VMTFBranchingHeuristic object.
+   *
+   * \param maxVar              The largest variable occurring in the SAT
+   * problem instance to be solved. \p maxVar must be a regular variable.
+   * \param assignmentProvider  A reference to an object using which the current
+   * variable assignment can be obtained.
+   */
+  VMTFBranchingHeuristic(CNFVar maxVar, AssignmentProvider const& assignmentProvider);
+
+  /**
+   * \brief Informs the branching heuristic that the given variable was
+   * contained in a clause used to obtain a learned clause during conflict
+   * resolution.
+   *
+   * If this method is called between calls to beginHandlingConflict() and
+   * endHandlingConflict(), \p variable is moved to the front of the queue
+   * when endHandlingConflict() is called. Otherwise, \p variable is moved
+   * to the front of the queue immediately. Between calls to beginHandlingConflict()
+   * and endHandlingConflict(), this method may be called at most once per variable.
+   *
+   * \param variable  The variable as described above. \p variable must not be
+   * larger than \p maxVar passed to this object's constructor.
+   */
+  void seenInConflict(CNFVar variable) noexcept;
+
+  /**
+   * \brief Obtains a branching literal if possible.
+   *
+   * The chosen variable \p v will not be used for branching again before
+   * reset() or reset reset(\p v) has been called. The solver is expected to
+   * assign \p v before calling this method again: variables skipped by the
+   * search cursor are only reconsidered if they are unassigned when the cursor
+   * is moved beyond them via reset().
+   *
+   * \returns If a branching decision can be performed, this method returns a
+   * literal \p L with variable \p v and sign \p s such that the solver can
+   * assign \p v to the value corresponding to \p s as a branching decision.
+   * Otherwise, CNFLit::getUndefinedLiteral() is returned.
+   */
+  auto pickBranchLiteral() noexcept -> CNFLit;
+
+  /**
+   * \brief Resets the record of branching decisions.
+   *
+   * After calling this method, all variables which are marked as possible
+   * decision variables and which are not assigned may be used for determining a
+   * branching decision literal.
+   */
+  void reset() noexcept;
+
+  /**
+   * \brief Resets the record of branching decisions for the given variable.
+   *
+   * After calling this method, the given variable may be used in a branching
+   * decision literal if it is marked as a possible decision variable and has no
+   * assinment.
+   *
+   * \param variable    The variable to be reset.
+   */
+  void reset(CNFVar variable) noexcept;
+
+  /**
+   * \brief Informs the heuristic that the solver is about to begin processing a
+   * conflict.
+   */
+  void beginHandlingConflict() noexcept;
+
+  /**
+   * \brief Informs the heuristic that the solver has just finished processing a
+   * conflict.
+   *
+   * The variables seen in the conflict are moved to the front of the queue.
+   */
+  void endHandlingConflict() noexcept;
+
+  /**
+   * \brief Gets the time at which the given variable has last been moved to the
+   * front of the queue.
+   *
+   * \param variable    A variable not larger than the current maximum variable.
+   * \returns The enqueue time of \p variable. Variables with greater enqueue times
+   *   are closer to the front of the queue.
+   */
+  auto getEnqueueTime(CNFVar variable) const noexcept -> uint64_t;
+
+  /**
+   * \brief Moves the given variable to the front of the queue.
+   *
+   * This method may not be called between calls to beginHandlingConflict() and
+   * endHandlingConflict().
+   *
+   * \param variable    A variable not larger than the current maximum variable.
+   */
+  void moveToFront(CNFVar variable) noexcept;
+
+  /**
+   * \brief Increases the maximum variable known to occur in the SAT problem to be solved.
+   *
+   * The new variables are enqueued at the front of the queue.
+   *
+   * \param newMaxVar     The new maximum variable. Must not be smaller than the previous
+   *                      maximum variable, and must be a regular variable.
+   */
+  void increaseMaxVarTo(CNFVar newMaxVar);
+
+private:
+  using Timestamp = uint64_t;
+
+  void enqueue(CNFVar variable) noexcept;
+  void dequeue(CNFVar variable) noexcept;
+
+  auto isEnqueuedAfterCursor(CNFVar variable) const noexcept -> bool;
+
+  // The queue, represented as a doubly linked list. The variable enqueued last
+  // ("front") is m_last. Variables are linked towards the front via m_next.
+  BoundedMap<CNFVar, CNFVar> m_next;
+  BoundedMap<CNFVar, CNFVar> m_previous;
+  BoundedMap<CNFVar, Timestamp> m_enqueueTimes;
+  CNFVar m_first;
+  CNFVar m_last;
+  Timestamp m_nextTimestamp;
+
+  // All variables enqueued after m_searchCursor are assigned, ineligible for
+  // decisions or have been picked since they have last been reset. If
+  // m_searchCursor is undefined, this holds for all variables.
+  CNFVar m_searchCursor;
+
+  AssignmentProvider const& m_assignmentProvider;
+
+  bool m_isHandlingConflict;
+  std::vector<CNFVar> m_seenInConflict;
+};
+
+/********** Implementation ****************************** */
+
+template <class AssignmentProvider>
+VMTFBranchingHeuristic<AssignmentProvider>::VMTFBranchingHeuristic(
+    CNFVar maxVar, AssignmentProvider const& assignmentProvider)
+  : BranchingHeuristicBase(maxVar)
+  , m_next(maxVar, CNFVar::getUndefinedVariable())
+  , m_previous(maxVar, CNFVar::getUndefinedVariable())
+  , m_enqueueTimes(maxVar, 0)
+  , m_first(CNFVar::getUndefinedVariable())
+  , m_last(CNFVar::getUndefinedVariable())
+  , m_nextTimestamp(1)
+  , m_searchCursor(CNFVar::getUndefinedVariable())
+  , m_assignmentProvider(assignmentProvider)
+  , m_isHandlingConflict(false)
+  , m_seenInConflict()
+{
+  JAM_ASSERT(isRegular(maxVar), "Argument maxVar must be a regular variable.");
+  for (CNFVar i = CNFVar{0}; i <= maxVar; i = nextCNFVar(i)) {
+    enqueue(i);
+  }
+  // Reserving the buffer in advance to keep seenInConflict() free of allocations,
+  // since each variable is seen at most once per conflict:
+  m_seenInConflict.reserve(maxVar.getRawValue() + 1);
+  reset();
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::enqueue(CNFVar variable) noexcept
+{
+  m_previous[variable] = m_last;
+  m_next[variable] = CNFVar::getUndefinedVariable();
+  if (m_last != CNFVar::getUndefinedVariable()) {
+    m_next[m_last] = variable;
+  }
+  else {
+    m_first = variable;
+  }
+  m_last = variable;
+  m_enqueueTimes[variable] = m_nextTimestamp;
+  ++m_nextTimestamp;
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::dequeue(CNFVar variable) noexcept
+{
+  CNFVar const previous = m_previous[variable];
+  CNFVar const next = m_next[variable];
+
+  if (previous != CNFVar::getUndefinedVariable()) {
+    m_next[previous] = next;
+  }
+  else {
+    m_first = next;
+  }
+
+  if (next != CNFVar::getUndefinedVariable()) {
+    m_previous[next] = previous;
+  }
+  else {
+    m_last = previous;
+  }
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::moveToFront(CNFVar variable) noexcept
+{
+  if (variable != m_last) {
+    if (variable == m_searchCursor) {
+      // Keep the cursor invariant: all variables enqueued after the new cursor
+      // have been enqueued after the old cursor as well.
+      m_searchCursor = m_previous[variable];
+    }
+
+    dequeue(variable);
+    enqueue(variable);
+  }
+
+  if (!isDeterminate(m_assignmentProvider.getAssignment(variable))) {
+    m_searchCursor = variable;
+  }
+}
+
+template <class AssignmentProvider>
+auto VMTFBranchingHeuristic<AssignmentProvider>::getEnqueueTime(CNFVar variable) const noexcept
+    -> uint64_t
+{
+  return m_enqueueTimes[variable];
+}
+
+template <class AssignmentProvider>
+auto VMTFBranchingHeuristic<AssignmentProvider>::isEnqueuedAfterCursor(CNFVar variable) const
+    noexcept -> bool
+{
+  return m_searchCursor == CNFVar::getUndefinedVariable() ||
+         m_enqueueTimes[variable] > m_enqueueTimes[m_searchCursor];
+}
+
+template <class AssignmentProvider>
+auto VMTFBranchingHeuristic<AssignmentProvider>::pickBranchLiteral() noexcept -> CNFLit
+{
+  CNFVar candidate = m_searchCursor;
+  while (candidate != CNFVar::getUndefinedVariable()) {
+    if (!isDeterminate(m_assignmentProvider.getAssignment(candidate)) &&
+        isEligibleForDecisions(candidate)) {
+      m_searchCursor = m_previous[candidate];
+      CNFSign sign =
+          static_cast<CNFSign>(m_assignmentProvider.getPhase(candidate).getUnderlyingValue());
+      return CNFLit{candidate, sign};
+    }
+    candidate = m_previous[candidate];
+  }
+
+  m_searchCursor = CNFVar::getUndefinedVariable();
+  return CNFLit::getUndefinedLiteral();
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::seenInConflict(CNFVar variable) noexcept
+{
+  if (m_isHandlingConflict) {
+    m_seenInConflict.push_back(variable);
+  }
+  else {
+    moveToFront(variable);
+  }
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::reset() noexcept
+{
+  m_searchCursor = m_last;
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::reset(CNFVar variable) noexcept
+{
+  if (isEnqueuedAfterCursor(variable)) {
+    m_searchCursor = variable;
+  }
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::beginHandlingConflict() noexcept
+{
+  m_isHandlingConflict = true;
+  m_seenInConflict.clear();
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::endHandlingConflict() noexcept
+{
+  m_isHandlingConflict = false;
+
+  // Move the variables to the front in the order of their enqueue times to
+  // preserve their relative order:
+  std::sort(m_seenInConflict.begin(), m_seenInConflict.end(), [this](CNFVar lhs, CNFVar rhs) {
+    return m_enqueueTimes[lhs] < m_enqueueTimes[rhs];
+  });
+
+  for (CNFVar variable : m_seenInConflict) {
+    moveToFront(variable);
+  }
+  m_seenInConflict.clear();
+}
+
+template <class AssignmentProvider>
+void VMTFBranchingHeuristic<AssignmentProvider>::increaseMaxVarTo(CNFVar newMaxVar)
+{
+  JAM_ASSERT(newMaxVar.getRawValue() >= (m_enqueueTimes.size() - 1),
+             "Argument newMaxVar must not be smaller than the previous maximum variable");
+  JAM_ASSERT(isRegular(newMaxVar), "Argument newMaxVar must be a regular variable.");
+
+  CNFVar firstNewVar = CNFVar{static_checked_cast<CNFVar::RawVariable>(m_enqueueTimes.size())};
+
+  increaseMaxDecisionVarTo(newMaxVar);
+  m_next.increaseSizeTo(newMaxVar);
+  m_previous.increaseSizeTo(newMaxVar);
+  m_enqueueTimes.increaseSizeTo(newMaxVar);
+  m_seenInConflict.reserve(newMaxVar.getRawValue() + 1);
+
+  for (CNFVar i = firstNewVar; i <= newMaxVar; i = nextCNFVar(i)) {
+    enqueue(i);
+    m_searchCursor = i;
+  }
+}
+}
@@ -36,36 +36,11 @@
 #include <libjamsat/branching/BranchingHeuristicBase.h>
 #include <libjamsat/cnfproblem/CNFLiteral.h>
 #include <libjamsat/utils/Assert.h>
-#include <libjamsat/utils/BinaryHeap.h>
-#include <libjamsat/utils/BoundedMap.h>
 #include <libjamsat/utils/Casts.h>
+#include <libjamsat/utils/DAryHeap.h>
 #include <libjamsat/utils/Truth.h>
 
 namespace jamsat {
-namespace detail {
-
-class CNFVarActivityOrder {
-public:
-  explicit CNFVarActivityOrder(CNFVar maxVar) : m_activity(maxVar) {}
-
-  auto operator()(CNFVar lhs, CNFVar rhs) const noexcept -> bool
-  {
-    JAM_ASSERT(lhs.getRawValue() < static_checked_cast<CNFVar::RawVariable>(m_activity.size()),
-               "Index out of bounds");
-    JAM_ASSERT(rhs.getRawValue() < static_checked_cast<CNFVar::RawVariable>(m_activity.size()),
-               "Index out of bounds");
-
-    return m_activity[lhs] < m_activity[rhs];
-  }
-
-  auto getActivityMap() noexcept -> BoundedMap<CNFVar, double>& { return m_activity; }
-
-  void increaseMaxSizeTo(CNFVar newMaxElement) { m_activity.increaseSizeTo(newMaxElement); }
-
-private:
-  BoundedMap<CNFVar, double> m_activity;
-};
-}
 
 /**
  * \ingroup JamSAT_Branching
@@ -74,13 +49,17 @@ private:
  *
  * \brief A VSIDS Branching heuristic implementation.
  *
+ * The variable activities are stored as single-precision floating point numbers
+ * in a 4-ary heap keeping the activities next to the heap entries.
+ *
  * Usage example: Use VSIDSBranchingHeuristic in a CDCL SAT solver to decide
  * which literal to put on the solver's trail (which can be used as an
  * assignment provider) when currently no further facts can be propagated.
  *
  * \tparam AssignmentProvider   A class type T having the method TBool
  * T::getAssignment(CNFLit x) which returns the current variable assignment of
- * x.
+ * x, and the methods TBool T::getPhase(CNFVar x) and TBool T::getTargetPhase(CNFVar x)
+ * which return the phase rsp. the target phase of x.
  */
 template <class AssignmentProvider>
 class VSIDSBranchingHeuristic : public BranchingHeuristicBase {
@@ -166,6 +145,44 @@ public:
    */
   auto getActivityBumpDelta() const noexcept -> double;
 
+  /**
+   * \brief Gets the activity of the given variable.
+   *
+   * \param variable    A variable not larger than the current maximum variable.
+   * \returns The activity of \p variable.
+   */
+  auto getActivity(CNFVar variable) const noexcept -> double;
+
+  /**
+   * \brief Sets the activity of the given variable.
+   *
+   * \param variable    A variable not larger than the current maximum variable.
+   * \param activity    A finite, non-negative activity.
+   */
+  void setActivity(CNFVar variable, double activity) noexcept;
+
+  /**
+   * \brief Sets the activity decay rate.
+   *
+   * By default, the decay rate is gradually increased from 0.8 to 0.95 during
+   * search. After calling this method, the decay rate remains fixed at
+   * \p decayRate.
+   *
+   * \param decayRate    The new decay rate. Must be in the range `(0, 1]`.
+   *                     Smaller values cause activities to decay faster.
+   */
+  void setDecayRate(double decayRate) noexcept;
+
+  /**
+   * \brief Determines whether the signs of branching literals are chosen according to
+   *   the target phases of the variables rather than their phases.
+   *
+   * By default, the phases are used.
+   *
+   * \param useTargetPhases   Iff true, target phases are used.
+   */
+  void setUseTargetPhases(bool useTargetPhases) noexcept;
+
   /**
    * \brief Increases the maximum variable known to occur in the SAT problem to be solved.
    *
@@ -177,14 +194,17 @@ public:
 private:
   void scaleDownActivities() noexcept;
 
-  using VariableHeap = BinaryMaxHeap<CNFVar, detail::CNFVarActivityOrder>;
+  using Activity = float;
+  using VariableHeap = DAryMaxHeap<CNFVar, Activity, 4>;
   VariableHeap m_variableOrder;
+  CNFVar m_maxVar;
 
   const AssignmentProvider& m_assignmentProvider;
   double m_activityBumpDelta;
   double m_decayRate;
   double m_maxDecayRate;
   int m_numberOfConflicts;
+  bool m_useTargetPhases;
 };
 
 /********** Implementation ****************************** */
@@ -194,11 +214,13 @@ VSIDSBranchingHeuristic<AssignmentProvider>::VSIDSBranchingHeuristic(
     CNFVar maxVar, AssignmentProvider const& assignmentProvider)
   : BranchingHeuristicBase(maxVar)
   , m_variableOrder(maxVar)
+  , m_maxVar(maxVar)
   , m_assignmentProvider(assignmentProvider)
   , m_activityBumpDelta(1.0)
   , m_decayRate(0.8)
   , m_maxDecayRate(0.95)
   , m_numberOfConflicts(0)
+  , m_useTargetPhases(false)
 {
   JAM_ASSERT(isRegular(maxVar), "Argument maxVar must be a regular variable.");
   reset();
@@ -213,8 +235,9 @@ auto VSIDSBranchingHeuristic<AssignmentProvider>::pickBranchLiteral() noexcept -
     branchingVar = m_variableOrder.removeMax();
     if (!isDeterminate(m_assignmentProvider.getAssignment(branchingVar)) &&
         isEligibleForDecisions(branchingVar)) {
-      CNFSign sign =
-          static_cast<CNFSign>(m_assignmentProvider.getPhase(branchingVar).getUnderlyingValue());
+      TBool const phase = m_useTargetPhases ? m_assignmentProvider.getTargetPhase(branchingVar)
+                                            : m_assignmentProvider.getPhase(branchingVar);
+      CNFSign sign = static_cast<CNFSign>(phase.getUnderlyingValue());
       return CNFLit{branchingVar, sign};
     }
   }
@@ -225,38 +248,27 @@ auto VSIDSBranchingHeuristic<AssignmentProvider>::pickBranchLiteral() noexcept -
 template <class AssignmentProvider>
 void VSIDSBranchingHeuristic<AssignmentProvider>::seenInConflict(CNFVar variable) noexcept
 {
-  auto& activityMap = m_variableOrder.getComparator().getActivityMap();
+  Activity const activity =
+      m_variableOrder.getKey(variable) + static_cast<Activity>(m_activityBumpDelta);
+  m_variableOrder.setKey(variable, activity);
 
-  activityMap[variable] += m_activityBumpDelta;
-
-  if (activityMap[variable] >= 1e100) {
+  if (activity >= 1e30f) {
     scaleDownActivities();
   }
-
-  if (m_variableOrder.contains(variable)) {
-    m_variableOrder.increasingUpdate(variable);
-  }
 }
 
 template <class AssignmentProvider>
 void VSIDSBranchingHeuristic<AssignmentProvider>::scaleDownActivities() noexcept
 {
-  auto& activityMap = m_variableOrder.getComparator().getActivityMap();
-  for (size_t i = 0; i < activityMap.size(); ++i) {
-    auto rawVariable = static_checked_cast<CNFVar::RawVariable>(i);
-    auto& activity = activityMap[CNFVar{rawVariable}];
-    activity = 1e-100 * activity;
-  }
-  m_activityBumpDelta *= 1e-100;
+  m_variableOrder.scaleKeys(1e-30f);
+  m_activityBumpDelta *= 1e-30;
 }
 
 template <class AssignmentProvider>
 void VSIDSBranchingHeuristic<AssignmentProvider>::reset() noexcept
 {
   m_variableOrder.clear();
-  auto& activityMap = m_variableOrder.getComparator().getActivityMap();
-  CNFVar max = CNFVar{static_checked_cast<CNFVar::RawVariable>(activityMap.size())};
-  for (CNFVar i = CNFVar{0}; i < max; i = nextCNFVar(i)) {
+  for (CNFVar i = CNFVar{0}; i <= m_maxVar; i = nextCNFVar(i)) {
     m_variableOrder.insert(i);
   }
 }
@@ -279,6 +291,40 @@ auto VSIDSBranchingHeuristic<AssignmentProvider>::getActivityBumpDelta() const n
   return m_activityBumpDelta;
 }
 
+template <class AssignmentProvider>
+auto VSIDSBranchingHeuristic<AssignmentProvider>::getActivity(CNFVar variable) const noexcept
+    -> double
+{
+  return m_variableOrder.getKey(variable);
+}
+
+template <class AssignmentProvider>
+void VSIDSBranchingHeuristic<AssignmentProvider>::setActivity(CNFVar variable,
+                                                              double activity) noexcept
+{
+  JAM_ASSERT(activity >= 0.0, "Argument activity must not be negative");
+  Activity const newActivity = static_cast<Activity>(std::min(activity, 1e30));
+  m_variableOrder.setKey(variable, newActivity);
+
+  if (newActivity >= 1e30f) {
+    scaleDownActivities();
+  }
+}
+
+template <class AssignmentProvider>
+void VSIDSBranchingHeuristic<AssignmentProvider>::setDecayRate(double decayRate) noexcept
+{
+  JAM_ASSERT(decayRate > 0.0 && decayRate <= 1.0, "Argument decayRate out of range");
+  m_decayRate = decayRate;
+  m_maxDecayRate = decayRate;
+}
+
+template <class AssignmentProvider>
+void VSIDSBranchingHeuristic<AssignmentProvider>::setUseTargetPhases(bool useTargetPhases) noexcept
+{
+  m_useTargetPhases = useTargetPhases;
+}
+
 template <class AssignmentProvider>
 void VSIDSBranchingHeuristic<AssignmentProvider>::beginHandlingConflict() noexcept
 {
@@ -293,23 +339,25 @@ template <class AssignmentProvider>
 void VSIDSBranchingHeuristic<AssignmentProvider>::endHandlingConflict() noexcept
 {
   m_activityBumpDelta *= (1 / m_decayRate);
+  if (m_activityBumpDelta >= 1e30) {
+    scaleDownActivities();
+  }
 }
 
 template <class AssignmentProvider>
 void VSIDSBranchingHeuristic<AssignmentProvider>::increaseMaxVarTo(CNFVar newMaxVar)
 {
-  auto& activityMap = m_variableOrder.getComparator().getActivityMap();
-  JAM_ASSERT(newMaxVar.getRawValue() >= (activityMap.size() - 1),
+  JAM_ASSERT(newMaxVar >= m_maxVar,
              "Argument newMaxVar must not be smaller than the previous maximum variable");
   JAM_ASSERT(isRegular(newMaxVar), "Argument newMaxVar must be a regular variable.");
 
-  CNFVar firstNewVar = CNFVar{static_checked_cast<CNFVar::RawVariable>(activityMap.size())};
+  CNFVar firstNewVar = nextCNFVar(m_maxVar);
 
   increaseMaxDecisionVarTo(newMaxVar);
   m_variableOrder.increaseMaxSizeTo(newMaxVar);
+  m_maxVar = newMaxVar;
 
   for (CNFVar i = firstNewVar; i <= newMaxVar; i = nextCNFVar(i)) {
-    activityMap[i] = 0.0f;
     m_variableOrder.insert(i);
   }
 }
@@ -73,7 +73,19 @@ public:
 
     /// MODIFIED is a general flag for clause modification flags and is intended to
     /// be used in conjunction with occurrence maps.
-    MODIFIED = 4
+    MODIFIED = 4,
+
+    /// If USED_RECENTLY is set, the clause has been used in conflict analysis since
+    /// the flag has last been cleared.
+    USED_RECENTLY = 8,
+
+    /// If USED_PREVIOUSLY is set, the clause had been used in conflict analysis before
+    /// the USED_RECENTLY flag has last been cleared by a clause database reduction.
+    USED_PREVIOUSLY = 16,
+
+    /// If VIVIFIED is set, the clause has been vivified in the current vivification
+    /// round.
+    VIVIFIED = 32
   };
 
   /**
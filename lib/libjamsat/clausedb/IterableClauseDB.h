@@ -39,13 +39,16 @@
 
 #include <boost/range.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -166,6 +169,14 @@ public:
    */
   auto empty() const noexcept -> bool;
 
+  /**
+   * \brief Returns the range of memory used up by allocations.
+   *
+   * \returns a pair of pointers, pointing to the first byte of the region's memory
+   *          and past the last byte used up by allocations.
+   */
+  auto getUsedMemory() const noexcept -> std::pair<char const*, char const*>;
+
   /**
    * \brief Clones the region.
    *
@@ -296,7 +307,9 @@ public:
    *
    * A clause is scheduled for deletion iff its SCHEDULED_FOR_DELETION flag is set.
    *
-   * This operation invalidates all pointers to clauses stored in this database.
+   * The clauses stored in the database before the first clause scheduled for deletion
+   * are only relocated if they share a memory chunk with a clause scheduled for deletion.
+   * This operation invalidates all pointers to relocated clauses.
    */
   void compress() noexcept;
 
@@ -313,12 +326,68 @@ public:
    */
   auto getClauses() noexcept -> boost::iterator_range<iterator>;
 
+  /**
+   * \brief Clears the change log.
+   *
+   * The change log keeps track of the clauses created or relocated since it has last
+   * been cleared, allowing data structures referencing clauses of the database to be
+   * updated without traversing the entire database. Initially, all clauses are regarded
+   * as changed.
+   */
+  void clearChangeLog() noexcept;
+
+  /**
+   * \brief Gets the range of clauses created or relocated since the last call to
+   *        `clearChangeLog()`.
+   *
+   * The returned range is invalidated by any call to `compress()`.
+   *
+   * \returns a range of clauses as described above, referencing the clauses in the
+   *          order of addition.
+   */
+  auto getChangedClauses() noexcept -> boost::iterator_range<iterator>;
+
+  /**
+   * \brief Predicate determining whether a pointer refers to a clause that has been
+   *        neither created nor relocated since the last call to `clearChangeLog()`.
+   *
+   * The pointers passed to the predicate are not dereferenced, so the predicate can
+   * be used for detecting dangling pointers to relocated clauses.
+   */
+  class UnchangedClauseQuery {
+  public:
+    auto operator()(ClauseT const* clause) const noexcept -> bool;
+
+  private:
+    friend class IterableClauseDB;
+
+    /** Memory ranges of unchanged clauses, sorted by their begin */
+    std::vector<std::pair<char const*, char const*>> m_unchangedMemory;
+  };
+
+  /**
+   * \brief Returns a predicate determining whether a clause has been neither created
+   *        nor relocated since the last call to `clearChangeLog()`.
+   *
+   * The returned predicate is invalidated by any call to a non-const method of the
+   * database.
+   *
+   * \throws std::bad_alloc on memory allocation failure.
+   */
+  auto getUnchangedClauseQuery() const -> UnchangedClauseQuery;
+
 private:
   auto createActiveRegion() -> Region<ClauseT>&;
 
   size_type m_regionSize;
   std::vector<Region<ClauseT>> m_activeRegions;
   std::vector<Region<ClauseT>> m_spareRegions;
+
+  // The change log: all clauses stored in the regions m_activeRegions[i] with
+  // i < m_changeLogRegion are unchanged, as well as the clauses stored in
+  // m_activeRegions[m_changeLogRegion] within the first m_changeLogOffset bytes.
+  size_type m_changeLogRegion;
+  std::size_t m_changeLogOffset;
 };
 }
 
@@ -398,6 +467,13 @@ auto Region<ClauseT>::empty() const noexcept -> bool
   return m_free == m_size;
 }
 
+template <typename ClauseT>
+auto Region<ClauseT>::getUsedMemory() const noexcept -> std::pair<char const*, char const*>
+{
+  char const* begin = reinterpret_cast<char const*>(m_memory);
+  return std::make_pair(begin, begin + getUsedSize());
+}
+
 template <typename ClauseT>
 auto Region<ClauseT>::clone() const noexcept -> std::optional<Region>
 {
@@ -570,7 +646,11 @@ auto RegionIterator<RegionT>::operator!=(RegionIterator const& rhs) const noexce
 
 template <typename ClauseT>
 IterableClauseDB<ClauseT>::IterableClauseDB(size_type regionSize) noexcept
-  : m_regionSize(regionSize), m_activeRegions(), m_spareRegions()
+  : m_regionSize(regionSize)
+  , m_activeRegions()
+  , m_spareRegions()
+  , m_changeLogRegion(0)
+  , m_changeLogOffset(0)
 {
 }
 
@@ -621,14 +701,29 @@ void IterableClauseDB<ClauseT>::compress() noexcept
     return;
   }
 
+  // Regions without clauses scheduled for deletion are left untouched until the
+  // first region containing such a clause:
+  auto const hasDeletedClause = [](Region<ClauseT>& region) {
+    return std::any_of(region.begin(), region.end(), [](ClauseT const& clause) {
+      return clause.getFlag(ClauseT::Flag::SCHEDULED_FOR_DELETION);
+    });
+  };
+  auto const firstRewritten =
+      std::find_if(m_activeRegions.begin(), m_activeRegions.end(), hasDeletedClause);
+  if (firstRewritten == m_activeRegions.end()) {
+    return;
+  }
+  std::size_t const firstRewrittenIndex = std::distance(m_activeRegions.begin(), firstRewritten);
+
   JAM_ASSERT(!m_spareRegions.empty(), "There must be at least 1 spare region");
 
   Region<ClauseT> currentSpare = std::move(m_spareRegions.back());
   m_spareRegions.pop_back();
   JAM_ASSERT(currentSpare.empty(), "Spare regions must be empty");
 
-  std::size_t swapInIndex = 0;
-  for (auto& region : m_activeRegions) {
+  std::size_t swapInIndex = firstRewrittenIndex;
+  for (auto regionIt = firstRewritten; regionIt != m_activeRegions.end(); ++regionIt) {
+    auto& region = *regionIt;
     // Let idx be the index of `region` in `m_activeRegions`.
     // Loop invariant A: (swapInIndex < idx) || (currentSpare.getFreeSize() >=
     // region.getUsedSize())
@@ -667,6 +762,17 @@ void IterableClauseDB<ClauseT>::compress() noexcept
     m_spareRegions.push_back(std::move(m_activeRegions.back()));
     m_activeRegions.pop_back();
   }
+
+  if (firstRewrittenIndex < m_changeLogRegion ||
+      (firstRewrittenIndex == m_changeLogRegion && m_changeLogOffset > 0)) {
+    m_changeLogRegion = firstRewrittenIndex;
+    m_changeLogOffset = 0;
+  }
+  if (m_changeLogRegion >= m_activeRegions.size()) {
+    // All remaining clauses are unchanged, but new clauses may be allocated in the
+    // last region:
+    clearChangeLog();
+  }
 }
 
 template <typename ClauseT>
@@ -697,4 +803,81 @@ auto IterableClauseDB<ClauseT>::getClauses() noexcept -> boost::iterator_range<i
                                     iterator{});
 }
 
+template <typename ClauseT>
+void IterableClauseDB<ClauseT>::clearChangeLog() noexcept
+{
+  if (m_activeRegions.empty()) {
+    m_changeLogRegion = 0;
+    m_changeLogOffset = 0;
+    return;
+  }
+
+  m_changeLogRegion = m_activeRegions.size() - 1;
+  m_changeLogOffset = m_activeRegions.back().getUsedSize();
+}
+
+template <typename ClauseT>
+auto IterableClauseDB<ClauseT>::getChangedClauses() noexcept -> boost::iterator_range<iterator>
+{
+  if (m_changeLogRegion >= m_activeRegions.size()) {
+    return boost::make_iterator_range(iterator{}, iterator{});
+  }
+
+  Region<ClauseT>& firstRegion = m_activeRegions[m_changeLogRegion];
+  char const* changesBegin = firstRegion.getUsedMemory().first + m_changeLogOffset;
+  auto const amntUnchanged = std::count_if(
+      firstRegion.begin(), firstRegion.end(), [changesBegin](ClauseT const& clause) {
+        return std::less<char const*>{}(reinterpret_cast<char const*>(&clause), changesBegin);
+      });
+
+  iterator begin{m_activeRegions.begin() + m_changeLogRegion, m_activeRegions.end()};
+  for (auto i = amntUnchanged; i > 0; --i) {
+    ++begin;
+  }
+  return boost::make_iterator_range(begin, iterator{});
+}
+
+template <typename ClauseT>
+auto IterableClauseDB<ClauseT>::getUnchangedClauseQuery() const -> UnchangedClauseQuery
+{
+  UnchangedClauseQuery result;
+  std::size_t const amntRegions = std::min(m_changeLogRegion + 1, m_activeRegions.size());
+  result.m_unchangedMemory.reserve(amntRegions);
+
+  for (std::size_t i = 0; i < amntRegions; ++i) {
+    auto memory = m_activeRegions[i].getUsedMemory();
+    if (i == m_changeLogRegion) {
+      memory.second = memory.first + m_changeLogOffset;
+    }
+    result.m_unchangedMemory.push_back(memory);
+  }
+
+  std::sort(result.m_unchangedMemory.begin(),
+            result.m_unchangedMemory.end(),
+            [](auto const& lhs, auto const& rhs) {
+              return std::less<char const*>{}(lhs.first, rhs.first);
+            });
+  return result;
+}
+
+template <typename ClauseT>
+auto IterableClauseDB<ClauseT>::UnchangedClauseQuery::operator()(ClauseT const* clause) const
+    noexcept -> bool
+{
+  char const* address = reinterpret_cast<char const*>(clause);
+  std::less<char const*> const less;
+
+  auto range = std::upper_bound(m_unchangedMemory.begin(),
+                                m_unchangedMemory.end(),
+                                address,
+                                [less](char const* lhs, auto const& rhs) {
+                                  return less(lhs, rhs.first);
+                                });
+  if (range == m_unchangedMemory.begin()) {
+    return false;
+  }
+  --range;
+  return less(address, range->second);
+}
+
 }
\ No newline at end of file
@@ -304,6 +304,11 @@ struct is_lbd_carrier<T,
  *   <td></td>
  *   <td>`T`</td>
  *  </tr>
+ *  <tr>
+ *   <td>`T::USED_RECENTLY`</td>
+ *   <td></td>
+ *   <td>`T`</td>
+ *  </tr>
  * </table>
  */
 template <typename, typename = j_void_t<>>
@@ -311,7 +316,9 @@ struct is_clause_flag : public std::false_type {
 };
 
 template <typename T>
-struct is_clause_flag<T, j_void_t<decltype(T::SCHEDULED_FOR_DELETION), decltype(T::REDUNDANT)>>
+struct is_clause_flag<
+    T,
+    j_void_t<decltype(T::SCHEDULED_FOR_DELETION), decltype(T::REDUNDANT), decltype(T::USED_RECENTLY)>>
   : public std::true_type {
 };
 
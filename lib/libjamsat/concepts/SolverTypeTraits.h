@@ -289,5 +289,63 @@ struct is_assignment_provider<T, j_void_t<
     // end requirements
     >> : public std::true_type {};
 
+
+/**
+ * \ingroup JamSAT_Concepts
+ *
+ * \brief Checks whether a type is a conflict analysis observer type.
+ *
+ * \tparam T        A type.
+ * \tparam Clause   The clause type used in conflict analysis.
+ *
+ * `is_conflict_analysis_observer<T, Clause>::value` is `true` if `T` satisfies the
+ * ConflictAnalysisObserver concept defined below, with `Clause` as the clause type.
+ * Otherwise, `is_conflict_analysis_observer<T, Clause>::value` is `false`.
+ *
+ * Objects of types satisfying ConflictAnalysisObserver are notified about the variables
+ * and clauses encountered during conflict analysis.
+ *
+ * A type satisfies the ConflictAnalysisObserver concept iff it satisfies the following
+ * requirements:
+ *
+ * \par Requirements
+ *
+ * Given
+ *  - `o`, an object of type `T`
+ *  - `v`, an object of type `CNFVar`
+ *  - `c`, an object of type `Clause const`
+ *
+ * <table>
+ *  <tr><th>Expression</th><th>Requirements</th><th>Return value</th></tr>
+ *  <tr>
+ *    <td> `o.onSeenVariable(v)` </td>
+ *    <td> Notifies `o` that `v` has been encountered during conflict analysis. </td>
+ *    <td> `void` </td>
+ *  </tr>
+ *  <tr>
+ *    <td> `o.onSeenClause(c)` </td>
+ *    <td> Notifies `o` that `c` has taken part in the resolution process, ie. that
+ *         `c` is the conflicting clause or a reason clause with which resolution has
+ *         been performed. </td>
+ *    <td> `void` </td>
+ *  </tr>
+ * </table>
+ */
+template<typename, typename, typename = j_void_t<>>
+struct is_conflict_analysis_observer : public std::false_type {};
+
+template<typename T, typename Clause>
+struct is_conflict_analysis_observer<T, Clause, j_void_t<
+    // For o of type T and v of type CNFVar, require that o.onSeenVariable(v) is
+    // a valid expression:
+    JAM_REQUIRE_EXPR(std::declval<T>().onSeenVariable(std::declval<CNFVar>()), void),
+
+    // For o of type T and c of type Clause const, require that o.onSeenClause(c) is
+    // a valid expression:
+    JAM_REQUIRE_EXPR(std::declval<T>().onSeenClause(std::declval<Clause const&>()), void)
+
+    // end requirements
+    >> : public std::true_type {};
+
 // clang-format on
 }
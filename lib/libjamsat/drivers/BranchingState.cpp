@@ -0,0 +1,176 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <libjamsat/drivers/BranchingState.h>
+#include <libjamsat/utils/Assert.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace jamsat {
+namespace {
+// Format: the magic bytes, the format version, the heuristic (one byte, omitted in
+// version 1), the amount of variables N, N activities (IEEE 754 single precision),
+// ceil(N/8) bytes of phases. Integers and floating-point numbers are stored in
+// little-endian byte order.
+constexpr std::array<char, 4> magic{'J', 'S', 'B', 'S'};
+constexpr uint32_t formatVersion = 2;
+constexpr uint32_t formatVersionWithoutHeuristic = 1;
+
+void writeUInt32(std::ostream& output, uint32_t value)
+{
+  std::array<char, 4> bytes;
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+  output.write(bytes.data(), bytes.size());
+}
+
+auto readUInt32(std::istream& input) -> uint32_t
+{
+  std::array<char, 4> bytes;
+  input.read(bytes.data(), bytes.size());
+  uint32_t result = 0;
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    result |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+  }
+  return result;
+}
+
+static_assert(std::numeric_limits<float>::is_iec559 && sizeof(float) == sizeof(uint32_t),
+              "The branching state format requires IEEE 754 single-precision floats");
+
+void writeFloat(std::ostream& output, float value)
+{
+  uint32_t rawValue;
+  std::memcpy(&rawValue, &value, sizeof(rawValue));
+  writeUInt32(output, rawValue);
+}
+
+auto readFloat(std::istream& input) -> float
+{
+  uint32_t const rawValue = readUInt32(input);
+  float result;
+  std::memcpy(&result, &rawValue, sizeof(result));
+  return result;
+}
+}
+
+std::ostream& operator<<(std::ostream& output, BranchingState const& state)
+{
+  JAM_ASSERT(state.activities.size() == state.phases.size(),
+             "The amount of activities and phases must be equal");
+  if (state.activities.size() > std::numeric_limits<uint32_t>::max()) {
+    output.setstate(std::ios::failbit);
+    return output;
+  }
+
+  output.write(magic.data(), magic.size());
+  writeUInt32(output, formatVersion);
+  output.put(static_cast<char>(state.heuristic));
+  writeUInt32(output, static_cast<uint32_t>(state.activities.size()));
+
+  for (double activity : state.activities) {
+    writeFloat(output, static_cast<float>(activity));
+  }
+
+  unsigned char phaseBits = 0;
+  for (std::size_t i = 0; i < state.phases.size(); ++i) {
+    if (isTrue(state.phases[i])) {
+      phaseBits |= static_cast<unsigned char>(1 << (i % 8));
+    }
+    if (i % 8 == 7 || i + 1 == state.phases.size()) {
+      output.put(static_cast<char>(phaseBits));
+      phaseBits = 0;
+    }
+  }
+
+  return output;
+}
+
+std::istream& operator>>(std::istream& input, BranchingState& state)
+{
+  state.heuristic = BranchingState::Heuristic::VSIDS;
+  state.activities.clear();
+  state.phases.clear();
+
+  auto fail = [&input, &state]() -> std::istream& {
+    state.heuristic = BranchingState::Heuristic::VSIDS;
+    state.activities.clear();
+    state.phases.clear();
+    input.setstate(std::ios::failbit);
+    return input;
+  };
+
+  std::array<char, 4> magicInput;
+  input.read(magicInput.data(), magicInput.size());
+  if (!input || magicInput != magic) {
+    return fail();
+  }
+
+  uint32_t const version = readUInt32(input);
+  if (!input || (version != formatVersion && version != formatVersionWithoutHeuristic)) {
+    return fail();
+  }
+
+  if (version != formatVersionWithoutHeuristic) {
+    int const heuristic = input.get();
+    if (!input || heuristic > static_cast<int>(BranchingState::Heuristic::LRB)) {
+      return fail();
+    }
+    state.heuristic = static_cast<BranchingState::Heuristic>(heuristic);
+  }
+
+  uint32_t const amntVariables = readUInt32(input);
+  if (!input) {
+    return fail();
+  }
+
+  // Not reserving amntVariables elements in advance, since the size might be bogus:
+  for (uint32_t i = 0; i < amntVariables; ++i) {
+    float const activity = readFloat(input);
+    if (!input || !std::isfinite(activity) || activity < 0.0f) {
+      return fail();
+    }
+    state.activities.push_back(activity);
+  }
+
+  for (uint32_t i = 0; i < amntVariables; i += 8) {
+    int const phaseBits = input.get();
+    if (!input) {
+      return fail();
+    }
+    for (uint32_t bit = 0; bit < 8 && i + bit < amntVariables; ++bit) {
+      state.phases.push_back(toTBool(((phaseBits >> bit) & 1) == 1));
+    }
+  }
+
+  return input;
+}
+}
@@ -0,0 +1,97 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file BranchingState.h
+ * \brief Exportable branching heuristic state for warm-starting solvers
+ */
+
+#pragma once
+
+#include <libjamsat/utils/Truth.h>
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace jamsat {
+
+/**
+ * \ingroup JamSAT_Drivers
+ *
+ * \brief The state of a solver's branching heuristic, as exported by
+ *        `CDCLSatSolver::exportBranchingState()`
+ *
+ * For each variable `v` with raw value `i`, `activities[i]` is the score of `v`
+ * in the branching heuristic `heuristic`, and `phases[i]` is the phase of `v`.
+ * `activities` and `phases` have the same size. The scores are
+ *  - for VSIDS, the activity of `v` relative to the activity bump increment the
+ *    solver used at the time of the export;
+ *  - for VMTF, the position of `v` in the queue divided by the amount of variables,
+ *    with greater values being closer to the front of the queue;
+ *  - for LRB, the learning rate activity of `v`, which is in the range `[0, 1]`.
+ */
+struct BranchingState {
+  /** The branching heuristics whose scores can be stored in a branching state */
+  enum class Heuristic { VSIDS, VMTF, LRB };
+
+  Heuristic heuristic = Heuristic::VSIDS;
+  std::vector<double> activities;
+  std::vector<TBool> phases;
+};
+
+/**
+ * \ingroup JamSAT_Drivers
+ *
+ * \brief Writes the given branching state to the given stream in a compact
+ *        binary format.
+ *
+ * The heuristic is stored as a byte, the activities are stored as single-precision
+ * floating-point numbers, and the phases are stored as bits. INDETERMINATE phases
+ * are stored as FALSE.
+ *
+ * \param output    The target output stream, which should be opened in binary mode.
+ * \param state     The branching state to be written. The sizes of
+ *                  `state.activities` and `state.phases` must be equal.
+ */
+std::ostream& operator<<(std::ostream& output, BranchingState const& state);
+
+/**
+ * \ingroup JamSAT_Drivers
+ *
+ * \brief Reads a branching state written by `operator<<(std::ostream&, BranchingState const&)`
+ *        from the given stream.
+ *
+ * States written in the format of earlier versions, which does not contain the
+ * heuristic, are read as VSIDS states. If reading the state fails, e.g. due to the
+ * stream containing malformed data, \p state is empty when this method returns, and
+ * the fail bit of \p input is set.
+ *
+ * \param input     The input stream, which should be opened in binary mode.
+ * \param state     The branching state object receiving the data.
+ */
+std::istream& operator>>(std::istream& input, BranchingState& state);
+}
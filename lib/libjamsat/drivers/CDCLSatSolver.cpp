@@ -31,19 +31,34 @@
 
 #include <libjamsat/drivers/CDCLSatSolver.h>
 
+#include <libjamsat/branching/LRBBranchingHeuristic.h>
+#include <libjamsat/branching/VMTFBranchingHeuristic.h>
 #include <libjamsat/branching/VSIDSBranchingHeuristic.h>
 #include <libjamsat/clausedb/Clause.h>
 #include <libjamsat/clausedb/IterableClauseDB.h>
 #include <libjamsat/proof/DRATCertificate.h>
 #include <libjamsat/proof/Model.h>
 #include <libjamsat/simplification/ClauseMinimization.h>
+#include <libjamsat/simplification/ModelReconstruction.h>
+#include <libjamsat/simplification/OptimizerScheduler.h>
 #include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/XorDetection.h>
+#include <libjamsat/simplification/optimizers/BlockedClauseElimination.h>
+#include <libjamsat/simplification/optimizers/BoundedVariableAddition.h>
+#include <libjamsat/simplification/optimizers/BoundedVariableElimination.h>
+#include <libjamsat/simplification/optimizers/EquivalentLiteralSubstitution.h>
 #include <libjamsat/simplification/optimizers/FactCleaner.h>
+#include <libjamsat/simplification/optimizers/FailedLiteralProbing.h>
+#include <libjamsat/simplification/optimizers/Subsumption.h>
+#include <libjamsat/simplification/optimizers/TransitiveReduction.h>
+#include <libjamsat/simplification/optimizers/Vivification.h>
 #include <libjamsat/solver/Assignment.h>
 #include <libjamsat/solver/AssignmentAnalysis.h>
 #include <libjamsat/solver/ClauseDBReductionPolicies.h>
 #include <libjamsat/solver/FirstUIPLearning.h>
+#include <libjamsat/solver/GaussJordanEngine.h>
 #include <libjamsat/solver/LiteralBlockDistance.h>
+#include <libjamsat/solver/RephasingPolicy.h>
 #include <libjamsat/solver/RestartPolicies.h>
 #include <libjamsat/solver/Statistics.h>
 #include <libjamsat/utils/Logger.h>
@@ -51,12 +66,17 @@
 #include <libjamsat/utils/RangeUtils.h>
 #include <libjamsat/utils/StampMap.h>
 
-#include <boost/range/adaptors.hpp>
 #include <boost/variant.hpp>
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <random>
+#include <stdexcept>
 
 
 #if defined(JAM_ENABLE_SOLVER_LOGGING)
@@ -95,6 +115,224 @@ private:
   std::vector<CNFLit> m_failedAssumptions;
 };
 
+/**
+ * \ingroup JamSAT_Drivers
+ *
+ * \brief Branching heuristic delegating to the branching heuristic selected at runtime.
+ *
+ * All heuristics are kept up to date with respect to the maximum variable and the
+ * eligibility of variables for decisions. Only the selected heuristic is informed
+ * about conflicts and backtracking, and it is reset when it gets selected.
+ *
+ * \tparam AssignmentProvider   See VSIDSBranchingHeuristic.
+ */
+template <typename AssignmentProvider>
+class SelectableBranchingHeuristic {
+public:
+  using Kind = CDCLSatSolver::BranchingHeuristic;
+
+  SelectableBranchingHeuristic(CNFVar maxVar, AssignmentProvider const& assignmentProvider)
+    : m_vsids{maxVar, assignmentProvider}
+    , m_vmtf{maxVar, assignmentProvider}
+    , m_lrb{maxVar, assignmentProvider}
+    , m_selected{Kind::VSIDS}
+  {
+  }
+
+  void select(Kind heuristic) noexcept
+  {
+    if (heuristic == m_selected) {
+      return;
+    }
+    m_selected = heuristic;
+    switch (m_selected) {
+    case Kind::VMTF:
+      m_vmtf.reset();
+      break;
+    case Kind::LRB:
+      m_lrb.reset();
+      break;
+    default:
+      m_vsids.reset();
+    }
+  }
+
+  /**
+   * \brief Determines whether the selected heuristic needs to be informed about
+   *   assignments via assigned().
+   */
+  auto requiresAssignmentNotifications() const noexcept -> bool
+  {
+    return m_selected == Kind::LRB;
+  }
+
+  auto pickBranchLiteral() noexcept -> CNFLit
+  {
+    switch (m_selected) {
+    case Kind::VMTF:
+      return m_vmtf.pickBranchLiteral();
+    case Kind::LRB:
+      return m_lrb.pickBranchLiteral();
+    default:
+      return m_vsids.pickBranchLiteral();
+    }
+  }
+
+  void seenInConflict(CNFVar variable) noexcept
+  {
+    switch (m_selected) {
+    case Kind::VMTF:
+      m_vmtf.seenInConflict(variable);
+      break;
+    case Kind::LRB:
+      m_lrb.seenInConflict(variable);
+      break;
+    default:
+      m_vsids.seenInConflict(variable);
+    }
+  }
+
+  template <typename LiteralRange, typename ReasonProvider>
+  void registerLemma(LiteralRange const& lemma, ReasonProvider const& reasonProvider) noexcept
+  {
+    if (m_selected == Kind::LRB) {
+      m_lrb.registerLemma(lemma, reasonProvider);
+    }
+  }
+
+  void assigned(CNFVar variable) noexcept
+  {
+    if (m_selected == Kind::LRB) {
+      m_lrb.assigned(variable);
+    }
+  }
+
+  void reset(CNFVar variable) noexcept
+  {
+    switch (m_selected) {
+    case Kind::VMTF:
+      m_vmtf.reset(variable);
+      break;
+    case Kind::LRB:
+      m_lrb.reset(variable);
+      break;
+    default:
+      m_vsids.reset(variable);
+    }
+  }
+
+  void beginHandlingConflict() noexcept
+  {
+    switch (m_selected) {
+    case Kind::VMTF:
+      m_vmtf.beginHandlingConflict();
+      break;
+    case Kind::LRB:
+      m_lrb.beginHandlingConflict();
+      break;
+    default:
+      m_vsids.beginHandlingConflict();
+    }
+  }
+
+  void endHandlingConflict() noexcept
+  {
+    switch (m_selected) {
+    case Kind::VMTF:
+      m_vmtf.endHandlingConflict();
+      break;
+    case Kind::LRB:
+      m_lrb.endHandlingConflict();
+      break;
+    default:
+      m_vsids.endHandlingConflict();
+    }
+  }
+
+  void setEligibleForDecisions(CNFVar variable, bool isEligible) noexcept
+  {
+    m_vsids.setEligibleForDecisions(variable, isEligible);
+    m_vmtf.setEligibleForDecisions(variable, isEligible);
+    m_lrb.setEligibleForDecisions(variable, isEligible);
+  }
+
+  void setVSIDSDecayRate(double decayRate) noexcept { m_vsids.setDecayRate(decayRate); }
+
+  void setVSIDSUseTargetPhases(bool useTargetPhases) noexcept
+  {
+    m_vsids.setUseTargetPhases(useTargetPhases);
+  }
+
+  auto getVSIDSActivity(CNFVar variable) const noexcept -> double
+  {
+    return m_vsids.getActivity(variable);
+  }
+
+  void setVSIDSActivity(CNFVar variable, double activity) noexcept
+  {
+    m_vsids.setActivity(variable, activity);
+  }
+
+  auto getVSIDSActivityBumpDelta() const noexcept -> double
+  {
+    return m_vsids.getActivityBumpDelta();
+  }
+
+  auto getLRBActivity(CNFVar variable) const noexcept -> double
+  {
+    return m_lrb.getActivity(variable);
+  }
+
+  void setLRBActivity(CNFVar variable, double activity) noexcept
+  {
+    m_lrb.setActivity(variable, activity);
+  }
+
+  auto getVMTFEnqueueTime(CNFVar variable) const noexcept -> uint64_t
+  {
+    return m_vmtf.getEnqueueTime(variable);
+  }
+
+  void moveToVMTFQueueFront(CNFVar variable) noexcept { m_vmtf.moveToFront(variable); }
+
+  void increaseMaxVarTo(CNFVar newMaxVar)
+  {
+    m_vsids.increaseMaxVarTo(newMaxVar);
+    m_vmtf.increaseMaxVarTo(newMaxVar);
+    m_lrb.increaseMaxVarTo(newMaxVar);
+  }
+
+private:
+  VSIDSBranchingHeuristic<AssignmentProvider> m_vsids;
+  VMTFBranchingHeuristic<AssignmentProvider> m_vmtf;
+  LRBBranchingHeuristic<AssignmentProvider> m_lrb;
+  Kind m_selected;
+};
+
+/**
+ * \ingroup JamSAT_Drivers
+ *
+ * \brief Conflict analysis observer bumping the activities of the variables seen
+ *   during conflict analysis.
+ *
+ * \tparam BranchingHeuristic    The branching heuristic type.
+ */
+template <typename BranchingHeuristic>
+class ActivityBumpingObserver {
+public:
+  explicit ActivityBumpingObserver(BranchingHeuristic& branchingHeuristic) noexcept
+    : m_branchingHeuristic{branchingHeuristic}
+  {
+  }
+
+  void onSeenVariable(CNFVar var) noexcept { m_branchingHeuristic.seenInConflict(var); }
+
+  void onSeenClause(Clause const&) noexcept {}
+
+private:
+  BranchingHeuristic& m_branchingHeuristic;
+};
+
 /**
  * \ingroup JamSAT_Drivers
  *
@@ -121,15 +359,26 @@ public:
      */
     uint32_t clauseRemovalIntervalGrowthRate = 1300;
 
-    /** The restart policy configuration */
-    GlucoseRestartPolicy::Options restartPolicyOptions = GlucoseRestartPolicy::Options{};
+    /** The restart policy configuration, including the search mode lengths */
+    ModeSwitchingRestartPolicy::Options restartPolicyOptions =
+        ModeSwitchingRestartPolicy::Options{};
+
+    /** The VSIDS decay rate used in focused search mode */
+    double focusedModeVSIDSDecayRate = 0.8;
+
+    /** The VSIDS decay rate used in stable search mode */
+    double stableModeVSIDSDecayRate = 0.95;
+
+    /** The rephasing policy configuration */
+    RephasingPolicy::Options rephasingPolicyOptions = RephasingPolicy::Options{};
 
     /**
-     * The maximum amount of clauses for which LBD updates are performed during
-     * backtracking
+     * Iff `true`, bounded variable addition is performed during simplification. Since
+     * the added variables are allocated above the maximum variable known to the solver,
+     * no clauses or assumptions containing new variables may be added after the first
+     * call to `solve()`. See CDCLSatSolver::setVariableAdditionEnabled().
      */
-    std::size_t maxLBDUpdatesOnBacktrack = 32;
-
+    bool enableVariableAddition = false;
 
     /** Iff `true`, the solver regularly prints statistics */
     bool printStatistics = true;
@@ -143,15 +392,44 @@ public:
   void stop() noexcept override;
   void setLogger(LoggerFn loggerFunction) override;
   void setDRATCertificate(DRATCertificate& cert) noexcept override;
+  void setFailedAssumptionsMinimization(FailedAssumptionsMinimization mode,
+                                        uint64_t conflictBudget) noexcept override;
+  void setBranchingHeuristic(BranchingHeuristic heuristic) noexcept override;
+  void setVariableAdditionEnabled(bool enabled) override;
+  auto exportBranchingState() -> BranchingState override;
+  void importBranchingState(BranchingState const& state) override;
+  void setDefaultPhase(CNFVar variable, TBool phase) override;
+  void setDecisionPriority(CNFVar variable, uint32_t priority) override;
 
   virtual ~CDCLSatSolverImpl();
 
 private:
   using ClauseT = Clause;
 
-  /** Adjusts the sizes of all subsystems after new SAT variables have been detected */
+  /**
+   * Adjusts the sizes of all subsystems after new SAT variables have been detected,
+   * and applies the imported branching state and the default phases to the new variables
+   */
   void resizeSubsystems();
 
+  /**
+   * Applies the activities and phases of the imported branching state to the variables
+   * to which they have not been applied yet.
+   */
+  void applyImportedBranchingState();
+
+  /**
+   * Applies the default phases set via setDefaultPhase() to the known variables to which
+   * they have not been applied yet.
+   */
+  void applyDefaultPhases() noexcept;
+
+  /**
+   * Returns the default phase of \p variable, i.e. `false` if no default phase has been
+   * set via setDefaultPhase().
+   */
+  auto getDefaultPhase(CNFVar variable) const noexcept -> TBool;
+
   /**
    * Adjusts subsystems storing pointers to clauses. This method restores the solver's
    * consistency after a clause database compression has been performed.
@@ -160,21 +438,149 @@ private:
    */
   void synchronizeSubsystemsWithClauseDB();
 
-  /** Sets all variables except for assumed facts as eligible for being branched on */
+  /**
+   * Selects the configured branching heuristic and sets all variables except for assumed
+   * facts as eligible for being branched on
+   */
   void initializeBranchingHeuristic(std::vector<CNFLit> const& assumedFacts);
 
+  /**
+   * Partitions the variables not occurring in \p assumedFacts into groups of variables
+   * having the same decision priority, ordered by descending priority. If all variables
+   * have the same priority, no groups are created.
+   */
+  void initializePriorityGroups(std::vector<CNFLit> const& assumedFacts);
+
+  /**
+   * Makes the variables added during simplification, i.e. the variables greater than
+   * \p previousMaxVar, eligible for being branched on. If priority groups exist, the
+   * variables are instead added to the last group, which contains the variables with
+   * priority 0, and become eligible when that group is activated.
+   */
+  void addSimplificationVariables(CNFVar previousMaxVar);
+
+  /**
+   * Throws std::invalid_argument if bounded variable addition is enabled and any of
+   * the given literals has a variable that has not been known to the solver at the
+   * first call to solve().
+   */
+  void checkVariablesKnownAtFirstSolve(gsl::span<CNFLit const> literals) const;
+
+  /**
+   * Picks a branching literal via the branching heuristic. If the variables eligible for
+   * branching decisions have been exhausted, the next priority group is made eligible.
+   *
+   * \returns a branching literal, or the undefined literal if all variables eligible for
+   *   branching decisions are assigned.
+   */
+  auto pickBranchLiteral() noexcept -> CNFLit;
+
+  /**
+   * Makes the priority groups ineligible for branching decisions which have been made
+   * eligible on decision levels `[level, currentDecisionLevel]`.
+   */
+  void deactivatePriorityGroups(Assignment::Level level) noexcept;
+
+  /**
+   * Configures the branching heuristic for the current search mode: in focused mode,
+   * the configured branching heuristic is used, with VSIDS decaying fast. In stable
+   * mode, slowly decaying VSIDS is used unless LRB has been configured.
+   *
+   * This method may only be called during restarts.
+   */
+  void applySearchMode() noexcept;
+
+  /**
+   * Resets the variable phases as advised by the rephasing policy, and resets the
+   * target phases to the new phases.
+   *
+   * This method may only be called during restarts.
+   */
+  void rephase() noexcept;
+
   enum class SimplificationResult { NONE, DETECTED_UNSAT };
 
   /**
    * Performs simplification if suitable.
    *
    * This method may only be called during restarts.
+   *
+   * \param assumedFacts   The facts assumed in the current call to solve(). Their
+   *                       variables are not eliminated, and neither are the variables
+   *                       of the failed assumptions currently being minimized.
    * 
    * \returns SimplificationResult::DETECTED_UNSAT if unsatisfiability has been
    *   determined during simplification, eg. by finding contradicting facts. Otherwise,
    *   NONE is returned.
    */
-  auto trySimplify() -> SimplificationResult;
+  auto trySimplify(std::vector<CNFLit> const& assumedFacts) -> SimplificationResult;
+
+  /**
+   * Adds the clauses removed by variable elimination or blocked clause elimination back
+   * to the problem, and makes the eliminated variables eligible for branching decisions
+   * again.
+   *
+   * This method needs to be called before clauses or assumptions containing a variable
+   * for which requiresRestoration() returns true are added.
+   */
+  void restoreEliminatedVariables();
+
+  /**
+   * Returns true iff \p var has been eliminated or is the witness variable of a clause
+   * removed by simplification.
+   */
+  auto requiresRestoration(CNFVar var) const noexcept -> bool;
+
+  /**
+   * Sets the phases of the unassigned witness variables of clauses removed by
+   * simplification to their values in \p model, since the model reconstruction may
+   * have flipped them. This method must be called after backtracking at the end of
+   * solve().
+   */
+  void adoptWitnessPhases(Model const& model) noexcept;
+
+  /**
+   * Returns true iff all variables not eliminated by simplification are assigned.
+   */
+  auto isAssignmentComplete() const noexcept -> bool;
+
+  /**
+   * Backtracks to the highest decision level whose assignments can be kept for
+   * solving under the given assumptions, and registers the clauses added since the
+   * previous call to solve() for propagation.
+   *
+   * Decision levels assigning assumed facts retained from the previous call to solve()
+   * are kept if the respective assumed facts also form a prefix of \p assumedFacts,
+   * except for decision levels on which some new clause would be unit or falsified.
+   * If no such decision level can be kept, all assignments are undone and all clauses
+   * are re-registered via synchronizeSubsystemsWithClauseDB().
+   *
+   * \param assumedFacts   Facts that shall be assumed (all variables <= m_maxVar),
+   *                       containing no duplicates.
+   */
+  void backtrackToRetainedAssumptions(std::vector<CNFLit> const& assumedFacts);
+
+  /**
+   * Reorders the given clause such that its first two literals are the best literals
+   * for watching them under the current assignment, ie. non-false literals first,
+   * followed by the false literals having the highest decision levels.
+   *
+   * \param clause  A clause not yet registered for propagation.
+   *
+   * \returns the highest decision level L such that the first two literals of
+   *   \p clause have no `false` assignment after backtracking to L. L may not be
+   *   lower than 0.
+   */
+  auto prepareWatchedLiterals(ClauseT& clause) noexcept -> Assignment::Level;
+
+  /**
+   * Backtracks to the decision levels assigning assumed facts, keeping these decision
+   * levels for the next call to solve(). This method must be called at the end of
+   * solve().
+   *
+   * \param assumedFacts   The assumed facts of the current call to solve().
+   */
+  void retainAssumptionLevels(std::vector<CNFLit> const& assumedFacts);
 
   /**
    * Heuristically deletes clauses from the clause database.
@@ -191,6 +597,12 @@ private:
    */
   void prepareBacktrack(Assignment::Level targetLevel);
 
+  /**
+   * Informs the branching heuristic about the assignments made since this
+   * method has last been called, if the branching heuristic requires it.
+   */
+  void notifyBranchingHeuristicOfAssignments() noexcept;
+
   /**
    * Backtracks all decisions. After this, the solver is on decision level
    * 0, without variable assignments.
@@ -206,13 +618,49 @@ private:
    */
   void backtrackToLevel(Assignment::Level targetLevel);
 
+  /**
+   * Performs CDCL search until the problem has been solved under the given assumptions,
+   * until stop() has been called or until the conflict limit has been reached.
+   *
+   * \param[in]  assumedFacts         Facts that shall be assumed (all variables <= m_maxVar)
+   * \param[out] failedAssumptions    (see solveUntilRestart)
+   *
+   * \returns TBools::TRUE rsp. TBools::FALSE if the problem has been determined to be
+   * satisfiable rsp. unsatisfiable under the assumptions. In the former case, the current
+   * variable assignment is a model for the SAT problem instance. Otherwise,
+   * TBools::INDETERMINATE is returned.
+   */
+  auto solveUnderAssumptions(std::vector<CNFLit> const& assumedFacts,
+                             std::vector<CNFLit>& failedAssumptions) -> TBool;
+
+  /**
+   * Minimizes the given set of failed assumptions via deletion-based minimization,
+   * performing nested calls to solveUnderAssumptions(). Each nested call is bounded
+   * by the conflict budget configured via setFailedAssumptionsMinimization().
+   *
+   * After this method returns, the solver is on decision level 0, without variable
+   * assignments.
+   *
+   * \param[in,out] failedAssumptions  A set of failed assumptions, which is replaced
+   *                                   by a subset of failed assumptions.
+   */
+  void minimizeFailedAssumptions(std::vector<CNFLit>& failedAssumptions);
+
   /**
    * Performs CDCL until a restart needs to be performed.
    *
    * This method may only be called during restarts, ie. when the solver is on
-   * decision level 0 and no SAT variables have been assigned.
+   * decision level 0 and no SAT variables have been assigned, or when the solver
+   * is on a decision level L <= `assumedFacts.size()` that has been retained by
+   * backtrackToRetainedAssumptions().
    *
-   * \param[in]  assumedFacts         Facts that shall be assumed (all variables <= m_maxVar)
+   * The i'th assumed fact is assigned on decision level i+1 (before any branching
+   * decision is made), so that backjumps preserve the assignments of the assumed facts
+   * not involved in the conflict. If an assumed fact is already satisfied when it would
+   * be assigned, its decision level remains empty.
+   *
+   * \param[in]  assumedFacts         Facts that shall be assumed (all variables <= m_maxVar),
+   *                                  containing no duplicates.
    * \param[out] failedAssumptions    If the result is UNSAT and the setting of
    *                                  assumedFacts has led to the UNSAT result,
    *                                  a subset Z of assumedFacts is stored in
@@ -223,7 +671,8 @@ private:
    * and the current variable assignment is a model for the SAT problem instance. If
    * TBool::FALSE is returned, the problem instance is not satisfiable.
    * If TBool::INDETERMINATE is returned, a restart must be performed and the
-   * solver is on decision level 0, with all variable assignemnts undone.
+   * solver is on decision level 0, with all variable assignemnts undone, or
+   * the solver has been stopped rsp. has reached its conflict limit.
    */
   auto solveUntilRestart(std::vector<CNFLit> const& assumedFacts,
                          std::vector<CNFLit>& failedAssumptions) -> TBool;
@@ -234,13 +683,11 @@ private:
    * Propagates the given facts.
    *
    * \param[in]     factsToPropagate   Facts to be propagated (all variables <= m_maxVar)
-   * \param[in,out] failedAssumptions  (see solveUntilRestart)
    *
    * \returns INCONSISTENT if a conflict occured during propagation. Otherwise, CONSISTENT
    *          is returned.
    */
-  auto propagateFactsOnSystemLevels(std::vector<CNFLit> const& factsToPropagate,
-                                    std::vector<CNFLit>* failedAssumptions)
+  auto propagateFactsOnSystemLevels(std::vector<CNFLit> const& factsToPropagate)
       -> FactPropagationResult;
 
   /**
@@ -253,18 +700,14 @@ private:
    */
   auto propagateHardFacts(std::vector<CNFLit>& facts) -> FactPropagationResult;
 
-
   /**
-   * Propagates the given assumed facts.
+   * Returns the given assumed facts without duplicates, preserving the order of
+   * their first occurrences.
    *
-   * \param[in]     factsToPropagate   Facts to be propagated (all variables <= m_maxVar)
-   * \param[in,out] failedAssumptions  (see solveUntilRestart)
-   *
-   * \returns INCONSISTENT if a conflict occured during propagation. Otherwise, CONSISTENT
-   *          is returned.
+   * \param assumedFacts   Facts that shall be assumed (all variables <= m_maxVar)
    */
-  auto propagateAssumedFacts(std::vector<CNFLit> const& assumedFacts,
-                             std::vector<CNFLit>& failedAssumptions) -> FactPropagationResult;
+  auto withoutDuplicateAssumptions(std::vector<CNFLit> const& assumedFacts)
+      -> std::vector<CNFLit>;
 
   /**
    * Creates a SolvingResult object describing the current solver state.
@@ -288,6 +731,17 @@ private:
    */
   void optimizeLemma(std::vector<CNFLit>& lemma);
 
+  /**
+   * Propagates the XOR constraints under the current assignment, extending the
+   * assignment until fixpoint.
+   *
+   * The reasons for XOR-implied assignments are owned by m_gaussJordanEngine and are
+   * not added to the clause database.
+   *
+   * \returns A conflicting clause if a conflict has been found, otherwise nullptr.
+   */
+  auto propagateXorConstraints() -> ClauseT*;
+
   /**
    * Derives a lemma from the given conflicting clause.
    *
@@ -301,16 +755,6 @@ private:
    */
   auto deriveLemma(ClauseT& conflictingClause) -> LemmaDerivationResult;
 
-
-  /**
-   * Recomputes the LBD value of the reason clauses associated with the assignments
-   * on the current decision level.
-   *
-   * Udating reason clauses on the current level is relatively cheap since those clauses
-   * have likely been used recently and thus are likely present in the L2 cache.
-   */
-  void updateReasonClauseLBDsOnCurrentLevel();
-
   enum class ResolveDecisionResult { CONTINUE, RESTART };
 
   /**
@@ -343,29 +787,106 @@ private:
 
   // Solver subsystems
   Assignment m_assignment;
-  VSIDSBranchingHeuristic<Assignment> m_branchingHeuristic;
-  FirstUIPLearning<Assignment, Assignment> m_conflictAnalyzer;
+  using BranchingHeuristicT = SelectableBranchingHeuristic<Assignment>;
+  BranchingHeuristicT m_branchingHeuristic;
+  /** The amount of assignments on the trail the branching heuristic has been informed about */
+  Assignment::size_type m_amntAssignmentsNotified;
+  FirstUIPLearning<Assignment, Assignment, ActivityBumpingObserver<BranchingHeuristicT>>
+      m_conflictAnalyzer;
 
   std::unique_ptr<ProblemOptimizer> m_optimizer;
+  ModelReconstructionStack m_reconstructionStack;
+
+  /**
+   * The occurrence map of the last simplification round, retained to avoid rebuilding
+   * it in the next round. Between simplification rounds, clauses may only be added to
+   * m_clauseDB and deleted by compressing m_clauseDB.
+   */
+  std::optional<SharedOptimizerState::OccMap> m_occurrenceMap;
+
+  /** Propagates the XOR constraints detected during simplification */
+  GaussJordanEngine m_gaussJordanEngine;
+
+  /**
+   * True iff irredundant clauses have been added or changed since the XOR constraints
+   * of m_gaussJordanEngine have been detected. Otherwise, the constraints are reused
+   * in the next simplification round instead of detecting them again.
+   */
+  bool m_xorConstraintsOutdated;
 
   // Clause storage
   IterableClauseDB<ClauseT> m_clauseDB;
   std::vector<CNFLit> m_facts;
   std::vector<ClauseT*> m_lemmas;
 
+  /** Clauses added since the last registration of clauses for propagation */
+  std::vector<ClauseT*> m_newClauses;
+
+  /** The assumed facts assigned on the decision levels retained after solve() */
+  std::vector<CNFLit> m_assignedAssumptions;
+
   // Policies
-  GlucoseClauseDBReductionPolicy<ClauseT, std::vector<ClauseT*>, LBD> m_clauseDBReductionPolicy;
-  GlucoseRestartPolicy m_restartPolicy;
+  TieredClauseDBReductionPolicy<ClauseT, std::vector<ClauseT*>, LBD> m_clauseDBReductionPolicy;
+  ModeSwitchingRestartPolicy m_restartPolicy;
+  RephasingPolicy m_rephasingPolicy;
+  /** The random number generator used for rephasing with random phases */
+  std::minstd_rand m_rephasingRNG;
 
   // Control
   CNFVar m_maxVar;
+
+  /** The maximum variable known at the first call to solve(), if solve() has been called */
+  std::optional<CNFVar> m_maxVarAtFirstSolve;
   bool m_detectedUNSAT;
   bool m_hadUnrecoverableError;
-  uint64_t m_amntBinariesLearnt;
   Statistics<> m_statistics;
   std::atomic<bool> m_stopRequested;
+  uint64_t m_conflictLimit;
   Config m_configuration;
 
+  FailedAssumptionsMinimization m_failedAssumptionsMinimization;
+  uint64_t m_failedAssumptionsMinimizationBudget;
+
+  /**
+   * The failed assumptions being minimized by minimizeFailedAssumptions(). Their
+   * variables are not eliminated by simplification during the minimization, since
+   * assumptions dropped by a nested call may be assumed again by a later one.
+   */
+  std::vector<CNFLit> m_assumptionsUnderMinimization;
+
+  BranchingHeuristic m_selectedBranchingHeuristic;
+
+  /** The branching state set via importBranchingState() */
+  BranchingState m_importedBranchingState;
+
+  /** The amount of variables to which m_importedBranchingState has been applied */
+  std::size_t m_amntImportedVarsApplied;
+
+  /** The default phases set via setDefaultPhase(), indexed by raw variable values */
+  std::vector<TBool> m_defaultPhases;
+
+  /** Variables whose default phases have not been applied yet */
+  std::vector<CNFVar> m_pendingDefaultPhases;
+
+  /** The decision priorities set via setDecisionPriority(), indexed by raw variable values */
+  std::vector<uint32_t> m_decisionPriorities;
+
+  /**
+   * The variables eligible for branching decisions in the current call to solve(),
+   * ordered by descending decision priority. Empty if there is just one priority group.
+   */
+  std::vector<CNFVar> m_priorityOrderedVars;
+
+  /** For each priority group, the index of its end in m_priorityOrderedVars */
+  std::vector<std::size_t> m_priorityGroupEnds;
+
+  /**
+   * For the i'th priority group eligible for branching decisions, the decision level
+   * m_priorityGroupActivationLevels[i-1] on which it has been made eligible (the first
+   * group is always eligible). The group is made ineligible when that level is undone.
+   */
+  std::vector<Assignment::Level> m_priorityGroupActivationLevels;
+
   // Buffers
   std::vector<CNFLit> m_lemmaBuffer;
   StampMap<uint16_t, CNFVar::Index, CNFLit::Index, Assignment::LevelKey> m_stamps;
@@ -391,6 +912,25 @@ SolvingResultImpl::SolvingResultImpl(TBool result,
 
 SolvingResultImpl::~SolvingResultImpl() {}
 
+namespace {
+auto createInprocessingOptimizer(bool enableVariableAddition) -> std::unique_ptr<ProblemOptimizer>
+{
+  std::vector<std::unique_ptr<ProblemOptimizer>> optimizers;
+  optimizers.push_back(createFailedLiteralProber());
+  optimizers.push_back(createFactCleaner());
+  optimizers.push_back(createTransitiveReducer());
+  optimizers.push_back(createEquivalentLiteralSubstitutor());
+  optimizers.push_back(createSubsumptionOptimizer());
+  if (enableVariableAddition) {
+    optimizers.push_back(createBoundedVariableAdder());
+  }
+  optimizers.push_back(createVivifier());
+  optimizers.push_back(createBlockedClauseEliminator());
+  optimizers.push_back(createBoundedVariableEliminator());
+  return createOptimizerScheduler(std::move(optimizers));
+}
+}
+
 auto SolvingResultImpl::isProblemSatisfiable() const noexcept -> TBool
 {
   return m_result;
@@ -416,27 +956,50 @@ CDCLSatSolverImpl::CDCLSatSolverImpl(Config const& configuration)
   : CDCLSatSolver()
   , m_assignment{CNFVar{0}}
   , m_branchingHeuristic{CNFVar{0}, m_assignment}
-  , m_conflictAnalyzer{CNFVar{0}, m_assignment, m_assignment}
-  , m_optimizer{createFactCleaner()}
+  , m_amntAssignmentsNotified{0}
+  , m_conflictAnalyzer{CNFVar{0},
+                       m_assignment,
+                       m_assignment,
+                       ActivityBumpingObserver<BranchingHeuristicT>{m_branchingHeuristic}}
+  , m_optimizer{createInprocessingOptimizer(configuration.enableVariableAddition)}
+  , m_reconstructionStack{}
+  , m_occurrenceMap{}
+  , m_gaussJordanEngine{CNFVar{0}}
+  , m_xorConstraintsOutdated{true}
   , m_clauseDB{configuration.clauseRegionSize}
   , m_facts{}
   , m_lemmas{}
+  , m_newClauses{}
+  , m_assignedAssumptions{}
   , m_clauseDBReductionPolicy{configuration.clauseRemovalIntervalGrowthRate, m_lemmas}
   , m_restartPolicy{configuration.restartPolicyOptions}
+  , m_rephasingPolicy{configuration.rephasingPolicyOptions}
+  , m_rephasingRNG{}
   , m_maxVar{CNFVar{0}}
+  , m_maxVarAtFirstSolve{}
   , m_detectedUNSAT{false}
   , m_hadUnrecoverableError{false}
-  , m_amntBinariesLearnt{0}
   , m_statistics{}
   , m_stopRequested{false}
+  , m_conflictLimit{std::numeric_limits<uint64_t>::max()}
   , m_configuration{configuration}
+  , m_failedAssumptionsMinimization{FailedAssumptionsMinimization::NONE}
+  , m_failedAssumptionsMinimizationBudget{0}
+  , m_assumptionsUnderMinimization{}
+  , m_selectedBranchingHeuristic{BranchingHeuristic::VSIDS}
+  , m_importedBranchingState{}
+  , m_amntImportedVarsApplied{0}
+  , m_defaultPhases{}
+  , m_pendingDefaultPhases{}
+  , m_decisionPriorities{}
+  , m_priorityOrderedVars{}
+  , m_priorityGroupEnds{}
+  , m_priorityGroupActivationLevels{}
   , m_lemmaBuffer{}
   , m_stamps{getMaxLit(CNFVar{0}).getRawValue()}
   , m_loggerFn{}
   , m_certificate{nullptr}
 {
-  m_conflictAnalyzer.setOnSeenVariableCallback(
-      [this](CNFVar var) { m_branchingHeuristic.seenInConflict(var); });
 }
 
 CDCLSatSolverImpl::~CDCLSatSolverImpl() {}
@@ -470,6 +1033,8 @@ auto compressClause(CNFClause const& clause) -> std::optional<std::vector<CNFLit
 
 void CDCLSatSolverImpl::addClause(CNFClause const& clause)
 {
+  checkVariablesKnownAtFirstSolve(clause);
+
   if (clause.empty()) {
     m_detectedUNSAT = true;
     return;
@@ -482,6 +1047,12 @@ void CDCLSatSolverImpl::addClause(CNFClause const& clause)
     return;
   }
 
+  if (std::any_of(compressed->begin(), compressed->end(), [this](CNFLit lit) {
+        return requiresRestoration(lit.getVariable());
+      })) {
+    restoreEliminatedVariables();
+  }
+
   if (compressed->size() == 1) {
     m_facts.push_back(compressed->at(0));
   }
@@ -493,6 +1064,8 @@ void CDCLSatSolverImpl::addClause(CNFClause const& clause)
 
     std::copy(compressed->begin(), compressed->end(), dbClause->begin());
     dbClause->clauseUpdated();
+    m_newClauses.push_back(dbClause);
+    m_xorConstraintsOutdated = true;
   }
 
   for (CNFLit lit : *compressed) {
@@ -504,6 +1077,8 @@ void CDCLSatSolverImpl::addClause(CNFClause const& clause)
 auto CDCLSatSolverImpl::solve(std::vector<CNFLit> const& assumedFacts)
     -> std::unique_ptr<SolvingResult>
 {
+  checkVariablesKnownAtFirstSolve(assumedFacts);
+
   try {
     m_statistics.registerSolvingStart();
     m_stopRequested.store(false);
@@ -526,31 +1101,38 @@ auto CDCLSatSolverImpl::solve(std::vector<CNFLit> const& assumedFacts)
     for (CNFLit lit : assumedFacts) {
       m_maxVar = std::max(m_maxVar, lit.getVariable());
     }
+    if (!m_maxVarAtFirstSolve.has_value()) {
+      m_maxVarAtFirstSolve = m_maxVar;
+    }
 
     m_facts = withoutRedundancies(m_facts.begin(), m_facts.end());
     resizeSubsystems();
-    synchronizeSubsystemsWithClauseDB();
-    initializeBranchingHeuristic(assumedFacts);
 
-    TBool intermediateResult = TBools::INDETERMINATE;
-    std::vector<CNFLit> failedAssumptions;
-    while (!isDeterminate(intermediateResult) && !m_stopRequested.load()) {
-      if (trySimplify() == SimplificationResult::DETECTED_UNSAT) {
-        failedAssumptions.clear();
-        intermediateResult = TBools::FALSE;
-        break;
-      }
-      tryReduceClauseDB();
-      m_statistics.registerRestart();
-      intermediateResult = solveUntilRestart(assumedFacts, failedAssumptions);
+    std::vector<CNFLit> const assumptions = withoutDuplicateAssumptions(assumedFacts);
+    if (std::any_of(assumptions.begin(), assumptions.end(), [this](CNFLit lit) {
+          return requiresRestoration(lit.getVariable());
+        })) {
+      restoreEliminatedVariables();
     }
+    backtrackToRetainedAssumptions(assumptions);
+
+    std::vector<CNFLit> failedAssumptions;
+    TBool intermediateResult = solveUnderAssumptions(assumptions, failedAssumptions);
 
     if (intermediateResult == TBools::FALSE) {
       finalizeProofOnUnsat();
+
+      if (m_failedAssumptionsMinimization != FailedAssumptionsMinimization::NONE &&
+          !failedAssumptions.empty()) {
+        minimizeFailedAssumptions(failedAssumptions);
+      }
     }
 
     auto result = createSolvingResult(intermediateResult, failedAssumptions);
-    backtrackAll();
+    retainAssumptionLevels(assumptions);
+    if (auto model = result->getModel(); model.has_value()) {
+      adoptWitnessPhases(model->get());
+    }
     m_statistics.registerSolvingStop();
     return result;
   }
@@ -571,24 +1153,115 @@ auto CDCLSatSolverImpl::solve(std::vector<CNFLit> const& assumedFacts)
 }
 
 
-auto CDCLSatSolverImpl::createSolvingResult(TBool result,
-                                            std::vector<CNFLit> const& failedAssumptions)
-    -> std::unique_ptr<SolvingResult>
+auto CDCLSatSolverImpl::solveUnderAssumptions(std::vector<CNFLit> const& assumedFacts,
+                                              std::vector<CNFLit>& failedAssumptions) -> TBool
 {
-  std::unique_ptr<Model> model{nullptr};
-
-  if (isTrue(result)) {
-    model = createModel(m_maxVar);
-    for (CNFLit lit : m_assignment.getAssignments()) {
-      model->setAssignment(lit.getVariable(),
-                           lit.getSign() == CNFSign::POSITIVE ? TBools::TRUE : TBools::FALSE);
+  initializeBranchingHeuristic(assumedFacts);
+
+  TBool result = TBools::INDETERMINATE;
+  while (!isDeterminate(result) && !m_stopRequested.load() &&
+         m_statistics.getCurrentEra().m_conflictCount < m_conflictLimit) {
+    // When the search is resumed on retained assumption levels, simplification and
+    // clause DB reduction are deferred until the next restart:
+    if (m_assignment.getNumAssignments() == 0) {
+      if (trySimplify(assumedFacts) == SimplificationResult::DETECTED_UNSAT) {
+        failedAssumptions.clear();
+        return TBools::FALSE;
+      }
+      tryReduceClauseDB();
+      m_statistics.registerRestart();
     }
+    result = solveUntilRestart(assumedFacts, failedAssumptions);
   }
-
-  return std::make_unique<SolvingResultImpl>(result,
-                                             std::move(model),
-                                             isFalse(result) ? std::move(failedAssumptions)
-                                                             : std::vector<CNFLit>{});
+  return result;
+}
+
+
+void CDCLSatSolverImpl::minimizeFailedAssumptions(std::vector<CNFLit>& failedAssumptions)
+{
+  JAM_LOG_SOLVER(info, "Minimizing " << failedAssumptions.size() << " failed assumptions");
+  backtrackAll();
+  m_assumptionsUnderMinimization = failedAssumptions;
+
+  std::vector<CNFLit> candidate;
+  std::vector<CNFLit> candidateFailures;
+
+  // Invariant: failedAssumptions is a set of failed assumptions, and for each of its
+  // first `index` assumptions, removing it has not led to an UNSAT result.
+  std::size_t index = 0;
+  while (index < failedAssumptions.size() && !m_stopRequested.load()) {
+    candidate.clear();
+    candidateFailures.clear();
+    std::copy(failedAssumptions.begin(),
+              failedAssumptions.begin() + index,
+              std::back_inserter(candidate));
+    std::copy(failedAssumptions.begin() + index + 1,
+              failedAssumptions.end(),
+              std::back_inserter(candidate));
+
+    m_conflictLimit = m_statistics.getCurrentEra().m_conflictCount +
+                      m_failedAssumptionsMinimizationBudget;
+    TBool result = solveUnderAssumptions(candidate, candidateFailures);
+    backtrackAll();
+
+    if (!isFalse(result)) {
+      // The assumption at `index` is required, or the budget has been exceeded
+      ++index;
+      continue;
+    }
+
+    // candidateFailures is a subset of candidate, and may be smaller than candidate.
+    // Retain the order of the remaining assumptions to preserve the invariant:
+    auto stampContext = m_stamps.createContext();
+    auto stamp = stampContext.getStamp();
+    for (CNFLit lit : candidateFailures) {
+      m_stamps.setStamped(lit, stamp, true);
+    }
+
+    std::size_t newIndex = 0;
+    auto insertionPoint = failedAssumptions.begin();
+    for (std::size_t i = 0; i < failedAssumptions.size(); ++i) {
+      if (i != index && m_stamps.isStamped(failedAssumptions[i], stamp)) {
+        newIndex += (i < index ? 1 : 0);
+        *insertionPoint = failedAssumptions[i];
+        ++insertionPoint;
+      }
+    }
+    failedAssumptions.erase(insertionPoint, failedAssumptions.end());
+    index = newIndex;
+  }
+
+  m_conflictLimit = std::numeric_limits<uint64_t>::max();
+  m_assumptionsUnderMinimization.clear();
+  JAM_LOG_SOLVER(info, "Minimized failed assumptions to " << failedAssumptions.size());
+}
+
+
+auto CDCLSatSolverImpl::createSolvingResult(TBool result,
+                                            std::vector<CNFLit> const& failedAssumptions)
+    -> std::unique_ptr<SolvingResult>
+{
+  std::unique_ptr<Model> model{nullptr};
+
+  if (isTrue(result)) {
+    model = createModel(m_maxVar);
+    for (CNFLit lit : m_assignment.getAssignments()) {
+      model->setAssignment(lit.getVariable(),
+                           lit.getSign() == CNFSign::POSITIVE ? TBools::TRUE : TBools::FALSE);
+    }
+    m_reconstructionStack.reconstruct(*model);
+
+    // Keeping the phases of eliminated variables consistent with the model, e.g. for
+    // exporting the branching state:
+    for (CNFVar eliminatedVar : m_reconstructionStack.getEliminatedVars()) {
+      m_assignment.setPhase(eliminatedVar, model->getAssignment(eliminatedVar));
+    }
+  }
+
+  return std::make_unique<SolvingResultImpl>(result,
+                                             std::move(model),
+                                             isFalse(result) ? failedAssumptions
+                                                             : std::vector<CNFLit>{});
 }
 
 void CDCLSatSolverImpl::resizeSubsystems()
@@ -597,6 +1270,104 @@ void CDCLSatSolverImpl::resizeSubsystems()
   m_branchingHeuristic.increaseMaxVarTo(m_maxVar);
   m_stamps.increaseSizeTo(getMaxLit(m_maxVar).getRawValue());
   m_conflictAnalyzer.increaseMaxVarTo(m_maxVar);
+  m_gaussJordanEngine.increaseMaxVarTo(m_maxVar);
+  applyImportedBranchingState();
+  applyDefaultPhases();
+}
+
+void CDCLSatSolverImpl::applyImportedBranchingState()
+{
+  std::size_t const stateSize =
+      std::min(m_importedBranchingState.activities.size(), m_importedBranchingState.phases.size());
+  std::size_t const end =
+      std::min(stateSize, static_cast<std::size_t>(m_maxVar.getRawValue()) + 1);
+  if (m_amntImportedVarsApplied >= end) {
+    return;
+  }
+
+  std::vector<double> const& activities = m_importedBranchingState.activities;
+  switch (m_importedBranchingState.heuristic) {
+  case BranchingState::Heuristic::VMTF: {
+    // Moving the variables to the front of the queue in the order of their imported
+    // queue positions:
+    std::vector<CNFVar> importedVars;
+    for (std::size_t i = m_amntImportedVarsApplied; i < end; ++i) {
+      if (std::isfinite(activities[i]) && activities[i] >= 0.0) {
+        importedVars.push_back(CNFVar{static_cast<CNFVar::RawVariable>(i)});
+      }
+    }
+    std::stable_sort(
+        importedVars.begin(), importedVars.end(), [&activities](CNFVar lhs, CNFVar rhs) {
+          return activities[lhs.getRawValue()] < activities[rhs.getRawValue()];
+        });
+    for (CNFVar var : importedVars) {
+      m_branchingHeuristic.moveToVMTFQueueFront(var);
+    }
+    break;
+  }
+  case BranchingState::Heuristic::LRB:
+    for (std::size_t i = m_amntImportedVarsApplied; i < end; ++i) {
+      if (std::isfinite(activities[i]) && activities[i] >= 0.0) {
+        CNFVar const var{static_cast<CNFVar::RawVariable>(i)};
+        m_branchingHeuristic.setLRBActivity(var, std::min(activities[i], 1.0));
+      }
+    }
+    break;
+  default: {
+    // The imported activities are relative to the activity bump delta of the exporting
+    // solver. Scaling them down further if they would exceed the activity range:
+    double maxActivity = 0.0;
+    for (std::size_t i = m_amntImportedVarsApplied; i < end; ++i) {
+      maxActivity = std::max(maxActivity, activities[i]);
+    }
+    double const bumpDelta = m_branchingHeuristic.getVSIDSActivityBumpDelta();
+    double const scale =
+        (maxActivity * bumpDelta < 1e29) ? bumpDelta : (bumpDelta * 1e29 / maxActivity);
+    for (std::size_t i = m_amntImportedVarsApplied; i < end; ++i) {
+      if (std::isfinite(activities[i]) && activities[i] >= 0.0) {
+        CNFVar const var{static_cast<CNFVar::RawVariable>(i)};
+        m_branchingHeuristic.setVSIDSActivity(var, scale * activities[i]);
+      }
+    }
+  }
+  }
+
+  for (std::size_t i = m_amntImportedVarsApplied; i < end; ++i) {
+    CNFVar const var{static_cast<CNFVar::RawVariable>(i)};
+    TBool const phase = m_importedBranchingState.phases[i];
+    if (isDeterminate(phase)) {
+      m_assignment.setPhase(var, phase);
+    }
+  }
+
+  m_assignment.resetTargetPhases();
+  m_amntImportedVarsApplied = end;
+}
+
+void CDCLSatSolverImpl::applyDefaultPhases() noexcept
+{
+  if (m_pendingDefaultPhases.empty()) {
+    return;
+  }
+
+  // Default phases of variables not known to the solver yet are applied later:
+  auto const appliedBegin = std::partition(m_pendingDefaultPhases.begin(),
+                                           m_pendingDefaultPhases.end(),
+                                           [this](CNFVar var) { return var > m_maxVar; });
+  for (auto var = appliedBegin; var != m_pendingDefaultPhases.end(); ++var) {
+    m_assignment.setPhase(*var, getDefaultPhase(*var));
+  }
+  m_pendingDefaultPhases.erase(appliedBegin, m_pendingDefaultPhases.end());
+  m_assignment.resetTargetPhases();
+}
+
+auto CDCLSatSolverImpl::getDefaultPhase(CNFVar variable) const noexcept -> TBool
+{
+  if (variable.getRawValue() >= m_defaultPhases.size() ||
+      !isDeterminate(m_defaultPhases[variable.getRawValue()])) {
+    return TBools::FALSE;
+  }
+  return m_defaultPhases[variable.getRawValue()];
 }
 
 
@@ -607,7 +1378,13 @@ void CDCLSatSolverImpl::synchronizeSubsystemsWithClauseDB()
 
   m_assignment.clearClauses();
   m_lemmas.clear();
+  m_newClauses.clear();
   for (auto& clause : m_clauseDB.getClauses()) {
+    // Clauses deleted by optimizers without a breaking change are still stored
+    // in the clause database until its next compression:
+    if (clause.getFlag(Clause::Flag::SCHEDULED_FOR_DELETION)) {
+      continue;
+    }
     m_assignment.registerClause(clause);
     if (clause.getFlag(Clause::Flag::REDUNDANT)) {
       m_lemmas.push_back(&clause);
@@ -616,18 +1393,304 @@ void CDCLSatSolverImpl::synchronizeSubsystemsWithClauseDB()
 }
 
 
+void CDCLSatSolverImpl::backtrackToRetainedAssumptions(std::vector<CNFLit> const& assumedFacts)
+{
+  JAM_ASSERT(m_assignedAssumptions.size() == m_assignment.getCurrentLevel(),
+             "The retained decision levels must be assumption levels");
+
+  auto mismatch = std::mismatch(m_assignedAssumptions.begin(),
+                                m_assignedAssumptions.end(),
+                                assumedFacts.begin(),
+                                assumedFacts.end());
+  auto retainedLevel =
+      static_cast<Assignment::Level>(std::distance(m_assignedAssumptions.begin(), mismatch.first));
+
+  // New facts must be propagated on level 0:
+  for (CNFLit fact : m_facts) {
+    if (retainedLevel == 0) {
+      break;
+    }
+    if (!isTrue(m_assignment.getAssignment(fact)) ||
+        m_assignment.getLevel(fact.getVariable()) != 0) {
+      retainedLevel = 0;
+    }
+  }
+
+  for (ClauseT* clause : m_newClauses) {
+    if (retainedLevel == 0) {
+      break;
+    }
+    retainedLevel = std::min(retainedLevel, prepareWatchedLiterals(*clause));
+  }
+
+  if (retainedLevel == 0) {
+    backtrackAll();
+    m_assignedAssumptions.clear();
+    synchronizeSubsystemsWithClauseDB();
+    return;
+  }
+
+  JAM_LOG_SOLVER(info, "Retaining " << retainedLevel << " assumption levels");
+  if (retainedLevel < m_assignment.getCurrentLevel()) {
+    backtrackToLevel(retainedLevel);
+  }
+  m_assignedAssumptions.resize(retainedLevel);
+
+  for (ClauseT* clause : m_newClauses) {
+    m_assignment.registerClause(*clause);
+  }
+  m_newClauses.clear();
+}
+
+
+auto CDCLSatSolverImpl::prepareWatchedLiterals(ClauseT& clause) noexcept -> Assignment::Level
+{
+  JAM_ASSERT(clause.size() >= 2, "Illegally small clause argument");
+  auto const notFalse = std::numeric_limits<Assignment::Level>::max();
+  auto watchPriority = [this, notFalse](CNFLit lit) {
+    return isFalse(m_assignment.getAssignment(lit)) ? m_assignment.getLevel(lit.getVariable())
+                                                    : notFalse;
+  };
+
+  std::partial_sort(
+      clause.begin(), clause.begin() + 2, clause.end(), [&watchPriority](CNFLit lhs, CNFLit rhs) {
+        return watchPriority(lhs) > watchPriority(rhs);
+      });
+
+  auto const secondWatchPriority = watchPriority(clause[1]);
+  if (secondWatchPriority == notFalse) {
+    return m_assignment.getCurrentLevel();
+  }
+  return secondWatchPriority == 0 ? 0 : secondWatchPriority - 1;
+}
+
+
+void CDCLSatSolverImpl::retainAssumptionLevels(std::vector<CNFLit> const& assumedFacts)
+{
+  // If the solver has been stopped, found a model or found a conflict with an assumed
+  // fact, all decision levels up to the current one have been fully propagated.
+  auto const retainedLevel =
+      std::min(m_assignment.getCurrentLevel(), static_cast<Assignment::Level>(assumedFacts.size()));
+
+  if (retainedLevel == 0) {
+    backtrackAll();
+    m_assignedAssumptions.clear();
+    return;
+  }
+
+  if (retainedLevel < m_assignment.getCurrentLevel()) {
+    backtrackToLevel(retainedLevel);
+  }
+  m_assignedAssumptions.assign(assumedFacts.begin(), assumedFacts.begin() + retainedLevel);
+}
+
+
 void CDCLSatSolverImpl::initializeBranchingHeuristic(std::vector<CNFLit> const& assumedFacts)
 {
-  for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
-    m_branchingHeuristic.setEligibleForDecisions(i, true);
+  applySearchMode();
+
+  bool const hadPriorityGroups = !m_priorityGroupEnds.empty();
+  initializePriorityGroups(assumedFacts);
+
+  if (m_priorityGroupEnds.empty()) {
+    for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+      m_branchingHeuristic.setEligibleForDecisions(i, true);
+    }
   }
+  else {
+    for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+      m_branchingHeuristic.setEligibleForDecisions(i, false);
+    }
+    for (std::size_t i = 0; i < m_priorityGroupEnds[0]; ++i) {
+      m_branchingHeuristic.setEligibleForDecisions(m_priorityOrderedVars[i], true);
+    }
+  }
+
   for (CNFLit assumption : assumedFacts) {
     m_branchingHeuristic.setEligibleForDecisions(assumption.getVariable(), false);
   }
+  for (CNFVar eliminatedVar : m_reconstructionStack.getEliminatedVars()) {
+    m_branchingHeuristic.setEligibleForDecisions(eliminatedVar, false);
+  }
+
+  if (hadPriorityGroups) {
+    // Variables of low-priority groups may have been dropped by the branching heuristic
+    // while they were ineligible for branching decisions:
+    for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+      if (!isDeterminate(m_assignment.getAssignment(i))) {
+        m_branchingHeuristic.reset(i);
+      }
+    }
+  }
+}
+
+void CDCLSatSolverImpl::initializePriorityGroups(std::vector<CNFLit> const& assumedFacts)
+{
+  m_priorityOrderedVars.clear();
+  m_priorityGroupEnds.clear();
+  m_priorityGroupActivationLevels.clear();
+
+  auto const getPriority = [this](CNFVar var) -> uint32_t {
+    return var.getRawValue() < m_decisionPriorities.size()
+               ? m_decisionPriorities[var.getRawValue()]
+               : 0;
+  };
+
+  bool const hasDistinctPriorities =
+      std::any_of(m_decisionPriorities.begin(), m_decisionPriorities.end(), [](uint32_t p) {
+        return p != 0;
+      });
+  if (!hasDistinctPriorities) {
+    return;
+  }
+
+  auto stampContext = m_stamps.createContext();
+  auto const stamp = stampContext.getStamp();
+  for (CNFLit assumption : assumedFacts) {
+    m_stamps.setStamped(assumption.getVariable(), stamp, true);
+  }
+
+  for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+    if (!m_stamps.isStamped(i, stamp) && !m_reconstructionStack.isEliminated(i)) {
+      m_priorityOrderedVars.push_back(i);
+    }
+  }
+
+  std::stable_sort(m_priorityOrderedVars.begin(),
+                   m_priorityOrderedVars.end(),
+                   [&getPriority](CNFVar lhs, CNFVar rhs) {
+                     return getPriority(lhs) > getPriority(rhs);
+                   });
+
+  for (std::size_t i = 1; i < m_priorityOrderedVars.size(); ++i) {
+    if (getPriority(m_priorityOrderedVars[i]) != getPriority(m_priorityOrderedVars[i - 1])) {
+      m_priorityGroupEnds.push_back(i);
+    }
+  }
+
+  if (m_priorityGroupEnds.empty()) {
+    // All variables have the same priority
+    m_priorityOrderedVars.clear();
+    return;
+  }
+  m_priorityGroupEnds.push_back(m_priorityOrderedVars.size());
+}
+
+void CDCLSatSolverImpl::addSimplificationVariables(CNFVar previousMaxVar)
+{
+  if (m_priorityGroupEnds.empty()) {
+    for (CNFVar var = nextCNFVar(previousMaxVar); var <= m_maxVar; var = nextCNFVar(var)) {
+      m_branchingHeuristic.setEligibleForDecisions(var, true);
+    }
+    return;
+  }
+
+  // The new variables have priority 0, so they join the last group, or form a new last
+  // group if the last group has a nonzero priority. Like all groups except for the first
+  // one, the last group is made eligible for decisions by pickBranchLiteral(), so the
+  // new variables are not made eligible here:
+  if (!m_priorityOrderedVars.empty()) {
+    CNFVar const lastGroupVar = m_priorityOrderedVars.back();
+    if (lastGroupVar.getRawValue() < m_decisionPriorities.size() &&
+        m_decisionPriorities[lastGroupVar.getRawValue()] != 0) {
+      m_priorityGroupEnds.push_back(m_priorityOrderedVars.size());
+    }
+  }
+  for (CNFVar var = nextCNFVar(previousMaxVar); var <= m_maxVar; var = nextCNFVar(var)) {
+    m_priorityOrderedVars.push_back(var);
+  }
+  m_priorityGroupEnds.back() = m_priorityOrderedVars.size();
+}
+
+auto CDCLSatSolverImpl::pickBranchLiteral() noexcept -> CNFLit
+{
+  CNFLit result = m_branchingHeuristic.pickBranchLiteral();
+
+  while (result == CNFLit::getUndefinedLiteral() &&
+         m_priorityGroupActivationLevels.size() + 1 < m_priorityGroupEnds.size()) {
+    // All variables of the eligible priority groups have been assigned on the current
+    // decision level or below. Making the next group eligible until that level is undone:
+    std::size_t const group = m_priorityGroupActivationLevels.size() + 1;
+    m_priorityGroupActivationLevels.push_back(m_assignment.getCurrentLevel());
+    for (std::size_t i = m_priorityGroupEnds[group - 1]; i < m_priorityGroupEnds[group]; ++i) {
+      CNFVar const var = m_priorityOrderedVars[i];
+      if (!isDeterminate(m_assignment.getAssignment(var)) &&
+          !m_reconstructionStack.isEliminated(var)) {
+        m_branchingHeuristic.setEligibleForDecisions(var, true);
+        m_branchingHeuristic.reset(var);
+      }
+    }
+    result = m_branchingHeuristic.pickBranchLiteral();
+  }
+
+  return result;
+}
+
+void CDCLSatSolverImpl::deactivatePriorityGroups(Assignment::Level level) noexcept
+{
+  while (!m_priorityGroupActivationLevels.empty() &&
+         m_priorityGroupActivationLevels.back() >= level) {
+    std::size_t const group = m_priorityGroupActivationLevels.size();
+    for (std::size_t i = m_priorityGroupEnds[group - 1]; i < m_priorityGroupEnds[group]; ++i) {
+      m_branchingHeuristic.setEligibleForDecisions(m_priorityOrderedVars[i], false);
+    }
+    m_priorityGroupActivationLevels.pop_back();
+  }
 }
 
+void CDCLSatSolverImpl::rephase() noexcept
+{
+  using Phases = RephasingPolicy::Phases;
+  Phases const phases = m_rephasingPolicy.getNextPhases();
+  JAM_LOG_SOLVER(info, "Rephasing");
 
-auto CDCLSatSolverImpl::trySimplify() -> SimplificationResult
+  for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+    switch (phases) {
+    case Phases::ORIGINAL:
+      m_assignment.setPhase(i, getDefaultPhase(i));
+      break;
+    case Phases::INVERTED:
+      m_assignment.setPhase(i, negate(getDefaultPhase(i)));
+      break;
+    case Phases::BEST:
+      m_assignment.setPhase(i, m_assignment.getBestPhase(i));
+      break;
+    default:
+      m_assignment.setPhase(i, toTBool((m_rephasingRNG() & 1) == 1));
+    }
+  }
+
+  if (phases == Phases::BEST) {
+    m_assignment.resetBestPhases();
+  }
+  m_assignment.resetTargetPhases();
+  m_rephasingPolicy.registerRephase();
+}
+
+void CDCLSatSolverImpl::applySearchMode() noexcept
+{
+  if (!m_configuration.restartPolicyOptions.enableStableMode) {
+    m_branchingHeuristic.select(m_selectedBranchingHeuristic);
+    return;
+  }
+
+  if (m_restartPolicy.getMode() == ModeSwitchingRestartPolicy::Mode::STABLE) {
+    m_branchingHeuristic.setVSIDSDecayRate(m_configuration.stableModeVSIDSDecayRate);
+    m_branchingHeuristic.setVSIDSUseTargetPhases(true);
+    m_branchingHeuristic.select(m_selectedBranchingHeuristic == BranchingHeuristic::LRB
+                                    ? BranchingHeuristic::LRB
+                                    : BranchingHeuristic::VSIDS);
+  }
+  else {
+    m_branchingHeuristic.setVSIDSDecayRate(m_configuration.focusedModeVSIDSDecayRate);
+    m_branchingHeuristic.setVSIDSUseTargetPhases(false);
+    m_branchingHeuristic.select(m_selectedBranchingHeuristic);
+  }
+}
+
+
+auto CDCLSatSolverImpl::trySimplify(std::vector<CNFLit> const& assumedFacts)
+    -> SimplificationResult
 {
   JAM_ASSERT(m_assignment.getNumAssignments() == 0,
              "Illegally attempted to simplify the problem in-flight");
@@ -641,9 +1704,43 @@ auto CDCLSatSolverImpl::trySimplify() -> SimplificationResult
                                         std::move(m_assignment),
                                         m_certificate,
                                         m_maxVar};
+    sharedOptState.setModelReconstructionStack(m_reconstructionStack);
+    if (m_occurrenceMap.has_value()) {
+      sharedOptState.adoptOccurrenceMap(std::move(*m_occurrenceMap));
+      m_occurrenceMap.reset();
+    }
+    for (CNFLit assumption : assumedFacts) {
+      sharedOptState.freeze(assumption.getVariable());
+    }
+    for (CNFLit assumption : m_assumptionsUnderMinimization) {
+      sharedOptState.freeze(assumption.getVariable());
+    }
+    for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+      // Not eliminating variables with user-provided branching hints, i.e. variables
+      // with a nonzero decision priority or a default phase:
+      std::size_t const index = i.getRawValue();
+      if ((index < m_decisionPriorities.size() && m_decisionPriorities[index] != 0) ||
+          (index < m_defaultPhases.size() && isDeterminate(m_defaultPhases[index]))) {
+        sharedOptState.freeze(i);
+      }
+    }
 
     SharedOptimizerState result =
         m_optimizer->optimize(std::move(sharedOptState), m_statistics.getCurrentEra());
+
+    // XOR reasoning is not supported by the DRAT certificates. The constraints
+    // detected in previous rounds remain implied by the problem, so they only need
+    // to be detected again when the irredundant clauses have changed:
+    m_xorConstraintsOutdated = m_xorConstraintsOutdated || result.hasBreakingChange();
+    bool const updateXors =
+        !result.hasDetectedUnsat() && (m_certificate != nullptr || m_xorConstraintsOutdated);
+    std::vector<XorConstraint> xorConstraints;
+    if (updateXors && m_certificate == nullptr) {
+      xorConstraints = detectXorConstraints(result);
+      m_xorConstraintsOutdated = false;
+    }
+
+    m_occurrenceMap = result.releaseOccurrenceMap();
     std::tie(m_facts, pmrClauseDB, m_assignment) = result.release();
 
     m_statistics.registerOptimizationStatistics(result.getStats());
@@ -651,14 +1748,40 @@ auto CDCLSatSolverImpl::trySimplify() -> SimplificationResult
     m_clauseDB = pmrClauseDB.release<decltype(m_clauseDB)>();
 
     if (result.hasBreakingChange()) {
+      CNFVar const previousMaxVar = m_maxVar;
       m_maxVar = result.getMaxVar();
       resizeSubsystems();
+      addSimplificationVariables(previousMaxVar);
+      m_clauseDB.compress();
       synchronizeSubsystemsWithClauseDB();
+      for (CNFVar eliminatedVar : m_reconstructionStack.getEliminatedVars()) {
+        m_branchingHeuristic.setEligibleForDecisions(eliminatedVar, false);
+      }
+    }
+
+    bool unsat = result.hasDetectedUnsat();
+    if (!unsat && updateXors) {
+      std::vector<CNFLit> xorUnits;
+      unsat = !m_gaussJordanEngine.setConstraints(xorConstraints, xorUnits);
+
+      // propagateHardFacts() requires the facts to be distinct:
+      auto stampContext = m_stamps.createContext();
+      auto stamp = stampContext.getStamp();
+      for (CNFLit fact : m_facts) {
+        m_stamps.setStamped(fact, stamp, true);
+      }
+      for (CNFLit unit : xorUnits) {
+        if (!m_stamps.isStamped(unit, stamp)) {
+          m_facts.push_back(unit);
+        }
+      }
+      JAM_LOG_SOLVER(info,
+                     "Propagating " << m_gaussJordanEngine.getAmntRows()
+                                    << " XOR constraints in reduced row echelon form");
     }
 
     JAM_LOG_SOLVER(info, "Finished simplification");
 
-    bool const unsat = result.hasDetectedUnsat();
     return unsat ? SimplificationResult::DETECTED_UNSAT : SimplificationResult::NONE;
   }
 
@@ -666,6 +1789,53 @@ auto CDCLSatSolverImpl::trySimplify() -> SimplificationResult
 }
 
 
+void CDCLSatSolverImpl::restoreEliminatedVariables()
+{
+  JAM_LOG_SOLVER(info, "Restoring clauses removed by simplification");
+  std::vector<CNFVar> const eliminatedVars = m_reconstructionStack.getEliminatedVars();
+
+  m_reconstructionStack.restoreAll([this](gsl::span<CNFLit const> clause, std::size_t witnessIdx) {
+    if (m_certificate != nullptr) {
+      m_certificate->addRATClause(clause, witnessIdx);
+    }
+
+    ClauseT* dbClause = m_clauseDB.createClause(clause.size());
+    if (dbClause == nullptr) {
+      throw std::bad_alloc{};
+    }
+    std::copy(clause.begin(), clause.end(), dbClause->begin());
+    dbClause->clauseUpdated();
+    m_newClauses.push_back(dbClause);
+  });
+  m_xorConstraintsOutdated = true;
+
+  for (CNFVar var : eliminatedVars) {
+    m_branchingHeuristic.setEligibleForDecisions(var, true);
+    m_branchingHeuristic.reset(var);
+  }
+}
+
+auto CDCLSatSolverImpl::requiresRestoration(CNFVar var) const noexcept -> bool
+{
+  return m_reconstructionStack.isEliminated(var) || m_reconstructionStack.isWitness(var);
+}
+
+void CDCLSatSolverImpl::adoptWitnessPhases(Model const& model) noexcept
+{
+  for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+    if (m_reconstructionStack.isWitness(i) && !isDeterminate(m_assignment.getAssignment(i))) {
+      m_assignment.setPhase(i, model.getAssignment(i));
+    }
+  }
+}
+
+auto CDCLSatSolverImpl::isAssignmentComplete() const noexcept -> bool
+{
+  return m_assignment.getNumAssignments() + m_reconstructionStack.getAmntEliminatedVars() ==
+         static_cast<std::size_t>(m_maxVar.getRawValue()) + 1;
+}
+
+
 void CDCLSatSolverImpl::tryReduceClauseDB()
 {
   JAM_ASSERT(m_assignment.getNumAssignments() == 0,
@@ -676,9 +1846,10 @@ void CDCLSatSolverImpl::tryReduceClauseDB()
 
   JAM_LOG_SOLVER(info, "Starting clause database reduction");
 
-  size_t knownGood = m_amntBinariesLearnt;
-  auto beginDel = m_clauseDBReductionPolicy.getClausesMarkedForDeletion(knownGood);
+  auto beginDel = m_clauseDBReductionPolicy.getClausesMarkedForDeletion();
   m_statistics.registerLemmaDeletion(std::distance(beginDel, m_lemmas.end()));
+  auto const& tierSizes = m_clauseDBReductionPolicy.getTierSizes();
+  m_statistics.registerLemmaTierSizes(tierSizes.core, tierSizes.tier2, tierSizes.local);
   for (auto delIter = beginDel, end = m_lemmas.end(); delIter != end; ++delIter) {
     (*delIter)->setFlag(ClauseT::Flag::SCHEDULED_FOR_DELETION);
   }
@@ -695,6 +1866,8 @@ void CDCLSatSolverImpl::backtrackAll()
   JAM_LOG_SOLVER(info, "Backtracking to level 0");
   prepareBacktrack(0);
   m_assignment.undoAll();
+  m_gaussJordanEngine.backtrack(0);
+  m_amntAssignmentsNotified = 0;
 }
 
 void CDCLSatSolverImpl::backtrackToLevel(Assignment::Level targetLevel)
@@ -702,12 +1875,13 @@ void CDCLSatSolverImpl::backtrackToLevel(Assignment::Level targetLevel)
   JAM_LOG_SOLVER(info, "Backtracking by revisiting decision level " << targetLevel);
   prepareBacktrack(targetLevel + 1);
   m_assignment.undoToLevel(targetLevel);
+  m_gaussJordanEngine.backtrack(m_assignment.getNumAssignments());
+  m_amntAssignmentsNotified = m_assignment.getNumAssignments();
 }
 
 void CDCLSatSolverImpl::prepareBacktrack(Assignment::Level level)
 {
-  updateReasonClauseLBDsOnCurrentLevel();
-
+  notifyBranchingHeuristicOfAssignments();
   for (auto l = m_assignment.getCurrentLevel(); l >= level; --l) {
     for (auto lit : m_assignment.getLevelAssignments(l)) {
       m_branchingHeuristic.reset(lit.getVariable());
@@ -716,52 +1890,77 @@ void CDCLSatSolverImpl::prepareBacktrack(Assignment::Level level)
       break;
     }
   }
+  deactivatePriorityGroups(level);
 }
 
-void CDCLSatSolverImpl::updateReasonClauseLBDsOnCurrentLevel()
+void CDCLSatSolverImpl::notifyBranchingHeuristicOfAssignments() noexcept
 {
-  if (m_configuration.maxLBDUpdatesOnBacktrack == 0) {
-    return;
-  }
-
-  auto level = m_assignment.getCurrentLevel();
-
-  std::size_t updated = 0;
-  for (auto lit : boost::adaptors::reverse(m_assignment.getLevelAssignments(level))) {
-    if (m_assignment.isForced(lit.getVariable())) {
-      ClauseT* reason = m_assignment.getReason(lit.getVariable());
-      LBD newLBD = getLBD(*reason, m_assignment, m_stamps);
-      reason->setLBD(newLBD);
-      ++updated;
-
-      if (updated == m_configuration.maxLBDUpdatesOnBacktrack) {
-        return;
-      }
+  auto const amntAssignments = m_assignment.getNumAssignments();
+  if (m_branchingHeuristic.requiresAssignmentNotifications()) {
+    // The trail may have been shrunk without backtracking, e.g. by problem optimizers:
+    auto const amntNotified = std::min(m_amntAssignmentsNotified, amntAssignments);
+    auto const assignments = m_assignment.getAssignments();
+    for (auto lit = assignments.begin() + amntNotified; lit != assignments.end(); ++lit) {
+      m_branchingHeuristic.assigned(lit->getVariable());
     }
   }
+  m_amntAssignmentsNotified = amntAssignments;
 }
 
 auto CDCLSatSolverImpl::solveUntilRestart(std::vector<CNFLit> const& assumedFacts,
                                           std::vector<CNFLit>& failedAssumptions) -> TBool
 {
-  JAM_ASSERT(m_assignment.getNumAssignments() == 0,
+  JAM_ASSERT(m_assignment.getCurrentLevel() <= assumedFacts.size(),
              "Illegally called solveUntilRestart() in-flight");
-  JAM_LOG_SOLVER(info, "Restarting");
 
-  if (propagateHardFacts(m_facts) == FactPropagationResult::INCONSISTENT) {
-    return TBools::FALSE;
+  if (m_assignment.getNumAssignments() == 0) {
+    JAM_LOG_SOLVER(info, "Restarting");
+    if (propagateHardFacts(m_facts) == FactPropagationResult::INCONSISTENT ||
+        propagateXorConstraints() != nullptr) {
+      return TBools::FALSE;
+    }
   }
-  m_assignment.newLevel();
-  if (propagateAssumedFacts(assumedFacts, failedAssumptions) ==
-      FactPropagationResult::INCONSISTENT) {
-    return TBools::FALSE;
+  else {
+    JAM_LOG_SOLVER(info,
+                   "Resuming search on decision level " << m_assignment.getCurrentLevel());
   }
 
-  while (!m_assignment.isComplete()) {
+  while (true) {
+    CNFLit decision = CNFLit::getUndefinedLiteral();
+
+    // Decision level i+1 is reserved for the i'th assumed fact:
+    while (m_assignment.getCurrentLevel() < assumedFacts.size()) {
+      CNFLit assumption = assumedFacts[m_assignment.getCurrentLevel()];
+      TBool assumptionValue = m_assignment.getAssignment(assumption);
+
+      if (isTrue(assumptionValue)) {
+        // The assumed fact is already implied: create an empty decision level for it
+        m_assignment.newLevel();
+      }
+      else if (isFalse(assumptionValue)) {
+        JAM_LOG_SOLVER(info, "Detected conflict at assumed fact " << assumption);
+        failedAssumptions = analyzeAssignment(m_assignment, m_assignment, m_stamps, assumption);
+        return TBools::FALSE;
+      }
+      else {
+        decision = assumption;
+        break;
+      }
+    }
+
+    if (decision == CNFLit::getUndefinedLiteral()) {
+      if (isAssignmentComplete()) {
+        // don't backtrack, so that the satisfying assignment can be read
+        return TBools::TRUE;
+      }
+
+      m_statistics.registerDecision();
+      decision = pickBranchLiteral();
+      JAM_ASSERT(decision != CNFLit::getUndefinedLiteral(),
+                 "The branching heuristic is not expected to return an undefined literal");
+    }
+
     m_assignment.newLevel();
-    auto decision = m_branchingHeuristic.pickBranchLiteral();
-    JAM_ASSERT(decision != CNFLit::getUndefinedLiteral(),
-               "The branching heuristic is not expected to return an undefined literal");
     JAM_LOG_SOLVER(info,
                    "Beginning new decision level " << m_assignment.getCurrentLevel()
                                                    << " with branching decision " << decision);
@@ -770,7 +1969,15 @@ auto CDCLSatSolverImpl::solveUntilRestart(std::vector<CNFLit> const& assumedFact
         m_restartPolicy.shouldRestart()) {
       JAM_LOG_SOLVER(info, "Performing restart");
       backtrackAll();
+      auto const previousMode = m_restartPolicy.getMode();
       m_restartPolicy.registerRestart();
+      if (m_restartPolicy.getMode() != previousMode) {
+        JAM_LOG_SOLVER(info, "Switching the search mode");
+        applySearchMode();
+      }
+      if (m_rephasingPolicy.shouldRephase()) {
+        rephase();
+      }
       return TBools::INDETERMINATE;
     }
 
@@ -778,10 +1985,11 @@ auto CDCLSatSolverImpl::solveUntilRestart(std::vector<CNFLit> const& assumedFact
         m_stopRequested.load()) {
       return TBools::INDETERMINATE;
     }
-  }
 
-  // don't backtrack, so that the satisfying assignment can be read
-  return TBools::TRUE;
+    if (m_statistics.getCurrentEra().m_conflictCount >= m_conflictLimit) {
+      return TBools::INDETERMINATE;
+    }
+  }
 }
 
 auto CDCLSatSolverImpl::propagateHardFacts(std::vector<CNFLit>& facts) -> FactPropagationResult
@@ -789,7 +1997,7 @@ auto CDCLSatSolverImpl::propagateHardFacts(std::vector<CNFLit>& facts) -> FactPr
   JAM_LOG_SOLVER(info,
                  "Propagating hard facts on decision level " << m_assignment.getCurrentLevel());
   auto amntUnits = facts.size();
-  auto result = propagateFactsOnSystemLevels(facts, nullptr);
+  auto result = propagateFactsOnSystemLevels(facts);
   if (result != FactPropagationResult::INCONSISTENT &&
       m_assignment.getNumAssignments() != amntUnits) {
     auto oldAmntUnits = m_facts.size();
@@ -804,18 +2012,24 @@ auto CDCLSatSolverImpl::propagateHardFacts(std::vector<CNFLit>& facts) -> FactPr
 }
 
 
-auto CDCLSatSolverImpl::propagateAssumedFacts(std::vector<CNFLit> const& assumedFacts,
-                                              std::vector<CNFLit>& failedAssumptions)
-    -> FactPropagationResult
+auto CDCLSatSolverImpl::withoutDuplicateAssumptions(std::vector<CNFLit> const& assumedFacts)
+    -> std::vector<CNFLit>
 {
-  JAM_LOG_SOLVER(info,
-                 "Propagating assumed facts on decision level " << m_assignment.getCurrentLevel());
-  return propagateFactsOnSystemLevels(assumedFacts, &failedAssumptions);
+  auto stampContext = m_stamps.createContext();
+  auto stamp = stampContext.getStamp();
+
+  std::vector<CNFLit> result;
+  for (CNFLit assumption : assumedFacts) {
+    if (!m_stamps.isStamped(assumption, stamp)) {
+      m_stamps.setStamped(assumption, stamp, true);
+      result.push_back(assumption);
+    }
+  }
+  return result;
 }
 
 
-auto CDCLSatSolverImpl::propagateFactsOnSystemLevels(std::vector<CNFLit> const& factsToPropagate,
-                                                     std::vector<CNFLit>* failedAssumptions)
+auto CDCLSatSolverImpl::propagateFactsOnSystemLevels(std::vector<CNFLit> const& factsToPropagate)
     -> FactPropagationResult
 {
   for (auto fact : factsToPropagate) {
@@ -824,9 +2038,6 @@ auto CDCLSatSolverImpl::propagateFactsOnSystemLevels(std::vector<CNFLit> const&
     if (isDeterminate(assignment)) {
       if (toTBool(fact.getSign() == CNFSign::POSITIVE) != assignment) {
         JAM_LOG_SOLVER(info, "Detected conflict at fact " << fact);
-        if (failedAssumptions != nullptr) {
-          *failedAssumptions = analyzeAssignment(m_assignment, m_assignment, m_stamps, fact);
-        }
         return FactPropagationResult::INCONSISTENT;
       }
       else {
@@ -838,9 +2049,6 @@ auto CDCLSatSolverImpl::propagateFactsOnSystemLevels(std::vector<CNFLit> const&
 
     if (unitConflict) {
       JAM_LOG_SOLVER(info, "Detected conflict at fact " << fact);
-      if (failedAssumptions != nullptr) {
-        *failedAssumptions = analyzeAssignment(m_assignment, m_assignment, m_stamps, fact);
-      }
       return FactPropagationResult::INCONSISTENT;
     }
 
@@ -851,21 +2059,28 @@ auto CDCLSatSolverImpl::propagateFactsOnSystemLevels(std::vector<CNFLit> const&
 
 auto CDCLSatSolverImpl::resolveDecision(CNFLit decision) -> ResolveDecisionResult
 {
-  m_statistics.registerDecision();
+  uint64_t amntAssignmentsBefore = m_assignment.getNumAssignments();
   ClauseT* conflictingClause = m_assignment.append(decision);
+  m_statistics.registerPropagations(m_assignment.getNumAssignments() - amntAssignmentsBefore);
+  if (conflictingClause == nullptr) {
+    conflictingClause = propagateXorConstraints();
+  }
 
   while (conflictingClause != nullptr) {
     loggingEpochElapsed();
     JAM_LOG_SOLVER(info, "Handling a conflict at clause " << conflictingClause);
     m_statistics.registerConflict();
+    notifyBranchingHeuristicOfAssignments();
     m_branchingHeuristic.beginHandlingConflict();
     LemmaDerivationResult result = deriveLemma(*conflictingClause);
     if (result.allocationFailed) {
       throw std::bad_alloc{};
     }
+    m_branchingHeuristic.registerLemma(m_lemmaBuffer, m_assignment);
     m_branchingHeuristic.endHandlingConflict();
 
     m_clauseDBReductionPolicy.registerConflict();
+    m_rephasingPolicy.registerConflict();
 
     if (CNFLit* newFact = boost::get<CNFLit>(&result.clause)) {
       m_facts.push_back(*newFact);
@@ -882,20 +2097,24 @@ auto CDCLSatSolverImpl::resolveDecision(CNFLit decision) -> ResolveDecisionResul
       m_statistics.registerLemma(newLemmaClause->size());
 
       LBD newLemmaLBD = (*newLemmaClause).template getLBD<LBD>();
-      m_restartPolicy.registerConflict({newLemmaLBD});
+      m_restartPolicy.registerConflict({newLemmaLBD, m_assignment.getNumAssignments()});
 
       addATClauseToProof(newLemmaClause->span());
       backtrackToLevel(result.backtrackLevel);
+      amntAssignmentsBefore = m_assignment.getNumAssignments();
       conflictingClause = m_assignment.registerLemma(*newLemmaClause);
+      m_statistics.registerPropagations(m_assignment.getNumAssignments() - amntAssignmentsBefore);
 
-      if (result.backtrackLevel == 0 ||
-          (result.backtrackLevel == 1 && conflictingClause != nullptr)) {
-        // Propagating the unit clauses and the assumptions now forces an assignment
-        // under which some clause is already "false". Under the current assumptions,
-        // the problem is not satisfiable. Perform a final restart to do
-        // conflict analysis:
+      if (result.backtrackLevel == 0) {
+        // Perform a restart to propagate the new lemma together with the unit clauses.
+        // If this forces an assignment under which some clause is already "false", the
+        // problem is not satisfiable.
         return ResolveDecisionResult::RESTART;
       }
+
+      if (conflictingClause == nullptr) {
+        conflictingClause = propagateXorConstraints();
+      }
     }
 
     if (m_configuration.printStatistics &&
@@ -909,6 +2128,14 @@ auto CDCLSatSolverImpl::resolveDecision(CNFLit decision) -> ResolveDecisionResul
   return ResolveDecisionResult::CONTINUE;
 }
 
+auto CDCLSatSolverImpl::propagateXorConstraints() -> ClauseT*
+{
+  uint64_t const amntAssignmentsBefore = m_assignment.getNumAssignments();
+  ClauseT* conflictingClause = m_gaussJordanEngine.propagate(m_assignment);
+  m_statistics.registerPropagations(m_assignment.getNumAssignments() - amntAssignmentsBefore);
+  return conflictingClause;
+}
+
 auto CDCLSatSolverImpl::deriveLemma(ClauseT& conflictingClause) -> LemmaDerivationResult
 {
   m_conflictAnalyzer.computeConflictClause(conflictingClause, m_lemmaBuffer);
@@ -927,14 +2154,14 @@ auto CDCLSatSolverImpl::deriveLemma(ClauseT& conflictingClause) -> LemmaDerivati
 
     std::copy(m_lemmaBuffer.begin(), m_lemmaBuffer.end(), newLemma->begin());
     newLemma->clauseUpdated();
+    // Computing the LBD in a separate pass is necessary since optimizeLemma() may
+    // have removed literals, possibly eliminating some decision levels of the lemma
+    // derived by conflict analysis.
     newLemma->setLBD(getLBD(*newLemma, m_assignment, m_stamps));
 
     if (newLemma->size() > 2) {
       m_lemmas.push_back(newLemma);
     }
-    else {
-      ++m_amntBinariesLearnt;
-    }
 
     // Place a non-asserting literal with the highest decision level second in
     // the clause to make sure that any new assignments get propagated correctly,
@@ -994,6 +2221,130 @@ void CDCLSatSolverImpl::setLogger(LoggerFn logger)
   m_loggerFn = std::move(logger);
 }
 
+void CDCLSatSolverImpl::setFailedAssumptionsMinimization(FailedAssumptionsMinimization mode,
+                                                         uint64_t conflictBudget) noexcept
+{
+  m_failedAssumptionsMinimization = mode;
+  m_failedAssumptionsMinimizationBudget = conflictBudget;
+}
+
+void CDCLSatSolverImpl::setBranchingHeuristic(BranchingHeuristic heuristic) noexcept
+{
+  m_selectedBranchingHeuristic = heuristic;
+}
+
+void CDCLSatSolverImpl::setVariableAdditionEnabled(bool enabled)
+{
+  if (m_maxVarAtFirstSolve.has_value()) {
+    throw std::logic_error{"Bounded variable addition must be configured before solving"};
+  }
+  if (enabled != m_configuration.enableVariableAddition) {
+    m_optimizer = createInprocessingOptimizer(enabled);
+    m_configuration.enableVariableAddition = enabled;
+  }
+}
+
+void CDCLSatSolverImpl::checkVariablesKnownAtFirstSolve(gsl::span<CNFLit const> literals) const
+{
+  if (!m_configuration.enableVariableAddition || !m_maxVarAtFirstSolve.has_value()) {
+    return;
+  }
+  CNFVar const maxKnownVar = *m_maxVarAtFirstSolve;
+  if (std::any_of(literals.begin(), literals.end(), [maxKnownVar](CNFLit lit) {
+        return lit.getVariable() > maxKnownVar;
+      })) {
+    throw std::invalid_argument{
+        "Variables unknown at the first call to solve() can't be used when bounded variable "
+        "addition is enabled"};
+  }
+}
+
+auto CDCLSatSolverImpl::exportBranchingState() -> BranchingState
+{
+  resizeSubsystems();
+
+  BranchingState result;
+  switch (m_selectedBranchingHeuristic) {
+  case BranchingHeuristic::VMTF: {
+    result.heuristic = BranchingState::Heuristic::VMTF;
+    std::vector<CNFVar> queue;
+    for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+      queue.push_back(i);
+    }
+    std::sort(queue.begin(), queue.end(), [this](CNFVar lhs, CNFVar rhs) {
+      return m_branchingHeuristic.getVMTFEnqueueTime(lhs) <
+             m_branchingHeuristic.getVMTFEnqueueTime(rhs);
+    });
+    result.activities.resize(queue.size());
+    for (std::size_t position = 0; position < queue.size(); ++position) {
+      result.activities[queue[position].getRawValue()] =
+          static_cast<double>(position) / queue.size();
+    }
+    break;
+  }
+  case BranchingHeuristic::LRB:
+    result.heuristic = BranchingState::Heuristic::LRB;
+    for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+      result.activities.push_back(m_branchingHeuristic.getLRBActivity(i));
+    }
+    break;
+  default: {
+    double const bumpDelta = m_branchingHeuristic.getVSIDSActivityBumpDelta();
+    for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+      result.activities.push_back(m_branchingHeuristic.getVSIDSActivity(i) / bumpDelta);
+    }
+  }
+  }
+
+  for (CNFVar i{0}; i <= m_maxVar; i = nextCNFVar(i)) {
+    TBool const assignment = m_assignment.getAssignment(i);
+    result.phases.push_back(isDeterminate(assignment) ? assignment : m_assignment.getPhase(i));
+  }
+  return result;
+}
+
+void CDCLSatSolverImpl::importBranchingState(BranchingState const& state)
+{
+  m_importedBranchingState = state;
+  m_amntImportedVarsApplied = 0;
+
+  // The default phases take precedence over the imported phases:
+  m_pendingDefaultPhases.clear();
+  for (std::size_t i = 0; i < m_defaultPhases.size(); ++i) {
+    if (isDeterminate(m_defaultPhases[i])) {
+      m_pendingDefaultPhases.push_back(CNFVar{static_cast<CNFVar::RawVariable>(i)});
+    }
+  }
+}
+
+void CDCLSatSolverImpl::setDefaultPhase(CNFVar variable, TBool phase)
+{
+  if (!isDeterminate(phase)) {
+    // Removing the hint, keeping the current phase of the variable:
+    if (variable.getRawValue() < m_defaultPhases.size()) {
+      m_defaultPhases[variable.getRawValue()] = TBools::INDETERMINATE;
+    }
+    m_pendingDefaultPhases.erase(
+        std::remove(m_pendingDefaultPhases.begin(), m_pendingDefaultPhases.end(), variable),
+        m_pendingDefaultPhases.end());
+    return;
+  }
+
+  if (variable.getRawValue() >= m_defaultPhases.size()) {
+    m_defaultPhases.resize(variable.getRawValue() + 1, TBools::INDETERMINATE);
+  }
+  m_defaultPhases[variable.getRawValue()] = phase;
+  m_pendingDefaultPhases.push_back(variable);
+}
+
+void CDCLSatSolverImpl::setDecisionPriority(CNFVar variable, uint32_t priority)
+{
+  if (variable.getRawValue() >= m_decisionPriorities.size()) {
+    m_decisionPriorities.resize(variable.getRawValue() + 1, 0);
+  }
+  m_decisionPriorities[variable.getRawValue()] = priority;
+}
+
 void CDCLSatSolverImpl::setDRATCertificate(DRATCertificate& cert) noexcept
 {
   m_certificate = &cert;
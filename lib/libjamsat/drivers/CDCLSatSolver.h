@@ -28,9 +28,11 @@
 
 #include <libjamsat/cnfproblem/CNFLiteral.h>
 #include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/drivers/BranchingState.h>
 #include <libjamsat/proof/Model.h>
 #include <libjamsat/utils/Truth.h>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -83,6 +85,10 @@ public:
    * and the result of this method is empty, the problem instance is unsatisfiable
    * regardless of the assumed fact setting.
    *
+   * If failed-assumption minimization has been enabled for the solver producing this
+   * result (see `CDCLSatSolver::setFailedAssumptionsMinimization()`), the failed
+   * assumptions have been minimized before the result has been created.
+   *
    * \returns a list of assumed facts that have been used to obtain the UNSAT result.
    */
   virtual auto getFailedAssumptions() const noexcept -> std::vector<CNFLit> const& = 0;
@@ -115,6 +121,11 @@ public:
    *
    * \throws std::bad_alloc   The clause database does not have enough memory to
    *                          hold \p clause
+   *
+   * \throws std::invalid_argument   Bounded variable addition is enabled, `solve()`
+   *   has already been called and \p clause contains a variable that has not been
+   *   known to the solver at the first call to `solve()`. See
+   *   `setVariableAdditionEnabled()`.
    */
   virtual void addClause(CNFClause const& clause) = 0;
 
@@ -136,6 +147,10 @@ public:
    *   cannot recover from that condition. On further calls, the solver will
    *   return INDETERMINATE. This exception can only be thrown if UNSAT certificate
    *   generation is enabled.
+   *
+   * \throws std::invalid_argument   Bounded variable addition is enabled and
+   *   \p assumedFacts contains a variable that has not been known to the solver at
+   *   the first call to `solve()`. See `setVariableAdditionEnabled()`.
    */
   virtual auto solve(std::vector<CNFLit> const& assumedFacts) -> std::unique_ptr<SolvingResult> = 0;
 
@@ -177,6 +192,158 @@ public:
    */
   virtual void setDRATCertificate(DRATCertificate& cert) noexcept = 0;
 
+  /**
+   * \brief Failed-assumption minimization modes
+   */
+  enum class FailedAssumptionsMinimization {
+    /// The failed assumptions are reported as obtained via conflict analysis.
+    NONE,
+
+    /// The solver attempts to remove each failed assumption in turn, checking
+    /// whether the remaining assumptions still lead to an UNSAT result.
+    DELETION_BASED
+  };
+
+  /**
+   * \brief Sets the failed-assumption minimization mode.
+   *
+   * If minimization is enabled and `solve()` determines that the problem is unsatisfiable
+   * under the given assumptions, the set of failed assumptions is minimized using nested
+   * solver invocations. Each nested invocation is bounded by \p conflictBudget conflicts;
+   * if a nested invocation exceeds its budget, the assumption in question is kept. Thus,
+   * the set of failed assumptions is guaranteed to be subset-minimal only if none of the
+   * nested invocations exceeded its budget. Lemmas learnt during the nested invocations are
+   * kept.
+   *
+   * By default, failed-assumption minimization is disabled.
+   *
+   * \param mode             The failed-assumption minimization mode.
+   * \param conflictBudget   The maximum amount of conflicts per nested solver invocation.
+   */
+  virtual void setFailedAssumptionsMinimization(FailedAssumptionsMinimization mode,
+                                                uint64_t conflictBudget) noexcept = 0;
+
+  /**
+   * \brief Branching heuristics
+   */
+  enum class BranchingHeuristic {
+    /// Variable-state independent decaying sum heuristic, using a 4-ary heap
+    VSIDS,
+
+    /// Variable-move-to-front heuristic, using a queue of variables
+    VMTF,
+
+    /// Learning-rate-based heuristic, using a 4-ary heap
+    LRB
+  };
+
+  /**
+   * \brief Sets the heuristic used for choosing branching literals.
+   *
+   * The heuristic is used beginning with the next call to `solve()`. By default,
+   * the VSIDS heuristic is used.
+   *
+   * \param heuristic    The branching heuristic.
+   */
+  virtual void setBranchingHeuristic(BranchingHeuristic heuristic) noexcept = 0;
+
+  /**
+   * \brief Enables or disables bounded variable addition.
+   *
+   * Bounded variable addition compresses the problem during simplification by
+   * introducing new variables, e.g. for replacing pairwise at-most-one encodings. The
+   * new variables are greater than all variables known to the solver when `solve()` is
+   * called for the first time. Therefore, if bounded variable addition is enabled, all
+   * clauses and assumptions passed to the solver after the first call to `solve()` may
+   * only contain variables that have been known to the solver at the time of that call.
+   *
+   * By default, bounded variable addition is disabled.
+   *
+   * This method may only be called before `solve()` is called for the first time.
+   *
+   * \param enabled    Iff `true`, bounded variable addition is enabled.
+   *
+   * \throws std::logic_error   `solve()` has already been called.
+   * \throws std::bad_alloc     The solver is out of memory.
+   */
+  virtual void setVariableAdditionEnabled(bool enabled) = 0;
+
+  /**
+   * \brief Exports the variable scores of the branching heuristic selected via
+   *        `setBranchingHeuristic()` and the variable phases.
+   *
+   * The exported state records the heuristic whose scores it contains, and can be
+   * imported into another solver via `importBranchingState()`, e.g. for warm-starting
+   * a solver on a problem closely related to the problem solved by this solver. The
+   * phases of variables assigned at the time of the export (e.g.
+   * after `solve()` has found a model) are their current assignments.
+   *
+   * This method may not be called while `solve()` is being executed.
+   *
+   * \returns the branching state for all variables known to the solver.
+   *
+   * \throws std::bad_alloc    The solver is out of memory.
+   */
+  virtual auto exportBranchingState() -> BranchingState = 0;
+
+  /**
+   * \brief Imports a branching state.
+   *
+   * The scores and phases are applied to the variables at the beginning of the
+   * next call to `solve()`, or as soon as the variables become known to the solver
+   * in later calls to `solve()`. The imported scores are applied to the heuristic
+   * recorded in \p state, and take precedence over the scores the solver has
+   * accumulated for the respective variables so far. Thus, the scores only take
+   * effect if that heuristic is selected via `setBranchingHeuristic()`.
+   *
+   * This method may not be called while `solve()` is being executed.
+   *
+   * \param state    A branching state, e.g. obtained via `exportBranchingState()`.
+   *
+   * \throws std::bad_alloc    The solver is out of memory.
+   */
+  virtual void importBranchingState(BranchingState const& state) = 0;
+
+  /**
+   * \brief Sets the default phase of a variable.
+   *
+   * When the solver branches on \p variable and no other phase has been saved for
+   * \p variable during search, \p variable is assigned \p phase. The default phase
+   * is applied at the beginning of the next call to `solve()` (or as soon as the
+   * variable becomes known to the solver), taking precedence over phases imported
+   * via `importBranchingState()`. When the solver resets the variable phases during
+   * search, it may restore the default phases. If no default phase has been set for
+   * a variable, the default phase is `false`. Variables with a default phase are not
+   * eliminated by problem simplification.
+   *
+   * This method may not be called while `solve()` is being executed.
+   *
+   * \param variable   A variable.
+   * \param phase      The default phase of \p variable. If \p phase is
+   *                   `TBools::INDETERMINATE`, the default phase hint for \p variable
+   *                   is removed.
+   *
+   * \throws std::bad_alloc    The solver is out of memory.
+   */
+  virtual void setDefaultPhase(CNFVar variable, TBool phase) = 0;
+
+  /**
+   * \brief Sets the decision priority of a variable.
+   *
+   * The solver only branches on a variable if all variables with a higher decision
+   * priority have been assigned. By default, all variables have priority 0. The
+   * decision priorities are used beginning with the next call to `solve()`. Variables
+   * with a nonzero priority are not eliminated by problem simplification.
+   *
+   * This method may not be called while `solve()` is being executed.
+   *
+   * \param variable   A variable.
+   * \param priority   The decision priority of \p variable.
+   *
+   * \throws std::bad_alloc    The solver is out of memory.
+   */
+  virtual void setDecisionPriority(CNFVar variable, uint32_t priority) = 0;
+
   virtual ~CDCLSatSolver();
 };
 
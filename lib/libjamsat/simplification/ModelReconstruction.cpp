@@ -0,0 +1,126 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "ModelReconstruction.h"
+
+#include <algorithm>
+
+#include <libjamsat/utils/Assert.h>
+
+namespace jamsat {
+
+void ModelReconstructionStack::push(gsl::span<CNFLit const> clause, CNFLit witness)
+{
+  JAM_ASSERT(std::find(clause.begin(), clause.end(), witness) != clause.end(),
+             "The witness literal must occur in the clause");
+  std::size_t const begin = m_literals.size();
+  m_literals.insert(m_literals.end(), clause.begin(), clause.end());
+  m_entries.push_back(Entry{begin, m_literals.size(), witness});
+
+  std::size_t const witnessIndex = witness.getVariable().getRawValue();
+  if (m_isWitness.size() <= witnessIndex) {
+    m_isWitness.resize(witnessIndex + 1, 0);
+  }
+  m_isWitness[witnessIndex] = 1;
+}
+
+void ModelReconstructionStack::setEliminated(CNFVar var)
+{
+  std::size_t const index = var.getRawValue();
+  if (m_isEliminated.size() <= index) {
+    m_isEliminated.resize(index + 1, 0);
+  }
+  if (m_isEliminated[index] == 0) {
+    m_isEliminated[index] = 1;
+    m_eliminatedVars.push_back(var);
+  }
+}
+
+auto ModelReconstructionStack::isEliminated(CNFVar var) const noexcept -> bool
+{
+  std::size_t const index = var.getRawValue();
+  return index < m_isEliminated.size() && m_isEliminated[index] != 0;
+}
+
+auto ModelReconstructionStack::isWitness(CNFVar var) const noexcept -> bool
+{
+  std::size_t const index = var.getRawValue();
+  return index < m_isWitness.size() && m_isWitness[index] != 0;
+}
+
+auto ModelReconstructionStack::getAmntEliminatedVars() const noexcept -> std::size_t
+{
+  return m_eliminatedVars.size();
+}
+
+auto ModelReconstructionStack::getEliminatedVars() const noexcept -> std::vector<CNFVar> const&
+{
+  return m_eliminatedVars;
+}
+
+auto ModelReconstructionStack::empty() const noexcept -> bool
+{
+  return m_entries.empty();
+}
+
+void ModelReconstructionStack::reconstruct(Model& model) const noexcept
+{
+  for (CNFVar var : m_eliminatedVars) {
+    model.setAssignment(var, TBools::FALSE);
+  }
+
+  for (auto entry = m_entries.rbegin(); entry != m_entries.rend(); ++entry) {
+    auto const clauseBegin = m_literals.begin() + entry->begin;
+    auto const clauseEnd = m_literals.begin() + entry->end;
+    bool const satisfied = std::any_of(clauseBegin, clauseEnd, [&model](CNFLit lit) {
+      TBool const value = model.getAssignment(lit.getVariable());
+      return isDeterminate(value) && (isTrue(value) == (lit.getSign() == CNFSign::POSITIVE));
+    });
+
+    if (!satisfied) {
+      CNFLit const witness = entry->witness;
+      model.setAssignment(witness.getVariable(),
+                          toTBool(witness.getSign() == CNFSign::POSITIVE));
+    }
+  }
+}
+
+void ModelReconstructionStack::restoreAll(RestoredClauseRecv const& receiver)
+{
+  for (auto entry = m_entries.rbegin(); entry != m_entries.rend(); ++entry) {
+    gsl::span<CNFLit const> clause{m_literals.data() + entry->begin, entry->end - entry->begin};
+    auto const witnessIdx = std::distance(clause.begin(),
+                                          std::find(clause.begin(), clause.end(), entry->witness));
+    receiver(clause, static_cast<std::size_t>(witnessIdx));
+  }
+
+  m_entries.clear();
+  m_literals.clear();
+  m_isWitness.clear();
+  m_isEliminated.clear();
+  m_eliminatedVars.clear();
+}
+}
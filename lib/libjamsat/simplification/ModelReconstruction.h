@@ -0,0 +1,131 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file ModelReconstruction.h
+ * \brief Extension of models to variables and clauses removed by problem optimizers
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <gsl/span>
+
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/proof/Model.h>
+
+namespace jamsat {
+
+/**
+ * \ingroup JamSAT_Simplification
+ *
+ * \brief A stack of clauses removed from the problem by satisfiability-preserving
+ *   (but not equivalence-preserving) transformations, e.g. by variable elimination.
+ *
+ * Each clause is stored together with a witness literal occurring in the clause.
+ * Models of the optimized problem are extended to models of the original problem
+ * by traversing the stack top-down, setting the witness literal of each clause
+ * falsified by the model to `true`.
+ */
+class ModelReconstructionStack {
+public:
+  using RestoredClauseRecv = std::function<void(gsl::span<CNFLit const>, std::size_t)>;
+
+  /**
+   * \brief Pushes a clause removed from the problem onto the stack.
+   *
+   * \param clause      The removed clause.
+   * \param witness     A literal occurring in \p clause.
+   */
+  void push(gsl::span<CNFLit const> clause, CNFLit witness);
+
+  /**
+   * \brief Marks the given variable as eliminated, i.e. as no longer occurring in the
+   *   optimized problem.
+   *
+   * All clauses of \p var removed from the problem must have been pushed onto the
+   * stack before.
+   */
+  void setEliminated(CNFVar var);
+
+  auto isEliminated(CNFVar var) const noexcept -> bool;
+
+  /**
+   * \brief Returns true iff \p var is the variable of the witness literal of a clause
+   *   on the stack.
+   *
+   * Since the witness literals of the clauses on the stack may be set to arbitrary
+   * values during model reconstruction, the clauses need to be restored before
+   * clauses or assumptions containing such variables are added to the problem.
+   */
+  auto isWitness(CNFVar var) const noexcept -> bool;
+
+  auto getAmntEliminatedVars() const noexcept -> std::size_t;
+
+  auto getEliminatedVars() const noexcept -> std::vector<CNFVar> const&;
+
+  auto empty() const noexcept -> bool;
+
+  /**
+   * \brief Extends the given model to a model of the original problem.
+   *
+   * \param model   A model of the optimized problem. Eliminated variables may
+   *                be unassigned in \p model.
+   */
+  void reconstruct(Model& model) const noexcept;
+
+  /**
+   * \brief Removes all clauses from the stack, passing them to the given receiver
+   *   in reverse order of their addition.
+   *
+   * After this operation, no variable is marked as eliminated or as a witness. Adding the clauses
+   * in the order in which they are received, each clause is a resolution asymmetric
+   * tautology (RAT) on its witness literal if the resolvents computed when removing
+   * the clauses are still implied by the problem.
+   *
+   * \param receiver    A function receiving the clauses and the index of the witness
+   *                    literal within the clause.
+   */
+  void restoreAll(RestoredClauseRecv const& receiver);
+
+private:
+  struct Entry {
+    std::size_t begin;
+    std::size_t end;
+    CNFLit witness;
+  };
+
+  std::vector<Entry> m_entries;
+  std::vector<CNFLit> m_literals;
+
+  std::vector<char> m_isWitness;
+  std::vector<char> m_isEliminated;
+  std::vector<CNFVar> m_eliminatedVars;
+};
+}
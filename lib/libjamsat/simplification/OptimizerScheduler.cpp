@@ -0,0 +1,123 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "OptimizerScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace jamsat {
+namespace {
+
+auto getBenefit(OptimizationStats const& stats) noexcept -> uint64_t
+{
+  return stats.amntFactsDerived + stats.amntLitsRemoved + stats.amntClausesRemoved +
+         stats.amntVarsEliminated;
+}
+
+class OptimizerScheduler : public ProblemOptimizer {
+public:
+  OptimizerScheduler(std::vector<std::unique_ptr<ProblemOptimizer>> optimizers,
+                     OptimizerSchedulerOptions const& options)
+    : m_optimizers{std::move(optimizers)}
+    , m_propagationsAtLastRun(m_optimizers.size(), 0)
+    , m_options{options}
+  {
+  }
+
+  auto getName() const -> std::string override { return "OptimizerScheduler"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return std::any_of(m_optimizers.begin(),
+                       m_optimizers.end(),
+                       [&currentStats](std::unique_ptr<ProblemOptimizer> const& optimizer) {
+                         return optimizer->wantsExecution(currentStats);
+                       });
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    for (std::size_t idx = 0; idx < m_optimizers.size(); ++idx) {
+      if (sharedOptimizerState.hasDetectedUnsat()) {
+        break;
+      }
+
+      ProblemOptimizer& optimizer = *m_optimizers[idx];
+      if (!optimizer.wantsExecution(currentStats)) {
+        continue;
+      }
+
+      uint64_t const searchEffort = currentStats.m_propagationCount - m_propagationsAtLastRun[idx];
+      m_propagationsAtLastRun[idx] = currentStats.m_propagationCount;
+      sharedOptimizerState.setTickBudget(getTickBudget(searchEffort));
+
+      uint64_t const benefitBefore = getBenefit(sharedOptimizerState.getStats());
+      auto const startTime = std::chrono::steady_clock::now();
+      sharedOptimizerState = optimizer.optimize(std::move(sharedOptimizerState), currentStats);
+      auto const stopTime = std::chrono::steady_clock::now();
+
+      OptimizationStats& stats = sharedOptimizerState.getStats();
+      OptimizerRunStats& runStats = stats.getOptimizerStats(optimizer.getName());
+      runStats.amntRuns += 1;
+      runStats.amntTicks += sharedOptimizerState.getTicksConsumed();
+      runStats.microsecondsSpent +=
+          std::chrono::duration_cast<std::chrono::microseconds>(stopTime - startTime).count();
+      runStats.benefit += getBenefit(stats) - benefitBefore;
+      if (sharedOptimizerState.isTickBudgetExhausted() && optimizer.wantsExecution(currentStats)) {
+        runStats.amntPreemptions += 1;
+      }
+    }
+
+    sharedOptimizerState.setTickBudget(std::numeric_limits<uint64_t>::max());
+    return sharedOptimizerState;
+  }
+
+private:
+  auto getTickBudget(uint64_t searchEffort) const noexcept -> uint64_t
+  {
+    double const scaledEffort = m_options.ticksPerPropagation * static_cast<double>(searchEffort);
+    if (scaledEffort >= static_cast<double>(m_options.maxTicks)) {
+      return std::max(m_options.minTicks, m_options.maxTicks);
+    }
+    return std::max(m_options.minTicks, static_cast<uint64_t>(scaledEffort));
+  }
+
+  std::vector<std::unique_ptr<ProblemOptimizer>> m_optimizers;
+  std::vector<uint64_t> m_propagationsAtLastRun;
+  OptimizerSchedulerOptions m_options;
+};
+}
+
+auto createOptimizerScheduler(std::vector<std::unique_ptr<ProblemOptimizer>> optimizers,
+                              OptimizerSchedulerOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<OptimizerScheduler>(std::move(optimizers), options);
+}
+}
@@ -0,0 +1,81 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file OptimizerScheduler.h
+ * \brief Effort-bounded scheduling of problem optimizers
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Effort limits for OptimizerScheduler
+ */
+struct OptimizerSchedulerOptions {
+  /**
+   * The tick budget of an optimizer is the amount of propagations performed
+   * since the optimizer's last run, multiplied by this factor.
+   */
+  double ticksPerPropagation = 0.2;
+
+  /** Minimum tick budget of an optimizer */
+  uint64_t minTicks = 100000;
+
+  /** Maximum tick budget of an optimizer */
+  uint64_t maxTicks = 50000000;
+};
+
+/**
+ * \brief Creates a problem optimizer executing the given optimizers one after the other,
+ *   giving each a tick budget relative to the search effort since its last run.
+ *
+ * The created optimizer wants execution iff any of the given optimizers wants execution.
+ * When executed, it runs the optimizers wanting execution in the given order, setting
+ * the tick budget of the shared optimizer state (see SharedOptimizerState::setTickBudget())
+ * before each run. Optimizers that have exhausted their budget and still want execution
+ * are regarded as preempted, and are expected to resume their work in the next run.
+ * Optimizers are not executed after UNSAT has been detected.
+ *
+ * The amount of runs, preemptions, consumed ticks, the time spent and the benefit of
+ * each optimizer are recorded in OptimizationStats::perOptimizer.
+ *
+ * \param optimizers    The optimizers to be scheduled.
+ * \param options       Effort limits.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createOptimizerScheduler(std::vector<std::unique_ptr<ProblemOptimizer>> optimizers,
+                              OptimizerSchedulerOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
@@ -26,6 +26,10 @@
 
 #include "ProblemOptimizer.h"
 
+#include <limits>
+
+#include <libjamsat/utils/Assert.h>
+
 namespace jamsat {
 
 namespace {
@@ -55,6 +59,21 @@ void PolymorphicClauseDB::getClauses(ClauseRecv const& receiver)
   m_impl->getClauses(receiver);
 }
 
+void PolymorphicClauseDB::getChangedClauses(ClauseRecv const& receiver)
+{
+  m_impl->getChangedClauses(receiver);
+}
+
+void PolymorphicClauseDB::clearChangeLog() noexcept
+{
+  m_impl->clearChangeLog();
+}
+
+auto PolymorphicClauseDB::getUnchangedClauseQuery() const -> UnchangedClauseQuery
+{
+  return m_impl->getUnchangedClauseQuery();
+}
+
 SharedOptimizerState::SharedOptimizerState(std::vector<CNFLit>&& facts,
                                            PolymorphicClauseDB&& clauseDB,
                                            Assignment&& assignment,
@@ -65,11 +84,17 @@ SharedOptimizerState::SharedOptimizerState(std::vector<CNFLit>&& facts,
   , m_assignment{std::move(assignment)}
   , m_maxVar{maxVar}
   , m_unsatCert{unsatCertificate}
+  , m_reconstructionStack{nullptr}
+  , m_frozenVars{}
   , m_occMap{}
   , m_breakingChange{false}
   , m_detectedUnsat{false}
   , m_stats{}
+  , m_tickBudget{std::numeric_limits<uint64_t>::max()}
+  , m_ticksConsumed{0}
 {
+  // The optimizers' propagations must not alter the target and best phases:
+  m_assignment.setTargetAndBestPhaseTracking(false);
 }
 
 SharedOptimizerState::SharedOptimizerState(SharedOptimizerState&& rhs) noexcept
@@ -78,10 +103,14 @@ SharedOptimizerState::SharedOptimizerState(SharedOptimizerState&& rhs) noexcept
   , m_assignment{std::move(rhs.m_assignment)}
   , m_maxVar{rhs.m_maxVar}
   , m_unsatCert{rhs.m_unsatCert}
+  , m_reconstructionStack{rhs.m_reconstructionStack}
+  , m_frozenVars{std::move(rhs.m_frozenVars)}
   , m_occMap{std::move(rhs.m_occMap)}
   , m_breakingChange{rhs.m_breakingChange}
   , m_detectedUnsat{rhs.m_detectedUnsat}
-  , m_stats{rhs.m_stats}
+  , m_stats{std::move(rhs.m_stats)}
+  , m_tickBudget{rhs.m_tickBudget}
+  , m_ticksConsumed{rhs.m_ticksConsumed}
 {
 }
 
@@ -92,10 +121,14 @@ auto SharedOptimizerState::operator=(SharedOptimizerState&& rhs) noexcept -> Sha
   m_assignment = std::move(rhs.m_assignment);
   m_maxVar = rhs.m_maxVar;
   m_unsatCert = rhs.m_unsatCert;
+  m_reconstructionStack = rhs.m_reconstructionStack;
+  m_frozenVars = std::move(rhs.m_frozenVars);
   m_occMap = std::move(rhs.m_occMap);
   m_breakingChange = rhs.m_breakingChange;
   m_detectedUnsat = rhs.m_detectedUnsat;
-  m_stats = rhs.m_stats;
+  m_stats = std::move(rhs.m_stats);
+  m_tickBudget = rhs.m_tickBudget;
+  m_ticksConsumed = rhs.m_ticksConsumed;
   return *this;
 }
 
@@ -109,6 +142,47 @@ void SharedOptimizerState::precomputeOccurrenceMap()
   });
 }
 
+void SharedOptimizerState::adoptOccurrenceMap(OccMap&& occMap)
+{
+  m_occMap = std::move(occMap);
+  m_occMap->increaseMaxElementTo(getMaxLit(m_maxVar));
+
+  // The occurrences of relocated clauses are dangling pointers, so they need to be
+  // removed before any clause is accessed via the occurrence map:
+  PolymorphicClauseDB::UnchangedClauseQuery const isUnchanged =
+      m_clauseDB.getUnchangedClauseQuery();
+  m_occMap->removeIf([&isUnchanged](Clause const* clause) { return !isUnchanged(clause); });
+
+  m_clauseDB.getChangedClauses([this](std::vector<Clause*> const& clauses) {
+    for (Clause* clause : clauses) {
+      m_occMap->insert(*clause);
+    }
+  });
+}
+
+auto SharedOptimizerState::releaseOccurrenceMap() -> std::optional<OccMap>
+{
+  if (!m_occMap.has_value()) {
+    return std::nullopt;
+  }
+
+  m_occMap->resolveModifications();
+  m_clauseDB.clearChangeLog();
+  std::optional<OccMap> result = std::move(m_occMap);
+  m_occMap.reset();
+  return result;
+}
+
+void SharedOptimizerState::setMaxVar(CNFVar var)
+{
+  JAM_ASSERT(var >= m_maxVar, "Illegally attempted to decrease the maximum variable");
+  m_assignment.increaseMaxVar(var);
+  if (m_occMap.has_value()) {
+    m_occMap->increaseMaxElementTo(getMaxLit(var));
+  }
+  m_maxVar = var;
+}
+
 auto SharedOptimizerState::getUnsatCertificate() noexcept -> DRATCertificate&
 {
   static NullDRATCertificate nullCert;
@@ -119,6 +193,11 @@ auto SharedOptimizerState::getUnsatCertificate() noexcept -> DRATCertificate&
   return nullCert;
 }
 
+auto SharedOptimizerState::hasUnsatCertificate() const noexcept -> bool
+{
+  return m_unsatCert != nullptr;
+}
+
 auto SharedOptimizerState::hasPrecomputedOccurrenceMap() const noexcept -> bool
 {
   return m_occMap.has_value();
@@ -134,6 +213,31 @@ void SharedOptimizerState::setDetectedUnsat() noexcept
   m_detectedUnsat = true;
 }
 
+void SharedOptimizerState::setModelReconstructionStack(ModelReconstructionStack& stack) noexcept
+{
+  m_reconstructionStack = &stack;
+}
+
+auto SharedOptimizerState::getModelReconstructionStack() noexcept -> ModelReconstructionStack*
+{
+  return m_reconstructionStack;
+}
+
+void SharedOptimizerState::freeze(CNFVar var)
+{
+  std::size_t const index = var.getRawValue();
+  if (m_frozenVars.size() <= index) {
+    m_frozenVars.resize(index + 1, 0);
+  }
+  m_frozenVars[index] = 1;
+}
+
+auto SharedOptimizerState::isFrozen(CNFVar var) const noexcept -> bool
+{
+  std::size_t const index = var.getRawValue();
+  return index < m_frozenVars.size() && m_frozenVars[index] != 0;
+}
+
 auto SharedOptimizerState::hasBreakingChange() const noexcept -> bool
 {
   return m_breakingChange;
@@ -157,9 +261,60 @@ auto SharedOptimizerState::getStats() const noexcept -> OptimizationStats const&
 auto SharedOptimizerState::release() noexcept
     -> std::tuple<std::vector<CNFLit>, PolymorphicClauseDB, Assignment>
 {
+  m_assignment.setTargetAndBestPhaseTracking(true);
   return make_tuple(std::move(m_facts), std::move(m_clauseDB), std::move(m_assignment));
 }
 
 SharedOptimizerState::~SharedOptimizerState() = default;
 
+auto factsPropagateToConflict(SharedOptimizerState& state) -> bool
+{
+  Assignment& assignment = state.getAssignment();
+  bool conflicting = false;
+  for (CNFLit fact : state.getFacts()) {
+    TBool const value = assignment.getAssignment(fact);
+    if (isFalse(value) || (!isDeterminate(value) && assignment.append(fact) != nullptr)) {
+      conflicting = true;
+      break;
+    }
+  }
+  state.consumeTicks(assignment.getNumAssignments());
+  assignment.undoAll();
+  return conflicting;
+}
+
+auto propagateFact(SharedOptimizerState& state, CNFLit fact) -> bool
+{
+  Assignment& assignment = state.getAssignment();
+  TBool const value = assignment.getAssignment(fact);
+  if (isDeterminate(value)) {
+    return isTrue(value);
+  }
+
+  auto const amntAssignmentsBefore = assignment.getNumAssignments();
+  bool const conflicting = (assignment.append(fact) != nullptr);
+  state.consumeTicks(assignment.getNumAssignments() - amntAssignmentsBefore);
+  return !conflicting;
+}
+
+void addFact(SharedOptimizerState& state, CNFLit fact)
+{
+  state.getFacts().push_back(fact);
+  state.getStats().amntFactsDerived += 1;
+  if (!propagateFact(state, fact)) {
+    state.setDetectedUnsat();
+  }
+}
+
+void deleteClause(SharedOptimizerState& state, Clause& clause)
+{
+  state.getUnsatCertificate().deleteClause(clause.span());
+  clause.setFlag(Clause::Flag::SCHEDULED_FOR_DELETION);
+  state.getAssignment().registerClauseModification(clause);
+  if (state.hasPrecomputedOccurrenceMap()) {
+    state.getOccurrenceMap().remove(clause);
+  }
+  state.getStats().amntClausesRemoved += 1;
+}
+
 }
\ No newline at end of file
@@ -33,6 +33,7 @@
 #include <optional>
 #include <ostream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <gsl/span>
@@ -40,6 +41,7 @@
 #include <libjamsat/clausedb/Clause.h>
 #include <libjamsat/cnfproblem/CNFLiteral.h>
 #include <libjamsat/proof/DRATCertificate.h>
+#include <libjamsat/simplification/ModelReconstruction.h>
 #include <libjamsat/solver/Assignment.h>
 #include <libjamsat/solver/Statistics.h>
 #include <libjamsat/utils/OccurrenceMap.h>
@@ -51,6 +53,7 @@ class PolymorphicClauseDB final {
 public:
   using ClauseRecv = std::function<void(std::vector<Clause*> const&)>;
   using ConstClauseRecv = std::function<void(std::vector<Clause const*> const&)>;
+  using UnchangedClauseQuery = std::function<bool(Clause const*)>;
 
 private:
   class Base {
@@ -58,6 +61,9 @@ private:
     virtual auto createClause(std::size_t size) noexcept -> Clause* = 0;
     virtual void compress() noexcept = 0;
     virtual void getClauses(ClauseRecv const& receiver) = 0;
+    virtual void getChangedClauses(ClauseRecv const& receiver) = 0;
+    virtual void clearChangeLog() noexcept = 0;
+    virtual auto getUnchangedClauseQuery() const -> UnchangedClauseQuery = 0;
 
     virtual ~Base() = default;
   };
@@ -70,12 +76,18 @@ private:
     auto createClause(std::size_t size) noexcept -> Clause* override;
     void compress() noexcept override;
     virtual void getClauses(ClauseRecv const& receiver) override;
+    virtual void getChangedClauses(ClauseRecv const& receiver) override;
+    void clearChangeLog() noexcept override;
+    auto getUnchangedClauseQuery() const -> UnchangedClauseQuery override;
 
     T release() noexcept;
 
     virtual ~Impl() = default;
 
   private:
+    template <typename ClauseRange>
+    static void passInChunks(ClauseRange clauses, ClauseRecv const& receiver);
+
     T m_impl;
   };
 
@@ -90,6 +102,22 @@ public:
   void compress() noexcept;
   void getClauses(ClauseRecv const& receiver);
 
+  /**
+   * \brief Passes the clauses created or relocated since the last call to
+   *   `clearChangeLog()` to \p receiver, in order of addition.
+   */
+  void getChangedClauses(ClauseRecv const& receiver);
+  void clearChangeLog() noexcept;
+
+  /**
+   * \brief Returns a predicate determining whether a (possibly dangling) clause pointer
+   *   refers to a clause that has been neither created nor relocated since the last
+   *   call to `clearChangeLog()`.
+   *
+   * The returned predicate is invalidated by modifications of the database.
+   */
+  auto getUnchangedClauseQuery() const -> UnchangedClauseQuery;
+
   auto operator=(PolymorphicClauseDB const&) -> PolymorphicClauseDB& = delete;
   PolymorphicClauseDB(PolymorphicClauseDB const&) = delete;
   auto operator=(PolymorphicClauseDB &&) -> PolymorphicClauseDB& = default;
@@ -121,6 +149,12 @@ private:
   };
 
 public:
+  /**
+   * \brief Constructs a SharedOptimizerState.
+   *
+   * Tracking the target and best phases of \p assignment is disabled until the
+   * assignment is obtained via release().
+   */
   SharedOptimizerState(std::vector<CNFLit>&& facts,
                        PolymorphicClauseDB&& clauseDB,
                        Assignment&& assignment,
@@ -139,6 +173,11 @@ public:
 
   auto getUnsatCertificate() noexcept -> DRATCertificate&;
 
+  /**
+   * \brief Returns `true` iff a DRAT certificate has been passed to the constructor.
+   */
+  auto hasUnsatCertificate() const noexcept -> bool;
+
   using OccMap = OccurrenceMap<Clause, ClauseDeletedQuery, ClauseModifiedQuery>;
   auto getOccurrenceMap() noexcept -> OccMap&;
   auto getOccurrenceMap() const noexcept -> OccMap const&;
@@ -146,18 +185,89 @@ public:
   void precomputeOccurrenceMap();
   auto hasPrecomputedOccurrenceMap() const noexcept -> bool;
 
+  /**
+   * \brief Adopts an occurrence map released by the state of a previous simplification
+   *   round, avoiding rebuilding the occurrence map from scratch.
+   *
+   * The occurrence map is brought up to date using the change log of the clause
+   * database: occurrences of relocated clauses are removed, and the clauses created or
+   * relocated since the occurrence map has been released are inserted. Clauses deleted
+   * in the meantime need to have been removed from the clause database by compressing
+   * it, or from the occurrence map via `OccMap::remove()`.
+   *
+   * \param occMap     An occurrence map obtained via `releaseOccurrenceMap()`. Since its
+   *                   release, the clause database may only have been modified by adding
+   *                   clauses and by compressing it.
+   *
+   * \throw std::bad_alloc on memory allocation failure.
+   */
+  void adoptOccurrenceMap(OccMap&& occMap);
+
+  /**
+   * \brief Releases the occurrence map for reuse in a later simplification round.
+   *
+   * Pending modifications of the occurrence map are resolved, and the change log of
+   * the clause database is cleared.
+   *
+   * \returns The occurrence map, or nothing if no occurrence map has been computed.
+   */
+  auto releaseOccurrenceMap() -> std::optional<OccMap>;
+
   auto getMaxVar() const noexcept -> CNFVar;
-  void setMaxVar(CNFVar var) noexcept;
+
+  /**
+   * \brief Increases the maximum variable, e.g. when adding new variables.
+   *
+   * The assignment and the occurrence map are resized accordingly.
+   *
+   * \param var    A variable not smaller than the current maximum variable.
+   *
+   * \throw std::bad_alloc on memory allocation failure.
+   */
+  void setMaxVar(CNFVar var);
 
   auto hasDetectedUnsat() const noexcept -> bool;
   void setDetectedUnsat() noexcept;
 
+  /**
+   * \brief Sets the stack receiving clauses removed by non-equivalence-preserving
+   *   transformations, e.g. variable elimination.
+   *
+   * If no such stack has been set, optimizers must not perform transformations
+   * requiring model reconstruction.
+   */
+  void setModelReconstructionStack(ModelReconstructionStack& stack) noexcept;
+  auto getModelReconstructionStack() noexcept -> ModelReconstructionStack*;
+
+  /**
+   * \brief Marks the given variable as frozen, i.e. as not to be eliminated.
+   *
+   * Variables occurring in assumptions need to be frozen.
+   */
+  void freeze(CNFVar var);
+  auto isFrozen(CNFVar var) const noexcept -> bool;
+
   auto hasBreakingChange() const noexcept -> bool;
   void setBreakingChange() noexcept;
 
   auto getStats() noexcept -> OptimizationStats&;
   auto getStats() const noexcept -> OptimizationStats const&;
 
+  /**
+   * \brief Sets the amount of ticks the next optimizer may spend.
+   *
+   * A tick is a unit of optimization effort, e.g. the visit of a clause in an
+   * occurrence list or the propagation of a literal. Optimizers should stop
+   * working when the budget has been exhausted and resume their work when
+   * they are executed again. Setting the budget resets the amount of consumed
+   * ticks to 0. By default, the budget is unlimited.
+   */
+  void setTickBudget(uint64_t ticks) noexcept;
+
+  void consumeTicks(uint64_t ticks) noexcept;
+  auto getTicksConsumed() const noexcept -> uint64_t;
+  auto isTickBudgetExhausted() const noexcept -> bool;
+
   auto release() noexcept -> std::tuple<std::vector<CNFLit>, PolymorphicClauseDB, Assignment>;
 
   auto operator=(SharedOptimizerState const&) -> SharedOptimizerState& = delete;
@@ -175,6 +285,8 @@ private:
   CNFVar m_maxVar;
 
   DRATCertificate* m_unsatCert;
+  ModelReconstructionStack* m_reconstructionStack;
+  std::vector<char> m_frozenVars;
 
   std::optional<OccMap> m_occMap;
 
@@ -182,10 +294,61 @@ private:
   bool m_detectedUnsat;
 
   OptimizationStats m_stats;
+
+  uint64_t m_tickBudget;
+  uint64_t m_ticksConsumed;
 };
 
+/**
+ * \brief Checks whether unit propagation of the facts of the given optimizer state
+ *   leads to a conflict.
+ *
+ * Optimizers deriving facts can use this function to detect unsatisfiability
+ * before adding further clauses to the proof. The assignment of \p state is
+ * empty after the call, and the propagated literals are charged as ticks.
+ *
+ * \param state    An optimizer state with an empty assignment.
+ * \returns        true iff the propagation of the facts leads to a conflict.
+ */
+auto factsPropagateToConflict(SharedOptimizerState& state) -> bool;
+
+/**
+ * \brief Propagates the given fact on decision level 0 of the assignment of the given
+ *   optimizer state.
+ *
+ * The propagated literals are charged as ticks.
+ *
+ * \param state    An optimizer state whose assignment is on decision level 0.
+ * \param fact     A literal.
+ * \returns        false iff \p fact is false or its propagation leads to a conflict.
+ */
+auto propagateFact(SharedOptimizerState& state, CNFLit fact) -> bool;
+
+/**
+ * \brief Adds a fact derived by an optimizer to the given optimizer state and
+ *   propagates it via propagateFact(), detecting unsatisfiability on conflict.
+ *
+ * The fact needs to have been added to the DRAT certificate by the caller.
+ *
+ * \param state    An optimizer state whose assignment is on decision level 0.
+ * \param fact     A literal not contained in the facts of \p state.
+ */
+void addFact(SharedOptimizerState& state, CNFLit fact);
+
+/**
+ * \brief Deletes the given clause from the given optimizer state.
+ *
+ * The deletion is added to the DRAT certificate, the clause is scheduled for
+ * deletion and removed from the occurrence map (if it has been computed).
+ *
+ * \param state    An optimizer state.
+ * \param clause   A clause in the clause database of \p state.
+ */
+void deleteClause(SharedOptimizerState& state, Clause& clause);
+
 class ProblemOptimizer {
 public:
+  virtual auto getName() const -> std::string = 0;
   virtual auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool = 0;
   virtual auto optimize(SharedOptimizerState sharedOptimizerState,
                         StatisticsEra const& currentStats) -> SharedOptimizerState = 0;
@@ -232,7 +395,31 @@ void PolymorphicClauseDB::Impl<T>::compress() noexcept
 template <typename T>
 void PolymorphicClauseDB::Impl<T>::getClauses(ClauseRecv const& receiver)
 {
-  auto clauses = m_impl.getClauses();
+  passInChunks(m_impl.getClauses(), receiver);
+}
+
+template <typename T>
+void PolymorphicClauseDB::Impl<T>::getChangedClauses(ClauseRecv const& receiver)
+{
+  passInChunks(m_impl.getChangedClauses(), receiver);
+}
+
+template <typename T>
+void PolymorphicClauseDB::Impl<T>::clearChangeLog() noexcept
+{
+  m_impl.clearChangeLog();
+}
+
+template <typename T>
+auto PolymorphicClauseDB::Impl<T>::getUnchangedClauseQuery() const -> UnchangedClauseQuery
+{
+  return m_impl.getUnchangedClauseQuery();
+}
+
+template <typename T>
+template <typename ClauseRange>
+void PolymorphicClauseDB::Impl<T>::passInChunks(ClauseRange clauses, ClauseRecv const& receiver)
+{
   auto cursor = clauses.begin();
 
   std::size_t const bufSize = 1024 * 10;
@@ -307,8 +494,24 @@ inline auto SharedOptimizerState::getMaxVar() const noexcept -> CNFVar
   return m_maxVar;
 }
 
-inline void SharedOptimizerState::setMaxVar(CNFVar var) noexcept
+inline void SharedOptimizerState::setTickBudget(uint64_t ticks) noexcept
+{
+  m_tickBudget = ticks;
+  m_ticksConsumed = 0;
+}
+
+inline void SharedOptimizerState::consumeTicks(uint64_t ticks) noexcept
+{
+  m_ticksConsumed += ticks;
+}
+
+inline auto SharedOptimizerState::getTicksConsumed() const noexcept -> uint64_t
+{
+  return m_ticksConsumed;
+}
+
+inline auto SharedOptimizerState::isTickBudgetExhausted() const noexcept -> bool
 {
-  m_maxVar = var;
+  return m_ticksConsumed >= m_tickBudget;
 }
 }
\ No newline at end of file
@@ -0,0 +1,192 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "XorDetection.h"
+
+#include <algorithm>
+#include <bitset>
+#include <limits>
+
+namespace jamsat {
+namespace {
+class XorDetector {
+public:
+  XorDetector(SharedOptimizerState& state, XorDetectionOptions const& options)
+    : m_state{state}
+    , m_options{options}
+    , m_varIndices(state.getMaxVar().getRawValue() + 1, noIndex)
+    , m_seenPatterns(1ULL << options.maxSize, 0)
+  {
+  }
+
+  auto detect() -> std::vector<XorConstraint>
+  {
+    std::vector<XorConstraint> result;
+    m_state.getClauseDB().getClauses([this, &result](std::vector<Clause*> const& clauses) {
+      for (Clause const* clause : clauses) {
+        if (isCandidate(*clause) && isRepresentative(*clause)) {
+          detectFrom(*clause, result);
+        }
+      }
+    });
+    return result;
+  }
+
+private:
+  auto isCandidate(Clause const& clause) const noexcept -> bool
+  {
+    return clause.size() >= 3 && clause.size() <= m_options.maxSize &&
+           !clause.getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) &&
+           !clause.getFlag(Clause::Flag::REDUNDANT);
+  }
+
+  /**
+   * Returns true iff \p clause is the clause of its potential XOR constraint whose
+   * negated literals are searched for the other clauses, ie. iff the clause has no
+   * negated literal except for the literal with the smallest variable, and no duplicate
+   * variables. This way, each constraint is detected exactly once.
+   */
+  auto isRepresentative(Clause const& clause) const noexcept -> bool
+  {
+    CNFVar const minVar =
+        std::min_element(clause.begin(), clause.end())->getVariable();
+    for (CNFLit lit : clause) {
+      if (lit.getSign() == CNFSign::NEGATIVE && lit.getVariable() != minVar) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void detectFrom(Clause const& clause, std::vector<XorConstraint>& result)
+  {
+    m_variables.clear();
+    for (CNFLit lit : clause) {
+      m_variables.push_back(lit.getVariable());
+    }
+    std::sort(m_variables.begin(), m_variables.end());
+    if (std::adjacent_find(m_variables.begin(), m_variables.end()) != m_variables.end()) {
+      return;
+    }
+    for (std::size_t i = 0; i < m_variables.size(); ++i) {
+      m_varIndices[m_variables[i].getRawValue()] = static_cast<uint32_t>(i);
+    }
+
+    uint32_t const negatedParity = getPattern(clause) & 1;
+    std::size_t const amntPatterns = 1ULL << m_variables.size();
+    std::fill(m_seenPatterns.begin(), m_seenPatterns.begin() + amntPatterns, 0);
+
+    // Searching the clauses over the same variables in the occurrence lists of the
+    // least frequently occurring variable:
+    SharedOptimizerState::OccMap& occurrences = m_state.getOccurrenceMap();
+    CNFVar searchVar = m_variables[0];
+    std::size_t minOccurrences = std::numeric_limits<std::size_t>::max();
+    for (CNFVar var : m_variables) {
+      std::size_t const amntOccurrences = occurrences[CNFLit{var, CNFSign::POSITIVE}].size() +
+                                          occurrences[CNFLit{var, CNFSign::NEGATIVE}].size();
+      if (amntOccurrences < minOccurrences) {
+        minOccurrences = amntOccurrences;
+        searchVar = var;
+      }
+    }
+
+    std::size_t amntFound = 0;
+    for (CNFSign sign : {CNFSign::POSITIVE, CNFSign::NEGATIVE}) {
+      for (Clause const* other : occurrences[CNFLit{searchVar, sign}]) {
+        if (other->size() != clause.size() || !isCandidate(*other) ||
+            !clause.mightShareAllVarsWith(*other) || !hasSameVariables(*other)) {
+          continue;
+        }
+        uint32_t const pattern = getPattern(*other);
+        if ((std::bitset<32>(pattern).count() & 1) == negatedParity &&
+            m_seenPatterns[pattern] == 0) {
+          m_seenPatterns[pattern] = 1;
+          ++amntFound;
+        }
+      }
+    }
+
+    for (CNFVar var : m_variables) {
+      m_varIndices[var.getRawValue()] = noIndex;
+    }
+
+    if (amntFound == amntPatterns / 2) {
+      // Each clause excludes the assignment falsifying it, having the parity
+      // negatedParity. Thus, the parity of the constraint is the opposite one:
+      result.push_back(XorConstraint{m_variables, negatedParity == 0});
+    }
+  }
+
+  /**
+   * Returns the bitset of the clause's negated literals, with bit i representing the
+   * i'th variable of m_variables.
+   */
+  auto getPattern(Clause const& clause) const noexcept -> uint32_t
+  {
+    uint32_t pattern = 0;
+    for (CNFLit lit : clause) {
+      if (lit.getSign() == CNFSign::NEGATIVE) {
+        pattern |= (1U << m_varIndices[lit.getVariable().getRawValue()]);
+      }
+    }
+    return pattern;
+  }
+
+  auto hasSameVariables(Clause const& other) const noexcept -> bool
+  {
+    uint32_t seenIndices = 0;
+    for (CNFLit lit : other) {
+      uint32_t const index = m_varIndices[lit.getVariable().getRawValue()];
+      if (index == noIndex) {
+        return false;
+      }
+      seenIndices |= (1U << index);
+    }
+    return seenIndices == (1U << m_variables.size()) - 1;
+  }
+
+  static constexpr uint32_t noIndex = std::numeric_limits<uint32_t>::max();
+
+  SharedOptimizerState& m_state;
+  XorDetectionOptions m_options;
+
+  /** Indexed by variables: the index of the variable in m_variables, or noIndex */
+  std::vector<uint32_t> m_varIndices;
+
+  /** Indexed by patterns of negated literals: 1 iff a clause with the pattern exists */
+  std::vector<char> m_seenPatterns;
+
+  /** The variables of the clause currently being checked, in ascending order */
+  std::vector<CNFVar> m_variables;
+};
+}
+
+auto detectXorConstraints(SharedOptimizerState& state, XorDetectionOptions const& options)
+    -> std::vector<XorConstraint>
+{
+  return XorDetector{state, options}.detect();
+}
+}
@@ -0,0 +1,69 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file XorDetection.h
+ * \brief Detection of XOR constraints encoded in CNF
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/solver/GaussJordanEngine.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for the detection of XOR constraints
+ */
+struct XorDetectionOptions {
+  /** The maximum amount of variables of detected constraints */
+  uint32_t maxSize = 5;
+};
+
+/**
+ * \ingroup JamSAT_Simplification
+ *
+ * \brief Detects XOR constraints encoded in the irredundant clauses of the given state.
+ *
+ * An XOR constraint over `k` variables is encoded by the `2^(k-1)` clauses over these
+ * variables that exclude the assignments with the wrong parity. Such sets of clauses
+ * are found via the occurrence map of \p state, using the clauses with at least 3
+ * literals. Clauses containing a variable twice are not considered. Since binary XOR
+ * constraints are equivalences, they are left to equivalent literal substitution.
+ *
+ * \param state     The shared optimizer state.
+ * \param options   Detection limits.
+ * \returns         The detected constraints, each containing distinct variables.
+ *
+ * \throw std::bad_alloc on memory allocation failure.
+ */
+auto detectXorConstraints(SharedOptimizerState& state, XorDetectionOptions const& options = {})
+    -> std::vector<XorConstraint>;
+}
@@ -0,0 +1,201 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "BlockedClauseElimination.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace jamsat {
+namespace {
+
+class BlockedClauseEliminator : public ProblemOptimizer {
+public:
+  explicit BlockedClauseEliminator(BlockedClauseEliminationOptions const& options)
+    : m_options{options}
+    , m_nextRoundAtConflict{0}
+    , m_conflictsBetweenRounds{options.conflictsBetweenRounds}
+  {
+  }
+
+  auto getName() const -> std::string override { return "BCE"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    // Restored blocked clauses are not necessarily RAT clauses, so DRAT certificates
+    // can't be maintained when eliminating blocked clauses. Skipped rounds are
+    // scheduled like completed ones, so that the optimizer is not requested in
+    // every simplification round:
+    if (sharedOptimizerState.hasDetectedUnsat() || sharedOptimizerState.hasUnsatCertificate() ||
+        sharedOptimizerState.getModelReconstructionStack() == nullptr) {
+      m_preempted = false;
+      scheduleNextRound(currentStats);
+      return sharedOptimizerState;
+    }
+
+    if (!m_preempted) {
+      // Beginning a new elimination round
+      m_nextVar = CNFVar{0};
+    }
+    m_preempted = false;
+
+    CNFVar const maxVar = sharedOptimizerState.getMaxVar();
+    m_marks.assign(getMaxLit(maxVar).getRawValue() + 1, 0);
+    m_isFactVar.assign(maxVar.getRawValue() + 1, 0);
+    for (CNFLit fact : sharedOptimizerState.getFacts()) {
+      m_isFactVar[fact.getVariable().getRawValue()] = 1;
+    }
+
+    for (; m_nextVar <= maxVar; m_nextVar = nextCNFVar(m_nextVar)) {
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_preempted = true;
+        break;
+      }
+      if (isWitnessCandidate(sharedOptimizerState, m_nextVar)) {
+        CNFLit const pos{m_nextVar, CNFSign::POSITIVE};
+        eliminateClausesBlockedBy(sharedOptimizerState, pos);
+        eliminateClausesBlockedBy(sharedOptimizerState, ~pos);
+      }
+    }
+
+    if (!m_preempted) {
+      scheduleNextRound(currentStats);
+    }
+    return sharedOptimizerState;
+  }
+
+private:
+  void scheduleNextRound(StatisticsEra const& currentStats) noexcept
+  {
+    m_nextRoundAtConflict = currentStats.m_conflictCount + m_conflictsBetweenRounds;
+    m_conflictsBetweenRounds *= 2;
+  }
+
+  auto isWitnessCandidate(SharedOptimizerState& state, CNFVar var) const noexcept -> bool
+  {
+    return !state.isFrozen(var) && m_isFactVar[var.getRawValue()] == 0 &&
+           !state.getModelReconstructionStack()->isEliminated(var);
+  }
+
+  /**
+   * Removes the irredundant clauses containing \p lit that are blocked by \p lit.
+   */
+  void eliminateClausesBlockedBy(SharedOptimizerState& state, CNFLit lit)
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+
+    m_partners.clear();
+    for (Clause* partner : occurrences[~lit]) {
+      if (!partner->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) &&
+          !partner->getFlag(Clause::Flag::REDUNDANT)) {
+        m_partners.push_back(partner);
+      }
+    }
+    state.consumeTicks(m_partners.size());
+    if (m_partners.size() > m_options.maxOccurrences) {
+      return;
+    }
+
+    // Copying the occurrence list, since it is modified when clauses are removed
+    auto candidates = occurrences[lit];
+    m_candidates.assign(candidates.begin(), candidates.end());
+    state.consumeTicks(m_candidates.size());
+
+    ModelReconstructionStack& reconstructionStack = *state.getModelReconstructionStack();
+    for (Clause* candidate : m_candidates) {
+      if (candidate->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) ||
+          candidate->getFlag(Clause::Flag::REDUNDANT)) {
+        continue;
+      }
+
+      if (isBlocked(state, *candidate, lit)) {
+        reconstructionStack.push(candidate->span(), lit);
+        deleteClause(state, *candidate);
+      }
+    }
+  }
+
+  /**
+   * Returns true iff all resolvents of \p clause on \p lit with the clauses in
+   * m_partners are tautological.
+   */
+  auto isBlocked(SharedOptimizerState& state, Clause const& clause, CNFLit lit) -> bool
+  {
+    for (CNFLit clauseLit : clause) {
+      m_marks[clauseLit.getRawValue()] = 1;
+    }
+    state.consumeTicks(clause.size());
+
+    bool blocked = true;
+    for (Clause const* partner : m_partners) {
+      state.consumeTicks(partner->size());
+      bool const tautological = std::any_of(partner->begin(), partner->end(), [&](CNFLit other) {
+        return other != ~lit && m_marks[(~other).getRawValue()] != 0;
+      });
+      if (!tautological) {
+        blocked = false;
+        break;
+      }
+    }
+
+    for (CNFLit clauseLit : clause) {
+      m_marks[clauseLit.getRawValue()] = 0;
+    }
+    return blocked;
+  }
+
+  BlockedClauseEliminationOptions m_options;
+  uint64_t m_nextRoundAtConflict;
+  uint64_t m_conflictsBetweenRounds;
+  bool m_preempted = false;
+
+  /** The variable at which the current round is continued after preemption */
+  CNFVar m_nextVar{0};
+
+  /** Indexed by literals: 1 iff the literal occurs in the clause being checked */
+  std::vector<char> m_marks;
+
+  /** Indexed by variables: 1 iff the variable occurs in a fact */
+  std::vector<char> m_isFactVar;
+
+  // Temporary data for the literal currently being checked
+  std::vector<Clause*> m_partners;
+  std::vector<Clause*> m_candidates;
+};
+}
+
+auto createBlockedClauseEliminator(BlockedClauseEliminationOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<BlockedClauseEliminator>(options);
+}
+}
@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for blocked clause elimination
+ */
+struct BlockedClauseEliminationOptions {
+  /**
+   * Literals whose negation occurs in more irredundant clauses are not checked
+   * for blocking clauses
+   */
+  uint32_t maxOccurrences = 32;
+
+  /** Amount of conflicts between the first and the second elimination round */
+  uint64_t conflictsBetweenRounds = 10000;
+};
+
+/**
+ * \brief Creates an optimizer performing blocked clause elimination.
+ *
+ * An irredundant clause `C` containing a literal `l` is blocked by `l` if all resolvents
+ * of `C` on `l` with irredundant clauses are tautological. Blocked clauses are removed
+ * from the problem and pushed onto the model reconstruction stack of the shared
+ * optimizer state, with `l` being the witness literal. No clauses are removed if the
+ * state has no such stack, or if it has a DRAT certificate: restored blocked clauses
+ * are not necessarily RAT clauses, so restoring them would invalidate the proof.
+ * Since the solver restores the removed clauses before clauses or assumptions
+ * containing the variable of a witness literal are added, frozen variables and
+ * variables occurring in facts are not used as witnesses.
+ *
+ * The optimizer consumes ticks for occurrence list visits and resolvent checks, and
+ * resumes an elimination round where it has been preempted. Elimination rounds are
+ * performed before the search and after geometrically growing amounts of conflicts.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createBlockedClauseEliminator(BlockedClauseEliminationOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
@@ -0,0 +1,392 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "BoundedVariableAddition.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace jamsat {
+namespace {
+
+class BoundedVariableAdder : public ProblemOptimizer {
+public:
+  explicit BoundedVariableAdder(BoundedVariableAdditionOptions const& options)
+    : m_options{options}
+    , m_nextRoundAtConflict{0}
+    , m_conflictsBetweenRounds{options.conflictsBetweenRounds}
+  {
+  }
+
+  auto getName() const -> std::string override { return "BVA"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    if (sharedOptimizerState.hasDetectedUnsat()) {
+      return sharedOptimizerState;
+    }
+
+    resizeLiteralMaps(sharedOptimizerState);
+    if (!m_preempted) {
+      // Beginning a new addition round
+      createLiteralQueue(sharedOptimizerState);
+      m_amntVarsAddedInRound = 0;
+    }
+    m_preempted = false;
+
+    while (m_nextQueueIndex < m_queue.size() &&
+           m_amntVarsAddedInRound < m_options.maxVarsAddedPerRound) {
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_preempted = true;
+        break;
+      }
+
+      // After a replacement, the literal might be part of further replacements:
+      if (!tryReplace(sharedOptimizerState, m_queue[m_nextQueueIndex])) {
+        ++m_nextQueueIndex;
+      }
+    }
+
+    if (!m_preempted) {
+      m_nextRoundAtConflict = currentStats.m_conflictCount + m_conflictsBetweenRounds;
+      m_conflictsBetweenRounds *= 2;
+    }
+    return sharedOptimizerState;
+  }
+
+private:
+  void resizeLiteralMaps(SharedOptimizerState& state)
+  {
+    std::size_t const amntLits = getMaxLit(state.getMaxVar()).getRawValue() + 1;
+    m_marks.resize(amntLits, 0);
+    m_partnerCounts.resize(amntLits, 0);
+  }
+
+  /**
+   * Fills m_queue with the literals occurring in at least two irredundant clauses,
+   * in descending order of their occurrence count.
+   */
+  void createLiteralQueue(SharedOptimizerState& state)
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+    std::vector<std::pair<std::size_t, CNFLit>> weightedLits;
+    for (CNFVar var{0}; var <= state.getMaxVar(); var = nextCNFVar(var)) {
+      for (CNFSign sign : {CNFSign::NEGATIVE, CNFSign::POSITIVE}) {
+        CNFLit const lit{var, sign};
+        std::size_t const amntOccurrences = countIrredundant(occurrences[lit]);
+        if (amntOccurrences >= 2) {
+          weightedLits.emplace_back(amntOccurrences, lit);
+        }
+      }
+    }
+    state.consumeTicks(getMaxLit(state.getMaxVar()).getRawValue() + 1);
+
+    std::stable_sort(
+        weightedLits.begin(), weightedLits.end(), [](auto const& lhs, auto const& rhs) {
+          return lhs.first > rhs.first;
+        });
+    m_queue.clear();
+    for (auto const& weightedLit : weightedLits) {
+      m_queue.push_back(weightedLit.second);
+    }
+    m_nextQueueIndex = 0;
+  }
+
+  template <typename ClauseRange>
+  static auto countIrredundant(ClauseRange const& clauses) noexcept -> std::size_t
+  {
+    return std::count_if(clauses.begin(), clauses.end(), [](Clause const* clause) {
+      return isIrredundant(*clause);
+    });
+  }
+
+  static auto isIrredundant(Clause const& clause) noexcept -> bool
+  {
+    return !clause.getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) &&
+           !clause.getFlag(Clause::Flag::REDUNDANT);
+  }
+
+  /**
+   * Returns the amount of clauses saved by replacing the clauses for
+   * `amntLits` literals and `amntClauses` clauses.
+   */
+  static auto getReduction(std::size_t amntLits, std::size_t amntClauses) noexcept -> int64_t
+  {
+    return static_cast<int64_t>(amntLits * amntClauses) -
+           static_cast<int64_t>(amntLits + amntClauses);
+  }
+
+  /**
+   * Greedily searches for a set of literals L containing \p lit and a set of clauses
+   * R such that all clauses `r | l` with `r` in R and `l` in L exist, and performs the
+   * replacement if it reduces the amount of clauses.
+   *
+   * \returns true iff a replacement has been performed.
+   */
+  auto tryReplace(SharedOptimizerState& state, CNFLit lit) -> bool
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+    m_matchedLits.assign(1, lit);
+    m_matchedClauses.clear();
+    for (Clause* clause : occurrences[lit]) {
+      if (isIrredundant(*clause)) {
+        m_matchedClauses.push_back(clause);
+      }
+    }
+    state.consumeTicks(m_matchedClauses.size());
+
+    while (m_matchedClauses.size() >= 2) {
+      collectPartners(state, lit);
+      if (m_partners.empty()) {
+        break;
+      }
+
+      // Choosing the literal completing the most clauses of m_matchedClauses:
+      CNFLit bestLit = CNFLit::getUndefinedLiteral();
+      std::size_t bestCount = 0;
+      for (auto const& partner : m_partners) {
+        std::size_t const count = ++m_partnerCounts[partner.first.getRawValue()];
+        if (count > bestCount) {
+          bestCount = count;
+          bestLit = partner.first;
+        }
+      }
+      for (auto const& partner : m_partners) {
+        m_partnerCounts[partner.first.getRawValue()] = 0;
+      }
+
+      if (getReduction(m_matchedLits.size() + 1, bestCount) <=
+          getReduction(m_matchedLits.size(), m_matchedClauses.size())) {
+        break;
+      }
+
+      m_matchedLits.push_back(bestLit);
+      m_matchedClauses.clear();
+      for (auto const& partner : m_partners) {
+        if (partner.first == bestLit) {
+          m_matchedClauses.push_back(partner.second);
+        }
+      }
+    }
+
+    if (m_matchedLits.size() < 2 ||
+        getReduction(m_matchedLits.size(), m_matchedClauses.size()) <= 0) {
+      return false;
+    }
+    replace(state, lit);
+    return true;
+  }
+
+  /**
+   * For each clause `C` in m_matchedClauses, finds the literals `l'` not occurring in
+   * m_matchedLits such that the clause `(C - lit) | l'` exists, and stores the pairs
+   * `(l', C)` in m_partners, ordered by literal.
+   */
+  void collectPartners(SharedOptimizerState& state, CNFLit lit)
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+    m_partners.clear();
+
+    for (Clause* clause : m_matchedClauses) {
+      // Searching the occurrence list of the least frequent literal of C - lit:
+      CNFLit searchLit = CNFLit::getUndefinedLiteral();
+      std::size_t minOccurrences = 0;
+      for (CNFLit clauseLit : *clause) {
+        if (clauseLit == lit) {
+          continue;
+        }
+        m_marks[clauseLit.getRawValue()] = 1;
+        std::size_t const amntOccurrences = occurrences[clauseLit].size();
+        if (searchLit == CNFLit::getUndefinedLiteral() || amntOccurrences < minOccurrences) {
+          searchLit = clauseLit;
+          minOccurrences = amntOccurrences;
+        }
+      }
+      state.consumeTicks(clause->size() + minOccurrences);
+
+      for (Clause const* other : occurrences[searchLit]) {
+        if (other == clause || other->size() != clause->size() || !isIrredundant(*other)) {
+          continue;
+        }
+        CNFLit const partnerLit = getSingleUnmarkedLiteral(*other);
+        if (partnerLit != CNFLit::getUndefinedLiteral() && !isMatchedVariable(partnerLit)) {
+          m_partners.emplace_back(partnerLit, clause);
+        }
+      }
+
+      for (CNFLit clauseLit : *clause) {
+        m_marks[clauseLit.getRawValue()] = 0;
+      }
+    }
+
+    // Clauses occurring multiple times in the clause database can cause duplicates:
+    std::sort(m_partners.begin(), m_partners.end());
+    m_partners.erase(std::unique(m_partners.begin(), m_partners.end()), m_partners.end());
+  }
+
+  auto getSingleUnmarkedLiteral(Clause const& clause) const noexcept -> CNFLit
+  {
+    CNFLit result = CNFLit::getUndefinedLiteral();
+    for (CNFLit lit : clause) {
+      if (m_marks[lit.getRawValue()] == 0) {
+        if (result != CNFLit::getUndefinedLiteral()) {
+          return CNFLit::getUndefinedLiteral();
+        }
+        result = lit;
+      }
+    }
+    return result;
+  }
+
+  auto isMatchedVariable(CNFLit lit) const noexcept -> bool
+  {
+    return std::any_of(m_matchedLits.begin(), m_matchedLits.end(), [lit](CNFLit matchedLit) {
+      return matchedLit.getVariable() == lit.getVariable();
+    });
+  }
+
+  /**
+   * Replaces the clauses `(C - lit) | l` with `C` in m_matchedClauses and `l` in
+   * m_matchedLits by the clauses `(C - lit) | x` and `l | ~x`, with `x` being a new
+   * variable.
+   */
+  void replace(SharedOptimizerState& state, CNFLit lit)
+  {
+    CNFVar const newVar = nextCNFVar(state.getMaxVar());
+    state.setMaxVar(newVar);
+    state.setBreakingChange();
+    resizeLiteralMaps(state);
+    state.getStats().amntVarsAdded += 1;
+    ++m_amntVarsAddedInRound;
+
+    // Since newVar does not occur in the problem, the clauses containing newVar are
+    // RAT on newVar. The clauses containing ~newVar are RAT on ~newVar, since their
+    // resolvents with the former are the clauses to be replaced.
+    CNFLit const newLit{newVar, CNFSign::POSITIVE};
+    for (Clause const* clause : m_matchedClauses) {
+      m_clauseBuffer.assign(1, newLit);
+      std::copy_if(clause->begin(),
+                   clause->end(),
+                   std::back_inserter(m_clauseBuffer),
+                   [lit](CNFLit clauseLit) { return clauseLit != lit; });
+      addClause(state, m_clauseBuffer);
+    }
+    for (CNFLit matchedLit : m_matchedLits) {
+      m_clauseBuffer.assign({~newLit, matchedLit});
+      addClause(state, m_clauseBuffer);
+    }
+
+    // Copying the matched clauses, since deleting clauses modifies the occurrence lists:
+    std::vector<Clause*> replacedClauses = m_matchedClauses;
+    for (Clause* clause : replacedClauses) {
+      for (CNFLit clauseLit : *clause) {
+        m_marks[clauseLit.getRawValue()] = (clauseLit != lit ? 1 : 0);
+      }
+      for (CNFLit matchedLit : m_matchedLits) {
+        if (matchedLit != lit) {
+          Clause* partner = findPartner(state, *clause, matchedLit);
+          if (partner != nullptr) {
+            deleteClause(state, *partner);
+          }
+        }
+      }
+      for (CNFLit clauseLit : *clause) {
+        m_marks[clauseLit.getRawValue()] = 0;
+      }
+      deleteClause(state, *clause);
+    }
+  }
+
+  /**
+   * Returns the clause `(clause - lit) | partnerLit`, with the literals of `clause - lit`
+   * being marked in m_marks, or nullptr if no such clause exists.
+   */
+  auto findPartner(SharedOptimizerState& state, Clause const& clause, CNFLit partnerLit)
+      -> Clause*
+  {
+    auto partners = state.getOccurrenceMap()[partnerLit];
+    state.consumeTicks(partners.size());
+    for (Clause* partner : partners) {
+      if (partner != &clause && partner->size() == clause.size() && isIrredundant(*partner) &&
+          getSingleUnmarkedLiteral(*partner) == partnerLit) {
+        return partner;
+      }
+    }
+    return nullptr;
+  }
+
+  void addClause(SharedOptimizerState& state, std::vector<CNFLit> const& literals)
+  {
+    state.getUnsatCertificate().addRATClause(literals, 0);
+    Clause* clause = state.getClauseDB().createClause(literals.size());
+    if (clause == nullptr) {
+      throw std::bad_alloc{};
+    }
+    std::copy(literals.begin(), literals.end(), clause->begin());
+    clause->clauseUpdated();
+    state.getOccurrenceMap().insert(*clause);
+    state.getAssignment().registerClause(*clause);
+    state.getStats().amntClausesAdded += 1;
+  }
+
+  BoundedVariableAdditionOptions m_options;
+  uint64_t m_nextRoundAtConflict;
+  uint64_t m_conflictsBetweenRounds;
+  bool m_preempted = false;
+
+  /** The literals to be checked in the current round, and the index of the next one */
+  std::vector<CNFLit> m_queue;
+  std::size_t m_nextQueueIndex = 0;
+  uint32_t m_amntVarsAddedInRound = 0;
+
+  /** Indexed by literals: 1 iff the literal occurs in the clause being checked */
+  std::vector<char> m_marks;
+
+  /** Indexed by literals: temporary counters for the partner literals */
+  std::vector<uint32_t> m_partnerCounts;
+
+  // Temporary data for the literal currently being checked
+  std::vector<CNFLit> m_matchedLits;
+  std::vector<Clause*> m_matchedClauses;
+  std::vector<std::pair<CNFLit, Clause*>> m_partners;
+  std::vector<CNFLit> m_clauseBuffer;
+};
+}
+
+auto createBoundedVariableAdder(BoundedVariableAdditionOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<BoundedVariableAdder>(options);
+}
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for bounded variable addition
+ */
+struct BoundedVariableAdditionOptions {
+  /** Maximum amount of variables added per addition round */
+  uint32_t maxVarsAddedPerRound = 1 << 16;
+
+  /** Amount of conflicts between the first and the second addition round */
+  uint64_t conflictsBetweenRounds = 20000;
+};
+
+/**
+ * \brief Creates an optimizer performing bounded variable addition.
+ *
+ * For a set of literals `L` and a set of clauses `R` such that the problem contains
+ * the irredundant clauses `r | l` for all `r` in `R` and `l` in `L`, these
+ * `|L| * |R|` clauses are replaced by the clauses `r | x` and `l | ~x`, with `x` being
+ * a new variable. The replacement is performed iff it reduces the amount of clauses.
+ * This compresses encodings such as pairwise at-most-one constraints. Literals are
+ * processed in descending order of their occurrence count, and `L` is grown greedily
+ * as in SimpleBVA.
+ *
+ * The new variables are allocated above the maximum variable of the shared optimizer
+ * state. The new clauses are added to the proof as RAT clauses, with the literal of
+ * the new variable being the pivot. Since the removed clauses are implied by the new
+ * ones, no model reconstruction is required. The optimizer consumes ticks for
+ * occurrence list visits and resumes an addition round where it has been preempted.
+ * Addition rounds are performed before the search and after geometrically growing
+ * amounts of conflicts.
+ *
+ * Clients of this optimizer must make sure that the variables above the state's
+ * maximum variable are not used otherwise.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createBoundedVariableAdder(BoundedVariableAdditionOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
@@ -0,0 +1,333 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "BoundedVariableElimination.h"
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <libjamsat/utils/Assert.h>
+
+namespace jamsat {
+namespace {
+
+class BoundedVariableEliminator : public ProblemOptimizer {
+public:
+  explicit BoundedVariableEliminator(BoundedVariableEliminationOptions const& options)
+    : m_options{options}
+    , m_nextRoundAtConflict{0}
+    , m_conflictsBetweenRounds{options.conflictsBetweenRounds}
+  {
+  }
+
+  auto getName() const -> std::string override { return "BVE"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    if (sharedOptimizerState.hasDetectedUnsat() ||
+        sharedOptimizerState.getModelReconstructionStack() == nullptr) {
+      return sharedOptimizerState;
+    }
+
+    if (!m_preempted) {
+      // Beginning a new elimination round
+      m_tried.clear();
+    }
+    m_preempted = false;
+
+    CNFVar const maxVar = sharedOptimizerState.getMaxVar();
+    std::size_t const amntVars = maxVar.getRawValue() + 1;
+    std::size_t const amntLits = getMaxLit(maxVar).getRawValue() + 1;
+    m_tried.resize(amntVars, 0);
+    m_marks.assign(amntLits, 0);
+    m_isFact.assign(amntLits, 0);
+    for (CNFLit fact : sharedOptimizerState.getFacts()) {
+      m_isFact[fact.getRawValue()] = 1;
+    }
+
+    bool eliminatedAny = false;
+    for (CNFVar candidate : getCandidates(sharedOptimizerState)) {
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_preempted = true;
+        break;
+      }
+
+      m_tried[candidate.getRawValue()] = 1;
+      eliminatedAny = tryEliminate(sharedOptimizerState, candidate) || eliminatedAny;
+      if (sharedOptimizerState.hasDetectedUnsat()) {
+        break;
+      }
+    }
+
+    if (!m_preempted) {
+      m_nextRoundAtConflict = currentStats.m_conflictCount + m_conflictsBetweenRounds;
+      m_conflictsBetweenRounds *= 2;
+    }
+
+    if (eliminatedAny) {
+      // The solver needs to stop deciding on eliminated variables
+      sharedOptimizerState.setBreakingChange();
+    }
+    return sharedOptimizerState;
+  }
+
+private:
+  auto getCandidates(SharedOptimizerState& state) -> std::vector<CNFVar>
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+    ModelReconstructionStack const& reconstructionStack = *state.getModelReconstructionStack();
+
+    std::vector<std::pair<uint64_t, CNFVar>> costs;
+    for (CNFVar var{0}; var <= state.getMaxVar(); var = nextCNFVar(var)) {
+      CNFLit const pos{var, CNFSign::POSITIVE};
+      if (m_tried[var.getRawValue()] != 0 || state.isFrozen(var) ||
+          reconstructionStack.isEliminated(var) || isFact(pos) || isFact(~pos)) {
+        continue;
+      }
+
+      uint64_t const amntPos = occurrences[pos].size();
+      uint64_t const amntNeg = occurrences[~pos].size();
+      if (amntPos + amntNeg > 0) {
+        costs.emplace_back(amntPos * amntNeg, var);
+      }
+    }
+    state.consumeTicks(state.getMaxVar().getRawValue() + 1);
+
+    // Trying the variables with the least amount of potential resolvents first
+    std::stable_sort(costs.begin(), costs.end(), [](auto const& lhs, auto const& rhs) {
+      return lhs.first < rhs.first;
+    });
+
+    std::vector<CNFVar> result;
+    result.reserve(costs.size());
+    for (auto const& cost : costs) {
+      result.push_back(cost.second);
+    }
+    return result;
+  }
+
+  auto tryEliminate(SharedOptimizerState& state, CNFVar var) -> bool
+  {
+    CNFLit const pos{var, CNFSign::POSITIVE};
+    if (isFact(pos) || isFact(~pos)) {
+      // The variable has become a fact during this round
+      return false;
+    }
+
+    m_redundantClauses.clear();
+    collectOccurrences(state, pos, m_posClauses);
+    collectOccurrences(state, ~pos, m_negClauses);
+
+    std::size_t const amntIrredundant = m_posClauses.size() + m_negClauses.size();
+    if (amntIrredundant == 0) {
+      return false;
+    }
+    if (!m_posClauses.empty() && !m_negClauses.empty() &&
+        amntIrredundant > m_options.maxOccurrences) {
+      return false;
+    }
+
+    if (!computeResolvents(state, pos, amntIrredundant)) {
+      return false;
+    }
+
+    addResolvents(state);
+    if (state.hasDetectedUnsat()) {
+      return false;
+    }
+
+    ModelReconstructionStack& reconstructionStack = *state.getModelReconstructionStack();
+    for (Clause* clause : m_negClauses) {
+      reconstructionStack.push(clause->span(), ~pos);
+    }
+    for (Clause* clause : m_posClauses) {
+      reconstructionStack.push(clause->span(), pos);
+    }
+    reconstructionStack.setEliminated(var);
+
+    for (auto* clauses : {&m_posClauses, &m_negClauses, &m_redundantClauses}) {
+      for (Clause* clause : *clauses) {
+        deleteClause(state, *clause);
+      }
+    }
+
+    state.getStats().amntVarsEliminated += 1;
+    return true;
+  }
+
+  void collectOccurrences(SharedOptimizerState& state, CNFLit lit, std::vector<Clause*>& target)
+  {
+    target.clear();
+
+    auto occurrences = state.getOccurrenceMap()[lit];
+    state.consumeTicks(occurrences.size());
+    for (Clause* clause : occurrences) {
+      if (clause->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION)) {
+        continue;
+      }
+      if (clause->getFlag(Clause::Flag::REDUNDANT)) {
+        m_redundantClauses.push_back(clause);
+      }
+      else {
+        target.push_back(clause);
+      }
+    }
+  }
+
+  /**
+   * Computes the non-tautological resolvents of m_posClauses and m_negClauses on
+   * the variable of \p pos, storing them in m_resolventLits and m_resolventEnds.
+   * Returns false if the resolvents exceed the limits.
+   */
+  auto computeResolvents(SharedOptimizerState& state, CNFLit pos, std::size_t maxResolvents)
+      -> bool
+  {
+    m_resolventLits.clear();
+    m_resolventEnds.clear();
+
+    for (Clause* posClause : m_posClauses) {
+      for (Clause* negClause : m_negClauses) {
+        state.consumeTicks(posClause->size() + negClause->size());
+        std::size_t const resolventBegin = m_resolventLits.size();
+        bool tautological = false;
+
+        for (CNFLit lit : *posClause) {
+          if (lit != pos && m_marks[lit.getRawValue()] == 0) {
+            m_marks[lit.getRawValue()] = 1;
+            m_resolventLits.push_back(lit);
+          }
+        }
+        for (CNFLit lit : *negClause) {
+          if (lit == ~pos || m_marks[lit.getRawValue()] != 0) {
+            continue;
+          }
+          if (m_marks[(~lit).getRawValue()] != 0) {
+            tautological = true;
+            break;
+          }
+          m_marks[lit.getRawValue()] = 1;
+          m_resolventLits.push_back(lit);
+        }
+
+        auto const resolventStart = m_resolventLits.begin() + resolventBegin;
+        for (auto it = resolventStart; it != m_resolventLits.end(); ++it) {
+          m_marks[it->getRawValue()] = 0;
+        }
+
+        std::size_t const resolventSize = m_resolventLits.size() - resolventBegin;
+        if (tautological) {
+          m_resolventLits.resize(resolventBegin);
+          continue;
+        }
+        if (resolventSize > m_options.maxResolventSize ||
+            m_resolventEnds.size() + 1 > maxResolvents) {
+          return false;
+        }
+        m_resolventEnds.push_back(m_resolventLits.size());
+      }
+    }
+    return true;
+  }
+
+  void addResolvents(SharedOptimizerState& state)
+  {
+    DRATCertificate& unsatCert = state.getUnsatCertificate();
+    OptimizationStats& stats = state.getStats();
+
+    std::size_t resolventBegin = 0;
+    for (std::size_t resolventEnd : m_resolventEnds) {
+      gsl::span<CNFLit const> resolvent{m_resolventLits.data() + resolventBegin,
+                                        resolventEnd - resolventBegin};
+      resolventBegin = resolventEnd;
+      unsatCert.addATClause(resolvent);
+
+      if (resolvent.size() == 1) {
+        CNFLit const fact = resolvent[0];
+        if (isFact(~fact)) {
+          state.setDetectedUnsat();
+          return;
+        }
+        if (!isFact(fact)) {
+          state.getFacts().push_back(fact);
+          m_isFact[fact.getRawValue()] = 1;
+          stats.amntFactsDerived += 1;
+          if (factsPropagateToConflict(state)) {
+            // Stopping here, since all further clauses in the proof would be redundant
+            state.setDetectedUnsat();
+            return;
+          }
+        }
+        continue;
+      }
+
+      Clause* clause = state.getClauseDB().createClause(resolvent.size());
+      if (clause == nullptr) {
+        throw std::bad_alloc{};
+      }
+      std::copy(resolvent.begin(), resolvent.end(), clause->begin());
+      clause->clauseUpdated();
+      state.getOccurrenceMap().insert(*clause);
+      state.getAssignment().registerClause(*clause);
+      stats.amntClausesAdded += 1;
+    }
+  }
+
+  auto isFact(CNFLit lit) const noexcept -> bool { return m_isFact[lit.getRawValue()] != 0; }
+
+  BoundedVariableEliminationOptions m_options;
+  uint64_t m_nextRoundAtConflict;
+  uint64_t m_conflictsBetweenRounds;
+  bool m_preempted = false;
+
+  /** Indexed by variables: 1 iff elimination has been tried in the current round */
+  std::vector<char> m_tried;
+
+  // Temporary data, indexed by literals
+  std::vector<char> m_marks;
+  std::vector<char> m_isFact;
+
+  // Temporary data for the variable currently being eliminated
+  std::vector<Clause*> m_posClauses;
+  std::vector<Clause*> m_negClauses;
+  std::vector<Clause*> m_redundantClauses;
+  std::vector<CNFLit> m_resolventLits;
+  std::vector<std::size_t> m_resolventEnds;
+};
+}
+
+auto createBoundedVariableEliminator(BoundedVariableEliminationOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<BoundedVariableEliminator>(options);
+}
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for bounded variable elimination
+ */
+struct BoundedVariableEliminationOptions {
+  /**
+   * Variables occurring in more irredundant clauses are not eliminated, unless
+   * they occur in only one polarity.
+   */
+  uint32_t maxOccurrences = 24;
+
+  /** Variables are not eliminated if this would produce larger resolvents */
+  uint32_t maxResolventSize = 16;
+
+  /** Amount of conflicts between the first and the second elimination round */
+  uint64_t conflictsBetweenRounds = 10000;
+};
+
+/**
+ * \brief Creates an optimizer performing bounded variable elimination by clause
+ *   distribution.
+ *
+ * A variable `x` is eliminated by replacing the irredundant clauses containing `x`
+ * or `~x` by their non-tautological resolvents on `x`, if this does not increase
+ * the amount of clauses. Redundant clauses containing `x` are deleted. The removed
+ * irredundant clauses are pushed onto the model reconstruction stack of the shared
+ * optimizer state; no variables are eliminated if the state has no such stack.
+ * Frozen variables and variables occurring in facts are not eliminated.
+ *
+ * The optimizer consumes ticks for occurrence list visits and resolution steps, and
+ * resumes an elimination round where it has been preempted. Elimination rounds are
+ * performed before the search and after geometrically growing amounts of conflicts.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createBoundedVariableEliminator(BoundedVariableEliminationOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
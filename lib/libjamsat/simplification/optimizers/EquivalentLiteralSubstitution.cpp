@@ -0,0 +1,461 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "EquivalentLiteralSubstitution.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace jamsat {
+namespace {
+
+auto toLiteral(std::size_t rawValue) noexcept -> CNFLit
+{
+  return CNFLit{CNFVar{static_cast<CNFVar::RawVariable>(rawValue >> 1)},
+                static_cast<CNFSign>(rawValue & 1)};
+}
+
+class EquivalentLiteralSubstitutor : public ProblemOptimizer {
+public:
+  explicit EquivalentLiteralSubstitutor(EquivalentLiteralSubstitutionOptions const& options)
+    : m_nextRoundAtConflict{0}, m_conflictsBetweenRounds{options.conflictsBetweenRounds}
+  {
+  }
+
+  auto getName() const -> std::string override { return "EquivalentLiterals"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    if (sharedOptimizerState.hasDetectedUnsat() ||
+        sharedOptimizerState.getModelReconstructionStack() == nullptr) {
+      m_preempted = false;
+      scheduleNextRound(currentStats);
+      return sharedOptimizerState;
+    }
+
+    if (!m_preempted) {
+      // Beginning a new round
+      m_nextRoot = 0;
+    }
+    m_preempted = false;
+
+    std::size_t const amntLits = getMaxLit(sharedOptimizerState.getMaxVar()).getRawValue() + 1;
+    m_isFactVar.assign(amntLits / 2, 0);
+    for (CNFLit fact : sharedOptimizerState.getFacts()) {
+      m_isFactVar[fact.getVariable().getRawValue()] = 1;
+    }
+    m_representatives.resize(amntLits);
+    for (std::size_t i = 0; i < amntLits; ++i) {
+      m_representatives[i] = toLiteral(i);
+    }
+    m_substitutedVars.clear();
+
+    buildImplicationGraph(sharedOptimizerState);
+    computeEquivalenceClasses(sharedOptimizerState);
+    if (!m_preempted) {
+      scheduleNextRound(currentStats);
+    }
+    if (sharedOptimizerState.hasDetectedUnsat() || m_substitutedVars.empty()) {
+      return sharedOptimizerState;
+    }
+
+    substitute(sharedOptimizerState);
+    if (sharedOptimizerState.hasDetectedUnsat()) {
+      return sharedOptimizerState;
+    }
+
+    ModelReconstructionStack& reconstructionStack =
+        *sharedOptimizerState.getModelReconstructionStack();
+    for (CNFVar var : m_substitutedVars) {
+      CNFLit const pos{var, CNFSign::POSITIVE};
+      CNFLit const representative = getRepresentative(pos);
+      std::array<CNFLit, 2> const forward{~pos, representative};
+      std::array<CNFLit, 2> const backward{pos, ~representative};
+      reconstructionStack.push(forward, ~pos);
+      reconstructionStack.push(backward, pos);
+      reconstructionStack.setEliminated(var);
+    }
+    sharedOptimizerState.getStats().amntVarsEliminated += m_substitutedVars.size();
+
+    // The solver needs to stop deciding on substituted variables
+    sharedOptimizerState.setBreakingChange();
+    return sharedOptimizerState;
+  }
+
+private:
+  void scheduleNextRound(StatisticsEra const& currentStats) noexcept
+  {
+    m_nextRoundAtConflict = currentStats.m_conflictCount + m_conflictsBetweenRounds;
+    m_conflictsBetweenRounds *= 2;
+  }
+
+  /**
+   * Stores the edges `~a -> b` of the binary implication graph, for the binary
+   * clauses `(a b)` not containing variables occurring in facts.
+   */
+  void buildImplicationGraph(SharedOptimizerState& state)
+  {
+    Assignment& assignment = state.getAssignment();
+    assignment.cleanupWatchers();
+    Assignment::BinariesMap const binaries = assignment.getBinariesMap();
+
+    std::size_t const amntLits = getMaxLit(state.getMaxVar()).getRawValue() + 1;
+    m_edgesBegin.clear();
+    m_edges.clear();
+    for (std::size_t rawLit = 0; rawLit < amntLits; ++rawLit) {
+      CNFLit const lit = toLiteral(rawLit);
+      m_edgesBegin.push_back(m_edges.size());
+      if (isFactVar(lit.getVariable())) {
+        continue;
+      }
+      for (CNFLit implied : binaries[~lit]) {
+        if (!isFactVar(implied.getVariable())) {
+          m_edges.push_back(implied);
+        }
+      }
+    }
+    m_edgesBegin.push_back(m_edges.size());
+    state.consumeTicks(m_edges.size() + m_edgesBegin.size());
+  }
+
+  /**
+   * Computes the strongly connected components of the binary implication graph via
+   * Tarjan's algorithm, without recursion, and selects the representatives.
+   *
+   * The search is started from the literals beginning with m_nextRoot. When the tick
+   * budget is exhausted, the search is stopped before the next root and m_preempted
+   * is set. Since the components found until then are complete, their literals can
+   * be substituted nevertheless.
+   */
+  void computeEquivalenceClasses(SharedOptimizerState& state)
+  {
+    constexpr uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+    std::size_t const amntLits = m_edgesBegin.size() - 1;
+    m_index.assign(amntLits, unvisited);
+    m_lowLink.assign(amntLits, 0);
+    m_onStack.assign(amntLits, 0);
+    m_componentStack.clear();
+    uint32_t nextIndex = 0;
+
+    auto const visit = [&](CNFLit lit) {
+      std::size_t const rawLit = lit.getRawValue();
+      m_index[rawLit] = nextIndex;
+      m_lowLink[rawLit] = nextIndex;
+      ++nextIndex;
+      m_componentStack.push_back(lit);
+      m_onStack[rawLit] = 1;
+      m_callStack.emplace_back(lit, m_edgesBegin[rawLit]);
+      state.consumeTicks(1 + m_edgesBegin[rawLit + 1] - m_edgesBegin[rawLit]);
+    };
+
+    for (; m_nextRoot < amntLits; ++m_nextRoot) {
+      std::size_t const root = m_nextRoot;
+      if (m_index[root] != unvisited || m_edgesBegin[root] == m_edgesBegin[root + 1]) {
+        continue;
+      }
+      if (state.isTickBudgetExhausted()) {
+        m_preempted = true;
+        return;
+      }
+
+      visit(toLiteral(root));
+      while (!m_callStack.empty()) {
+        CNFLit const lit = m_callStack.back().first;
+        std::size_t& nextEdge = m_callStack.back().second;
+
+        if (nextEdge != m_edgesBegin[lit.getRawValue() + 1]) {
+          CNFLit const successor = m_edges[nextEdge];
+          ++nextEdge;
+          if (m_index[successor.getRawValue()] == unvisited) {
+            visit(successor);
+          }
+          else if (m_onStack[successor.getRawValue()] != 0) {
+            m_lowLink[lit.getRawValue()] =
+                std::min(m_lowLink[lit.getRawValue()], m_index[successor.getRawValue()]);
+          }
+          continue;
+        }
+
+        m_callStack.pop_back();
+        if (!m_callStack.empty()) {
+          CNFLit const parent = m_callStack.back().first;
+          m_lowLink[parent.getRawValue()] =
+              std::min(m_lowLink[parent.getRawValue()], m_lowLink[lit.getRawValue()]);
+        }
+
+        if (m_lowLink[lit.getRawValue()] == m_index[lit.getRawValue()]) {
+          // The component consists of the literals above lit on the stack, and lit:
+          m_component.clear();
+          CNFLit member;
+          do {
+            member = m_componentStack.back();
+            m_componentStack.pop_back();
+            m_onStack[member.getRawValue()] = 0;
+            m_component.push_back(member);
+          } while (member != lit);
+
+          processComponent(state);
+          if (state.hasDetectedUnsat()) {
+            m_callStack.clear();
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Selects the representative of the equivalence class stored in m_component.
+   * Since the class of the negated literals is a component, too, and the selection
+   * only depends on the variables, the representatives are chosen consistently.
+   * The representatives of the negated literals are set right away, since the
+   * search may be preempted before the component of the negated literals is found.
+   */
+  void processComponent(SharedOptimizerState& state)
+  {
+    if (m_component.size() < 2) {
+      return;
+    }
+
+    std::sort(m_component.begin(), m_component.end());
+    for (std::size_t i = 1; i < m_component.size(); ++i) {
+      if (m_component[i - 1] == ~m_component[i]) {
+        // lit -> ~lit -> lit: adding lit as a RUP clause, making the empty clause RUP
+        std::array<CNFLit, 1> const unit{m_component[i]};
+        state.getUnsatCertificate().addATClause(unit);
+        state.setDetectedUnsat();
+        return;
+      }
+    }
+
+    CNFLit representative = m_component[0];
+    for (CNFLit lit : m_component) {
+      if (state.isFrozen(lit.getVariable())) {
+        representative = lit;
+        break;
+      }
+    }
+
+    for (CNFLit lit : m_component) {
+      if (lit != representative && !state.isFrozen(lit.getVariable()) &&
+          getRepresentative(lit) == lit) {
+        m_representatives[lit.getRawValue()] = representative;
+        m_representatives[(~lit).getRawValue()] = ~representative;
+        m_substitutedVars.push_back(lit.getVariable());
+      }
+    }
+  }
+
+  /**
+   * Replaces the substituted variables in all clauses. The rewritten clauses are
+   * added before the original clauses are deleted, since the proof of a rewritten
+   * clause may depend on the binary clauses of the equivalence classes.
+   */
+  void substitute(SharedOptimizerState& state)
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+    m_affectedClauses.clear();
+    for (CNFVar var : m_substitutedVars) {
+      CNFLit const pos{var, CNFSign::POSITIVE};
+      for (CNFLit lit : {pos, ~pos}) {
+        for (Clause* clause : occurrences[lit]) {
+          if (!clause->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION)) {
+            m_affectedClauses.push_back(clause);
+          }
+        }
+      }
+    }
+    std::sort(m_affectedClauses.begin(), m_affectedClauses.end());
+    m_affectedClauses.erase(std::unique(m_affectedClauses.begin(), m_affectedClauses.end()),
+                            m_affectedClauses.end());
+    state.consumeTicks(m_affectedClauses.size());
+
+    m_marks.assign(m_representatives.size(), 0);
+    for (Clause* clause : m_affectedClauses) {
+      addRewrittenClause(state, *clause);
+      if (state.hasDetectedUnsat()) {
+        return;
+      }
+    }
+
+    for (Clause* clause : m_affectedClauses) {
+      deleteClause(state, *clause);
+    }
+  }
+
+  void addRewrittenClause(SharedOptimizerState& state, Clause& original)
+  {
+    state.consumeTicks(original.size());
+
+    m_rewritten.clear();
+    bool tautological = false;
+    for (CNFLit lit : original) {
+      CNFLit const replacement = getRepresentative(lit);
+      if (m_marks[replacement.getRawValue()] != 0) {
+        continue;
+      }
+      if (m_marks[(~replacement).getRawValue()] != 0) {
+        tautological = true;
+        break;
+      }
+      m_marks[replacement.getRawValue()] = 1;
+      m_rewritten.push_back(replacement);
+    }
+
+    bool const duplicate = !tautological && m_rewritten.size() > 1 &&
+                           hasDuplicate(state, original.getFlag(Clause::Flag::REDUNDANT));
+    for (CNFLit lit : m_rewritten) {
+      m_marks[lit.getRawValue()] = 0;
+    }
+    if (tautological || duplicate) {
+      return;
+    }
+
+    std::vector<CNFLit>& facts = state.getFacts();
+    if (m_rewritten.size() == 1 &&
+        std::find(facts.begin(), facts.end(), m_rewritten[0]) != facts.end()) {
+      return;
+    }
+
+    DRATCertificate& unsatCert = state.getUnsatCertificate();
+    unsatCert.addATClause(m_rewritten);
+
+    if (m_rewritten.size() == 1) {
+      facts.push_back(m_rewritten[0]);
+      state.getStats().amntFactsDerived += 1;
+      if (factsPropagateToConflict(state)) {
+        state.setDetectedUnsat();
+      }
+      return;
+    }
+
+    Clause* clause = state.getClauseDB().createClause(m_rewritten.size());
+    if (clause == nullptr) {
+      throw std::bad_alloc{};
+    }
+    std::copy(m_rewritten.begin(), m_rewritten.end(), clause->begin());
+    if (original.getFlag(Clause::Flag::REDUNDANT)) {
+      clause->setFlag(Clause::Flag::REDUNDANT);
+      clause->setLBD(original.getLBD<Clause::lbd_type>());
+    }
+    clause->clauseUpdated();
+    state.getOccurrenceMap().insert(*clause);
+    state.getAssignment().registerClause(*clause);
+    state.getStats().amntClausesAdded += 1;
+  }
+
+  /**
+   * Returns true iff a clause consisting of the literals marked in m_marks exists,
+   * and is not redundant unless \p redundant is true.
+   */
+  auto hasDuplicate(SharedOptimizerState& state, bool redundant) -> bool
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+
+    CNFLit minLit = m_rewritten[0];
+    for (CNFLit lit : m_rewritten) {
+      if (occurrences[lit].size() < occurrences[minLit].size()) {
+        minLit = lit;
+      }
+    }
+
+    auto candidates = occurrences[minLit];
+    state.consumeTicks(candidates.size());
+    for (Clause* candidate : candidates) {
+      if (candidate->size() != m_rewritten.size() ||
+          candidate->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) ||
+          (!redundant && candidate->getFlag(Clause::Flag::REDUNDANT))) {
+        continue;
+      }
+      if (std::all_of(candidate->begin(), candidate->end(), [this](CNFLit lit) {
+            return m_marks[lit.getRawValue()] != 0;
+          })) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  auto getRepresentative(CNFLit lit) const noexcept -> CNFLit
+  {
+    return m_representatives[lit.getRawValue()];
+  }
+
+  auto isFactVar(CNFVar var) const noexcept -> bool
+  {
+    return m_isFactVar[var.getRawValue()] != 0;
+  }
+
+  uint64_t m_nextRoundAtConflict;
+  uint64_t m_conflictsBetweenRounds;
+  bool m_preempted = false;
+
+  /** The literal from which the search for components is continued */
+  std::size_t m_nextRoot = 0;
+
+  /** Indexed by variables: 1 iff the variable occurs in a fact */
+  std::vector<char> m_isFactVar;
+
+  /** Indexed by literals: the literal replacing the literal */
+  std::vector<CNFLit> m_representatives;
+  std::vector<CNFVar> m_substitutedVars;
+
+  // The binary implication graph: the successors of a literal `l` are stored in
+  // m_edges, beginning at the index m_edgesBegin[l] and ending before m_edgesBegin[l+1].
+  std::vector<std::size_t> m_edgesBegin;
+  std::vector<CNFLit> m_edges;
+
+  // Temporary data for Tarjan's algorithm, indexed by literals
+  std::vector<uint32_t> m_index;
+  std::vector<uint32_t> m_lowLink;
+  std::vector<char> m_onStack;
+  std::vector<CNFLit> m_componentStack;
+  std::vector<std::pair<CNFLit, std::size_t>> m_callStack;
+  std::vector<CNFLit> m_component;
+
+  // Temporary data for the substitution
+  std::vector<Clause*> m_affectedClauses;
+  std::vector<CNFLit> m_rewritten;
+  std::vector<char> m_marks;
+};
+}
+
+auto createEquivalentLiteralSubstitutor(EquivalentLiteralSubstitutionOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<EquivalentLiteralSubstitutor>(options);
+}
+}
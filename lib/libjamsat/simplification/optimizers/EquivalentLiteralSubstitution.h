@@ -0,0 +1,70 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Scheduling options for equivalent literal substitution
+ */
+struct EquivalentLiteralSubstitutionOptions {
+  /** Amount of conflicts between the first and the second substitution round */
+  uint64_t conflictsBetweenRounds = 10000;
+};
+
+/**
+ * \brief Creates an optimizer substituting equivalent literals.
+ *
+ * The optimizer computes the strongly connected components of the binary implication
+ * graph, obtained from the binary watchers of the optimizer state's assignment, using
+ * Tarjan's algorithm. The literals of each component are equivalent. Each variable
+ * whose literals are equivalent to a literal `r` of another variable is replaced by `r`
+ * in all clauses, and is eliminated: the equivalence is pushed onto the model
+ * reconstruction stack. The representative `r` of a component is the literal with the
+ * smallest variable, preferring frozen variables. Frozen variables are not replaced.
+ *
+ * Clauses becoming tautological or duplicate by the substitution are deleted, and
+ * clauses becoming unit are turned into facts. If a literal is equivalent to its own
+ * negation, the problem is unsatisfiable.
+ *
+ * No substitutions are made if the shared optimizer state has no model reconstruction
+ * stack. A breaking change is reported only if variables have been eliminated.
+ * Substitution rounds are performed before the search and after geometrically growing
+ * amounts of conflicts. The optimizer consumes ticks for graph edges and rewritten
+ * clauses. When preempted, it substitutes the literals of the components found so far,
+ * and resumes the search for components in the next round.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createEquivalentLiteralSubstitutor(EquivalentLiteralSubstitutionOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
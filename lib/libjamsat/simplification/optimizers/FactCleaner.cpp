@@ -28,6 +28,8 @@
 
 #include <boost/range/algorithm_ext/erase.hpp>
 
+#include <algorithm>
+
 #include <libjamsat/solver/Statistics.h>
 #include <libjamsat/utils/BoundedMap.h>
 #include <libjamsat/utils/ControlFlow.h>
@@ -61,20 +63,13 @@ std::vector<CNFLit> withConsequences(Assignment& assignment, std::vector<CNFLit>
   return std::vector<CNFLit>{factsAndConsequences.begin(), factsAndConsequences.end()};
 }
 
-void deleteClause(SharedOptimizerState& optState, Clause& clause)
-{
-  optState.getUnsatCertificate().deleteClause(clause.span());
-  clause.setFlag(Clause::Flag::SCHEDULED_FOR_DELETION);
-  optState.getAssignment().registerClauseModification(clause);
-  optState.getOccurrenceMap().remove(clause);
-  optState.getStats().amntClausesRemoved += 1;
-}
-
 class FactCleaner : public ProblemOptimizer {
 public:
+  auto getName() const -> std::string override { return "FactCleaner"; }
+
   auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
   {
-    return currentStats.m_conflictCount == 0 ||
+    return m_preempted || currentStats.m_conflictCount == 0 ||
            currentStats.m_unitLemmas > m_learntFactsAfterLastCall;
   }
 
@@ -87,10 +82,13 @@ public:
 
     m_learntFactsAfterLastCall = currentStats.m_unitLemmas;
 
-    if (sharedOptimizerState.getFacts().size() == m_factsAfterLastCall) {
+    if (!m_preempted && sharedOptimizerState.getFacts().size() == m_factsAfterLastCall) {
       return sharedOptimizerState;
     }
 
+    bool const resuming = m_preempted;
+    m_preempted = false;
+
     SharedOptimizerState::OccMap& occurrences = sharedOptimizerState.getOccurrenceMap();
     Assignment& assignment = sharedOptimizerState.getAssignment();
     OptimizationStats& stats = sharedOptimizerState.getStats();
@@ -111,16 +109,56 @@ public:
 
     m_factsAfterLastCall = sharedOptimizerState.getFacts().size();
 
+    std::size_t const amntVars = sharedOptimizerState.getMaxVar().getRawValue() + 1;
+    if (!resuming) {
+      // Clauses might have been added since the last run, so all facts need to be revisited
+      std::fill(m_cleanupStage.begin(), m_cleanupStage.end(), CleanupStage::NONE);
+    }
+    if (m_cleanupStage.size() < amntVars) {
+      m_cleanupStage.resize(amntVars, CleanupStage::NONE);
+    }
+
     // Deleting clauses in a separate loop to avoid strengthening
-    // operations later on
+    // operations later on. The loops can be preempted between two facts,
+    // with the cleanup stages of the facts recording where to resume.
+    bool allSatisfiedClausesDeleted = true;
     for (CNFLit fact : facts) {
-      for (Clause* toDelete : occurrences[fact]) {
+      CleanupStage& stage = m_cleanupStage[fact.getVariable().getRawValue()];
+      if (stage != CleanupStage::NONE) {
+        continue;
+      }
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        allSatisfiedClausesDeleted = false;
+        m_preempted = true;
+        break;
+      }
+
+      auto occurrencesOfFact = occurrences[fact];
+      sharedOptimizerState.consumeTicks(occurrencesOfFact.size());
+      for (Clause* toDelete : occurrencesOfFact) {
         deleteClause(sharedOptimizerState, *toDelete);
       }
+      stage = CleanupStage::SATISFIED_CLAUSES_DELETED;
+    }
+
+    if (!allSatisfiedClausesDeleted) {
+      return sharedOptimizerState;
     }
 
     for (CNFLit fact : facts) {
-      for (Clause* toStrengthen : occurrences[~fact]) {
+      CleanupStage& stage = m_cleanupStage[fact.getVariable().getRawValue()];
+      if (stage == CleanupStage::DONE) {
+        continue;
+      }
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_preempted = true;
+        break;
+      }
+
+      auto occurrencesOfNegatedFact = occurrences[~fact];
+      sharedOptimizerState.consumeTicks(occurrencesOfNegatedFact.size());
+      stage = CleanupStage::DONE;
+      for (Clause* toStrengthen : occurrencesOfNegatedFact) {
         if (toStrengthen->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION)) {
           continue;
         }
@@ -149,8 +187,14 @@ public:
   }
 
 private:
+  enum class CleanupStage : uint8_t { NONE, SATISFIED_CLAUSES_DELETED, DONE };
+
   uint64_t m_learntFactsAfterLastCall = 0;
   uint64_t m_factsAfterLastCall = 0;
+  bool m_preempted = false;
+
+  /** Indexed by variables; records how far the clauses containing a fact have been cleaned */
+  std::vector<CleanupStage> m_cleanupStage;
 };
 }
 
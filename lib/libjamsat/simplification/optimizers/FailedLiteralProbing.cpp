@@ -0,0 +1,319 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "FailedLiteralProbing.h"
+
+#include <algorithm>
+#include <array>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace jamsat {
+namespace {
+
+class FailedLiteralProber : public ProblemOptimizer {
+public:
+  explicit FailedLiteralProber(FailedLiteralProbingOptions const& options)
+    : m_options{options}
+    , m_nextRoundAtConflict{0}
+    , m_conflictsBetweenRounds{options.conflictsBetweenRounds}
+  {
+  }
+
+  auto getName() const -> std::string override { return "Probing"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    if (sharedOptimizerState.hasDetectedUnsat()) {
+      return sharedOptimizerState;
+    }
+
+    if (!m_preempted) {
+      // Beginning a new probing round
+      m_probed.clear();
+    }
+    m_preempted = false;
+
+    CNFVar const maxVar = sharedOptimizerState.getMaxVar();
+    m_probed.resize(maxVar.getRawValue() + 1, 0);
+    m_marks.assign(getMaxLit(maxVar).getRawValue() + 1, 0);
+
+    Assignment& assignment = sharedOptimizerState.getAssignment();
+    assignment.undoAll();
+    for (CNFLit fact : sharedOptimizerState.getFacts()) {
+      if (!propagateFact(sharedOptimizerState, fact)) {
+        sharedOptimizerState.setDetectedUnsat();
+        assignment.undoAll();
+        return sharedOptimizerState;
+      }
+    }
+
+    for (CNFLit root : getCandidates(sharedOptimizerState)) {
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_preempted = true;
+        break;
+      }
+
+      m_probed[root.getVariable().getRawValue()] = 1;
+      probe(sharedOptimizerState, root);
+      if (sharedOptimizerState.hasDetectedUnsat()) {
+        break;
+      }
+    }
+    assignment.undoAll();
+
+    if (!m_preempted) {
+      m_nextRoundAtConflict = currentStats.m_conflictCount + m_conflictsBetweenRounds;
+      m_conflictsBetweenRounds *= 2;
+    }
+    return sharedOptimizerState;
+  }
+
+private:
+  /**
+   * Returns the roots of the binary implication graph whose variables have not been
+   * probed in the current round and are not assigned on level 0.
+   */
+  auto getCandidates(SharedOptimizerState& state) -> std::vector<CNFLit>
+  {
+    Assignment const& assignment = state.getAssignment();
+    Assignment::BinariesMap const binaries = assignment.getBinariesMap();
+
+    std::vector<CNFLit> result;
+    for (CNFVar var{0}; var <= state.getMaxVar(); var = nextCNFVar(var)) {
+      if (m_probed[var.getRawValue()] != 0 || isDeterminate(assignment.getAssignment(var))) {
+        continue;
+      }
+
+      for (CNFSign sign : {CNFSign::POSITIVE, CNFSign::NEGATIVE}) {
+        // The binary clauses containing ~lit represent the implications lit -> x:
+        CNFLit const lit{var, sign};
+        if (binaries[lit].empty() && !binaries[~lit].empty()) {
+          result.push_back(lit);
+          break;
+        }
+      }
+    }
+    state.consumeTicks(state.getMaxVar().getRawValue() + 1);
+    return result;
+  }
+
+  void probe(SharedOptimizerState& state, CNFLit root)
+  {
+    if (isDeterminate(state.getAssignment().getAssignment(root))) {
+      // The variable has become a fact during this round
+      return;
+    }
+
+    m_lifted.clear();
+    m_hyperBinaryResolvents.clear();
+    bool const rootFails = probeFails(state, root, ProbeKind::FIRST);
+    bool const negatedRootFails = !rootFails && probeFails(state, ~root, ProbeKind::SECOND);
+
+    for (CNFLit marked : m_firstProbeImplications) {
+      m_marks[marked.getRawValue()] = 0;
+    }
+    m_firstProbeImplications.clear();
+
+    if (rootFails) {
+      addFailedLiteralFact(state, ~root);
+      return;
+    }
+    if (negatedRootFails) {
+      addFailedLiteralFact(state, root);
+      return;
+    }
+
+    // Adding the resolvents before the lifted facts, since clauses must not be
+    // registered with literals assigned on level 0 without being propagated:
+    for (auto const& resolvent : m_hyperBinaryResolvents) {
+      addHyperBinaryResolvent(state, resolvent);
+    }
+
+    for (CNFLit lifted : m_lifted) {
+      addLiftedFact(state, root, lifted);
+      if (state.hasDetectedUnsat()) {
+        return;
+      }
+    }
+  }
+
+  enum class ProbeKind { FIRST, SECOND };
+
+  /**
+   * Propagates \p lit on decision level 1 and backtracks to level 0 afterwards. When
+   * probing the first polarity of a variable, the implied literals are marked;
+   * when probing the second one, the marked implied literals are added to m_lifted.
+   * The hyper-binary resolvents of the implications are added to
+   * m_hyperBinaryResolvents.
+   *
+   * Returns true iff propagating \p lit leads to a conflict.
+   */
+  auto probeFails(SharedOptimizerState& state, CNFLit lit, ProbeKind kind) -> bool
+  {
+    Assignment& assignment = state.getAssignment();
+    assignment.newLevel();
+    bool const conflicting =
+        (assignment.append(lit, Assignment::up_mode::exclude_lemmas) != nullptr);
+
+    auto const implied = assignment.getLevelAssignments(1);
+    state.consumeTicks(implied.size());
+
+    if (!conflicting) {
+      collectHyperBinaryResolvents(assignment, lit);
+      for (CNFLit impliedLit : implied) {
+        if (kind == ProbeKind::FIRST) {
+          m_marks[impliedLit.getRawValue()] = 1;
+          m_firstProbeImplications.push_back(impliedLit);
+        }
+        else if (m_marks[impliedLit.getRawValue()] != 0) {
+          m_lifted.push_back(impliedLit);
+        }
+      }
+    }
+
+    // Probing must not alter the phases saved for the search:
+    m_savedPhases.clear();
+    for (CNFLit impliedLit : implied) {
+      CNFVar const var = impliedLit.getVariable();
+      m_savedPhases.emplace_back(var, assignment.getPhase(var));
+    }
+    assignment.undoToLevel(0);
+    for (auto const& savedPhase : m_savedPhases) {
+      assignment.setPhase(savedPhase.first, savedPhase.second);
+    }
+
+    return conflicting;
+  }
+
+  /**
+   * Adds the resolvents `(~probed x)` to m_hyperBinaryResolvents for literals `x`
+   * assigned on level 1 with non-binary reasons.
+   */
+  void collectHyperBinaryResolvents(Assignment const& assignment, CNFLit probed)
+  {
+    uint32_t amntCollected = 0;
+    for (CNFLit impliedLit : assignment.getLevelAssignments(1)) {
+      if (amntCollected == m_options.maxHyperBinaryResolvents) {
+        return;
+      }
+      Clause const* reason = assignment.getReason(impliedLit.getVariable());
+      if (reason != nullptr && reason->size() > 2) {
+        m_hyperBinaryResolvents.push_back({~probed, impliedLit});
+        ++amntCollected;
+      }
+    }
+  }
+
+  void addHyperBinaryResolvent(SharedOptimizerState& state,
+                               std::array<CNFLit, 2> const& resolvent)
+  {
+    // (~probed x) is a RUP clause, since propagating probed implies x:
+    state.getUnsatCertificate().addATClause(resolvent);
+
+    Clause* clause = state.getClauseDB().createClause(2);
+    if (clause == nullptr) {
+      throw std::bad_alloc{};
+    }
+    std::copy(resolvent.begin(), resolvent.end(), clause->begin());
+    clause->setFlag(Clause::Flag::REDUNDANT);
+    clause->setLBD(Clause::lbd_type{2});
+    clause->clauseUpdated();
+    state.getAssignment().registerClause(*clause);
+    if (state.hasPrecomputedOccurrenceMap()) {
+      state.getOccurrenceMap().insert(*clause);
+    }
+    state.getStats().amntClausesAdded += 1;
+  }
+
+  void addFailedLiteralFact(SharedOptimizerState& state, CNFLit fact)
+  {
+    if (isFalse(state.getAssignment().getAssignment(fact))) {
+      state.setDetectedUnsat();
+      return;
+    }
+
+    std::array<CNFLit, 1> const factClause{fact};
+    state.getUnsatCertificate().addATClause(factClause);
+    addFact(state, fact);
+  }
+
+  /**
+   * Adds \p fact, which is implied both by \p root and by \p ~root.
+   */
+  void addLiftedFact(SharedOptimizerState& state, CNFLit root, CNFLit fact)
+  {
+    TBool const value = state.getAssignment().getAssignment(fact);
+    if (isTrue(value)) {
+      return;
+    }
+    if (isFalse(value)) {
+      state.setDetectedUnsat();
+      return;
+    }
+
+    // (~root fact) is a RUP clause, and with it, so is (fact):
+    DRATCertificate& unsatCert = state.getUnsatCertificate();
+    std::array<CNFLit, 2> const implication{~root, fact};
+    std::array<CNFLit, 1> const factClause{fact};
+    unsatCert.addATClause(implication);
+    unsatCert.addATClause(factClause);
+    unsatCert.deleteClause(implication);
+    addFact(state, fact);
+  }
+
+  FailedLiteralProbingOptions m_options;
+  uint64_t m_nextRoundAtConflict;
+  uint64_t m_conflictsBetweenRounds;
+  bool m_preempted = false;
+
+  /** Indexed by variables: 1 iff the variable has been probed in the current round */
+  std::vector<char> m_probed;
+
+  /** Indexed by literals: 1 iff the literal is implied by the first probe of a variable */
+  std::vector<char> m_marks;
+
+  // Temporary data for the variable currently being probed
+  std::vector<CNFLit> m_firstProbeImplications;
+  std::vector<CNFLit> m_lifted;
+  std::vector<std::array<CNFLit, 2>> m_hyperBinaryResolvents;
+  std::vector<std::pair<CNFVar, TBool>> m_savedPhases;
+};
+}
+
+auto createFailedLiteralProber(FailedLiteralProbingOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<FailedLiteralProber>(options);
+}
+}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for failed literal probing
+ */
+struct FailedLiteralProbingOptions {
+  /** Amount of conflicts between the first and the second probing round */
+  uint64_t conflictsBetweenRounds = 10000;
+
+  /** Maximum amount of hyper-binary resolvents added per probed literal */
+  uint32_t maxHyperBinaryResolvents = 16;
+};
+
+/**
+ * \brief Creates an optimizer performing failed literal probing with lifting.
+ *
+ * The probed literals are the roots of the binary implication graph, i.e. literals
+ * `r` such that no binary clause contains `r`, but some binary clause contains `~r`.
+ * Both `r` and `~r` are assigned on a new decision level of the optimizer state's
+ * assignment and propagated without using redundant non-binary clauses. If the
+ * propagation of a literal leads to a conflict, its negation is added to the facts.
+ * Literals implied by both `r` and `~r` are added to the facts as well.
+ *
+ * When propagating a probed literal `p` implies a literal `x` via a non-binary clause,
+ * the hyper-binary resolvent `(~p x)` is added as a redundant clause, shortcutting the
+ * implication chain from `p` to `x`.
+ *
+ * The optimizer consumes a tick for each assignment made by propagation, and resumes
+ * a probing round where it has been preempted. Probing rounds are performed before
+ * the search and after geometrically growing amounts of conflicts. The saved phases
+ * of the probed variables are restored after probing.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createFailedLiteralProber(FailedLiteralProbingOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
@@ -0,0 +1,303 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "Subsumption.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <libjamsat/utils/RangeUtils.h>
+
+namespace jamsat {
+namespace {
+
+class SubsumptionOptimizer : public ProblemOptimizer {
+public:
+  explicit SubsumptionOptimizer(SubsumptionOptions const& options)
+    : m_options{options}, m_nextRoundAtConflict{0}
+  {
+  }
+
+  auto getName() const -> std::string override { return "Subsumption"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    if (sharedOptimizerState.hasDetectedUnsat()) {
+      return sharedOptimizerState;
+    }
+
+    // When resuming a preempted round, the clauses smaller than the ones
+    // remaining in the previous round have already been processed.
+    Clause::size_type const minClauseSize = m_preempted ? m_resumeSize : 0;
+    m_preempted = false;
+
+    std::size_t const amntLits = getMaxLit(sharedOptimizerState.getMaxVar()).getRawValue() + 1;
+    m_marks.assign(amntLits, 0);
+    m_isFact.assign(amntLits, 0);
+    for (CNFLit fact : sharedOptimizerState.getFacts()) {
+      m_isFact[fact.getRawValue()] = 1;
+    }
+
+    collectClauses(sharedOptimizerState, minClauseSize);
+
+    // m_queue may grow during the loop, since strengthened clauses are processed again
+    for (std::size_t index = 0; index < m_queue.size(); ++index) {
+      Clause* clause = m_queue[index];
+      if (clause->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION)) {
+        continue;
+      }
+
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_preempted = true;
+        m_resumeSize = std::numeric_limits<Clause::size_type>::max();
+        for (auto it = m_queue.begin() + index; it != m_queue.end(); ++it) {
+          m_resumeSize = std::min(m_resumeSize, (*it)->size());
+        }
+        break;
+      }
+
+      subsumeAndStrengthen(sharedOptimizerState, *clause);
+      if (sharedOptimizerState.hasDetectedUnsat()) {
+        break;
+      }
+    }
+    m_queue.clear();
+
+    if (!m_preempted) {
+      m_nextRoundAtConflict = currentStats.m_conflictCount + m_options.conflictsBetweenRounds;
+    }
+    return sharedOptimizerState;
+  }
+
+private:
+  void collectClauses(SharedOptimizerState& state, Clause::size_type minClauseSize)
+  {
+    m_queue.clear();
+    state.getClauseDB().getClauses([this, minClauseSize](std::vector<Clause*> const& clauses) {
+      for (Clause* clause : clauses) {
+        if (!clause->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) &&
+            clause->size() >= minClauseSize && clause->size() <= m_options.maxSubsumingClauseSize) {
+          m_queue.push_back(clause);
+        }
+      }
+    });
+    state.consumeTicks(m_queue.size());
+
+    std::stable_sort(m_queue.begin(), m_queue.end(), [](Clause const* lhs, Clause const* rhs) {
+      return lhs->size() < rhs->size();
+    });
+  }
+
+  /**
+   * Deletes the clauses subsumed by \p subsuming and strengthens the clauses
+   * with which \p subsuming can be resolved to a subsuming resolvent.
+   */
+  void subsumeAndStrengthen(SharedOptimizerState& state, Clause& subsuming)
+  {
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+
+    // Only clauses containing the least-occurring variable need to be checked:
+    CNFLit minLit = subsuming[0];
+    std::size_t minOccurrences = std::numeric_limits<std::size_t>::max();
+    for (CNFLit lit : subsuming) {
+      std::size_t const amntOccurrences = occurrences[lit].size() + occurrences[~lit].size();
+      if (amntOccurrences < minOccurrences) {
+        minOccurrences = amntOccurrences;
+        minLit = lit;
+      }
+    }
+    state.consumeTicks(subsuming.size());
+
+    for (CNFLit lit : subsuming) {
+      m_marks[lit.getRawValue()] = 1;
+    }
+
+    for (CNFLit occLit : {minLit, ~minLit}) {
+      // Copying the occurrence list, since it is modified when clauses are strengthened
+      auto occList = occurrences[occLit];
+      m_candidates.assign(occList.begin(), occList.end());
+      state.consumeTicks(m_candidates.size());
+
+      for (Clause* candidate : m_candidates) {
+        if (candidate == &subsuming ||
+            candidate->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) ||
+            candidate->size() < subsuming.size() || !subsuming.mightShareAllVarsWith(*candidate)) {
+          continue;
+        }
+
+        state.consumeTicks(candidate->size());
+        std::optional<CNFLit> const removableLit = getRemovableLiteral(subsuming, *candidate);
+        if (!removableLit.has_value()) {
+          continue;
+        }
+
+        if (*removableLit == CNFLit::getUndefinedLiteral()) {
+          deleteSubsumed(state, subsuming, *candidate);
+        }
+        else {
+          strengthen(state, *candidate, *removableLit);
+          if (state.hasDetectedUnsat()) {
+            break;
+          }
+        }
+      }
+
+      if (state.hasDetectedUnsat()) {
+        break;
+      }
+    }
+
+    for (CNFLit lit : subsuming) {
+      m_marks[lit.getRawValue()] = 0;
+    }
+  }
+
+  /**
+   * Checks if the clause whose literals are marked in m_marks subsumes \p candidate,
+   * or if their resolvent subsumes \p candidate.
+   *
+   * Returns the undefined literal in the first case, the literal to be removed from
+   * \p candidate in the second case, and nothing otherwise.
+   */
+  auto getRemovableLiteral(Clause const& subsuming, Clause const& candidate) const noexcept
+      -> std::optional<CNFLit>
+  {
+    CNFLit removable = CNFLit::getUndefinedLiteral();
+    std::size_t amntShared = 0;
+    for (CNFLit lit : candidate) {
+      if (m_marks[lit.getRawValue()] != 0) {
+        ++amntShared;
+      }
+      else if (m_marks[(~lit).getRawValue()] != 0) {
+        if (removable != CNFLit::getUndefinedLiteral()) {
+          return std::nullopt;
+        }
+        removable = lit;
+      }
+    }
+
+    std::size_t const amntRequired =
+        subsuming.size() - (removable == CNFLit::getUndefinedLiteral() ? 0 : 1);
+    if (amntShared != amntRequired) {
+      return std::nullopt;
+    }
+    return removable;
+  }
+
+  void deleteSubsumed(SharedOptimizerState& state, Clause& subsuming, Clause& subsumed)
+  {
+    if (subsuming.getFlag(Clause::Flag::REDUNDANT) &&
+        !subsumed.getFlag(Clause::Flag::REDUNDANT)) {
+      // The subsuming clause must not be deleted by clause database reductions
+      // any longer. The solver needs to be notified to update its lemma list.
+      subsuming.clearFlag(Clause::Flag::REDUNDANT);
+      state.setBreakingChange();
+    }
+    deleteClause(state, subsumed);
+  }
+
+  void strengthen(SharedOptimizerState& state, Clause& clause, CNFLit toRemove)
+  {
+    DRATCertificate& unsatCert = state.getUnsatCertificate();
+
+    if (clause.size() == 2) {
+      CNFLit const fact = (clause[0] == toRemove) ? clause[1] : clause[0];
+      std::array<CNFLit, 1> const factClause{fact};
+      unsatCert.addATClause(factClause);
+      deleteClause(state, clause);
+      addFact(state, fact);
+      return;
+    }
+
+    // Registering the modification first, since the watched literals may be moved:
+    state.getAssignment().registerClauseModification(clause);
+    swapWithLastElement(clause, toRemove);
+    unsatCert.addATClause(clause.span().subspan(0, clause.size() - 1));
+    unsatCert.deleteClause(clause.span());
+    clause.resize(clause.size() - 1);
+
+    clause.setFlag(Clause::Flag::MODIFIED);
+    clause.clauseUpdated();
+    state.getOccurrenceMap().setModified(
+        clause, std::array<CNFLit, 0>{}, std::array<CNFLit, 1>{toRemove});
+    state.getStats().amntLitsRemoved += 1;
+
+    // The strengthened clause might subsume further clauses:
+    if (clause.size() <= m_options.maxSubsumingClauseSize) {
+      m_queue.push_back(&clause);
+    }
+  }
+
+  void addFact(SharedOptimizerState& state, CNFLit fact)
+  {
+    if (m_isFact[(~fact).getRawValue()] != 0) {
+      state.setDetectedUnsat();
+      return;
+    }
+    if (m_isFact[fact.getRawValue()] != 0) {
+      return;
+    }
+
+    state.getFacts().push_back(fact);
+    m_isFact[fact.getRawValue()] = 1;
+    state.getStats().amntFactsDerived += 1;
+    if (factsPropagateToConflict(state)) {
+      state.setDetectedUnsat();
+    }
+  }
+
+  SubsumptionOptions m_options;
+  uint64_t m_nextRoundAtConflict;
+  bool m_preempted = false;
+
+  /** The size of the smallest clause left unprocessed when the last round was preempted */
+  Clause::size_type m_resumeSize = 0;
+
+  // Temporary data, indexed by literals
+  std::vector<char> m_marks;
+  std::vector<char> m_isFact;
+
+  // Temporary data for the current round
+  std::vector<Clause*> m_queue;
+  std::vector<Clause*> m_candidates;
+};
+}
+
+auto createSubsumptionOptimizer(SubsumptionOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<SubsumptionOptimizer>(options);
+}
+}
@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for subsumption and self-subsuming resolution
+ */
+struct SubsumptionOptions {
+  /** Clauses larger than this are not used to subsume or strengthen other clauses */
+  uint32_t maxSubsumingClauseSize = 32;
+
+  /** Amount of conflicts between two subsumption rounds */
+  uint64_t conflictsBetweenRounds = 5000;
+};
+
+/**
+ * \brief Creates an optimizer performing backward subsumption and self-subsuming
+ *   resolution.
+ *
+ * The clauses are processed in ascending order of their size. For each clause `C`,
+ * the clauses containing the least-occurring variable of `C` are checked for being
+ * subsumed by `C`, with the clause signatures serving as a prefilter. Subsumed clauses
+ * are deleted, and clauses `D` containing all literals of `C` except for a literal
+ * `l` of which `D` contains the negation are strengthened by removing `~l`.
+ * Strengthened clauses are processed again afterwards.
+ *
+ * Both irredundant and redundant clauses are used for subsumption and strengthening.
+ * When a redundant clause subsumes an irredundant clause, the redundant clause becomes
+ * irredundant; in this case, the optimizer reports a breaking change so that the
+ * solver can update its lemma bookkeeping.
+ *
+ * The optimizer consumes ticks for occurrence list visits and clause comparisons, and
+ * resumes a round where it has been preempted. Rounds are performed before the search
+ * and then after every `conflictsBetweenRounds` conflicts.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createSubsumptionOptimizer(SubsumptionOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
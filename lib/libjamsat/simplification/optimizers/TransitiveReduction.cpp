@@ -0,0 +1,268 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "TransitiveReduction.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace jamsat {
+namespace {
+
+struct BinaryClause {
+  CNFLit first;
+  CNFLit second;
+  Clause* clause;
+
+  auto isRedundant() const noexcept -> bool { return clause->getFlag(Clause::Flag::REDUNDANT); }
+
+  auto isDeleted() const noexcept -> bool
+  {
+    return clause->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION);
+  }
+};
+
+class TransitiveReducer : public ProblemOptimizer {
+public:
+  explicit TransitiveReducer(TransitiveReductionOptions const& options)
+    : m_nextRoundAtConflict{0}, m_conflictsBetweenRounds{options.conflictsBetweenRounds}
+  {
+  }
+
+  auto getName() const -> std::string override { return "TransitiveReduction"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    if (sharedOptimizerState.hasDetectedUnsat()) {
+      return sharedOptimizerState;
+    }
+
+    if (!m_preempted) {
+      // Beginning a new reduction round
+      m_nextLit = CNFLit{CNFVar{0}, CNFSign::NEGATIVE};
+    }
+    m_preempted = false;
+
+    collectBinaries(sharedOptimizerState);
+    removeDuplicates(sharedOptimizerState);
+    buildImplicationGraph(sharedOptimizerState);
+
+    m_visited.assign(m_edgesBegin.size() - 1, 0);
+    m_stamp = 0;
+    for (std::size_t index = 0; index < m_binaries.size(); ++index) {
+      BinaryClause const& binary = m_binaries[index];
+      if (binary.first < m_nextLit) {
+        continue;
+      }
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_nextLit = binary.first;
+        m_preempted = true;
+        break;
+      }
+      if (isTransitivelyRedundant(sharedOptimizerState, index)) {
+        deleteClause(sharedOptimizerState, *binary.clause);
+      }
+    }
+
+    if (!m_preempted) {
+      m_nextRoundAtConflict = currentStats.m_conflictCount + m_conflictsBetweenRounds;
+      m_conflictsBetweenRounds *= 2;
+    }
+    return sharedOptimizerState;
+  }
+
+private:
+  /**
+   * Stores the non-deleted binary clauses not containing variables of facts in
+   * m_binaries, ordered by their literals. Of clauses with the same literals,
+   * irredundant clauses precede redundant ones.
+   */
+  void collectBinaries(SharedOptimizerState& state)
+  {
+    CNFVar const maxVar = state.getMaxVar();
+    m_isFactVar.assign(maxVar.getRawValue() + 1, 0);
+    for (CNFLit fact : state.getFacts()) {
+      m_isFactVar[fact.getVariable().getRawValue()] = 1;
+    }
+
+    m_binaries.clear();
+    state.getClauseDB().getClauses([this, &state](std::vector<Clause*> const& clauses) {
+      state.consumeTicks(clauses.size());
+      for (Clause* clause : clauses) {
+        if (clause->size() != 2 || clause->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) ||
+            isFactVar((*clause)[0].getVariable()) || isFactVar((*clause)[1].getVariable())) {
+          continue;
+        }
+        CNFLit const lit0 = (*clause)[0];
+        CNFLit const lit1 = (*clause)[1];
+        m_binaries.push_back(BinaryClause{std::min(lit0, lit1), std::max(lit0, lit1), clause});
+      }
+    });
+
+    std::sort(m_binaries.begin(),
+              m_binaries.end(),
+              [](BinaryClause const& lhs, BinaryClause const& rhs) {
+                return std::make_tuple(lhs.first, lhs.second, lhs.isRedundant()) <
+                       std::make_tuple(rhs.first, rhs.second, rhs.isRedundant());
+              });
+  }
+
+  void removeDuplicates(SharedOptimizerState& state)
+  {
+    auto const isDuplicate = [](BinaryClause const& lhs, BinaryClause const& rhs) {
+      return lhs.first == rhs.first && lhs.second == rhs.second;
+    };
+
+    for (std::size_t index = 1; index < m_binaries.size(); ++index) {
+      if (isDuplicate(m_binaries[index - 1], m_binaries[index])) {
+        deleteClause(state, *m_binaries[index].clause);
+      }
+    }
+    m_binaries.erase(std::unique(m_binaries.begin(), m_binaries.end(), isDuplicate),
+                     m_binaries.end());
+  }
+
+  /**
+   * Stores the edges `~a -> b` and `~b -> a` for each binary clause `(a b)` in
+   * m_binaries, together with the index of the clause.
+   */
+  void buildImplicationGraph(SharedOptimizerState& state)
+  {
+    std::size_t const amntLits = getMaxLit(state.getMaxVar()).getRawValue() + 1;
+    m_edgesBegin.assign(amntLits + 1, 0);
+    for (BinaryClause const& binary : m_binaries) {
+      ++m_edgesBegin[(~binary.first).getRawValue() + 1];
+      ++m_edgesBegin[(~binary.second).getRawValue() + 1];
+    }
+    for (std::size_t i = 1; i < m_edgesBegin.size(); ++i) {
+      m_edgesBegin[i] += m_edgesBegin[i - 1];
+    }
+
+    m_edges.resize(2 * m_binaries.size());
+    std::vector<std::size_t> nextEdge{m_edgesBegin.begin(), m_edgesBegin.end() - 1};
+    for (std::size_t index = 0; index < m_binaries.size(); ++index) {
+      BinaryClause const& binary = m_binaries[index];
+      m_edges[nextEdge[(~binary.first).getRawValue()]++] = Edge{binary.second, index};
+      m_edges[nextEdge[(~binary.second).getRawValue()]++] = Edge{binary.first, index};
+    }
+    state.consumeTicks(m_edges.size() + amntLits);
+  }
+
+  /**
+   * Returns true iff the implication graph contains a path from `~a` to `b` for the
+   * clause `(a b)` at \p index in m_binaries, not using that clause nor deleted
+   * clauses. If the clause is irredundant, the path may only use irredundant clauses.
+   */
+  auto isTransitivelyRedundant(SharedOptimizerState& state, std::size_t index) -> bool
+  {
+    BinaryClause const& binary = m_binaries[index];
+    if (binary.isDeleted()) {
+      return false;
+    }
+    bool const irredundantOnly = !binary.isRedundant();
+    CNFLit const source = ~binary.first;
+    CNFLit const target = binary.second;
+
+    ++m_stamp;
+    m_queue.clear();
+    m_queue.push_back(source);
+    m_visited[source.getRawValue()] = m_stamp;
+
+    uint64_t amntEdgesVisited = 0;
+    bool found = false;
+    for (std::size_t next = 0; next < m_queue.size() && !found; ++next) {
+      CNFLit const lit = m_queue[next];
+      std::size_t const end = m_edgesBegin[lit.getRawValue() + 1];
+      for (std::size_t edge = m_edgesBegin[lit.getRawValue()]; edge < end; ++edge) {
+        ++amntEdgesVisited;
+        Edge const& current = m_edges[edge];
+        BinaryClause const& via = m_binaries[current.binaryIndex];
+        if (current.binaryIndex == index || via.isDeleted() ||
+            (irredundantOnly && via.isRedundant())) {
+          continue;
+        }
+        if (current.target == target) {
+          found = true;
+          break;
+        }
+        if (m_visited[current.target.getRawValue()] != m_stamp) {
+          m_visited[current.target.getRawValue()] = m_stamp;
+          m_queue.push_back(current.target);
+        }
+      }
+    }
+
+    state.consumeTicks(amntEdgesVisited + 1);
+    return found;
+  }
+
+  auto isFactVar(CNFVar var) const noexcept -> bool
+  {
+    return m_isFactVar[var.getRawValue()] != 0;
+  }
+
+  struct Edge {
+    CNFLit target;
+    std::size_t binaryIndex;
+  };
+
+  uint64_t m_nextRoundAtConflict;
+  uint64_t m_conflictsBetweenRounds;
+  bool m_preempted = false;
+
+  /** The smallest literal of the first clause checked when resuming a preempted round */
+  CNFLit m_nextLit{CNFVar{0}, CNFSign::NEGATIVE};
+
+  /** Indexed by variables: 1 iff the variable occurs in a fact */
+  std::vector<char> m_isFactVar;
+
+  std::vector<BinaryClause> m_binaries;
+
+  // The binary implication graph: the outgoing edges of a literal `l` are stored in
+  // m_edges, beginning at the index m_edgesBegin[l] and ending before m_edgesBegin[l+1].
+  std::vector<std::size_t> m_edgesBegin;
+  std::vector<Edge> m_edges;
+
+  // Temporary data for the breadth-first search, m_visited being indexed by literals
+  std::vector<uint32_t> m_visited;
+  uint32_t m_stamp = 0;
+  std::vector<CNFLit> m_queue;
+};
+}
+
+auto createTransitiveReducer(TransitiveReductionOptions const& options)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<TransitiveReducer>(options);
+}
+}
@@ -0,0 +1,63 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for the transitive reduction of binary clauses
+ */
+struct TransitiveReductionOptions {
+  /** Amount of conflicts between the first and the second reduction round */
+  uint64_t conflictsBetweenRounds = 10000;
+};
+
+/**
+ * \brief Creates an optimizer removing duplicate and transitively redundant binary
+ *   clauses.
+ *
+ * Of a set of binary clauses consisting of the same literals, only one clause is
+ * kept, preferring irredundant clauses. A binary clause `(a b)` is transitively
+ * redundant if the binary implication graph contains a path from `~a` to `b` not
+ * using the clause itself. Irredundant clauses are only removed via paths consisting
+ * of irredundant clauses. Binary clauses containing variables of facts are not
+ * considered.
+ *
+ * The optimizer consumes ticks for the visited implication graph edges, and resumes
+ * a reduction round where it has been preempted. Reduction rounds are performed
+ * before the search and after geometrically growing amounts of conflicts.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createTransitiveReducer(TransitiveReductionOptions const& options = {})
+    -> std::unique_ptr<ProblemOptimizer>;
+}
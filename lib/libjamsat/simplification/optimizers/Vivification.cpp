@@ -0,0 +1,257 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "Vivification.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace jamsat {
+namespace {
+
+class Vivifier : public ProblemOptimizer {
+public:
+  explicit Vivifier(VivificationOptions const& options)
+    : m_options{options}, m_nextRoundAtConflict{options.conflictsBetweenRounds}
+  {
+  }
+
+  auto getName() const -> std::string override { return "Vivification"; }
+
+  auto wantsExecution(StatisticsEra const& currentStats) const noexcept -> bool override
+  {
+    return m_preempted || currentStats.m_conflictCount >= m_nextRoundAtConflict;
+  }
+
+  auto optimize(SharedOptimizerState sharedOptimizerState, StatisticsEra const& currentStats)
+      -> SharedOptimizerState override
+  {
+    if (sharedOptimizerState.hasDetectedUnsat()) {
+      return sharedOptimizerState;
+    }
+
+    bool const resuming = m_preempted;
+    m_preempted = false;
+
+    Assignment& assignment = sharedOptimizerState.getAssignment();
+    assignment.undoAll();
+    for (CNFLit fact : sharedOptimizerState.getFacts()) {
+      if (!propagateFact(sharedOptimizerState, fact)) {
+        sharedOptimizerState.setDetectedUnsat();
+        assignment.undoAll();
+        return sharedOptimizerState;
+      }
+    }
+
+    collectCandidates(sharedOptimizerState, resuming);
+
+    for (Clause* candidate : m_candidates) {
+      if (sharedOptimizerState.isTickBudgetExhausted()) {
+        m_preempted = true;
+        break;
+      }
+
+      candidate->setFlag(Clause::Flag::VIVIFIED);
+      if (!candidate->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION)) {
+        vivify(sharedOptimizerState, *candidate);
+        if (sharedOptimizerState.hasDetectedUnsat()) {
+          break;
+        }
+      }
+    }
+    m_candidates.clear();
+    assignment.undoAll();
+
+    if (!m_preempted) {
+      m_nextRoundAtConflict = currentStats.m_conflictCount + m_options.conflictsBetweenRounds;
+    }
+    return sharedOptimizerState;
+  }
+
+private:
+  /**
+   * Collects the clauses to be vivified, with the tier-2 lemmas preceding the irredundant
+   * clauses. When beginning a new round, the VIVIFIED flags of all clauses are cleared;
+   * otherwise, only clauses without the VIVIFIED flag are collected.
+   */
+  void collectCandidates(SharedOptimizerState& state, bool resuming)
+  {
+    m_candidates.clear();
+    std::size_t amntRedundant = 0;
+    state.getClauseDB().getClauses(
+        [this, resuming, &amntRedundant](std::vector<Clause*> const& clauses) {
+          for (Clause* clause : clauses) {
+            if (!resuming) {
+              clause->clearFlag(Clause::Flag::VIVIFIED);
+            }
+            if (!isCandidate(*clause)) {
+              continue;
+            }
+
+            m_candidates.push_back(clause);
+            if (clause->getFlag(Clause::Flag::REDUNDANT)) {
+              // Moving the redundant clauses to the front:
+              std::swap(m_candidates[amntRedundant], m_candidates.back());
+              ++amntRedundant;
+            }
+          }
+        });
+    state.consumeTicks(m_candidates.size());
+  }
+
+  auto isCandidate(Clause const& clause) const noexcept -> bool
+  {
+    if (clause.getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) ||
+        clause.getFlag(Clause::Flag::VIVIFIED) || clause.size() <= 2) {
+      return false;
+    }
+    return !clause.getFlag(Clause::Flag::REDUNDANT) ||
+           clause.getLBD<Clause::lbd_type>() <= m_options.tier2LBDLimit;
+  }
+
+  void vivify(SharedOptimizerState& state, Clause& clause)
+  {
+    Assignment& assignment = state.getAssignment();
+    if (std::any_of(clause.begin(), clause.end(), [&assignment](CNFLit lit) {
+          return isDeterminate(assignment.getAssignment(lit));
+        })) {
+      // Clauses with literals assigned on level 0 are handled by the fact cleaner
+      return;
+    }
+
+    // Assigning the negations of frequently occurring literals first, since they are
+    // more likely to imply other literals of the clause:
+    SharedOptimizerState::OccMap& occurrences = state.getOccurrenceMap();
+    m_literals.assign(clause.begin(), clause.end());
+    std::stable_sort(m_literals.begin(), m_literals.end(), [&occurrences](CNFLit lhs, CNFLit rhs) {
+      return occurrences[lhs].size() > occurrences[rhs].size();
+    });
+    state.consumeTicks(clause.size());
+
+    m_vivified.clear();
+    assignment.newLevel();
+    for (CNFLit lit : m_literals) {
+      TBool const value = assignment.getAssignment(lit);
+      if (isTrue(value)) {
+        // ~l1 ... ~li imply lit
+        m_vivified.push_back(lit);
+        break;
+      }
+      if (isFalse(value)) {
+        // ~l1 ... ~li imply ~lit
+        continue;
+      }
+
+      m_vivified.push_back(lit);
+      if (assignment.append(~lit) != nullptr) {
+        break;
+      }
+    }
+    undoVivificationLevel(state);
+
+    if (m_vivified.size() < clause.size()) {
+      shorten(state, clause);
+    }
+  }
+
+  void undoVivificationLevel(SharedOptimizerState& state)
+  {
+    Assignment& assignment = state.getAssignment();
+    auto const assigned = assignment.getLevelAssignments(1);
+    state.consumeTicks(assigned.size());
+
+    // Vivification must not alter the phases saved for the search. The target and
+    // best phases are not tracked while optimizers hold the assignment, see
+    // SharedOptimizerState.
+    m_savedPhases.clear();
+    for (CNFLit lit : assigned) {
+      CNFVar const var = lit.getVariable();
+      m_savedPhases.emplace_back(var, assignment.getPhase(var));
+    }
+    assignment.undoToLevel(0);
+    for (auto const& savedPhase : m_savedPhases) {
+      assignment.setPhase(savedPhase.first, savedPhase.second);
+    }
+  }
+
+  /**
+   * Replaces the literals of \p clause by the literals in m_vivified.
+   */
+  void shorten(SharedOptimizerState& state, Clause& clause)
+  {
+    DRATCertificate& unsatCert = state.getUnsatCertificate();
+    unsatCert.addATClause(m_vivified);
+    state.getStats().amntLitsRemoved += clause.size() - m_vivified.size();
+
+    if (m_vivified.size() == 1) {
+      deleteClause(state, clause);
+      addFact(state, m_vivified[0]);
+      return;
+    }
+
+    // Registering the modification first, since the watched literals may be moved:
+    state.getAssignment().registerClauseModification(clause);
+    unsatCert.deleteClause(clause.span());
+
+    m_removed.clear();
+    std::copy_if(clause.begin(),
+                 clause.end(),
+                 std::back_inserter(m_removed),
+                 [this](CNFLit lit) {
+                   return std::find(m_vivified.begin(), m_vivified.end(), lit) ==
+                          m_vivified.end();
+                 });
+    std::copy(m_vivified.begin(), m_vivified.end(), clause.begin());
+    clause.resize(m_vivified.size());
+
+    clause.setFlag(Clause::Flag::MODIFIED);
+    clause.clauseUpdated();
+    state.getOccurrenceMap().setModified(clause, std::array<CNFLit, 0>{}, m_removed);
+  }
+
+  VivificationOptions m_options;
+  uint64_t m_nextRoundAtConflict;
+  bool m_preempted = false;
+
+  // Temporary data for the current round
+  std::vector<Clause*> m_candidates;
+
+  // Temporary data for the clause currently being vivified
+  std::vector<CNFLit> m_literals;
+  std::vector<CNFLit> m_vivified;
+  std::vector<CNFLit> m_removed;
+  std::vector<std::pair<CNFVar, TBool>> m_savedPhases;
+};
+}
+
+auto createVivifier(VivificationOptions const& options) -> std::unique_ptr<ProblemOptimizer>
+{
+  return std::make_unique<Vivifier>(options);
+}
+}
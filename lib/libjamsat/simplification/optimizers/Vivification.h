@@ -0,0 +1,73 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+namespace jamsat {
+
+/**
+ * \brief Limits for clause vivification
+ */
+struct VivificationOptions {
+  /** Redundant clauses with LBD values larger than this are not vivified */
+  uint32_t tier2LBDLimit = 6;
+
+  /** Amount of conflicts between two vivification rounds */
+  uint64_t conflictsBetweenRounds = 10000;
+};
+
+/**
+ * \brief Creates an optimizer performing clause vivification.
+ *
+ * For a clause `C = (l1 ... ln)`, with the literals ordered by descending amounts of
+ * occurrences, the literals `~l1`, `~l2`, ... are assigned one by one on a new decision
+ * level of the optimizer state's assignment, and propagated after each assignment. `C` is shortened to
+ *  - `(l1 ... li)` if propagating `~li` leads to a conflict,
+ *  - `(l1 ... li lj)` if `lj` (with `j > i`) is implied by `~l1 ... ~li`,
+ * and the literals of `C` falsified by propagation are removed from `C`. The shortened
+ * clause is a RUP clause, and replaces `C` in the clause database. Clauses shortened to
+ * a single literal are removed, adding the literal to the facts.
+ *
+ * Redundant clauses with LBD values not exceeding `tier2LBDLimit` are vivified first,
+ * followed by the irredundant clauses. Binary clauses and clauses containing literals
+ * assigned on decision level 0 are not vivified.
+ *
+ * The optimizer consumes ticks for each assignment made by propagation, and resumes
+ * a vivification round where it has been preempted, using the `VIVIFIED` clause flag
+ * to mark the clauses already processed in the current round. Since vivification is
+ * mostly beneficial for lemmas, rounds are performed after every `conflictsBetweenRounds`
+ * conflicts, but not before the search. The saved phases of the variables assigned
+ * during vivification are restored afterwards.
+ *
+ * \ingroup JamSAT_Simplification
+ */
+auto createVivifier(VivificationOptions const& options = {}) -> std::unique_ptr<ProblemOptimizer>;
+}
@@ -1,5 +1,7 @@
 #include <libjamsat/solver/Assignment.h>
 
+#include <algorithm>
+
 #include <libjamsat/utils/Assert.h>
 #include <libjamsat/utils/Casts.h>
 #include <libjamsat/utils/Logger.h>
@@ -17,6 +19,14 @@ Assignment::Assignment(CNFVar max_var)
   , m_levelLimits{}
   , m_assignments{max_var, TBools::INDETERMINATE}
   , m_phases{max_var, TBools::FALSE}
+  , m_targetPhases{max_var, TBools::FALSE}
+  , m_bestPhases{max_var, TBools::FALSE}
+  , m_amntConflictFreeAssignments{0}
+  , m_amntTargetPhaseAssignments{0}
+  , m_amntBestPhaseAssignments{0}
+  , m_amntTrailAssignmentsInTargetPhases{0}
+  , m_amntTrailAssignmentsInBestPhases{0}
+  , m_tracksTargetAndBestPhases{true}
   , m_currentLevel{0}
   , m_reasonsAndALs{max_var}
   , m_binaryWatchers{max_var}
@@ -45,6 +55,8 @@ void Assignment::increaseMaxVar(CNFVar var)
   m_trail.increaseMaxSizeBy(amnt_new_vars);
   m_assignments.increaseSizeTo(var);
   m_phases.increaseSizeTo(var);
+  m_targetPhases.increaseSizeTo(var);
+  m_bestPhases.increaseSizeTo(var);
   m_reasonsAndALs.increaseSizeTo(var);
   m_binaryWatchers.increaseMaxVarTo(var);
   m_watchers.increaseMaxVarTo(var);
@@ -56,6 +68,8 @@ void Assignment::increaseMaxVar(CNFVar var)
     m_reasonsAndALs[i].m_level = 0;
     m_reasonsAndALs[i].m_reason = nullptr;
     m_phases[i] = TBools::FALSE;
+    m_targetPhases[i] = TBools::FALSE;
+    m_bestPhases[i] = TBools::FALSE;
   }
 }
 
@@ -75,7 +89,9 @@ void Assignment::assign(CNFLit literal, Clause* reason)
 auto Assignment::append(CNFLit literal, up_mode mode) -> Clause*
 {
   assign(literal, nullptr);
-  return propagateUntilFixpoint(literal, mode);
+  Clause* conflictingClause = propagateUntilFixpoint(literal, mode);
+  registerPropagationResult(conflictingClause);
+  return conflictingClause;
 }
 
 void Assignment::registerClause(Clause& clause)
@@ -108,10 +124,25 @@ auto Assignment::registerLemma(Clause& clause) -> Clause*
   JAM_LOG_ASSIGN(info, "Propagating first literal of registered clause.");
   CNFLit const asserting_lit = clause[0];
   assign(asserting_lit, &clause);
-  return propagateUntilFixpoint(asserting_lit, up_mode::include_lemmas);
+  Clause* conflictingClause = propagateUntilFixpoint(asserting_lit, up_mode::include_lemmas);
+  registerPropagationResult(conflictingClause);
+  return conflictingClause;
 }
 
 
+auto Assignment::appendImplied(Clause& reason) -> Clause*
+{
+  JAM_EXPENSIVE_ASSERT(std::all_of(reason.begin() + 1,
+                                   reason.end(),
+                                   [this](CNFLit l) { return isFalse(getAssignment(l)); }),
+                       "Added a reason which does not actually force its first literal");
+  CNFLit const implied = reason[0];
+  assign(implied, &reason);
+  Clause* conflictingClause = propagateUntilFixpoint(implied, up_mode::include_lemmas);
+  registerPropagationResult(conflictingClause);
+  return conflictingClause;
+}
+
 void Assignment::registerClauseModification(Clause& clause) noexcept
 {
   JAM_LOG_ASSIGN(info,
@@ -138,8 +169,69 @@ void Assignment::newLevel() noexcept
                                                << " assignments in total");
 }
 
+void Assignment::registerPropagationResult(Clause const* conflictingClause) noexcept
+{
+  if (conflictingClause == nullptr) {
+    m_amntConflictFreeAssignments = m_trail.size();
+  }
+  else {
+    m_amntConflictFreeAssignments = std::min<size_type>(m_amntConflictFreeAssignments,
+                                                        m_levelLimits.back());
+  }
+}
+
+void Assignment::updateTargetAndBestPhases() noexcept
+{
+  if (!m_tracksTargetAndBestPhases) {
+    return;
+  }
+
+  auto const amntConflictFree = std::min(m_amntConflictFreeAssignments, m_trail.size());
+
+  // The assignments on the trail below m_amntTrailAssignmentsIn{Target,Best}Phases
+  // have already been saved:
+  if (amntConflictFree > m_amntTargetPhaseAssignments) {
+    auto const begin = m_trail.begin() + m_amntTrailAssignmentsInTargetPhases;
+    for (auto i = begin; i != m_trail.begin() + amntConflictFree; ++i) {
+      m_targetPhases[i->getVariable()] = m_assignments[i->getVariable()];
+    }
+    m_amntTargetPhaseAssignments = amntConflictFree;
+    m_amntTrailAssignmentsInTargetPhases = amntConflictFree;
+  }
+
+  if (amntConflictFree > m_amntBestPhaseAssignments) {
+    auto const begin = m_trail.begin() + m_amntTrailAssignmentsInBestPhases;
+    for (auto i = begin; i != m_trail.begin() + amntConflictFree; ++i) {
+      m_bestPhases[i->getVariable()] = m_assignments[i->getVariable()];
+    }
+    m_amntBestPhaseAssignments = amntConflictFree;
+    m_amntTrailAssignmentsInBestPhases = amntConflictFree;
+  }
+}
+
+void Assignment::resetTargetPhases() noexcept
+{
+  for (CNFVar::RawVariable i = 0; i < m_phases.size(); ++i) {
+    m_targetPhases[CNFVar{i}] = m_phases[CNFVar{i}];
+  }
+  m_amntTargetPhaseAssignments = 0;
+  m_amntTrailAssignmentsInTargetPhases = 0;
+}
+
+void Assignment::resetBestPhases() noexcept
+{
+  m_amntBestPhaseAssignments = 0;
+  m_amntTrailAssignmentsInBestPhases = 0;
+}
+
+void Assignment::setTargetAndBestPhaseTracking(bool enabled) noexcept
+{
+  m_tracksTargetAndBestPhases = enabled;
+}
+
 void Assignment::undoToLevel(Level level) noexcept
 {
+  updateTargetAndBestPhases();
   for (auto i = m_trail.begin() + m_levelLimits[level + 1]; i != m_trail.end(); ++i) {
     m_phases[i->getVariable()] = m_assignments[(*i).getVariable()];
     m_assignments[i->getVariable()] = TBools::INDETERMINATE;
@@ -148,6 +240,10 @@ void Assignment::undoToLevel(Level level) noexcept
   m_trail.pop_to(m_levelLimits[level + 1]);
   m_levelLimits.resize(level + 1);
   m_currentLevel = level;
+  m_amntConflictFreeAssignments = std::min(m_amntConflictFreeAssignments, m_trail.size());
+  m_amntTrailAssignmentsInTargetPhases =
+      std::min(m_amntTrailAssignmentsInTargetPhases, m_trail.size());
+  m_amntTrailAssignmentsInBestPhases = std::min(m_amntTrailAssignmentsInBestPhases, m_trail.size());
 
   JAM_LOG_ASSIGN(info,
                  "Entering assignment level: " << m_currentLevel << ", currently " << m_trail.size()
@@ -158,6 +254,7 @@ void Assignment::undoAll() noexcept
 {
   // TODO: remove code duplication
   // TODO: testing
+  updateTargetAndBestPhases();
   for (auto i = m_trail.begin(); i != m_trail.end(); ++i) {
     m_phases[i->getVariable()] = m_assignments[(*i).getVariable()];
     m_assignments[i->getVariable()] = TBools::INDETERMINATE;
@@ -166,6 +263,9 @@ void Assignment::undoAll() noexcept
   m_trail.pop_to(0);
   m_levelLimits.resize(1);
   m_currentLevel = 0;
+  m_amntConflictFreeAssignments = 0;
+  m_amntTrailAssignmentsInTargetPhases = 0;
+  m_amntTrailAssignmentsInBestPhases = 0;
 
   JAM_LOG_ASSIGN(info, "Entering assignment level: 0, currently 0 assignments in total");
 }
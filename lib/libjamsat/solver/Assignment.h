@@ -33,6 +33,7 @@
 #include <libjamsat/clausedb/Clause.h>
 #include <libjamsat/cnfproblem/CNFLiteral.h>
 #include <libjamsat/solver/Watcher.h>
+#include <libjamsat/utils/Assert.h>
 #include <libjamsat/utils/BoundedMap.h>
 #include <libjamsat/utils/BoundedStack.h>
 #include <libjamsat/utils/Truth.h>
@@ -114,6 +115,55 @@ public:
    */
   auto getPhase(CNFVar var) const noexcept -> TBool;
 
+  /**
+   * \brief Sets the phase of the given variable, e.g. for rephasing.
+   *
+   * \param var      A variable.
+   * \param phase    The new phase of \p var. Must not be TBools::INDETERMINATE.
+   */
+  void setPhase(CNFVar var, TBool phase) noexcept;
+
+  /**
+   * \brief Returns the target phase of the given variable.
+   *
+   * The target phases are the truth values of the largest conflict-free assignment
+   * observed since resetTargetPhases() has last been called. Variables not occurring
+   * in that assignment keep their previous target phase.
+   */
+  auto getTargetPhase(CNFVar var) const noexcept -> TBool;
+
+  /**
+   * \brief Returns the best phase of the given variable.
+   *
+   * The best phases are the truth values of the largest conflict-free assignment
+   * observed since resetBestPhases() has last been called. Variables not occurring
+   * in that assignment keep their previous best phase.
+   */
+  auto getBestPhase(CNFVar var) const noexcept -> TBool;
+
+  /**
+   * \brief Sets the target phases to the current phases and begins searching for
+   *   a new largest conflict-free assignment.
+   */
+  void resetTargetPhases() noexcept;
+
+  /**
+   * \brief Begins searching for a new largest conflict-free assignment for the best
+   *   phases, keeping the current best phases until a conflict-free assignment has
+   *   been found.
+   */
+  void resetBestPhases() noexcept;
+
+  /**
+   * \brief Enables or disables updating the target and best phases when
+   *   assignments are undone.
+   *
+   * Tracking is enabled by default. It should be disabled while the assignment
+   * is used for propagations not belonging to the search, e.g. by problem
+   * optimizers.
+   */
+  void setTargetAndBestPhaseTracking(bool enabled) noexcept;
+
   /**
    * \brief Returns `true` iff all variables have an assignment.
    */
@@ -161,6 +211,25 @@ public:
    */
   auto registerLemma(Clause& clause) -> Clause*;
 
+  /**
+   * \brief Adds the first literal of the given clause to the assignment, with the clause
+   *   being the reason of the assignment, and computes its consequences.
+   *
+   * Unlike registerLemma(), this method does not register \p reason for participating
+   * in consequence computation.
+   *
+   * \param reason  A clause whose literals except the first one have a `false` assignment;
+   *   the first literal of the clause must be unassigned. \p reason must reference a valid
+   *   object as long as its first literal is assigned.
+   *
+   * \returns If any consequence causes the assignment to become inconsistent, a clause
+   *   which is unsatisfied under the current assignment is returned. Otherwise, nullptr
+   *   is returned.
+   *
+   * \throw std::bad_alloc on memory allocation failure.
+   */
+  auto appendImplied(Clause& reason) -> Clause*;
+
   /**
    * \brief Registers a clause modification.
    * 
@@ -268,6 +337,17 @@ public:
    */
   auto getBinariesMap() const noexcept -> BinariesMap;
 
+  /**
+   * \brief Updates the watchers of the clauses passed to `registerClauseModification()`.
+   *
+   * This is done automatically before propagating literals. Clients need to call
+   * this method before `getBinariesMap()` if binary clauses may have been deleted
+   * or modified since the last propagation.
+   *
+   * \throw std::bad_alloc on memory allocation failure.
+   */
+  void cleanupWatchers();
+
   Assignment& operator=(Assignment const&) = delete;
   Assignment(Assignment const&) = delete;
 
@@ -298,10 +378,25 @@ public:
 private:
   auto propagateUntilFixpoint(CNFLit toPropagate, up_mode mode) -> Clause*;
   auto propagateBinaries(CNFLit toPropagate, size_t& amountOfNewFacts) -> Clause*;
-  void cleanupWatchers();
   auto isWatcherCleanupRequired() const noexcept -> bool;
   void cleanupWatchers(CNFLit lit);
 
+  /**
+   * \internal
+   *
+   * Updates the size of the conflict-free prefix of the trail after propagation.
+   */
+  void registerPropagationResult(Clause const* conflictingClause) noexcept;
+
+  /**
+   * \internal
+   *
+   * Saves the conflict-free prefix of the trail as target rsp. best phases if it is
+   * larger than the assignment from which the target rsp. best phases were obtained.
+   * Only the part of the prefix not saved yet is copied.
+   */
+  void updateTargetAndBestPhases() noexcept;
+
   using level_limit = uint32_t;
 
   /** \internal Variable assignments, in order of assignment */
@@ -316,6 +411,36 @@ private:
   /** \internal Map of variable phases; updated during undoToLevel */
   BoundedMap<CNFVar, TBool> m_phases;
 
+  /** \internal Map of target phases; updated during undoToLevel */
+  BoundedMap<CNFVar, TBool> m_targetPhases;
+
+  /** \internal Map of best phases; updated during undoToLevel */
+  BoundedMap<CNFVar, TBool> m_bestPhases;
+
+  /** \internal The size of the trail's prefix not involved in a conflict */
+  size_type m_amntConflictFreeAssignments;
+
+  /** \internal The size of the assignment from which the target phases were obtained */
+  size_type m_amntTargetPhaseAssignments;
+
+  /** \internal The size of the assignment from which the best phases were obtained */
+  size_type m_amntBestPhaseAssignments;
+
+  /**
+   * \internal The size of the trail's prefix that has been saved as target phases
+   * and has not been undone since then
+   */
+  size_type m_amntTrailAssignmentsInTargetPhases;
+
+  /**
+   * \internal The size of the trail's prefix that has been saved as best phases
+   * and has not been undone since then
+   */
+  size_type m_amntTrailAssignmentsInBestPhases;
+
+  /** \internal Iff true, the target and best phases are updated during undoToLevel */
+  bool m_tracksTargetAndBestPhases;
+
   /** \internal The current assignment level */
   Level m_currentLevel;
 
@@ -384,6 +509,22 @@ inline auto Assignment::getPhase(CNFVar var) const noexcept -> TBool
   return m_phases[var];
 }
 
+inline void Assignment::setPhase(CNFVar var, TBool phase) noexcept
+{
+  JAM_ASSERT(isDeterminate(phase), "Argument phase must be determinate");
+  m_phases[var] = phase;
+}
+
+inline auto Assignment::getTargetPhase(CNFVar var) const noexcept -> TBool
+{
+  return m_targetPhases[var];
+}
+
+inline auto Assignment::getBestPhase(CNFVar var) const noexcept -> TBool
+{
+  return m_bestPhases[var];
+}
+
 inline auto Assignment::getCurrentLevel() const noexcept
 {
   return m_currentLevel;
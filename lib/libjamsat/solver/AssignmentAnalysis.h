@@ -41,16 +41,19 @@
 namespace jamsat {
 
 /**
- * \brief Collect the reason-less literals on the current decision level (i.e.
+ * \brief Collect the reason-less literals on decision levels above 0 (i.e.
  *        literals representing a variable assignment) that led to the assignment
  *        of a given literal \p query.
  *
- * Usage example: use this function to analyze conflicts on the decision level where
- * assumption literals are stored (and propagated) to obtain a superset of the assumptions
- * that were used to obtain an UNSAT result.
+ * Usage example: use this function to analyze conflicts occurring while assumption
+ * literals are assigned (and propagated) to obtain a superset of the assumptions
+ * that were used to obtain an UNSAT result. Literals assigned on decision level 0
+ * are not included in the result.
  *
  * Note: \p query is always included in the result, even when \p query has
- * an assignment reason.
+ * an assignment reason. If the variable of \p query has been assigned without
+ * a reason on a decision level above 0 (e.g. by a complementary assumption),
+ * \p ~query is included in the result, too.
  *
  * \param reasonProvider    A provider of reason clauses.
  * \param dlProvider        A provider of decision levels for literals.
@@ -96,11 +99,12 @@ std::vector<CNFLit> analyzeAssignment(ReasonProviderT& reasonProvider,
   std::vector<CNFLit> result{query};
 
   if (reasonProvider.getReason(query.getVariable()) == nullptr) {
+    if (dlProvider.getLevel(query.getVariable()) != 0) {
+      result.push_back(~query);
+    }
     return result;
   }
 
-  auto currentDecisionLevel = dlProvider.getCurrentLevel();
-
   std::vector<CNFVar> toAnalyze{query.getVariable()};
   while (!toAnalyze.empty()) {
     CNFVar currentVar = toAnalyze.back();
@@ -114,7 +118,7 @@ std::vector<CNFLit> analyzeAssignment(ReasonProviderT& reasonProvider,
         continue;
       }
       stamps.setStamped(lit.getVariable(), stamp, true);
-      if (dlProvider.getLevel(lit.getVariable()) == currentDecisionLevel) {
+      if (dlProvider.getLevel(lit.getVariable()) != 0) {
         if (reasonProvider.getReason(lit.getVariable()) != nullptr) {
           toAnalyze.push_back(lit.getVariable());
         }
@@ -49,6 +49,25 @@
 #endif
 
 namespace jamsat {
+namespace detail_solver {
+/**
+ * \brief Determines whether \p lhs is a better lemma than \p rhs, i.e. whether \p lhs has
+ *        a lower LBD value than \p rhs, or is smaller than \p rhs in case of equal LBD values.
+ */
+template <class ClauseT, typename LBDType>
+auto isBetterLemma(ClauseT* lhs, ClauseT* rhs) noexcept -> bool
+{
+  auto lhsLBD = lhs->template getLBD<LBDType>();
+  auto rhsLBD = rhs->template getLBD<LBDType>();
+  if (lhsLBD != rhsLBD) {
+    return lhsLBD < rhsLBD;
+  }
+
+  // Use the clause size for tie-breaking, since smaller clauses are likely propagated faster:
+  return lhs->size() < rhs->size();
+}
+}
+
 /**
  * \ingroup JamSAT_Solver
  *
@@ -59,8 +78,9 @@ namespace jamsat {
  * with `K` increasing by a fixed value at each reduction. The first reduction may be performed
  * any time when at least one clause has been learned.
  *
- * \tparam ClauseT              The clause type, a type satisfying the LBDCarrier concept (i.e.
- *                              `is_lbd_carrier<ClauseT>::value` is `true`).
+ * \tparam ClauseT              The clause type, a type satisfying the LBDCarrier and
+ *                              ClauseFlaggable concepts (i.e. `is_lbd_carrier<ClauseT>::value`
+ *                              and `is_clause_flaggable<ClauseT>::value` are `true`).
  * \tparam LearntClauseSeq      A sequence container type for pointers to ClauseT.
  * \tparam LBD                  The LBD type, which must be an integral type.
  */
@@ -68,6 +88,8 @@ template <class ClauseT, class LearntClauseSeq, typename LBD>
 class GlucoseClauseDBReductionPolicy {
   static_assert(is_lbd_carrier<ClauseT>::value,
                 "ClauseT must satisfy is_lbd_carrier<T>, but does not");
+  static_assert(is_clause_flaggable<ClauseT>::value,
+                "ClauseT must satisfy is_clause_flaggable<T>, but does not");
 
 public:
   /**
@@ -100,8 +122,13 @@ public:
    * The elements in \p learntClauses are rearranged by this method.
    *
    * A clause is selected for removal if its LBD value is higher than that of 50% of all
-   * learnt clauses. If there are more "known good" clauses than clauses in \p learntClauses
+   * learnt clauses. The clauses are partitioned via `std::nth_element`, i.e. they are not
+   * fully sorted. If there are more "known good" clauses than clauses in \p learntClauses
    * or if a clause with LBD <= 3 would have to be removed, an empty range is returned.
+   * Clauses with the USED_RECENTLY flag are spared from removal. Unless an empty range
+   * is returned for one of the reasons above, the USED_RECENTLY flag is cleared for all
+   * clauses in \p learntClauses, even if all clauses selected for removal have been
+   * spared and the returned range is empty.
    *
    * \param knownGoodClauses  The amount of "known good" learnt clauses which will never be
    *                          removed from the clause database and are not included in
@@ -118,6 +145,102 @@ private:
   uint64_t m_conflictsRemaining;
 };
 
+/**
+ * \ingroup JamSAT_Solver
+ *
+ * \brief A policy deciding which clauses should be reduced from the main clause database,
+ *        dividing the lemmas into three tiers.
+ *
+ * The lemmas are divided into tiers by their LBD values:
+ *  - core lemmas (LBD <= `coreLBDLimit`) are never deleted.
+ *  - tier-2 lemmas (LBD <= `tier2LBDLimit`) are kept if they have been used in conflict
+ *    analysis since the last-but-one clause DB reduction.
+ *  - local lemmas (all other lemmas) are kept if they have been used in conflict analysis
+ *    since the last clause DB reduction.
+ * Of the remaining lemmas, the worse half is deleted, with lemmas being ordered by their
+ * LBD values and their size. Since the lemma LBD values are updated during conflict
+ * analysis, lemmas are promoted to a better tier as soon as their LBD value improves.
+ *
+ * Like with GlucoseClauseDBReductionPolicy, ClauseDB reduction is admitted `K` conflicts after
+ * the previous reduction, with `K` increasing by a fixed value at each reduction.
+ *
+ * \tparam ClauseT              The clause type, a type satisfying the LBDCarrier and
+ *                              ClauseFlaggable concepts, with the additional flag
+ *                              `USED_PREVIOUSLY`.
+ * \tparam LearntClauseSeq      A sequence container type for pointers to ClauseT.
+ * \tparam LBD                  The LBD type, which must be an integral type.
+ */
+template <class ClauseT, class LearntClauseSeq, typename LBD>
+class TieredClauseDBReductionPolicy {
+  static_assert(is_lbd_carrier<ClauseT>::value,
+                "ClauseT must satisfy is_lbd_carrier<T>, but does not");
+  static_assert(is_clause_flaggable<ClauseT>::value,
+                "ClauseT must satisfy is_clause_flaggable<T>, but does not");
+
+public:
+  struct TierSizes {
+    uint64_t core = 0;
+    uint64_t tier2 = 0;
+    uint64_t local = 0;
+  };
+
+  /**
+   * \brief Constructs a new TieredClauseDBReductionPolicy instance.
+   *
+   * \param intervalIncrease  The constant by which the intervals of conflicts between clause
+   *                          DB reductions are increased at each reduction.
+   * \param learntClauses     A reference to a sequence container containing pointers to the
+   *                          learnt clauses.
+   * \param coreLBDLimit      The maximum LBD of core lemmas.
+   * \param tier2LBDLimit     The maximum LBD of tier-2 lemmas.
+   */
+  TieredClauseDBReductionPolicy(uint32_t intervalIncrease,
+                                LearntClauseSeq& learntClauses,
+                                LBD coreLBDLimit = 2,
+                                LBD tier2LBDLimit = 6) noexcept;
+
+  /**
+   * \brief Notifies the policy that the solver has handled a conflict.
+   */
+  void registerConflict() noexcept;
+
+  /**
+   * \brief Determines whether a clause DB reduction should be performed.
+   *
+   * \returns true iff a clause DB reduction should be performed.
+   */
+  bool shouldReduceDB() const noexcept;
+
+  /**
+   * \brief Moves clauses to be deleted in \p learntClauses to the end of \p learntClauses
+   *        and returns an iterator pointing past the last clause not to be deleted.
+   *
+   * The elements in \p learntClauses are rearranged by this method. For all clauses in
+   * \p learntClauses, the USED_PREVIOUSLY flag is set to the value of the USED_RECENTLY
+   * flag, and the USED_RECENTLY flag is cleared.
+   *
+   * \returns An iterator pointing past the last clause not to be deleted.
+   */
+  auto getClausesMarkedForDeletion() noexcept -> typename LearntClauseSeq::iterator;
+
+  /**
+   * \brief Returns the amount of lemmas in each tier, as determined during the last call
+   *        to getClausesMarkedForDeletion(). Lemmas selected for deletion are included.
+   */
+  auto getTierSizes() const noexcept -> TierSizes const&;
+
+private:
+  auto isKept(ClauseT& clause) const noexcept -> bool;
+
+  const uint32_t m_intervalIncrease;
+  LearntClauseSeq& m_learntClauses;
+  LBD m_coreLBDLimit;
+  LBD m_tier2LBDLimit;
+  uint64_t m_intervalSize;
+  uint64_t m_conflictsRemaining;
+  TierSizes m_tierSizes;
+};
+
 /********** Implementation ****************************** */
 
 template <class ClauseT, class LearntClauseSeq, typename LBDType>
@@ -165,24 +288,129 @@ GlucoseClauseDBReductionPolicy<ClauseT, LearntClauseSeq, LBDType>::getClausesMar
     return m_learntClauses.end();
   }
 
-  std::sort(m_learntClauses.begin(), m_learntClauses.end(), [](ClauseT* lhs, ClauseT* rhs) {
-    auto lhsLBD = lhs->template getLBD<LBDType>();
-    auto rhsLBD = rhs->template getLBD<LBDType>();
-    if (lhsLBD != rhsLBD) {
-      return lhs->template getLBD<LBDType>() < rhs->template getLBD<LBDType>();
-    }
-
-    // Use the clause size for tie-breaking, since smaller clauses are likely propagated faster:
-    return lhs->size() < rhs->size();
-  });
+  std::nth_element(m_learntClauses.begin(),
+                   m_learntClauses.begin() + midIndex,
+                   m_learntClauses.end(),
+                   detail_solver::isBetterLemma<ClauseT, LBDType>);
 
   if (m_learntClauses[midIndex]->template getLBD<LBDType>() <= static_cast<LBDType>(3)) {
     JAM_LOG_REDUCE(info, "Selecting no clauses for reduction: LBD values are too low");
     return m_learntClauses.end();
   }
 
+  // Keep the clauses that have been used in conflict analysis since the last reduction:
+  auto toDeleteBegin =
+      std::partition(m_learntClauses.begin() + midIndex, m_learntClauses.end(), [](ClauseT* c) {
+        return c->getFlag(ClauseT::Flag::USED_RECENTLY);
+      });
+
+  for (ClauseT* clause : m_learntClauses) {
+    clause->clearFlag(ClauseT::Flag::USED_RECENTLY);
+  }
+
+  JAM_LOG_REDUCE(info,
+                 "Selecting " << std::distance(toDeleteBegin, m_learntClauses.end())
+                              << " clauses for reduction");
+  return toDeleteBegin;
+}
+
+template <class ClauseT, class LearntClauseSeq, typename LBD>
+TieredClauseDBReductionPolicy<ClauseT, LearntClauseSeq, LBD>::TieredClauseDBReductionPolicy(
+    uint32_t intervalIncrease,
+    LearntClauseSeq& learntClauses,
+    LBD coreLBDLimit,
+    LBD tier2LBDLimit) noexcept
+  : m_intervalIncrease(intervalIncrease)
+  , m_learntClauses(learntClauses)
+  , m_coreLBDLimit(coreLBDLimit)
+  , m_tier2LBDLimit(tier2LBDLimit)
+  , m_intervalSize(0)
+  , m_conflictsRemaining(0)
+  , m_tierSizes()
+{
+}
+
+template <class ClauseT, class LearntClauseSeq, typename LBD>
+void TieredClauseDBReductionPolicy<ClauseT, LearntClauseSeq, LBD>::registerConflict() noexcept
+{
+  if (m_conflictsRemaining > 0) {
+    --m_conflictsRemaining;
+  }
+}
+
+template <class ClauseT, class LearntClauseSeq, typename LBD>
+bool TieredClauseDBReductionPolicy<ClauseT, LearntClauseSeq, LBD>::shouldReduceDB() const noexcept
+{
+  return m_conflictsRemaining == 0 && !m_learntClauses.empty();
+}
+
+template <class ClauseT, class LearntClauseSeq, typename LBD>
+auto TieredClauseDBReductionPolicy<ClauseT, LearntClauseSeq, LBD>::isKept(
+    ClauseT& clause) const noexcept -> bool
+{
+  LBD const lbd = clause.template getLBD<LBD>();
+  if (lbd <= m_coreLBDLimit || clause.getFlag(ClauseT::Flag::USED_RECENTLY)) {
+    return true;
+  }
+  return lbd <= m_tier2LBDLimit && clause.getFlag(ClauseT::Flag::USED_PREVIOUSLY);
+}
+
+template <class ClauseT, class LearntClauseSeq, typename LBD>
+auto TieredClauseDBReductionPolicy<ClauseT, LearntClauseSeq, LBD>::getClausesMarkedForDeletion()
+    noexcept -> typename LearntClauseSeq::iterator
+{
+  JAM_ASSERT(shouldReduceDB(), "Clause DB reduction not allowed at this point");
+  JAM_LOG_REDUCE(info, "Determining clauses to be removed...");
+
+  m_intervalSize += m_intervalIncrease;
+  m_conflictsRemaining = m_intervalSize;
+
+  m_tierSizes = TierSizes{};
+  for (ClauseT* clause : m_learntClauses) {
+    LBD const lbd = clause->template getLBD<LBD>();
+    if (lbd <= m_coreLBDLimit) {
+      ++m_tierSizes.core;
+    }
+    else if (lbd <= m_tier2LBDLimit) {
+      ++m_tierSizes.tier2;
+    }
+    else {
+      ++m_tierSizes.local;
+    }
+  }
+
+  auto candidatesBegin = std::partition(
+      m_learntClauses.begin(), m_learntClauses.end(), [this](ClauseT* clause) {
+        return isKept(*clause);
+      });
+
+  for (ClauseT* clause : m_learntClauses) {
+    if (clause->getFlag(ClauseT::Flag::USED_RECENTLY)) {
+      clause->setFlag(ClauseT::Flag::USED_PREVIOUSLY);
+      clause->clearFlag(ClauseT::Flag::USED_RECENTLY);
+    }
+    else {
+      clause->clearFlag(ClauseT::Flag::USED_PREVIOUSLY);
+    }
+  }
+
+  auto const amntCandidates = std::distance(candidatesBegin, m_learntClauses.end());
+  auto toDeleteBegin = candidatesBegin + (amntCandidates + 1) / 2;
+  std::nth_element(candidatesBegin,
+                   toDeleteBegin,
+                   m_learntClauses.end(),
+                   detail_solver::isBetterLemma<ClauseT, LBD>);
+
   JAM_LOG_REDUCE(info,
-                 "Selecting " << (m_learntClauses.size() - midIndex) << " clauses for reduction");
-  return m_learntClauses.begin() + midIndex;
+                 "Selecting " << std::distance(toDeleteBegin, m_learntClauses.end())
+                              << " clauses for reduction");
+  return toDeleteBegin;
+}
+
+template <class ClauseT, class LearntClauseSeq, typename LBD>
+auto TieredClauseDBReductionPolicy<ClauseT, LearntClauseSeq, LBD>::getTierSizes() const noexcept
+    -> TierSizes const&
+{
+  return m_tierSizes;
 }
 }
@@ -34,7 +34,6 @@
 #pragma once
 
 #include <algorithm>
-#include <functional>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -42,10 +41,12 @@
 #include <libjamsat/cnfproblem/CNFLiteral.h>
 #include <libjamsat/concepts/ClauseTraits.h>
 #include <libjamsat/concepts/SolverTypeTraits.h>
+#include <libjamsat/solver/LiteralBlockDistance.h>
 #include <libjamsat/utils/Assert.h>
 #include <libjamsat/utils/BoundedMap.h>
 #include <libjamsat/utils/FaultInjector.h>
 #include <libjamsat/utils/Logger.h>
+#include <libjamsat/utils/StampMap.h>
 #include <libjamsat/utils/Truth.h>
 
 #if defined(JAM_ENABLE_CA_LOGGING)
@@ -55,6 +56,20 @@
 #endif
 
 namespace jamsat {
+/**
+ * \ingroup JamSAT_Solver
+ *
+ * \brief A ConflictAnalysisObserver ignoring all notifications.
+ */
+struct NullConflictAnalysisObserver {
+  void onSeenVariable(CNFVar) const noexcept {}
+
+  template <typename Clause>
+  void onSeenClause(Clause const&) const noexcept
+  {
+  }
+};
+
 /**
  * \ingroup JamSAT_Solver
  *
@@ -69,12 +84,29 @@ namespace jamsat {
  * This implementation closely follows Donald Knuth's prosaic description
  * of first-UIP clause learning. See "The Art of Computer Programming", chapter 7.2.2.2.
  *
- * \tparam DLProvider           A type that is a model of the DecisionLevelProvider concept.
- * \tparam ReasonProvider       A type that is a model of the ReasonProvider concept, with the
- *                              reason type satisfying the LiteralContainer concept.
+ * The clauses taking part in the resolution process are marked with the USED_RECENTLY
+ * flag, and their LBD values are updated if they have decreased since the clauses have
+ * been learnt (see Audemard, Simon: "Predicting Learnt Clauses Quality in Modern SAT
+ * Solvers", 2009).
  *
+ * \tparam DLProvider           A type that is a model of the DecisionLevelProvider concept,
+ *                              additionally providing a `LevelKey` type satisfying the Index
+ *                              concept for decision levels.
+ * \tparam ReasonProvider       A type that is a model of the ReasonProvider concept, with the
+ *                              reason type satisfying the LiteralContainer, LBDCarrier and
+ *                              ClauseFlaggable concepts. For non-const objects `r` of type
+ *                              `ReasonProvider` and variables `v`, `r.getReason(v)` must
+ *                              return a pointer to a non-const reason.
+ * \tparam ConflictAnalysisObserver  A type that is a model of the ConflictAnalysisObserver
+ *                              concept for the reason type. The observer is notified about
+ *                              all variables seen during conflict analysis (at most once per
+ *                              variable and conflict) and about all clauses taking part in
+ *                              the resolution process. Since the observer is a compile-time
+ *                              policy, its notifications can be inlined.
  */
-template <class DLProvider, class ReasonProvider>
+template <class DLProvider,
+          class ReasonProvider,
+          class ConflictAnalysisObserver = NullConflictAnalysisObserver>
 class FirstUIPLearning {
 
 public:
@@ -86,9 +118,16 @@ public:
                 " does not");
   static_assert(is_literal_container<Clause>::value,
                 "The ReasonProvider's reason type must satisfy LiteralContainer, but does not");
+  static_assert(is_lbd_carrier<Clause>::value,
+                "The ReasonProvider's reason type must satisfy LBDCarrier, but does not");
+  static_assert(is_clause_flaggable<Clause>::value,
+                "The ReasonProvider's reason type must satisfy ClauseFlaggable, but does not");
   static_assert(is_decision_level_provider<DLProvider>::value,
                 "Template argument DLProvider must satisfy the DecisionLevelProvider concept,"
                 " but does not");
+  static_assert(is_conflict_analysis_observer<ConflictAnalysisObserver, Clause>::value,
+                "Template argument ConflictAnalysisObserver must satisfy the"
+                " ConflictAnalysisObserver concept, but does not");
 
 
   /**
@@ -100,14 +139,27 @@ public:
    *                    long as the constructed object.
    * \param reasonProvider  The assignment reason providing object. Needs to
    *                        live as long as the constructed object.
+   * \param observer    The observer notified about variables and clauses seen during
+   *                    conflict analysis.
    */
   FirstUIPLearning(CNFVar maxVar,
                    const DLProvider& dlProvider,
-                   ReasonProvider const& reasonProvider);
+                   ReasonProvider& reasonProvider,
+                   ConflictAnalysisObserver observer = ConflictAnalysisObserver{});
 
   /**
    * \brief Given a conflicting clause, computes a conflict clause.
    *
+   * The conflicting clause and all reason clauses with which resolution is performed
+   * are marked with the USED_RECENTLY flag. If the LBD of such a clause has decreased,
+   * its LBD value is updated. The observer is notified about these clauses as well as
+   * about all variables occurring in them.
+   *
+   * The LBD of \p result is not computed here: the decision levels of the result's
+   * literals are not stamped during analysis (\p m_levelStamps is only used per reason
+   * clause), and callers typically shrink \p result further via lemma minimization,
+   * which can drop decision levels. The LBD needs to be computed for the final lemma.
+   *
    * \param[in] conflictingClause  The conflicting clause, ie. a clause being
    *                               falsified through propagation under the current assignment.
    * \param[out] result            The conflict clause determined via resolutions
@@ -117,18 +169,6 @@ public:
   void computeConflictClause(Clause& conflictingClause, std::vector<CNFLit>& result) const;
 
 
-  /**
-   * \brief Set the callback for variables seen during conflict resolution.
-   *
-   * The provided callback is called for all variables in the conflicting clause
-   * as well as for all variables in all clauses with which the conflicting clause
-   * is resolved. Per call to computeConflictClause(), the callback is invoked at
-   * most once per variable.
-   *
-   * \param callback  The callback function to be installed (see above).
-   */
-  void setOnSeenVariableCallback(std::function<void(CNFVar)> const& callback) noexcept;
-
   /**
    * \brief Increases the maximum variable occuring in the problem to be solved.
    *
@@ -210,8 +250,17 @@ private:
    */
   void clearStamps(std::vector<CNFLit> const& lits) const noexcept;
 
+  /**
+   * \brief Marks \p clause as recently used and updates its LBD value if it has
+   *        decreased.
+   *
+   * \param clause   A clause participating in the resolution process. All literals of
+   *                 \p clause must be assigned.
+   */
+  void updateUsedClause(Clause& clause) const noexcept;
+
   const DLProvider& m_dlProvider;
-  const ReasonProvider& m_reasonProvider;
+  ReasonProvider& m_reasonProvider;
   const CNFVar m_maxVar;
 
   // Temporary storage for stamps, since we can't afford to allocate
@@ -232,29 +281,43 @@ private:
   // are handled by the same data structure for memory efficiency.
   mutable BoundedMap<CNFVar, char> m_stamps;
 
-  // Callback called once for every literal seen during conflict analysis
-  std::function<void(CNFVar)> m_onSeenVariableCallback;
+  // Temporary storage for decision level stamps, used for computing LBD values of the
+  // clauses taking part in the resolution process. Each computation uses a fresh stamp.
+  mutable StampMap<uint16_t, typename DLProvider::LevelKey> m_levelStamps;
+
+  // Observer notified once for every variable seen during conflict analysis and
+  // for every clause taking part in the resolution process
+  mutable ConflictAnalysisObserver m_observer;
 
   // Class invariant A: m_stamps[x] = 0 for all keys x
 };
 
 /********** Implementation ****************************** */
 
-template <class DLProvider, class ReasonProvider>
-FirstUIPLearning<DLProvider, ReasonProvider>::FirstUIPLearning(CNFVar maxVar,
-                                                               const DLProvider& dlProvider,
-                                                               const ReasonProvider& reasonProvider)
-  : m_dlProvider(dlProvider), m_reasonProvider(reasonProvider), m_maxVar(maxVar), m_stamps(maxVar)
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::FirstUIPLearning(
+    CNFVar maxVar,
+    const DLProvider& dlProvider,
+    ReasonProvider& reasonProvider,
+    ConflictAnalysisObserver observer)
+  : m_dlProvider(dlProvider)
+  , m_reasonProvider(reasonProvider)
+  , m_maxVar(maxVar)
+  , m_stamps(maxVar)
+  , m_levelStamps(getMaxLit(maxVar).getRawValue())
+  , m_observer(std::move(observer))
 {
   JAM_ASSERT(isRegular(maxVar), "Argument maxVar must be a regular variable.");
 }
 
-template <class DLProvider, class ReasonProvider>
-void FirstUIPLearning<DLProvider, ReasonProvider>::increaseMaxVarTo(CNFVar newMaxVar)
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+void FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::increaseMaxVarTo(
+    CNFVar newMaxVar)
 {
   JAM_ASSERT(isRegular(newMaxVar), "Argument newMaxVar must be a regular variable.");
   CNFVar firstNewVar = CNFVar{static_cast<CNFVar::RawVariable>(m_stamps.size())};
   m_stamps.increaseSizeTo(newMaxVar);
+  m_levelStamps.increaseSizeTo(getMaxLit(newMaxVar).getRawValue());
 
   for (CNFVar i = firstNewVar; i <= newMaxVar; i = nextCNFVar(i)) {
     m_stamps[i] = 0;
@@ -274,8 +337,8 @@ inline bool isAllZero(const BoundedMap<CNFVar, char>& stamps, CNFVar maxVar) noe
 }
 #endif
 
-template <class DLProvider, class ReasonProvider>
-auto FirstUIPLearning<DLProvider, ReasonProvider>::initializeResult(
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+auto FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::initializeResult(
     Clause const& conflictingClause, std::vector<CNFLit>& result) const -> int
 {
 
@@ -307,11 +370,9 @@ auto FirstUIPLearning<DLProvider, ReasonProvider>::initializeResult(
   return unresolvedCount;
 }
 
-template <class DLProvider, class ReasonProvider>
-auto FirstUIPLearning<DLProvider, ReasonProvider>::addResolvent(Clause const& reason,
-                                                                CNFLit resolveAtLit,
-                                                                std::vector<CNFLit>& result) const
-    -> int
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+auto FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::addResolvent(
+    Clause const& reason, CNFLit resolveAtLit, std::vector<CNFLit>& result) const -> int
 {
   int unresolvedCount = 0;
 
@@ -358,9 +419,9 @@ auto FirstUIPLearning<DLProvider, ReasonProvider>::addResolvent(Clause const& re
   return unresolvedCount;
 }
 
-template <class DLProvider, class ReasonProvider>
-void FirstUIPLearning<DLProvider, ReasonProvider>::resolveUntilUIP(std::vector<CNFLit>& result,
-                                                                   int unresolvedCount) const
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+void FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::resolveUntilUIP(
+    std::vector<CNFLit>& result, int unresolvedCount) const
 {
 
   // unresolvedCount counts how many literals L are left to resolve on the
@@ -399,9 +460,7 @@ void FirstUIPLearning<DLProvider, ReasonProvider>::resolveUntilUIP(std::vector<C
     JAM_LOG_CA(info, "  Resolving at literal: " << resolveAtLit);
 
     if (m_stamps[resolveAtVar] != 0) {
-      if (m_onSeenVariableCallback) {
-        m_onSeenVariableCallback(resolveAtLit.getVariable());
-      }
+      m_observer.onSeenVariable(resolveAtVar);
 
       JAM_ASSERT(m_dlProvider.getLevel(resolveAtVar) == currentLevel,
                  "Expected to traverse only literals on the current decision level");
@@ -409,6 +468,8 @@ void FirstUIPLearning<DLProvider, ReasonProvider>::resolveUntilUIP(std::vector<C
 
       JAM_ASSERT(reason != nullptr, "Encountered the UIP too early");
       unresolvedCount += addResolvent(*reason, resolveAtLit, result);
+      updateUsedClause(*reason);
+      m_observer.onSeenClause(static_cast<Clause const&>(*reason));
       --unresolvedCount;
       JAM_LOG_CA(info,
                  "  Resolved with reason clause "
@@ -438,20 +499,38 @@ void FirstUIPLearning<DLProvider, ReasonProvider>::resolveUntilUIP(std::vector<C
              "Implementation error: didn't find exactly one asserting literal");
 }
 
-template <class DLProvider, class ReasonProvider>
-void FirstUIPLearning<DLProvider, ReasonProvider>::clearStamps(
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+void FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::clearStamps(
     std::vector<CNFLit> const& lits) const noexcept
 {
   for (CNFLit w : lits) {
     m_stamps[w.getVariable()] = 0;
-    if (m_onSeenVariableCallback) {
-      m_onSeenVariableCallback(w.getVariable());
-    }
+    m_observer.onSeenVariable(w.getVariable());
   }
 }
 
-template <class DLProvider, class ReasonProvider>
-void FirstUIPLearning<DLProvider, ReasonProvider>::computeConflictClause(
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+void FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::updateUsedClause(
+    Clause& clause) const noexcept
+{
+  clause.setFlag(Clause::Flag::USED_RECENTLY);
+
+  // Clauses with LBD values <= 2 are already considered to be of the
+  // highest quality, so the computation can be skipped for them:
+  LBD const oldLBD = clause.template getLBD<LBD>();
+  if (oldLBD <= 2) {
+    return;
+  }
+
+  LBD const newLBD = getLBD(clause, m_dlProvider, m_levelStamps);
+  if (newLBD < oldLBD) {
+    JAM_LOG_CA(info, "  Updating LBD of clause " << &clause << ": " << oldLBD << " -> " << newLBD);
+    clause.template setLBD<LBD>(newLBD);
+  }
+}
+
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+void FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::computeConflictClause(
     Clause& conflictingClause, std::vector<CNFLit>& result) const
 {
   JAM_LOG_CA(info, "Beginning conflict analysis.");
@@ -461,6 +540,8 @@ void FirstUIPLearning<DLProvider, ReasonProvider>::computeConflictClause(
     result.clear();
 
     int unresolvedCount = initializeResult(conflictingClause, result);
+    updateUsedClause(conflictingClause);
+    m_observer.onSeenClause(static_cast<Clause const&>(conflictingClause));
     resolveUntilUIP(result, unresolvedCount);
 
     JAM_ASSERT(result[0] != CNFLit::getUndefinedLiteral(), "Didn't find an asserting literal");
@@ -483,16 +564,9 @@ void FirstUIPLearning<DLProvider, ReasonProvider>::computeConflictClause(
   }
 }
 
-template <class DLProvider, class ReasonProvider>
-void FirstUIPLearning<DLProvider, ReasonProvider>::setOnSeenVariableCallback(
-    std::function<void(CNFVar)> const& callback) noexcept
-{
-  m_onSeenVariableCallback = callback;
-}
-
-template <class DLProvider, class ReasonProvider>
-void FirstUIPLearning<DLProvider, ReasonProvider>::test_assertClassInvariantsSatisfied()
-    const noexcept
+template <class DLProvider, class ReasonProvider, class ConflictAnalysisObserver>
+void FirstUIPLearning<DLProvider, ReasonProvider, ConflictAnalysisObserver>::
+    test_assertClassInvariantsSatisfied() const noexcept
 {
   JAM_ASSERT(detail_solver::isAllZero(m_stamps, m_maxVar), "Class invariant A violated");
 }
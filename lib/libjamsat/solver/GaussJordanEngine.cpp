@@ -0,0 +1,287 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include "GaussJordanEngine.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <libjamsat/utils/Assert.h>
+
+namespace jamsat {
+
+GaussJordanEngine::GaussJordanEngine(CNFVar maxVar, uint64_t maxMatrixSize)
+  : m_rowVars{}
+  , m_rowBegin{0}
+  , m_rowParities{}
+  , m_watchers(maxVar.getRawValue() + 1)
+  , m_nextTrailIndex{0}
+  , m_maxMatrixSize{maxMatrixSize}
+  , m_clauseBuffer{}
+  , m_conflictingClause{}
+  , m_reasons{}
+{
+}
+
+auto GaussJordanEngine::setConstraints(std::vector<XorConstraint> const& constraints,
+                                       std::vector<CNFLit>& units) -> bool
+{
+  m_rowVars.clear();
+  m_rowBegin.assign(1, 0);
+  m_rowParities.clear();
+  for (auto& watchers : m_watchers) {
+    watchers.clear();
+  }
+  m_nextTrailIndex = 0;
+  m_reasons.clear();
+
+  // Assigning the columns in the order of first occurrence:
+  constexpr uint32_t noColumn = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> columns(m_watchers.size(), noColumn);
+  std::vector<CNFVar> columnVars;
+  for (XorConstraint const& constraint : constraints) {
+    for (CNFVar var : constraint.variables) {
+      JAM_ASSERT(var.getRawValue() < m_watchers.size(), "Variable out of range");
+      if (columns[var.getRawValue()] == noColumn) {
+        columns[var.getRawValue()] = static_cast<uint32_t>(columnVars.size());
+        columnVars.push_back(var);
+      }
+    }
+  }
+
+  std::size_t const amntWords = (columnVars.size() + 63) / 64;
+  std::vector<std::vector<CNFVar>> rows;
+  std::vector<char> parities;
+  if (amntWords * 64 * constraints.size() <= m_maxMatrixSize) {
+    // Gauss-Jordan elimination, with each row being a bitset over the columns:
+    std::vector<std::vector<uint64_t>> matrix;
+    for (XorConstraint const& constraint : constraints) {
+      std::vector<uint64_t> row(amntWords, 0);
+      for (CNFVar var : constraint.variables) {
+        uint32_t const column = columns[var.getRawValue()];
+        row[column / 64] ^= (1ULL << (column % 64));
+      }
+      matrix.push_back(std::move(row));
+      parities.push_back(constraint.parity ? 1 : 0);
+    }
+
+    std::size_t pivotRow = 0;
+    for (std::size_t column = 0; column < columnVars.size() && pivotRow < matrix.size();
+         ++column) {
+      std::size_t const word = column / 64;
+      uint64_t const bit = 1ULL << (column % 64);
+      auto const pivot =
+          std::find_if(matrix.begin() + pivotRow, matrix.end(), [word, bit](auto const& row) {
+            return (row[word] & bit) != 0;
+          });
+      if (pivot == matrix.end()) {
+        continue;
+      }
+      std::size_t const pivotIndex = std::distance(matrix.begin(), pivot);
+      std::swap(matrix[pivotRow], matrix[pivotIndex]);
+      std::swap(parities[pivotRow], parities[pivotIndex]);
+
+      for (std::size_t other = 0; other < matrix.size(); ++other) {
+        if (other != pivotRow && (matrix[other][word] & bit) != 0) {
+          for (std::size_t i = word; i < amntWords; ++i) {
+            matrix[other][i] ^= matrix[pivotRow][i];
+          }
+          parities[other] ^= parities[pivotRow];
+        }
+      }
+      ++pivotRow;
+    }
+
+    for (std::size_t i = 0; i < matrix.size(); ++i) {
+      std::vector<CNFVar> variables;
+      for (std::size_t column = 0; column < columnVars.size(); ++column) {
+        if ((matrix[i][column / 64] & (1ULL << (column % 64))) != 0) {
+          variables.push_back(columnVars[column]);
+        }
+      }
+      rows.push_back(std::move(variables));
+    }
+  }
+  else {
+    for (XorConstraint const& constraint : constraints) {
+      rows.push_back(constraint.variables);
+      parities.push_back(constraint.parity ? 1 : 0);
+    }
+  }
+
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    bool const parity = (parities[i] != 0);
+    if (rows[i].empty()) {
+      if (parity) {
+        return false;
+      }
+    }
+    else if (rows[i].size() == 1) {
+      units.push_back(CNFLit{rows[i][0], parity ? CNFSign::POSITIVE : CNFSign::NEGATIVE});
+    }
+    else {
+      addRow(rows[i], parity);
+    }
+  }
+  return true;
+}
+
+void GaussJordanEngine::addRow(std::vector<CNFVar> const& variables, bool parity)
+{
+  std::size_t const row = m_rowParities.size();
+  m_rowVars.insert(m_rowVars.end(), variables.begin(), variables.end());
+  m_rowBegin.push_back(m_rowVars.size());
+  m_rowParities.push_back(parity ? 1 : 0);
+  m_watchers[variables[0].getRawValue()].push_back(row);
+  m_watchers[variables[1].getRawValue()].push_back(row);
+}
+
+auto GaussJordanEngine::updateWatch(std::size_t row, CNFVar var, Assignment const& assignment)
+    -> RowState
+{
+  std::size_t const begin = m_rowBegin[row];
+  std::size_t const end = m_rowBegin[row + 1];
+  if (m_rowVars[begin] == var) {
+    std::swap(m_rowVars[begin], m_rowVars[begin + 1]);
+  }
+  JAM_ASSERT(m_rowVars[begin + 1] == var, "The row is not watched on the given variable");
+
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    if (!isDeterminate(assignment.getAssignment(m_rowVars[i]))) {
+      std::swap(m_rowVars[begin + 1], m_rowVars[i]);
+      m_watchers[m_rowVars[begin + 1].getRawValue()].push_back(row);
+      return RowState::NONE;
+    }
+  }
+
+  CNFVar const otherWatched = m_rowVars[begin];
+  if (!isDeterminate(assignment.getAssignment(otherWatched))) {
+    storeRowAsClause(row, otherWatched, assignment);
+    return RowState::PROPAGATING;
+  }
+
+  bool parity = false;
+  for (std::size_t i = begin; i < end; ++i) {
+    parity ^= isTrue(assignment.getAssignment(m_rowVars[i]));
+  }
+  if (parity == (m_rowParities[row] != 0)) {
+    return RowState::NONE;
+  }
+  storeRowAsClause(row, CNFVar::getUndefinedVariable(), assignment);
+  return RowState::CONFLICTING;
+}
+
+void GaussJordanEngine::storeRowAsClause(std::size_t row,
+                                         CNFVar unassigned,
+                                         Assignment const& assignment)
+{
+  m_clauseBuffer.clear();
+  if (unassigned != CNFVar::getUndefinedVariable()) {
+    m_clauseBuffer.push_back(CNFLit::getUndefinedLiteral());
+  }
+
+  bool parity = false;
+  for (std::size_t i = m_rowBegin[row]; i < m_rowBegin[row + 1]; ++i) {
+    CNFVar const var = m_rowVars[i];
+    if (var == unassigned) {
+      continue;
+    }
+    bool const value = isTrue(assignment.getAssignment(var));
+    parity ^= value;
+    m_clauseBuffer.push_back(CNFLit{var, value ? CNFSign::NEGATIVE : CNFSign::POSITIVE});
+  }
+
+  if (unassigned != CNFVar::getUndefinedVariable()) {
+    bool const impliedValue = parity != (m_rowParities[row] != 0);
+    m_clauseBuffer[0] = CNFLit{unassigned, impliedValue ? CNFSign::POSITIVE : CNFSign::NEGATIVE};
+  }
+}
+
+auto GaussJordanEngine::createClauseFromBuffer() const -> std::unique_ptr<Clause>
+{
+  auto const size = static_cast<Clause::size_type>(m_clauseBuffer.size());
+  std::unique_ptr<Clause> result = createHeapClause(size);
+  std::copy(m_clauseBuffer.begin(), m_clauseBuffer.end(), result->begin());
+  result->clauseUpdated();
+  return result;
+}
+
+auto GaussJordanEngine::propagate(Assignment& assignment) -> Clause*
+{
+  while (m_nextTrailIndex < assignment.getNumAssignments()) {
+    CNFVar const var = (assignment.getAssignments().begin() + m_nextTrailIndex)->getVariable();
+    ++m_nextTrailIndex;
+
+    std::vector<std::size_t>& watchers = m_watchers[var.getRawValue()];
+    std::size_t index = 0;
+    while (index < watchers.size()) {
+      std::size_t const row = watchers[index];
+      RowState const state = updateWatch(row, var, assignment);
+      if (m_rowVars[m_rowBegin[row]] != var && m_rowVars[m_rowBegin[row] + 1] != var) {
+        // The row is watched on another variable now
+        watchers[index] = watchers.back();
+        watchers.pop_back();
+        continue;
+      }
+      ++index;
+
+      if (state == RowState::PROPAGATING) {
+        m_reasons.push_back(Reason{assignment.getNumAssignments(), createClauseFromBuffer()});
+        Clause* conflict = assignment.appendImplied(*m_reasons.back().clause);
+        if (conflict != nullptr) {
+          return conflict;
+        }
+      }
+      else if (state == RowState::CONFLICTING) {
+        m_conflictingClause = createClauseFromBuffer();
+        return m_conflictingClause.get();
+      }
+    }
+  }
+  return nullptr;
+}
+
+void GaussJordanEngine::backtrack(std::size_t trailSize) noexcept
+{
+  m_nextTrailIndex = std::min(m_nextTrailIndex, trailSize);
+  while (!m_reasons.empty() && m_reasons.back().trailIndex >= trailSize) {
+    m_reasons.pop_back();
+  }
+}
+
+void GaussJordanEngine::increaseMaxVarTo(CNFVar maxVar)
+{
+  JAM_ASSERT(maxVar.getRawValue() + 1 >= m_watchers.size(),
+             "Illegally attempted to decrease the maximum variable");
+  m_watchers.resize(maxVar.getRawValue() + 1);
+}
+
+auto GaussJordanEngine::getAmntRows() const noexcept -> std::size_t
+{
+  return m_rowParities.size();
+}
+}
@@ -0,0 +1,178 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file GaussJordanEngine.h
+ * \brief Propagation of XOR constraints via Gauss-Jordan elimination
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/solver/Assignment.h>
+
+namespace jamsat {
+
+/**
+ * \ingroup JamSAT_Solver
+ *
+ * \brief An XOR constraint, satisfied iff the sum of its variables' values
+ *   modulo 2 is equal to its parity.
+ */
+struct XorConstraint {
+  std::vector<CNFVar> variables;
+  bool parity;
+};
+
+/**
+ * \ingroup JamSAT_Solver
+ *
+ * \brief Propagates a system of XOR constraints.
+ *
+ * The constraints passed to setConstraints() are transformed into reduced row
+ * echelon form via Gauss-Jordan elimination. During search, each row is watched
+ * on two unassigned variables. A row with a single unassigned variable forces the
+ * assignment of that variable, and a fully assigned row with the wrong parity is
+ * conflicting. The reasons of forced assignments and the conflicting clauses are
+ * materialized as clauses owned by the engine, so they can be processed by
+ * FirstUIPLearning without being added to the clause database. The reasons are
+ * released when backtracking past the forced assignments.
+ */
+class GaussJordanEngine {
+public:
+  /**
+   * \brief Constructs an engine without constraints.
+   *
+   * \param maxVar      The maximum variable occurring in the assignments passed to
+   *                    propagate().
+   * \param maxMatrixSize   The maximum amount of bits of the matrix used for the
+   *                    elimination. Larger systems of constraints are propagated
+   *                    without elimination.
+   */
+  explicit GaussJordanEngine(CNFVar maxVar, uint64_t maxMatrixSize = 1ULL << 26);
+
+  /**
+   * \brief Replaces the engine's constraints.
+   *
+   * Rows consisting of a single variable are not retained: the literals forced by
+   * these rows are added to \p units instead.
+   *
+   * \param constraints     The new constraints, containing no variable greater than
+   *                        the engine's maximum variable.
+   * \param units           Receives the literals implied by the constraints.
+   *
+   * \returns false iff the constraints are inconsistent.
+   *
+   * \throw std::bad_alloc on memory allocation failure.
+   */
+  auto setConstraints(std::vector<XorConstraint> const& constraints, std::vector<CNFLit>& units)
+      -> bool;
+
+  /**
+   * \brief Propagates the constraints under the assignments of \p assignment not
+   *   yet seen by the engine.
+   *
+   * The reason of each assignment forced by a constraint is materialized as a clause
+   * owned by the engine and passed to Assignment::appendImplied(), with the forced
+   * literal being the first literal of the clause. The reason remains valid until the
+   * engine is notified about backtracking past the forced assignment.
+   *
+   * \param assignment      The assignment. The clauses of \p assignment must have been
+   *                        propagated until fixpoint.
+   *
+   * \returns If the assignment is conflicting, a clause falsified by the assignment
+   *   is returned. Otherwise, nullptr is returned. A clause returned by this method
+   *   is owned by the engine, and is valid until the next call to propagate().
+   *
+   * \throw std::bad_alloc on memory allocation failure.
+   */
+  auto propagate(Assignment& assignment) -> Clause*;
+
+  /**
+   * \brief Notifies the engine about backtracking, releasing the reasons of the
+   *   undone assignments.
+   *
+   * \param trailSize   The amount of assignments after backtracking.
+   */
+  void backtrack(std::size_t trailSize) noexcept;
+
+  /**
+   * \brief Increases the maximum variable.
+   *
+   * \throw std::bad_alloc on memory allocation failure.
+   */
+  void increaseMaxVarTo(CNFVar maxVar);
+
+  auto getAmntRows() const noexcept -> std::size_t;
+
+private:
+  enum class RowState { PROPAGATING, CONFLICTING, NONE };
+
+  /**
+   * Updates the watch of \p row on \p var, which has been assigned. If no unassigned
+   * replacement exists, the row's literals are stored in m_clauseBuffer if the row
+   * propagates or conflicts, with the propagated literal being the first one.
+   */
+  auto updateWatch(std::size_t row, CNFVar var, Assignment const& assignment) -> RowState;
+
+  void storeRowAsClause(std::size_t row, CNFVar unassigned, Assignment const& assignment);
+
+  auto createClauseFromBuffer() const -> std::unique_ptr<Clause>;
+
+  void addRow(std::vector<CNFVar> const& variables, bool parity);
+
+  // The rows, stored consecutively: the variables of row i are stored in m_rowVars
+  // from m_rowBegin[i] to m_rowBegin[i+1]. The watched variables of a row are its
+  // first two variables.
+  std::vector<CNFVar> m_rowVars;
+  std::vector<std::size_t> m_rowBegin;
+  std::vector<char> m_rowParities;
+
+  /** Indexed by variables: the rows watching the variable */
+  std::vector<std::vector<std::size_t>> m_watchers;
+
+  /** The index of the first trail entry not yet seen by propagate() */
+  std::size_t m_nextTrailIndex;
+  uint64_t m_maxMatrixSize;
+
+  std::vector<CNFLit> m_clauseBuffer;
+  std::unique_ptr<Clause> m_conflictingClause;
+
+  struct Reason {
+    /** The index of the forced assignment on the trail */
+    std::size_t trailIndex;
+    std::unique_ptr<Clause> clause;
+  };
+
+  /** The reasons of the forced assignments, ordered by their trail indices */
+  std::vector<Reason> m_reasons;
+};
+}
@@ -0,0 +1,71 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/** \file */
+
+#include "RephasingPolicy.h"
+
+#include <array>
+
+namespace jamsat {
+namespace {
+constexpr std::array<RephasingPolicy::Phases, 6> phaseSchedule = {
+    RephasingPolicy::Phases::ORIGINAL,
+    RephasingPolicy::Phases::BEST,
+    RephasingPolicy::Phases::INVERTED,
+    RephasingPolicy::Phases::BEST,
+    RephasingPolicy::Phases::RANDOM,
+    RephasingPolicy::Phases::BEST};
+}
+
+RephasingPolicy::RephasingPolicy(Options const& options) noexcept
+  : m_interval(options.interval), m_conflictsUntilRephase(options.interval), m_amntRephases(0)
+{
+}
+
+void RephasingPolicy::registerConflict() noexcept
+{
+  if (m_conflictsUntilRephase > 0) {
+    --m_conflictsUntilRephase;
+  }
+}
+
+auto RephasingPolicy::shouldRephase() const noexcept -> bool
+{
+  return m_conflictsUntilRephase == 0;
+}
+
+auto RephasingPolicy::getNextPhases() const noexcept -> Phases
+{
+  return phaseSchedule[m_amntRephases % phaseSchedule.size()];
+}
+
+void RephasingPolicy::registerRephase() noexcept
+{
+  ++m_amntRephases;
+  m_conflictsUntilRephase = (m_amntRephases + 1) * m_interval;
+}
+}
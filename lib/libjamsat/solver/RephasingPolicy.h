@@ -0,0 +1,109 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file RephasingPolicy.h
+ * \brief Rephasing schedule for CDCL search
+ *
+ * Rephasing policies are used to control when to reset the variable phases
+ * of CDCL search, and which phases to use instead.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace jamsat {
+
+/**
+ * \ingroup JamSAT_Solver
+ *
+ * \brief A rephasing policy with arithmetically growing rephasing intervals.
+ *
+ * The n'th rephasing is advised `n * interval` conflicts after the previous
+ * rephasing. The kinds of phases to be used are cycled through the sequence
+ * ORIGINAL, BEST, INVERTED, BEST, RANDOM, BEST.
+ */
+class RephasingPolicy {
+public:
+  /** Kinds of phases to be used when rephasing */
+  enum class Phases {
+    /// The initial phases (all variables assigned `false`)
+    ORIGINAL,
+
+    /// The inverted initial phases (all variables assigned `true`)
+    INVERTED,
+
+    /// The best phases, see Assignment::getBestPhase()
+    BEST,
+
+    /// Randomly chosen phases
+    RANDOM
+  };
+
+  struct Options {
+    /** The amount of conflicts until the first rephasing */
+    uint64_t interval = 1000;
+  };
+
+  /**
+   * \brief Constructs a RephasingPolicy instance.
+   *
+   * \param[in] options   the configuration of the rephasing policy.
+   */
+  explicit RephasingPolicy(Options const& options) noexcept;
+
+  /**
+   * \brief Notifies the rephasing policy that the client has handled a conflict.
+   */
+  void registerConflict() noexcept;
+
+  /**
+   * \brief Indicates whether the client should rephase.
+   *
+   * \returns true iff the client should rephase.
+   */
+  auto shouldRephase() const noexcept -> bool;
+
+  /**
+   * \brief Gets the kind of phases the client should use when rephasing next.
+   *
+   * \returns the kind of phases to be used for the next rephasing.
+   */
+  auto getNextPhases() const noexcept -> Phases;
+
+  /**
+   * \brief Notifies the rephasing policy that the client has rephased using the
+   *   phases returned by getNextPhases().
+   */
+  void registerRephase() noexcept;
+
+private:
+  uint64_t m_interval;
+  uint64_t m_conflictsUntilRephase;
+  uint64_t m_amntRephases;
+};
+}
@@ -59,10 +59,15 @@ bool LubyRestartPolicy::shouldRestart() const noexcept
 }
 
 GlucoseRestartPolicy::GlucoseRestartPolicy(const GlucoseRestartPolicy::Options& options) noexcept
-  : m_averageLBD(options.movingAverageWindowSize)
+  : m_fastAverageLBD(options.fastLBDSmoothingFactor)
+  , m_slowAverageLBD(options.slowLBDSmoothingFactor)
+  , m_averageTrailSize(options.trailSizeSmoothingFactor)
   , m_K(options.K)
-  , m_sumLBD(0.0F)
+  , m_R(options.R)
+  , m_minConflictsBetweenRestarts(options.minConflictsBetweenRestarts)
+  , m_blockingGraceTime(options.blockingGraceTime)
   , m_conflictCount(0ULL)
+  , m_conflictsSinceRestart(0ULL)
 {
 }
 
@@ -70,18 +75,87 @@ void GlucoseRestartPolicy::registerConflict(
     GlucoseRestartPolicy::RegisterConflictArgs&& args) noexcept
 {
   ++m_conflictCount;
-  m_sumLBD += args.learntClauseLBD;
-  m_averageLBD.add(args.learntClauseLBD);
+  ++m_conflictsSinceRestart;
+  m_fastAverageLBD.add(args.learntClauseLBD);
+  m_slowAverageLBD.add(args.learntClauseLBD);
+  m_averageTrailSize.add(args.trailSize);
+
+  if (m_conflictCount > m_blockingGraceTime &&
+      m_conflictsSinceRestart >= m_minConflictsBetweenRestarts &&
+      static_cast<double>(args.trailSize) > m_R * m_averageTrailSize.getAverage()) {
+    m_conflictsSinceRestart = 0;
+  }
 }
 
 void GlucoseRestartPolicy::registerRestart() noexcept
 {
-  m_averageLBD.clear();
+  m_conflictsSinceRestart = 0;
 }
 
 bool GlucoseRestartPolicy::shouldRestart() const noexcept
 {
-  return m_averageLBD.isFull() &&
-         ((m_averageLBD.getAverage() * m_K) > (m_sumLBD / m_conflictCount));
+  return m_conflictsSinceRestart >= m_minConflictsBetweenRestarts &&
+         ((m_fastAverageLBD.getAverage() * m_K) > m_slowAverageLBD.getAverage());
+}
+
+ModeSwitchingRestartPolicy::ModeSwitchingRestartPolicy(
+    const ModeSwitchingRestartPolicy::Options& options) noexcept
+  : m_focusedModePolicy(options.focusedModeOptions)
+  , m_stableModePolicy(options.stableModeOptions)
+  , m_mode(Mode::FOCUSED)
+  , m_conflictsInMode(0)
+  , m_modeLength(options.initialModeLength)
+  , m_modeLengthGrowthFactor(options.modeLengthGrowthFactor)
+  , m_enableStableMode(options.enableStableMode)
+{
+}
+
+void ModeSwitchingRestartPolicy::registerConflict(
+    ModeSwitchingRestartPolicy::RegisterConflictArgs&& args) noexcept
+{
+  ++m_conflictsInMode;
+  if (m_mode == Mode::FOCUSED) {
+    m_focusedModePolicy.registerConflict({args.learntClauseLBD, args.trailSize});
+  }
+  else {
+    m_stableModePolicy.registerConflict({});
+  }
+}
+
+void ModeSwitchingRestartPolicy::registerRestart() noexcept
+{
+  if (isModeLengthExceeded()) {
+    if (m_mode == Mode::STABLE) {
+      m_modeLength = static_cast<uint64_t>(m_modeLength * m_modeLengthGrowthFactor);
+    }
+    m_mode = (m_mode == Mode::FOCUSED ? Mode::STABLE : Mode::FOCUSED);
+    m_conflictsInMode = 0;
+  }
+
+  if (m_mode == Mode::FOCUSED) {
+    m_focusedModePolicy.registerRestart();
+  }
+  else {
+    m_stableModePolicy.registerRestart();
+  }
+}
+
+bool ModeSwitchingRestartPolicy::shouldRestart() const noexcept
+{
+  if (isModeLengthExceeded()) {
+    return true;
+  }
+  return m_mode == Mode::FOCUSED ? m_focusedModePolicy.shouldRestart()
+                                 : m_stableModePolicy.shouldRestart();
+}
+
+auto ModeSwitchingRestartPolicy::getMode() const noexcept -> Mode
+{
+  return m_mode;
+}
+
+auto ModeSwitchingRestartPolicy::isModeLengthExceeded() const noexcept -> bool
+{
+  return m_enableStableMode && m_conflictsInMode >= m_modeLength;
 }
 }
@@ -37,8 +37,8 @@
 #include <cstdint>
 
 #include <libjamsat/solver/LiteralBlockDistance.h>
+#include <libjamsat/utils/ExponentialMovingAverage.h>
 #include <libjamsat/utils/LubySequence.h>
-#include <libjamsat/utils/SimpleMovingAverage.h>
 
 namespace jamsat {
 
@@ -47,20 +47,47 @@ namespace jamsat {
  *
  * \brief A restart policy similar to the one used in the Glucose solver.
  *
- * This restart policy triggers a restart when `(AverageLBD * K) > (SumLBD / TotalConflictCount)`
- * with `AverageLBD` being the average LBD of the past 50 derived lemmas, K is a constant
- * (by default 0.8), SumLBD being the total sum of LBD values of derived lemmas and
- * TotalConflictCount being the total amount of lemmas derived.
+ * This restart policy triggers a restart when `(FastAverageLBD * K) > SlowAverageLBD`,
+ * with `FastAverageLBD` and `SlowAverageLBD` being fast-moving and slow-moving exponential
+ * moving averages of the LBD values of derived lemmas, and K being a constant (by default
+ * 0.8). Restarts are only triggered if at least `minConflictsBetweenRestarts` conflicts
+ * have occurred since the last restart.
+ *
+ * Like in Glucose, restarts are blocked when the assignment is likely to be close to a
+ * satisfying assignment: if the trail size at a conflict exceeds the average trail size
+ * at conflicts by the factor R (by default 1.4), the next restart is postponed by
+ * `minConflictsBetweenRestarts` conflicts.
  */
 class GlucoseRestartPolicy {
 public:
   struct Options {
-    uint64_t movingAverageWindowSize = 50;
-    double K = 0.8f;
+    /** The smoothing factor of the fast-moving average of lemma LBD values */
+    double fastLBDSmoothingFactor = 1.0 / 32;
+
+    /** The smoothing factor of the slow-moving average of lemma LBD values */
+    double slowLBDSmoothingFactor = 1e-5;
+
+    /** The factor K described above */
+    double K = 0.8;
+
+    /** The minimum amount of conflicts between two restarts */
+    uint64_t minConflictsBetweenRestarts = 50;
+
+    /** The smoothing factor of the average of trail sizes at conflicts */
+    double trailSizeSmoothingFactor = 1.0 / 5000;
+
+    /** Restarts are blocked at conflicts where the trail is R times larger than on average */
+    double R = 1.4;
+
+    /** The amount of conflicts before restarts may get blocked */
+    uint64_t blockingGraceTime = 10000;
   };
 
   struct RegisterConflictArgs {
     LBD learntClauseLBD;
+
+    /** The amount of assignments at the time of the conflict */
+    uint64_t trailSize;
   };
 
   /**
@@ -91,10 +118,15 @@ public:
   bool shouldRestart() const noexcept;
 
 private:
-  SimpleMovingAverage<LBD> m_averageLBD;
+  ExponentialMovingAverage<LBD> m_fastAverageLBD;
+  ExponentialMovingAverage<LBD> m_slowAverageLBD;
+  ExponentialMovingAverage<uint64_t> m_averageTrailSize;
   double m_K;
-  double m_sumLBD;
+  double m_R;
+  uint64_t m_minConflictsBetweenRestarts;
+  uint64_t m_blockingGraceTime;
   uint64_t m_conflictCount;
+  uint64_t m_conflictsSinceRestart;
 };
 
 /**
@@ -152,4 +184,95 @@ private:
   uint64_t m_conflictsUntilRestart;
   const uint64_t m_log2OfScaleFactor;
 };
+
+/**
+ * \ingroup JamSAT_Solver
+ *
+ * \brief A restart policy alternating between a focused and a stable search mode.
+ *
+ * In focused mode, restarts are issued by a GlucoseRestartPolicy, leading to
+ * frequent restarts. In stable mode, restarts are issued by a LubyRestartPolicy,
+ * leading to rare restarts. The search starts in focused mode. The modes are
+ * switched when the amount of conflicts since the last mode switch exceeds the
+ * current mode length. The switch is performed when the client restarts, which
+ * is immediately advised by the policy when the mode length has been exceeded.
+ * After each stable mode, the mode length is multiplied by a constant factor.
+ */
+class ModeSwitchingRestartPolicy {
+public:
+  enum class Mode { FOCUSED, STABLE };
+
+  struct Options {
+    GlucoseRestartPolicy::Options focusedModeOptions = GlucoseRestartPolicy::Options{};
+
+    /**
+     * The Luby unit (2^8 conflicts) is smaller than the initial mode length, so that
+     * restarts are issued even within the first stable mode.
+     */
+    LubyRestartPolicy::Options stableModeOptions = LubyRestartPolicy::Options{0, 8};
+
+    /** The amount of conflicts until the first mode switch */
+    uint64_t initialModeLength = 1000;
+
+    /** The factor by which the mode length grows after each stable mode */
+    double modeLengthGrowthFactor = 2.0;
+
+    /** Iff `false`, the policy remains in focused mode. */
+    bool enableStableMode = true;
+  };
+
+  struct RegisterConflictArgs {
+    LBD learntClauseLBD;
+
+    /** The amount of assignments at the time of the conflict */
+    uint64_t trailSize;
+  };
+
+  /**
+   * \brief Constructs a ModeSwitchingRestartPolicy instance.
+   *
+   * \param[in] options   the configuration of the restart policy.
+   */
+  explicit ModeSwitchingRestartPolicy(const Options& options) noexcept;
+
+  /**
+   * \brief Notifies the restart policy that the client has handled a conflict.
+   *
+   * \param[in] args      client state just after handling the conflict. See
+   * ModeSwitchingRestartPolicy::RegisterConflictArgs.
+   */
+  void registerConflict(RegisterConflictArgs&& args) noexcept;
+
+  /**
+   * \brief Notifies the restart policy that the client has handled a restart.
+   *
+   * If the current mode length has been exceeded, the mode is switched.
+   */
+  void registerRestart() noexcept;
+
+  /**
+   * \brief Indicates whether the client should restart.
+   *
+   * \returns true iff the client should restart.
+   */
+  bool shouldRestart() const noexcept;
+
+  /**
+   * \brief Gets the current search mode.
+   *
+   * \returns the current search mode.
+   */
+  auto getMode() const noexcept -> Mode;
+
+private:
+  auto isModeLengthExceeded() const noexcept -> bool;
+
+  GlucoseRestartPolicy m_focusedModePolicy;
+  LubyRestartPolicy m_stableModePolicy;
+  Mode m_mode;
+  uint64_t m_conflictsInMode;
+  uint64_t m_modeLength;
+  double m_modeLengthGrowthFactor;
+  bool m_enableStableMode;
+};
 }
@@ -26,6 +26,7 @@
 
 #include "Statistics.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -38,9 +39,32 @@ auto OptimizationStats::operator+=(OptimizationStats const& rhs) -> Optimization
   amntClausesAdded += rhs.amntClausesAdded;
   amntVarsEliminated += rhs.amntVarsEliminated;
   amntVarsAdded += rhs.amntVarsAdded;
+
+  for (OptimizerRunStats const& rhsOptimizerStats : rhs.perOptimizer) {
+    OptimizerRunStats& target = getOptimizerStats(rhsOptimizerStats.name);
+    target.amntRuns += rhsOptimizerStats.amntRuns;
+    target.amntPreemptions += rhsOptimizerStats.amntPreemptions;
+    target.amntTicks += rhsOptimizerStats.amntTicks;
+    target.microsecondsSpent += rhsOptimizerStats.microsecondsSpent;
+    target.benefit += rhsOptimizerStats.benefit;
+  }
   return *this;
 }
 
+auto OptimizationStats::getOptimizerStats(std::string const& name) -> OptimizerRunStats&
+{
+  auto it = std::find_if(perOptimizer.begin(),
+                         perOptimizer.end(),
+                         [&name](OptimizerRunStats const& stats) { return stats.name == name; });
+  if (it != perOptimizer.end()) {
+    return *it;
+  }
+
+  perOptimizer.emplace_back();
+  perOptimizer.back().name = name;
+  return perOptimizer.back();
+}
+
 
 auto operator<<(std::ostream& output, OptimizationStats const& stats) -> std::ostream&
 {
@@ -51,9 +75,18 @@ auto operator<<(std::ostream& output, OptimizationStats const& stats) -> std::os
            << ",ClR" << stats.amntClausesRemoved
            << ",ClA:" << stats.amntClausesAdded
            << ",VE:" << stats.amntVarsEliminated
-           << ",VA:" << stats.amntVarsAdded
-           << "}";
-           return output;
+           << ",VA:" << stats.amntVarsAdded;
+    for (OptimizerRunStats const& optimizerStats : stats.perOptimizer) {
+      output << "," << optimizerStats.name << ":["
+             << "R:" << optimizerStats.amntRuns
+             << ",P:" << optimizerStats.amntPreemptions
+             << ",Ti:" << optimizerStats.amntTicks
+             << ",T:" << (optimizerStats.microsecondsSpent / 1000) << "ms"
+             << ",B:" << optimizerStats.benefit
+             << "]";
+    }
+    output << "}";
+    return output;
   // clang-format on
 }
 
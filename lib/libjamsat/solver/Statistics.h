@@ -35,7 +35,9 @@
 #include <cstdint>
 #include <ostream>
 #include <sstream>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -43,6 +45,22 @@
 
 namespace jamsat {
 
+/**
+ * \brief Effort and benefit statistics of a single problem optimizer
+ *
+ * \ingroup JamSAT_Solver
+ */
+struct OptimizerRunStats {
+  std::string name;
+  uint64_t amntRuns = 0;
+  uint64_t amntPreemptions = 0;
+  uint64_t amntTicks = 0;
+  uint64_t microsecondsSpent = 0;
+
+  /** Sum of derived facts, removed literals, removed clauses and eliminated variables */
+  uint64_t benefit = 0;
+};
+
 /**
  * \brief Optimization statistics
  *
@@ -56,6 +74,15 @@ struct OptimizationStats {
   uint64_t amntVarsEliminated = 0;
   uint64_t amntVarsAdded = 0;
 
+  /** Per-optimizer statistics, with at most one element per optimizer name */
+  std::vector<OptimizerRunStats> perOptimizer;
+
+  /**
+   * \brief Returns the statistics of the optimizer with the given name, adding
+   *   an empty entry if no such statistics exist yet.
+   */
+  auto getOptimizerStats(std::string const& name) -> OptimizerRunStats&;
+
   auto operator+=(OptimizationStats const& rhs) -> OptimizationStats&;
 };
 
@@ -89,6 +116,9 @@ struct StatisticsEra {
   uint64_t m_unitLemmas = 0;
   uint64_t m_binaryLemmas = 0;
   uint64_t m_lemmaDeletions = 0;
+  uint64_t m_coreLemmas = 0;
+  uint64_t m_tier2Lemmas = 0;
+  uint64_t m_localLemmas = 0;
   OptimizationStats m_optimizationStats;
   SimpleMovingAverage<uint32_t> m_avgLemmaSize{1000};
   double m_avgLBD = 0.0;
@@ -156,6 +186,16 @@ public:
    */
   void registerLemmaDeletion(uint32_t amount);
 
+  /**
+   * \brief Notifies the statistics about the amount of lemmas in each tier of the
+   *   clause database. These statistics are kept if lemma deletions are counted.
+   *
+   * \param core     The amount of core lemmas.
+   * \param tier2    The amount of tier-2 lemmas.
+   * \param local    The amount of local lemmas.
+   */
+  void registerLemmaTierSizes(uint64_t core, uint64_t tier2, uint64_t local) noexcept;
+
   /**
    * \brief Notifies the statistics system about optimizations performed
    *   on the problem instance.
@@ -289,6 +329,18 @@ void Statistics<StatisticsConfig>::registerLemmaDeletion(uint32_t amount)
   }
 }
 
+template <typename StatisticsConfig>
+void Statistics<StatisticsConfig>::registerLemmaTierSizes(uint64_t core,
+                                                          uint64_t tier2,
+                                                          uint64_t local) noexcept
+{
+  if (StatisticsConfig::CountLemmaDeletions::value == true) {
+    m_currentEra.m_coreLemmas = core;
+    m_currentEra.m_tier2Lemmas = tier2;
+    m_currentEra.m_localLemmas = local;
+  }
+}
+
 template <typename StatisticsConfig>
 void Statistics<StatisticsConfig>::registerOptimizationStatistics(OptimizationStats const& stats)
 {
@@ -331,6 +383,8 @@ auto Statistics<StatisticsConfig>::getStatisticsDescription() const -> std::stri
            "  #U = amount of unit lemmas added; " \
            "#B = amount of binary lemmas added; " \
            "#LD = amount of lemmas deleted; " \
+           "#T = amount of core/tier-2/local lemmas;\n" \
+           "  " \
            "O = optimization stats"};
   // clang-format on
 }
@@ -356,6 +410,8 @@ auto operator<<(std::ostream& stream, const Statistics<StatisticsConfig>& stats)
 
   if (StatisticsConfig::CountLemmaDeletions::value == true) {
     stream << "| #LD: " << currentEra.m_lemmaDeletions << " ";
+    stream << "| #T: " << currentEra.m_coreLemmas << "/" << currentEra.m_tier2Lemmas << "/"
+           << currentEra.m_localLemmas << " ";
   }
 
   if (StatisticsConfig::CountConflicts::value == true) {
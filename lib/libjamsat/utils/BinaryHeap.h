@@ -115,12 +115,8 @@ public:
   /**
    * \brief Removes all elements from the heap.
    *
-   * Precondition: the heap must not be empty.
-   *
-   * \returns the greatest object contained in the heap.
-   *
    * \par Complexity
-   * Worst case: `O(1)`
+   * Worst case: `O(size())`
    */
   void clear() noexcept;
 
@@ -431,6 +427,9 @@ auto BinaryMaxHeap<K, Comparator, KIndex>::removeMax() noexcept -> K
 template <typename K, typename Comparator, typename KIndex>
 void BinaryMaxHeap<K, Comparator, KIndex>::clear() noexcept
 {
+  for (size_type i = 0; i < m_size; ++i) {
+    m_indices[m_heap[i]] = -1;
+  }
   m_size = 0;
 }
 
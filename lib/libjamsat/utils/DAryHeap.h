@@ -0,0 +1,482 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file utils/DAryHeap.h
+ * \brief Fast d-ary heap implementation with inlined keys
+ */
+
+#pragma once
+
+#include <libjamsat/utils/Assert.h>
+#include <libjamsat/utils/BoundedMap.h>
+#include <libjamsat/utils/Casts.h>
+#include <libjamsat/utils/Concepts.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace jamsat {
+
+/**
+ * \brief A d-ary max-heap of objects ordered by numeric keys, storing the keys
+ * next to the heap entries.
+ *
+ * In contrast to `BinaryMaxHeap`, this heap does not use a comparator for
+ * ordering its elements. Instead, each element is associated with a numeric key
+ * managed by the heap, and the keys of the elements residing in the heap are
+ * stored in an array parallel to the heap array. Thus, comparing heap entries
+ * does not require accessing memory outside the heap, and the keys of the
+ * children of a heap node are adjacent in memory. With `Arity` = 4 and 32-bit
+ * keys, the keys of all children of a node fit into 16 bytes.
+ *
+ * Like `BinaryMaxHeap`, this heap performs allocations only during construction
+ * and in `increaseMaxSizeTo()`.
+ *
+ * \ingroup JamSAT_Utils
+ *
+ * \tparam K            The type of the values to be stored in the heap.
+ *                      `K` must satisfy the STL concepts `DefaultConstructible`,
+ *                      `CopyConstructible` and `CopyAssignable`.
+ * \tparam Key          The arithmetic type of the keys by which the elements are
+ *                      ordered.
+ * \tparam Arity        The maximum amount of children of a heap node. Must be at
+ *                      least 2.
+ * \tparam KIndex       A type that is a model of the concept `Index` with indexed
+ *                      type `K`.
+ */
+template <typename K, typename Key, std::size_t Arity = 4, typename KIndex = typename K::Index>
+class DAryMaxHeap {
+  static_assert(is_index<KIndex, K>::value, "KIndex must satisfy Index for K, but does not");
+  static_assert(std::is_arithmetic<Key>::value, "Key must be an arithmetic type");
+  static_assert(Arity >= 2, "Arity must be at least 2");
+
+public:
+  using size_type = size_t;
+
+  /**
+   * \brief Constructs an empty max-heap.
+   *
+   * The keys of all elements are initialized to `Key{0}`.
+   *
+   * \param maxElement    The maximal element (wrt. KIndex) that will be
+   *                      stored in the heap.
+   *
+   * \par Complexity
+   * Worst case: `O(KIndex::getIndex(maxElement))`
+   */
+  explicit DAryMaxHeap(K maxElement);
+
+  /**
+   * \brief Inserts an element into the heap.
+   *
+   * \param element   The value to be inserted. `element` must not be larger
+   *                  (wrt. KIndex) than the current maximal element.
+   *
+   * If `element` is already contained in the heap, no insertion is performed.
+   *
+   * \par Complexity
+   * Worst case: `O(log(size()))`
+   */
+  void insert(K element) noexcept;
+
+  /**
+   * \brief Removes the element with the greatest key from the heap and returns it.
+   *
+   * Precondition: the heap must not be empty.
+   *
+   * \returns the element with the greatest key contained in the heap.
+   *
+   * \par Complexity
+   * Worst case: `O(Arity * log(size()))`
+   */
+  auto removeMax() noexcept -> K;
+
+  /**
+   * \brief Removes all elements from the heap.
+   *
+   * The keys of the elements are not changed.
+   *
+   * \par Complexity
+   * Worst case: `O(size())`
+   */
+  void clear() noexcept;
+
+  /**
+   * \brief Returns the amount of elements currently stored in the heap.
+   *
+   * \returns the amount of elements currently stored in the heap.
+   *
+   * \par Complexity
+   * Worst case: `O(1)`
+   */
+  auto size() const noexcept -> size_type;
+
+  /**
+   * \brief Determines whether the heap is empty.
+   *
+   * \returns `true` iff the heap is empty.
+   *
+   * \par Complexity
+   * Worst case: `O(1)`
+   */
+  auto empty() const noexcept -> bool;
+
+  /**
+   * \brief Determines whether the heap contains a given element.
+   *
+   * \param element   The element to be looked up. `element` must not be larger
+   *                  (wrt. KIndex) than the current maximal element.
+   *
+   * \returns true iff the heap contains `element`.
+   *
+   * \par Complexity
+   * Worst case: `O(1)`
+   */
+  auto contains(K element) const noexcept -> bool;
+
+  /**
+   * \brief Returns the key of the given element.
+   *
+   * \param element   An element not larger (wrt. KIndex) than the current
+   *                  maximal element. `element` is not required to be contained
+   *                  in the heap.
+   *
+   * \returns the key of `element`.
+   *
+   * \par Complexity
+   * Worst case: `O(1)`
+   */
+  auto getKey(K element) const noexcept -> Key;
+
+  /**
+   * \brief Sets the key of the given element and restores the heap property.
+   *
+   * \param element   An element not larger (wrt. KIndex) than the current
+   *                  maximal element. `element` is not required to be contained
+   *                  in the heap.
+   * \param key       The new key of `element`.
+   *
+   * \par Complexity
+   * Worst case: `O(Arity * log(size()))`
+   */
+  void setKey(K element, Key key) noexcept;
+
+  /**
+   * \brief Multiplies the keys of all elements with the given factor.
+   *
+   * Since `factor` is positive, the order of the elements is preserved and the
+   * heap does not need to be restructured. The keys are scaled in loops over
+   * contiguous arrays, which compilers can vectorize.
+   *
+   * \param factor    A positive factor.
+   *
+   * \par Complexity
+   * Worst case: `O(KIndex::getIndex(maxElement))`
+   */
+  void scaleKeys(Key factor) noexcept;
+
+  /**
+   * \brief Increases the maximal element storable in the heap.
+   *
+   * The keys of the new elements are initialized to `Key{0}`.
+   *
+   * \param newMaxElement     The new maximal element. `newMaxElement`
+   *                          must not be smaller than the current maximal
+   *                          element.
+   *
+   * \par Complexity
+   * Worst case: `O(KIndex::getIndex(newMaxElement))`
+   */
+  void increaseMaxSizeTo(K newMaxElement);
+
+  /**
+   * \brief Checks the heap's internal consistency.
+   *
+   * This method should only be called by tests.
+   *
+   * \returns true iff the heap is internally consistent.
+   *
+   * \par Complexity
+   * Worst case: `O(size())`
+   */
+  auto test_satisfiesHeapProperty() const noexcept -> bool;
+
+private:
+  using Index = int32_t;
+
+  static constexpr auto getParentIdx(size_type index) noexcept -> size_type;
+  static constexpr auto getFirstChildIdx(size_type index) noexcept -> size_type;
+
+  void moveUp(size_type index) noexcept;
+  void moveDown(size_type index) noexcept;
+
+  /// Maps all insertable objects to their rsp. key.
+  BoundedMap<K, Key, KIndex> m_keys;
+
+  /// Maps stored objects to their rsp. index in m_heapElements.
+  /// Objects that are not contained in the heap have the index -1.
+  BoundedMap<K, Index, KIndex> m_indices;
+
+  /// The heap array: for all `i` in `[0, m_size)`, the key of the element
+  /// `m_heapElements[i]` is `m_heapKeys[i]`, and for all children `c` of `i`,
+  /// `m_heapKeys[c] <= m_heapKeys[i]`. The children of `i` are the indices
+  /// in `[getFirstChildIdx(i), getFirstChildIdx(i) + Arity)` that are smaller
+  /// than `m_size`.
+  std::vector<K> m_heapElements;
+  std::vector<Key> m_heapKeys;
+
+  /// The amount of elements currently residing in the heap.
+  size_type m_size;
+};
+
+/********** Implementation ****************************** */
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+DAryMaxHeap<K, Key, Arity, KIndex>::DAryMaxHeap(K maxElement)
+  : m_keys{maxElement, Key{0}}
+  , m_indices{maxElement, -1}
+  , m_heapElements(KIndex::getIndex(maxElement) + 1)
+  , m_heapKeys(KIndex::getIndex(maxElement) + 1)
+  , m_size{0}
+{
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+void DAryMaxHeap<K, Key, Arity, KIndex>::increaseMaxSizeTo(K newMaxElement)
+{
+  JAM_ASSERT(KIndex::getIndex(newMaxElement) + 1 >= m_heapElements.size(),
+             "Unable to shrink the heap");
+  m_heapElements.resize(KIndex::getIndex(newMaxElement) + 1);
+  m_heapKeys.resize(KIndex::getIndex(newMaxElement) + 1);
+  m_keys.increaseSizeTo(newMaxElement);
+  m_indices.increaseSizeTo(newMaxElement);
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+auto DAryMaxHeap<K, Key, Arity, KIndex>::size() const noexcept -> size_type
+{
+  return m_size;
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+auto DAryMaxHeap<K, Key, Arity, KIndex>::empty() const noexcept -> bool
+{
+  return m_size == 0;
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+auto DAryMaxHeap<K, Key, Arity, KIndex>::contains(K element) const noexcept -> bool
+{
+  return m_indices[element] >= 0;
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+auto DAryMaxHeap<K, Key, Arity, KIndex>::getKey(K element) const noexcept -> Key
+{
+  return m_keys[element];
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+constexpr auto DAryMaxHeap<K, Key, Arity, KIndex>::getParentIdx(size_type index) noexcept
+    -> size_type
+{
+  return (index - 1) / Arity;
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+constexpr auto DAryMaxHeap<K, Key, Arity, KIndex>::getFirstChildIdx(size_type index) noexcept
+    -> size_type
+{
+  return Arity * index + 1;
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+void DAryMaxHeap<K, Key, Arity, KIndex>::insert(K element) noexcept
+{
+  if (contains(element)) {
+    return;
+  }
+  JAM_ASSERT(m_size != m_heapElements.size(), "Heap out of space");
+
+  size_type const insertionIndex = m_size;
+  ++m_size;
+  m_heapElements[insertionIndex] = element;
+  m_heapKeys[insertionIndex] = m_keys[element];
+  m_indices[element] = static_checked_cast<Index>(insertionIndex);
+
+  // The new element might be larger than its parent ~> restore
+  // heap property by moving it up:
+  moveUp(insertionIndex);
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+void DAryMaxHeap<K, Key, Arity, KIndex>::setKey(K element, Key key) noexcept
+{
+  Key const oldKey = m_keys[element];
+  m_keys[element] = key;
+
+  if (!contains(element)) {
+    return;
+  }
+
+  size_type const index = static_cast<size_type>(m_indices[element]);
+  m_heapKeys[index] = key;
+  if (key >= oldKey) {
+    moveUp(index);
+  }
+  else {
+    moveDown(index);
+  }
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+void DAryMaxHeap<K, Key, Arity, KIndex>::moveUp(size_type index) noexcept
+{
+  K const element = m_heapElements[index];
+  Key const key = m_heapKeys[index];
+
+  while (index != 0) {
+    size_type const parentIdx = getParentIdx(index);
+    if (key < m_heapKeys[parentIdx]) {
+      break;
+    }
+
+    // element is not smaller than the current parent -> move down the parent
+    K const parent = m_heapElements[parentIdx];
+    m_heapElements[index] = parent;
+    m_heapKeys[index] = m_heapKeys[parentIdx];
+    m_indices[parent] = static_cast<Index>(index);
+    index = parentIdx;
+  }
+
+  m_heapElements[index] = element;
+  m_heapKeys[index] = key;
+  m_indices[element] = static_cast<Index>(index);
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+void DAryMaxHeap<K, Key, Arity, KIndex>::moveDown(size_type index) noexcept
+{
+  K const element = m_heapElements[index];
+  Key const key = m_heapKeys[index];
+
+  while (getFirstChildIdx(index) < m_size) {
+    size_type const firstChildIdx = getFirstChildIdx(index);
+    size_type const childrenEnd = std::min(firstChildIdx + Arity, m_size);
+
+    size_type maxChildIdx = firstChildIdx;
+    for (size_type childIdx = firstChildIdx + 1; childIdx < childrenEnd; ++childIdx) {
+      if (m_heapKeys[maxChildIdx] < m_heapKeys[childIdx]) {
+        maxChildIdx = childIdx;
+      }
+    }
+
+    if (!(key < m_heapKeys[maxChildIdx])) {
+      break;
+    }
+
+    // element is smaller than the largest child -> move the child upwards
+    K const maxChild = m_heapElements[maxChildIdx];
+    m_heapElements[index] = maxChild;
+    m_heapKeys[index] = m_heapKeys[maxChildIdx];
+    m_indices[maxChild] = static_cast<Index>(index);
+    index = maxChildIdx;
+  }
+
+  JAM_ASSERT(index < m_size, "Cursor index out of range");
+  m_heapElements[index] = element;
+  m_heapKeys[index] = key;
+  m_indices[element] = static_cast<Index>(index);
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+auto DAryMaxHeap<K, Key, Arity, KIndex>::removeMax() noexcept -> K
+{
+  JAM_ASSERT(m_size > 0, "Cannot remove from an empty heap");
+  K const result = m_heapElements[0];
+  m_indices[result] = -1;
+  --m_size;
+
+  if (m_size > 0) {
+    // The first element has been removed, so restore the heap property
+    // by moving the last element to the top and then moving it down:
+    m_heapElements[0] = m_heapElements[m_size];
+    m_heapKeys[0] = m_heapKeys[m_size];
+    moveDown(0);
+  }
+
+  return result;
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+void DAryMaxHeap<K, Key, Arity, KIndex>::clear() noexcept
+{
+  for (size_type i = 0; i < m_size; ++i) {
+    m_indices[m_heapElements[i]] = -1;
+  }
+  m_size = 0;
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+void DAryMaxHeap<K, Key, Arity, KIndex>::scaleKeys(Key factor) noexcept
+{
+  JAM_ASSERT(factor > Key{0}, "Argument factor must be positive");
+
+  // Scaling the keys via raw pointers, so that the loops can be vectorized:
+  Key* keys = &(*m_keys.values().begin());
+  size_type const amntKeys = m_keys.size();
+  for (size_type i = 0; i < amntKeys; ++i) {
+    keys[i] *= factor;
+  }
+
+  Key* heapKeys = m_heapKeys.data();
+  for (size_type i = 0; i < m_size; ++i) {
+    heapKeys[i] *= factor;
+  }
+}
+
+template <typename K, typename Key, std::size_t Arity, typename KIndex>
+auto DAryMaxHeap<K, Key, Arity, KIndex>::test_satisfiesHeapProperty() const noexcept -> bool
+{
+  for (size_type i = 0; i < m_size; ++i) {
+    if (m_indices[m_heapElements[i]] != static_cast<Index>(i) ||
+        m_keys[m_heapElements[i]] != m_heapKeys[i]) {
+      return false;
+    }
+
+    size_type const firstChildIdx = getFirstChildIdx(i);
+    for (size_type c = firstChildIdx; c < m_size && c < firstChildIdx + Arity; ++c) {
+      if (m_heapKeys[i] < m_heapKeys[c]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
@@ -0,0 +1,128 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file utils/ExponentialMovingAverage.h
+ * \brief Implementation of ExponentialMovingAverage
+ */
+
+#pragma once
+
+namespace jamsat {
+
+/**
+ * \ingroup JamSAT_Utils
+ *
+ * \class jamsat::ExponentialMovingAverage
+ *
+ * \brief A data structure for computing bias-corrected exponential moving averages.
+ *
+ * The average `A` is initialized with 0 and updated via `A := A + alpha * (value - A)`
+ * for each added value, with `alpha` being the smoothing factor. Since the initial
+ * value 0 biases `A` towards 0, `A / (1 - (1 - alpha)^n)` is reported as the average
+ * after `n` values have been added. Adding values and computing the average are
+ * constant-time operations, and no memory is allocated.
+ *
+ * \tparam T        The type of the values to be averaged.
+ * \tparam Average  The type of the mean value. Must be a floating-point type.
+ */
+template <typename T, typename Average = double>
+class ExponentialMovingAverage {
+public:
+  /**
+   * \brief Constructs an ExponentialMovingAverage instance with an empty sequence of
+   *        elements.
+   *
+   * \param smoothingFactor   The weight of newly added values, in `(0, 1]`. The
+   *                          smaller the smoothing factor, the slower the average moves.
+   */
+  explicit ExponentialMovingAverage(Average smoothingFactor) noexcept;
+
+  /**
+   * \brief Adds the given value to the sequence of elements whose mean value
+   *        can be computed.
+   *
+   * \param value     The value to be added.
+   */
+  void add(T value) noexcept;
+
+  /**
+   * \brief Computes the bias-corrected exponential moving average of the values
+   *        previously passed to \p add() .
+   *
+   * If no values have been passed yet to \p add() , this method returns 0.
+   *
+   * \returns The mean value as described above.
+   */
+  Average getAverage() const noexcept;
+
+  /**
+   * \brief Removes all elements.
+   */
+  void clear() noexcept;
+
+private:
+  Average m_smoothingFactor;
+  Average m_biasedAverage;
+
+  /** `(1 - alpha)^n`, with `n` being the amount of added values */
+  Average m_bias;
+};
+
+/********** Implementation ****************************** */
+
+template <typename T, typename Average>
+ExponentialMovingAverage<T, Average>::ExponentialMovingAverage(Average smoothingFactor) noexcept
+  : m_smoothingFactor(smoothingFactor), m_biasedAverage(0), m_bias(1)
+{
+}
+
+template <typename T, typename Average>
+void ExponentialMovingAverage<T, Average>::add(T value) noexcept
+{
+  m_biasedAverage += m_smoothingFactor * (static_cast<Average>(value) - m_biasedAverage);
+
+  // Setting the bias to 0 when it becomes negligible, avoiding computations on
+  // denormalized numbers:
+  m_bias = (m_bias > static_cast<Average>(1e-20)) ? m_bias * (1 - m_smoothingFactor) : 0;
+}
+
+template <typename T, typename Average>
+Average ExponentialMovingAverage<T, Average>::getAverage() const noexcept
+{
+  if (m_bias == static_cast<Average>(1)) {
+    return static_cast<Average>(0);
+  }
+  return m_biasedAverage / (1 - m_bias);
+}
+
+template <typename T, typename Average>
+void ExponentialMovingAverage<T, Average>::clear() noexcept
+{
+  m_biasedAverage = 0;
+  m_bias = 1;
+}
+}
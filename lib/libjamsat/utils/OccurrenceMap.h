@@ -195,6 +195,22 @@ public:
    */
   void resolveModifications();
 
+  /**
+   * \brief Removes all containers satisfying the given predicate from the occurrence map.
+   *
+   * In contrast to `remove()`, the removal is performed eagerly and the removed
+   * containers are not accessed by the occurrence map. Thus, this function can be used
+   * to remove containers which have been destroyed or moved.
+   *
+   * \param pred         The predicate determining which containers to remove. `pred` is
+   *                     invoked with `Container const*` arguments which may be dangling.
+   *
+   * \tparam ContainerPredicate  A type satisfying the STL UnaryPredicate concept for
+   *                             `Container const*` arguments.
+   */
+  template <typename ContainerPredicate>
+  void removeIf(ContainerPredicate const& pred);
+
   /**
    * \brief Removes all elements from the occurrence map.
    */
@@ -427,8 +443,10 @@ void OccurrenceMap<Container, ContainerDeletedQuery, ContainerModifiedQuery, Con
     m_modifiedQuery.clearModified(*c);
   }
 
-  JAM_ASSERT(m_delModUpdates.empty(),
-             "Elements requiring updates remain after resolution of all modifications");
+  // The remaining entries belong to containers which have been deleted after
+  // their modification, and which have already been removed from the occurrence
+  // lists for that reason:
+  m_delModUpdates.clear();
 }
 
 template <typename Container,
@@ -445,6 +463,29 @@ operator[](value_type value) noexcept -> ContainerRange
   return boost::make_iterator_range(occList.cbegin(), occList.cend());
 }
 
+template <typename Container,
+          typename ContainerDeletedQuery,
+          typename ContainerModifiedQuery,
+          typename ContainerValueIndex>
+template <typename ContainerPredicate>
+void OccurrenceMap<Container, ContainerDeletedQuery, ContainerModifiedQuery, ContainerValueIndex>::
+    removeIf(ContainerPredicate const& pred)
+{
+  for (auto& occurrences : m_occurrences.values()) {
+    boost::remove_erase_if(occurrences.m_occList,
+                           [&pred](Container const* container) { return pred(container); });
+  }
+
+  for (auto iter = m_delModUpdates.begin(); iter != m_delModUpdates.end();) {
+    if (pred(iter->first)) {
+      iter = m_delModUpdates.erase(iter);
+    }
+    else {
+      ++iter;
+    }
+  }
+}
+
 template <typename Container,
           typename ContainerDeletedQuery,
           typename ContainerModifiedQuery,
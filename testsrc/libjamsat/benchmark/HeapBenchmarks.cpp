@@ -0,0 +1,231 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+/**
+ * \file HeapBenchmarks.cpp
+ * \brief Microbenchmarks comparing BinaryMaxHeap and DAryMaxHeap as decision heaps
+ *
+ * The benchmarks simulate the decision heap usage of VSIDS: in each round,
+ * the activities of a few random variables are bumped, a sequence of variables
+ * is removed from the heap (as for branching decisions and propagations), and
+ * the removed variables are reinserted (as for backtracking).
+ *
+ * Usage: jstest.libjamsat.benchmark.heaps [<amount of variables> [<amount of rounds>]]
+ */
+
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/utils/BinaryHeap.h>
+#include <libjamsat/utils/BoundedMap.h>
+#include <libjamsat/utils/DAryHeap.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace jamsat {
+namespace {
+
+struct BenchmarkParams {
+  CNFVar::RawVariable amntVariables = 1000000;
+  uint64_t amntRounds = 20000;
+  uint64_t amntBumpsPerRound = 64;
+  uint64_t amntRemovalsPerRound = 256;
+  uint64_t amntRescales = 100;
+};
+
+struct BenchmarkResult {
+  double heapOpSeconds = 0.0;
+  double rescaleSeconds = 0.0;
+  uint64_t checksum = 0;
+};
+
+/// The activity order formerly used with BinaryMaxHeap in the VSIDS heuristic
+class DoubleActivityOrder {
+public:
+  explicit DoubleActivityOrder(CNFVar maxVar) : m_activity(maxVar, 0.0) {}
+
+  auto operator()(CNFVar lhs, CNFVar rhs) const noexcept -> bool
+  {
+    return m_activity[lhs] < m_activity[rhs];
+  }
+
+  auto getActivityMap() noexcept -> BoundedMap<CNFVar, double>& { return m_activity; }
+
+  void increaseMaxSizeTo(CNFVar newMaxElement) { m_activity.increaseSizeTo(newMaxElement); }
+
+private:
+  BoundedMap<CNFVar, double> m_activity;
+};
+
+class BinaryHeapAdapter {
+public:
+  explicit BinaryHeapAdapter(CNFVar maxVar) : m_heap{maxVar} {}
+
+  void insert(CNFVar var) noexcept { m_heap.insert(var); }
+  auto removeMax() noexcept -> CNFVar { return m_heap.removeMax(); }
+
+  void bump(CNFVar var, double delta) noexcept
+  {
+    m_heap.getComparator().getActivityMap()[var] += delta;
+    if (m_heap.contains(var)) {
+      m_heap.increasingUpdate(var);
+    }
+  }
+
+  void rescale(double factor) noexcept
+  {
+    auto& activityMap = m_heap.getComparator().getActivityMap();
+    for (size_t i = 0; i < activityMap.size(); ++i) {
+      auto& activity = activityMap[CNFVar{static_cast<CNFVar::RawVariable>(i)}];
+      activity = factor * activity;
+    }
+  }
+
+private:
+  BinaryMaxHeap<CNFVar, DoubleActivityOrder> m_heap;
+};
+
+template <std::size_t Arity>
+class DAryHeapAdapter {
+public:
+  explicit DAryHeapAdapter(CNFVar maxVar) : m_heap{maxVar} {}
+
+  void insert(CNFVar var) noexcept { m_heap.insert(var); }
+  auto removeMax() noexcept -> CNFVar { return m_heap.removeMax(); }
+
+  void bump(CNFVar var, double delta) noexcept
+  {
+    m_heap.setKey(var, m_heap.getKey(var) + static_cast<float>(delta));
+  }
+
+  void rescale(double factor) noexcept { m_heap.scaleKeys(static_cast<float>(factor)); }
+
+private:
+  DAryMaxHeap<CNFVar, float, Arity> m_heap;
+};
+
+template <typename Heap>
+auto runBenchmark(BenchmarkParams const& params) -> BenchmarkResult
+{
+  using Clock = std::chrono::steady_clock;
+
+  CNFVar const maxVar{params.amntVariables - 1};
+  Heap heap{maxVar};
+  for (CNFVar i{0}; i <= maxVar; i = nextCNFVar(i)) {
+    heap.insert(i);
+  }
+
+  std::mt19937 rng{1};
+  std::uniform_int_distribution<CNFVar::RawVariable> varDistribution{0, maxVar.getRawValue()};
+  std::vector<CNFVar> removed;
+  removed.reserve(params.amntRemovalsPerRound);
+  double delta = 1.0;
+
+  BenchmarkResult result;
+  auto const heapOpStart = Clock::now();
+  for (uint64_t round = 0; round < params.amntRounds; ++round) {
+    for (uint64_t i = 0; i < params.amntBumpsPerRound; ++i) {
+      heap.bump(CNFVar{varDistribution(rng)}, delta);
+    }
+    delta *= 1.0 / 0.95;
+    if (delta >= 1e20) {
+      heap.rescale(1e-20);
+      delta *= 1e-20;
+    }
+
+    for (uint64_t i = 0; i < params.amntRemovalsPerRound; ++i) {
+      removed.push_back(heap.removeMax());
+    }
+    for (CNFVar var : removed) {
+      result.checksum += var.getRawValue();
+      heap.insert(var);
+    }
+    removed.clear();
+  }
+  result.heapOpSeconds = std::chrono::duration<double>(Clock::now() - heapOpStart).count();
+
+  // Rescaling is measured with a fresh heap, since activities that have not been
+  // bumped for a long time are denormal numbers after the loop above, which
+  // would distort the measurement.
+  Heap rescaledHeap{maxVar};
+  for (CNFVar i{0}; i <= maxVar; i = nextCNFVar(i)) {
+    rescaledHeap.bump(i, 1.0 + (i.getRawValue() % 1024));
+    rescaledHeap.insert(i);
+  }
+
+  auto const rescaleStart = Clock::now();
+  for (uint64_t i = 0; i < params.amntRescales; ++i) {
+    rescaledHeap.rescale((i % 2 == 0) ? 1e-10 : 1e10);
+  }
+  result.rescaleSeconds = std::chrono::duration<double>(Clock::now() - rescaleStart).count();
+  result.checksum += rescaledHeap.removeMax().getRawValue();
+
+  return result;
+}
+
+template <typename Heap>
+void runAndPrintBenchmark(std::string const& name, BenchmarkParams const& params)
+{
+  BenchmarkResult const result = runBenchmark<Heap>(params);
+  std::cout << name << ": heap operations " << result.heapOpSeconds << "s, rescaling "
+            << result.rescaleSeconds << "s (checksum " << result.checksum << ")\n";
+}
+}
+}
+
+int main(int argc, char** argv)
+{
+  jamsat::BenchmarkParams params;
+  if (argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " [<amount of variables> [<amount of rounds>]]\n";
+    return EXIT_FAILURE;
+  }
+  if (argc >= 2) {
+    params.amntVariables = static_cast<jamsat::CNFVar::RawVariable>(std::stoul(argv[1]));
+  }
+  if (argc >= 3) {
+    params.amntRounds = std::stoull(argv[2]);
+  }
+  if (params.amntVariables < params.amntRemovalsPerRound) {
+    std::cerr << "Error: the amount of variables must be at least "
+              << params.amntRemovalsPerRound << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Variables: " << params.amntVariables << ", rounds: " << params.amntRounds
+            << "\n";
+
+  using namespace jamsat;
+  runAndPrintBenchmark<BinaryHeapAdapter>("BinaryMaxHeap<CNFVar, double activities>", params);
+  runAndPrintBenchmark<DAryHeapAdapter<2>>("DAryMaxHeap<CNFVar, float, 2>", params);
+  runAndPrintBenchmark<DAryHeapAdapter<4>>("DAryMaxHeap<CNFVar, float, 4>", params);
+  runAndPrintBenchmark<DAryHeapAdapter<8>>("DAryMaxHeap<CNFVar, float, 8>", params);
+  return EXIT_SUCCESS;
+}
@@ -30,6 +30,8 @@
 #include <libjamsat/utils/ControlFlow.h>
 #include <toolbox/cnfgenerators/Rule110.h>
 
+#include <boost/filesystem.hpp>
+
 #include <chrono>
 #include <thread>
 
@@ -121,6 +123,150 @@ TEST(IpasirIntegration, assumptionsLeadingToUnsatAreMarkedAsFailed)
   EXPECT_EQ(ipasir_failed(solver, 2), 0);
 }
 
+TEST(IpasirIntegration, failedAssumptionsAreMinimizedWhenEnabled)
+{
+  void* solver = ipasir_init();
+  auto destroyOnRelease = jamsat::OnExitScope([solver]() { ipasir_release(solver); });
+
+  ASSERT_EQ(jamsat_ipasir_set_failed_minimization(solver, 1, 1000), 0);
+
+  // Under the assumptions 1, 2, 3, the conflict at -1 is reached via 2 and 3,
+  // but the problem is unsatisfiable under the assumption 1 alone:
+  for (int lit : {-2, 4, 0, -3, 5, 0, -4, -5, -1, 0, -1, 6, 0, -1, -6, 0}) {
+    ipasir_add(solver, lit);
+  }
+
+  ipasir_assume(solver, 2);
+  ipasir_assume(solver, 3);
+  ipasir_assume(solver, 1);
+
+  ASSERT_EQ(ipasir_solve(solver), 20);
+  EXPECT_EQ(ipasir_failed(solver, 1), 1);
+  EXPECT_EQ(ipasir_failed(solver, 2), 0);
+  EXPECT_EQ(ipasir_failed(solver, 3), 0);
+}
+
+TEST(IpasirIntegration, invalidFailedAssumptionMinimizationSettingsAreRejected)
+{
+  void* solver = ipasir_init();
+  auto destroyOnRelease = jamsat::OnExitScope([solver]() { ipasir_release(solver); });
+
+  EXPECT_EQ(jamsat_ipasir_set_failed_minimization(nullptr, 1, 1000), -1);
+  EXPECT_EQ(jamsat_ipasir_set_failed_minimization(solver, 2, 1000), -1);
+  EXPECT_EQ(jamsat_ipasir_set_failed_minimization(solver, 1, -1), -1);
+  EXPECT_EQ(jamsat_ipasir_set_failed_minimization(solver, 0, 0), 0);
+}
+
+TEST(IpasirIntegration, branchingHeuristicCanBeSelected)
+{
+  void* solver = ipasir_init();
+  auto destroyOnRelease = jamsat::OnExitScope([solver]() { ipasir_release(solver); });
+
+  EXPECT_EQ(jamsat_ipasir_set_branching_heuristic(solver, 1), 0);
+  for (int lit : {1, 2, 0, -1, 2, 0, 1, -2, 0}) {
+    ipasir_add(solver, lit);
+  }
+  ASSERT_EQ(ipasir_solve(solver), 10);
+  EXPECT_EQ(ipasir_val(solver, 1), 1);
+  EXPECT_EQ(ipasir_val(solver, 2), 2);
+
+  EXPECT_EQ(jamsat_ipasir_set_branching_heuristic(solver, 2), 0);
+  ipasir_assume(solver, 1);
+  EXPECT_EQ(ipasir_solve(solver), 10);
+
+  EXPECT_EQ(jamsat_ipasir_set_branching_heuristic(solver, 0), 0);
+  ipasir_add(solver, -1);
+  ipasir_add(solver, -2);
+  ipasir_add(solver, 0);
+  EXPECT_EQ(ipasir_solve(solver), 20);
+}
+
+TEST(IpasirIntegration, invalidBranchingHeuristicsAreRejected)
+{
+  void* solver = ipasir_init();
+  auto destroyOnRelease = jamsat::OnExitScope([solver]() { ipasir_release(solver); });
+
+  EXPECT_EQ(jamsat_ipasir_set_branching_heuristic(nullptr, 0), -1);
+  EXPECT_EQ(jamsat_ipasir_set_branching_heuristic(solver, -1), -1);
+  EXPECT_EQ(jamsat_ipasir_set_branching_heuristic(solver, 3), -1);
+}
+
+TEST(IpasirIntegration, branchingStateCanBeExportedAndImported)
+{
+  namespace fs = boost::filesystem;
+  fs::path const stateFile = fs::temp_directory_path() / fs::unique_path("jamsat-tmp-%%%%-%%%%");
+  auto removeOnExit = jamsat::OnExitScope([&stateFile]() { fs::remove(stateFile); });
+
+  void* exporter = ipasir_init();
+  auto releaseExporter = jamsat::OnExitScope([exporter]() { ipasir_release(exporter); });
+  for (int lit : {1, 2, 0, -1, 3, 0, -2, -3, 0}) {
+    ipasir_add(exporter, lit);
+  }
+  ASSERT_EQ(ipasir_solve(exporter), 10);
+  int const expectedVal1 = ipasir_val(exporter, 1);
+  int const expectedVal2 = ipasir_val(exporter, 2);
+  int const expectedVal3 = ipasir_val(exporter, 3);
+  ASSERT_EQ(jamsat_ipasir_export_branching_state(exporter, stateFile.string().c_str()), 0);
+
+  void* importer = ipasir_init();
+  auto releaseImporter = jamsat::OnExitScope([importer]() { ipasir_release(importer); });
+  ASSERT_EQ(jamsat_ipasir_import_branching_state(importer, stateFile.string().c_str()), 0);
+  for (int lit : {1, 2, 0, -1, 3, 0, -2, -3, 0}) {
+    ipasir_add(importer, lit);
+  }
+  ASSERT_EQ(ipasir_solve(importer), 10);
+  EXPECT_EQ(ipasir_val(importer, 1), expectedVal1);
+  EXPECT_EQ(ipasir_val(importer, 2), expectedVal2);
+  EXPECT_EQ(ipasir_val(importer, 3), expectedVal3);
+}
+
+TEST(IpasirIntegration, importingMissingBranchingStateFails)
+{
+  void* solver = ipasir_init();
+  auto destroyOnRelease = jamsat::OnExitScope([solver]() { ipasir_release(solver); });
+
+  EXPECT_EQ(jamsat_ipasir_import_branching_state(solver, "/highly/unlikely/existing/state"), -1);
+  EXPECT_EQ(jamsat_ipasir_import_branching_state(solver, nullptr), -1);
+  EXPECT_EQ(jamsat_ipasir_import_branching_state(nullptr, "state"), -1);
+  EXPECT_EQ(jamsat_ipasir_export_branching_state(solver, "/highly/unlikely/existing/state"), -1);
+  EXPECT_EQ(jamsat_ipasir_export_branching_state(nullptr, "state"), -1);
+
+  // The solver remains usable:
+  ipasir_add(solver, 1);
+  ipasir_add(solver, 0);
+  EXPECT_EQ(ipasir_solve(solver), 10);
+}
+
+TEST(IpasirIntegration, decisionPrioritiesAndDefaultPhasesAreRespected)
+{
+  void* solver = ipasir_init();
+  auto destroyOnRelease = jamsat::OnExitScope([solver]() { ipasir_release(solver); });
+
+  EXPECT_EQ(jamsat_ipasir_set_default_phase(solver, 1), 0);
+  EXPECT_EQ(jamsat_ipasir_set_default_phase(solver, 2), 0);
+  EXPECT_EQ(jamsat_ipasir_set_decision_priority(solver, 2, 5), 0);
+  for (int lit : {-1, -2, 3, 0, -3, 0}) {
+    ipasir_add(solver, lit);
+  }
+
+  ASSERT_EQ(ipasir_solve(solver), 10);
+  EXPECT_EQ(ipasir_val(solver, 2), 2);
+  EXPECT_EQ(ipasir_val(solver, 1), -1);
+}
+
+TEST(IpasirIntegration, invalidDecisionPrioritiesAndDefaultPhasesAreRejected)
+{
+  void* solver = ipasir_init();
+  auto destroyOnRelease = jamsat::OnExitScope([solver]() { ipasir_release(solver); });
+
+  EXPECT_EQ(jamsat_ipasir_set_default_phase(nullptr, 1), -1);
+  EXPECT_EQ(jamsat_ipasir_set_default_phase(solver, 0), -1);
+  EXPECT_EQ(jamsat_ipasir_set_decision_priority(nullptr, 1, 1), -1);
+  EXPECT_EQ(jamsat_ipasir_set_decision_priority(solver, 0, 1), -1);
+  EXPECT_EQ(jamsat_ipasir_set_decision_priority(solver, -1, 1), -1);
+  EXPECT_EQ(jamsat_ipasir_set_decision_priority(solver, 1, -1), -1);
+}
+
 namespace {
 void addHardProblem(void* ipasirSolver)
 {
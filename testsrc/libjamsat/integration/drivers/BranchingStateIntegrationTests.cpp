@@ -0,0 +1,124 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/drivers/BranchingState.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace jamsat {
+
+TEST(DriversIntegration, BranchingState_emptyStateCanBeWrittenAndRead)
+{
+  std::stringstream buffer;
+  buffer << BranchingState{};
+  ASSERT_FALSE(buffer.fail());
+
+  BranchingState result;
+  result.activities.push_back(1.0);
+  result.phases.push_back(TBools::TRUE);
+  buffer >> result;
+  ASSERT_FALSE(buffer.fail());
+  EXPECT_TRUE(result.activities.empty());
+  EXPECT_TRUE(result.phases.empty());
+}
+
+TEST(DriversIntegration, BranchingState_stateSurvivesRoundTrip)
+{
+  BranchingState state;
+  state.heuristic = BranchingState::Heuristic::LRB;
+  for (int i = 0; i < 19; ++i) {
+    state.activities.push_back(0.5 * i);
+    state.phases.push_back(toTBool(i % 3 == 0));
+  }
+
+  std::stringstream buffer;
+  buffer << state;
+  ASSERT_FALSE(buffer.fail());
+  // Header, 4 bytes per activity, 1 bit per phase:
+  EXPECT_EQ(buffer.str().size(), 13ULL + 19 * 4 + 3);
+
+  BranchingState result;
+  buffer >> result;
+  ASSERT_FALSE(buffer.fail());
+  EXPECT_EQ(result.heuristic, BranchingState::Heuristic::LRB);
+  EXPECT_EQ(result.activities, state.activities);
+  EXPECT_EQ(result.phases, state.phases);
+}
+
+TEST(DriversIntegration, BranchingState_readingTruncatedStateFails)
+{
+  BranchingState state;
+  state.activities = {1.0, 2.0, 3.0};
+  state.phases = {TBools::TRUE, TBools::FALSE, TBools::TRUE};
+
+  std::stringstream buffer;
+  buffer << state;
+  std::string const serialized = buffer.str();
+
+  for (std::size_t length = 0; length < serialized.size(); ++length) {
+    std::stringstream truncated{serialized.substr(0, length)};
+    BranchingState result;
+    truncated >> result;
+    EXPECT_TRUE(truncated.fail()) << "Unexpectedly read state truncated to " << length;
+    EXPECT_TRUE(result.activities.empty());
+    EXPECT_TRUE(result.phases.empty());
+  }
+}
+
+TEST(DriversIntegration, BranchingState_readingDataWithBadHeaderFails)
+{
+  std::stringstream buffer{std::string{"JSBX\x01\x00\x00\x00\x00\x00\x00\x00", 12}};
+  BranchingState result;
+  buffer >> result;
+  EXPECT_TRUE(buffer.fail());
+}
+
+TEST(DriversIntegration, BranchingState_stateWithoutHeuristicIsReadAsVSIDSState)
+{
+  // Version 1 header, one variable with activity 1.0 and phase TRUE:
+  std::stringstream buffer{
+      std::string{"JSBS\x01\x00\x00\x00\x01\x00\x00\x00\x00\x00\x80\x3F\x01", 17}};
+  BranchingState result;
+  result.heuristic = BranchingState::Heuristic::VMTF;
+  buffer >> result;
+  ASSERT_FALSE(buffer.fail());
+  EXPECT_EQ(result.heuristic, BranchingState::Heuristic::VSIDS);
+  EXPECT_EQ(result.activities, std::vector<double>{1.0});
+  EXPECT_EQ(result.phases, std::vector<TBool>{TBools::TRUE});
+}
+
+TEST(DriversIntegration, BranchingState_readingStateWithUnknownHeuristicFails)
+{
+  std::stringstream buffer{std::string{"JSBS\x02\x00\x00\x00\x07\x00\x00\x00\x00", 13}};
+  BranchingState result;
+  buffer >> result;
+  EXPECT_TRUE(buffer.fail());
+}
+}
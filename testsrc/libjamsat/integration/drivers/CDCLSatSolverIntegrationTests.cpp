@@ -27,8 +27,13 @@
 #include <gtest/gtest.h>
 
 #include <libjamsat/drivers/CDCLSatSolver.h>
+#include <toolbox/cnfgenerators/GateStructure.h>
 #include <toolbox/cnfgenerators/Rule110.h>
 #include <toolbox/testutils/Minisat.h>
+#include <toolbox/testutils/OnlineDRATChecker.h>
+
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace jamsat {
@@ -138,4 +143,769 @@ TEST(DriversIntegration, CDCLSatSolver_rule110_incremental)
                              inputs[7]});
   EXPECT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
 }
+
+TEST(DriversIntegration, CDCLSatSolver_rule110_withVMTFHeuristic)
+{
+  Rule110PredecessorStateProblem problem{"xxxxxxxx", "11010111", 6};
+  auto rule110Encoding = problem.getCNFEncoding();
+  auto& inputs = rule110Encoding.freeInputs;
+  ASSERT_EQ(inputs.size(), 8ULL);
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic::VMTF);
+  underTest->addProblem(rule110Encoding.cnfProblem);
+
+  EXPECT_EQ(underTest->solve({inputs[7]})->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(underTest->solve({inputs[0], inputs[2], inputs[4], inputs[6], inputs[7]})
+                ->isProblemSatisfiable(),
+            TBools::FALSE);
+
+  // Switching back to VSIDS between calls to solve():
+  underTest->setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic::VSIDS);
+  EXPECT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::TRUE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_rule110_withLRBHeuristic)
+{
+  Rule110PredecessorStateProblem problem{"xxxxxxxx", "11010111", 6};
+  auto rule110Encoding = problem.getCNFEncoding();
+  auto& inputs = rule110Encoding.freeInputs;
+  ASSERT_EQ(inputs.size(), 8ULL);
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic::LRB);
+  underTest->addProblem(rule110Encoding.cnfProblem);
+
+  EXPECT_EQ(underTest->solve({inputs[7]})->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(underTest->solve({inputs[0], inputs[2], inputs[4], inputs[6], inputs[7]})
+                ->isProblemSatisfiable(),
+            TBools::FALSE);
+  EXPECT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::TRUE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_failedAssumptionsContainAssumptionsInvolvedInConflict)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addClause({~1_Lit, ~2_Lit, 4_Lit});
+  underTest->addClause({~1_Lit, ~2_Lit, ~4_Lit});
+  underTest->addClause({~3_Lit, 5_Lit});
+
+  auto result = underTest->solve({2_Lit, 3_Lit, 1_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+
+  std::vector<CNFLit> failed = result->getFailedAssumptions();
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<CNFLit>{1_Lit, 2_Lit}));
+}
+
+TEST(DriversIntegration, CDCLSatSolver_duplicateAssumptionsAreAllowed)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addClause({~1_Lit, 2_Lit});
+
+  auto result = underTest->solve({1_Lit, 2_Lit, 1_Lit, 1_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+
+  result = underTest->solve({1_Lit, ~2_Lit, 1_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+  std::vector<CNFLit> failed = result->getFailedAssumptions();
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<CNFLit>{1_Lit, ~2_Lit}));
+}
+
+TEST(DriversIntegration, CDCLSatSolver_complementaryAssumptionsAreFailedAssumptions)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addClause({~4_Lit, 5_Lit, 8_Lit});
+
+  auto result = underTest->solve({~5_Lit, 8_Lit, 4_Lit, ~8_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+  std::vector<CNFLit> failed = result->getFailedAssumptions();
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<CNFLit>{~8_Lit, 8_Lit}));
+
+  underTest->setFailedAssumptionsMinimization(
+      CDCLSatSolver::FailedAssumptionsMinimization::DELETION_BASED, 1000);
+  result = underTest->solve({~5_Lit, 8_Lit, 4_Lit, ~8_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+  failed = result->getFailedAssumptions();
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<CNFLit>{~8_Lit, 8_Lit}));
+}
+
+TEST(DriversIntegration, CDCLSatSolver_rule110_incrementalWithCommonAssumptionPrefixes)
+{
+  Rule110PredecessorStateProblem problem{"xxxxxxxx", "11010111", 6};
+  auto rule110Encoding = problem.getCNFEncoding();
+  auto& inputs = rule110Encoding.freeInputs;
+  ASSERT_EQ(inputs.size(), 8ULL);
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(rule110Encoding.cnfProblem);
+
+  std::vector<std::vector<CNFLit>> assumptionSequence{
+      {~inputs[0], ~inputs[1], ~inputs[2], inputs[7]},
+      {~inputs[0], ~inputs[1], ~inputs[2], ~inputs[3], ~inputs[4], ~inputs[5], ~inputs[6]},
+      {~inputs[0], ~inputs[1], inputs[2], inputs[4], inputs[6], inputs[7]},
+      {inputs[0], inputs[2], inputs[4], inputs[6], inputs[7]},
+      {inputs[0], inputs[2], inputs[4], inputs[6]},
+      {inputs[0], inputs[2], inputs[4], inputs[6], inputs[7]},
+      {inputs[0], inputs[2], inputs[3]},
+      {~inputs[0], ~inputs[1], ~inputs[2], inputs[7]}};
+
+  for (auto const& assumptions : assumptionSequence) {
+    std::unique_ptr<CDCLSatSolver> reference = createCDCLSatSolver();
+    reference->addProblem(rule110Encoding.cnfProblem);
+    TBool expected = reference->solve(assumptions)->isProblemSatisfiable();
+
+    auto result = underTest->solve(assumptions);
+    ASSERT_EQ(result->isProblemSatisfiable(), expected);
+
+    if (isTrue(expected)) {
+      auto model = result->getModel();
+      ASSERT_TRUE(model.has_value());
+      for (CNFLit assumption : assumptions) {
+        EXPECT_EQ(model->get().getAssignment(assumption.getVariable()),
+                  toTBool(assumption.getSign() == CNFSign::POSITIVE));
+      }
+    }
+  }
+}
+
+TEST(DriversIntegration, CDCLSatSolver_clausesAddedBetweenSolveCallsAreRespectedUnderAssumptions)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addClause({~1_Lit, 2_Lit});
+  underTest->addClause({~3_Lit, 6_Lit, 7_Lit});
+
+  auto result = underTest->solve({1_Lit, 3_Lit, 5_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+
+  // Unit under the previous assumptions:
+  underTest->addClause({~1_Lit, ~3_Lit, 4_Lit});
+  result = underTest->solve({1_Lit, 3_Lit, 5_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  ASSERT_TRUE(result->getModel().has_value());
+  EXPECT_EQ(result->getModel()->get().getAssignment(CNFVar{4}), TBools::TRUE);
+
+  // Falsified under the previous assumptions:
+  underTest->addClause({~4_Lit, ~5_Lit});
+  result = underTest->solve({1_Lit, 3_Lit, 5_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+  std::vector<CNFLit> failed = result->getFailedAssumptions();
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<CNFLit>{1_Lit, 3_Lit, 5_Lit}));
+
+  underTest->addClause({~1_Lit});
+  result = underTest->solve({3_Lit, 1_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+  EXPECT_EQ(result->getFailedAssumptions(), (std::vector<CNFLit>{1_Lit}));
+
+  result = underTest->solve({3_Lit, 5_Lit});
+  EXPECT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+}
+
+namespace {
+// Creates a problem that is unsatisfiable under the assumption 1, but not
+// under the assumptions 2 and 3. With the assumptions (2, 3, 1), 1 is already
+// forced to be false by 2 and 3.
+void addProblemWithInflatedCore(CDCLSatSolver& solver)
+{
+  solver.addClause({~2_Lit, 4_Lit});
+  solver.addClause({~3_Lit, 5_Lit});
+  solver.addClause({~4_Lit, ~5_Lit, ~1_Lit});
+
+  // Under the assumption 1, the pigeonhole problem over the variables 6, ..., 11 (3 pigeons,
+  // 2 holes) is unsatisfiable. Subsumption cannot derive ~1 from it. Variable elimination
+  // could derive ~1, but variables with default phases are not eliminated (see
+  // CDCLSatSolver::setDefaultPhase() and the test
+  // CDCLSatSolver_variablesWithDefaultPhasesAreNotEliminated):
+  auto pigeonInHole = [](CNFVar::RawVariable pigeon, CNFVar::RawVariable hole) {
+    return CNFLit{CNFVar{6 + 2 * pigeon + hole}, CNFSign::POSITIVE};
+  };
+  for (CNFVar::RawVariable pigeon = 0; pigeon < 3; ++pigeon) {
+    solver.addClause({~1_Lit, pigeonInHole(pigeon, 0), pigeonInHole(pigeon, 1)});
+    for (CNFVar::RawVariable otherPigeon = pigeon + 1; otherPigeon < 3; ++otherPigeon) {
+      for (CNFVar::RawVariable hole = 0; hole < 2; ++hole) {
+        solver.addClause({~1_Lit, ~pigeonInHole(pigeon, hole), ~pigeonInHole(otherPigeon, hole)});
+      }
+    }
+  }
+  for (CNFVar::RawVariable var = 6; var <= 11; ++var) {
+    solver.setDefaultPhase(CNFVar{var}, TBools::FALSE);
+  }
+}
+}
+
+TEST(DriversIntegration, CDCLSatSolver_failedAssumptionsAreNotMinimizedByDefault)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  addProblemWithInflatedCore(*underTest);
+
+  auto result = underTest->solve({2_Lit, 3_Lit, 1_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+
+  std::vector<CNFLit> failed = result->getFailedAssumptions();
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<CNFLit>{1_Lit, 2_Lit, 3_Lit}));
+}
+
+TEST(DriversIntegration, CDCLSatSolver_failedAssumptionsAreMinimizedWhenEnabled)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setFailedAssumptionsMinimization(
+      CDCLSatSolver::FailedAssumptionsMinimization::DELETION_BASED, 1000);
+  addProblemWithInflatedCore(*underTest);
+
+  auto result = underTest->solve({2_Lit, 3_Lit, 1_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+  EXPECT_EQ(result->getFailedAssumptions(), std::vector<CNFLit>{1_Lit});
+
+  // The solver remains usable after minimization:
+  result = underTest->solve({2_Lit, 3_Lit});
+  EXPECT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_failedAssumptionsAreMinimizedWithInprocessing)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setFailedAssumptionsMinimization(
+      CDCLSatSolver::FailedAssumptionsMinimization::DELETION_BASED, 15000);
+
+  // Under the assumptions (2, 10, 1), 1 is forced to be false via 3, so 2 is a failed
+  // assumption. The minimal set of failed assumptions is {1, 10}. The variables 3, 11
+  // and 12 have default phases, which keeps problem simplification from eliminating
+  // them (see CDCLSatSolver::setDefaultPhase()) and the core from being minimized
+  // before the minimization starts:
+  underTest->addClause({~2_Lit, 3_Lit});
+  underTest->addClause({~3_Lit, ~10_Lit, ~1_Lit});
+  underTest->addClause({~10_Lit, 11_Lit});
+  underTest->addClause({~11_Lit, 12_Lit});
+  underTest->addClause({~12_Lit, ~1_Lit});
+  for (CNFVar var : {CNFVar{3}, CNFVar{11}, CNFVar{12}}) {
+    underTest->setDefaultPhase(var, TBools::FALSE);
+  }
+
+  // Under the assumptions 1 and 2, a pigeonhole problem needs to be refuted. When 10 is
+  // dropped during minimization, the refutation exceeds the conflict budget, and the
+  // solver simplifies the problem again while 10 is not assumed. Since 10 is assumed
+  // again in a later nested solve() call, it must not be eliminated meanwhile:
+  CNFVar::RawVariable const amntHoles = 9;
+  auto pigeonInHole = [](CNFVar::RawVariable pigeon, CNFVar::RawVariable hole) {
+    return CNFLit{CNFVar{200 + amntHoles * pigeon + hole}, CNFSign::POSITIVE};
+  };
+  for (CNFVar::RawVariable pigeon = 0; pigeon <= amntHoles; ++pigeon) {
+    CNFClause atLeastOneHole{~1_Lit, ~2_Lit};
+    for (CNFVar::RawVariable hole = 0; hole < amntHoles; ++hole) {
+      atLeastOneHole.push_back(pigeonInHole(pigeon, hole));
+    }
+    underTest->addClause(atLeastOneHole);
+
+    for (CNFVar::RawVariable otherPigeon = pigeon + 1; otherPigeon <= amntHoles; ++otherPigeon) {
+      for (CNFVar::RawVariable hole = 0; hole < amntHoles; ++hole) {
+        underTest->addClause(
+            {~1_Lit, ~2_Lit, ~pigeonInHole(pigeon, hole), ~pigeonInHole(otherPigeon, hole)});
+      }
+    }
+  }
+
+  auto result = underTest->solve({2_Lit, 10_Lit, 1_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+  std::vector<CNFLit> failed = result->getFailedAssumptions();
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<CNFLit>{1_Lit, 10_Lit}));
+
+  result = underTest->solve({2_Lit, 10_Lit});
+  EXPECT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_exportedPhasesOfSatisfiableProblemAreModel)
+{
+  Rule110PredecessorStateProblem problem{"xx1xx", "x1xxx", 7};
+  auto rule110Encoding = problem.getCNFEncoding();
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(rule110Encoding.cnfProblem);
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  Model const& model = *(result->getModel());
+
+  BranchingState const state = underTest->exportBranchingState();
+  ASSERT_EQ(state.activities.size(), state.phases.size());
+  ASSERT_EQ(state.phases.size(), rule110Encoding.cnfProblem.getMaxVar().getRawValue() + 1);
+  for (CNFVar::RawVariable i = 0; i < state.phases.size(); ++i) {
+    EXPECT_EQ(state.phases[i], model.getAssignment(CNFVar{i})) << "Mismatch for variable " << i;
+  }
+}
+
+TEST(DriversIntegration, CDCLSatSolver_solverWarmStartedWithModelPhasesFindsModel)
+{
+  Rule110PredecessorStateProblem problem{"xx1xx", "x1xxx", 7};
+  auto rule110Encoding = problem.getCNFEncoding();
+
+  std::unique_ptr<CDCLSatSolver> exporter = createCDCLSatSolver();
+  exporter->addProblem(rule110Encoding.cnfProblem);
+  ASSERT_EQ(exporter->solve({})->isProblemSatisfiable(), TBools::TRUE);
+  BranchingState const state = exporter->exportBranchingState();
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->importBranchingState(state);
+  underTest->addProblem(rule110Encoding.cnfProblem);
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+
+  // All decisions follow the imported phases, so the search is conflict-free:
+  Model const& model = *(result->getModel());
+  for (CNFVar::RawVariable i = 0; i < state.phases.size(); ++i) {
+    EXPECT_EQ(model.getAssignment(CNFVar{i}), state.phases[i]) << "Mismatch for variable " << i;
+  }
+}
+
+TEST(DriversIntegration, CDCLSatSolver_lrbScoresSurviveExportAndImport)
+{
+  Rule110PredecessorStateProblem problem{"xx1xx", "x1xxx", 7};
+  auto rule110Encoding = problem.getCNFEncoding();
+
+  std::unique_ptr<CDCLSatSolver> exporter = createCDCLSatSolver();
+  exporter->setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic::LRB);
+  exporter->addProblem(rule110Encoding.cnfProblem);
+  ASSERT_EQ(exporter->solve({})->isProblemSatisfiable(), TBools::TRUE);
+  BranchingState const state = exporter->exportBranchingState();
+  EXPECT_EQ(state.heuristic, BranchingState::Heuristic::LRB);
+  ASSERT_TRUE(std::any_of(
+      state.activities.begin(), state.activities.end(), [](double score) { return score > 0.0; }));
+  for (double score : state.activities) {
+    EXPECT_GE(score, 0.0);
+    EXPECT_LE(score, 1.0);
+  }
+
+  std::unique_ptr<CDCLSatSolver> importer = createCDCLSatSolver();
+  importer->setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic::LRB);
+  importer->importBranchingState(state);
+  importer->addProblem(rule110Encoding.cnfProblem);
+  BranchingState const reexported = importer->exportBranchingState();
+  EXPECT_EQ(reexported.heuristic, BranchingState::Heuristic::LRB);
+  EXPECT_EQ(reexported.activities, state.activities);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_vmtfQueueOrderSurvivesExportAndImport)
+{
+  Rule110PredecessorStateProblem problem{"xx1xx", "x1xxx", 7};
+  auto rule110Encoding = problem.getCNFEncoding();
+
+  std::unique_ptr<CDCLSatSolver> exporter = createCDCLSatSolver();
+  exporter->setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic::VMTF);
+  exporter->addProblem(rule110Encoding.cnfProblem);
+  ASSERT_EQ(exporter->solve({})->isProblemSatisfiable(), TBools::TRUE);
+  BranchingState const state = exporter->exportBranchingState();
+  EXPECT_EQ(state.heuristic, BranchingState::Heuristic::VMTF);
+
+  std::unique_ptr<CDCLSatSolver> importer = createCDCLSatSolver();
+  importer->setBranchingHeuristic(CDCLSatSolver::BranchingHeuristic::VMTF);
+  importer->importBranchingState(state);
+  importer->addProblem(rule110Encoding.cnfProblem);
+  BranchingState const reexported = importer->exportBranchingState();
+  EXPECT_EQ(reexported.heuristic, BranchingState::Heuristic::VMTF);
+  EXPECT_EQ(reexported.activities, state.activities);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_importedStateIsAppliedToVariablesAddedLater)
+{
+  BranchingState state;
+  state.activities = {0.0, 0.0, 0.0, 1.0};
+  state.phases = {TBools::FALSE, TBools::FALSE, TBools::FALSE, TBools::TRUE};
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->importBranchingState(state);
+  underTest->addClause({0_Lit, 1_Lit});
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+
+  // Variable 3 becomes known to the solver only now:
+  underTest->addClause({~2_Lit, ~3_Lit});
+  result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  Model const& model = *(result->getModel());
+  EXPECT_EQ(model.getAssignment(CNFVar{3}), TBools::TRUE);
+  EXPECT_EQ(model.getAssignment(CNFVar{2}), TBools::FALSE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_unconstrainedVariablesAreAssignedTheirDefaultPhases)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setDefaultPhase(CNFVar{0}, TBools::FALSE);
+  underTest->setDefaultPhase(CNFVar{1}, TBools::TRUE);
+  underTest->setDefaultPhase(CNFVar{2}, TBools::FALSE);
+  underTest->setDefaultPhase(CNFVar{3}, TBools::TRUE);
+  underTest->addClause({0_Lit, 1_Lit, 2_Lit, 3_Lit});
+
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  Model const& model = *(result->getModel());
+  EXPECT_EQ(model.getAssignment(CNFVar{0}), TBools::FALSE);
+  EXPECT_EQ(model.getAssignment(CNFVar{1}), TBools::TRUE);
+  EXPECT_EQ(model.getAssignment(CNFVar{2}), TBools::FALSE);
+  EXPECT_EQ(model.getAssignment(CNFVar{3}), TBools::TRUE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_removedDefaultPhasesDoNotOverrideImportedPhases)
+{
+  BranchingState state;
+  state.activities = {0.0, 0.0, 0.0};
+  state.phases = {TBools::TRUE, TBools::TRUE, TBools::TRUE};
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->importBranchingState(state);
+  underTest->setDefaultPhase(CNFVar{0}, TBools::FALSE);
+  underTest->setDefaultPhase(CNFVar{0}, TBools::INDETERMINATE);
+  underTest->setDefaultPhase(CNFVar{1}, TBools::INDETERMINATE);
+  underTest->addClause({0_Lit, 1_Lit, 2_Lit});
+
+  BranchingState const exported = underTest->exportBranchingState();
+  EXPECT_EQ(exported.phases, state.phases);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_variablesWithHigherPriorityAreDecidedFirst)
+{
+  for (CNFVar prioritized : {CNFVar{0}, CNFVar{1}}) {
+    for (auto heuristic : {CDCLSatSolver::BranchingHeuristic::VSIDS,
+                           CDCLSatSolver::BranchingHeuristic::VMTF,
+                           CDCLSatSolver::BranchingHeuristic::LRB}) {
+      std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+      underTest->setBranchingHeuristic(heuristic);
+      underTest->setDefaultPhase(CNFVar{0}, TBools::TRUE);
+      underTest->setDefaultPhase(CNFVar{1}, TBools::TRUE);
+      underTest->setDecisionPriority(prioritized, 1);
+      underTest->addClause({~0_Lit, ~1_Lit, 2_Lit});
+      underTest->addClause({~2_Lit});
+
+      auto result = underTest->solve({});
+      ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+      Model const& model = *(result->getModel());
+      CNFVar const other = (prioritized == CNFVar{0}) ? CNFVar{1} : CNFVar{0};
+      EXPECT_EQ(model.getAssignment(prioritized), TBools::TRUE);
+      EXPECT_EQ(model.getAssignment(other), TBools::FALSE);
+    }
+  }
+}
+
+TEST(DriversIntegration, CDCLSatSolver_rule110_incrementalWithPrioritizedInputs)
+{
+  Rule110PredecessorStateProblem problem{"xxxxxxxx", "11010111", 6};
+  auto rule110Encoding = problem.getCNFEncoding();
+  auto& inputs = rule110Encoding.freeInputs;
+  ASSERT_EQ(inputs.size(), 8ULL);
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(rule110Encoding.cnfProblem);
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    underTest->setDecisionPriority(inputs[i].getVariable(), 1 + (i % 3));
+    underTest->setDefaultPhase(inputs[i].getVariable(), toTBool(i % 2 == 0));
+  }
+
+  std::vector<std::vector<CNFLit>> assumptionSequence{
+      {},
+      {~inputs[0], ~inputs[1], ~inputs[2], inputs[7]},
+      {inputs[0], inputs[2], inputs[4], inputs[6], inputs[7]},
+      {inputs[0], inputs[2], inputs[3]},
+      {}};
+
+  for (auto const& assumptions : assumptionSequence) {
+    std::unique_ptr<CDCLSatSolver> reference = createCDCLSatSolver();
+    reference->addProblem(rule110Encoding.cnfProblem);
+    TBool expected = reference->solve(assumptions)->isProblemSatisfiable();
+
+    auto result = underTest->solve(assumptions);
+    ASSERT_EQ(result->isProblemSatisfiable(), expected);
+
+    if (isTrue(expected)) {
+      auto model = result->getModel();
+      ASSERT_TRUE(model.has_value());
+      EXPECT_EQ(model->get().check(rule110Encoding.cnfProblem), TBools::TRUE);
+      for (CNFLit assumption : assumptions) {
+        EXPECT_EQ(model->get().getAssignment(assumption.getVariable()),
+                  toTBool(assumption.getSign() == CNFSign::POSITIVE));
+      }
+    }
+  }
+}
+
+namespace {
+auto createImplicationChain(CNFVar::RawVariable length) -> CNFProblem
+{
+  CNFProblem result;
+  for (CNFVar::RawVariable i = 0; i < length; ++i) {
+    result.addClause({~CNFLit{CNFVar{i}, CNFSign::POSITIVE},
+                      CNFLit{CNFVar{i + 1}, CNFSign::POSITIVE}});
+  }
+  return result;
+}
+}
+
+TEST(DriversIntegration, CDCLSatSolver_modelsAreExtendedToEliminatedVariables)
+{
+  CNFProblem problem = createImplicationChain(10);
+  problem.addClause({0_Lit, 5_Lit});
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  auto model = result->getModel();
+  ASSERT_TRUE(model.has_value());
+  EXPECT_EQ(model->get().check(problem), TBools::TRUE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_variablesWithDefaultPhasesAreNotEliminated)
+{
+  CNFProblem problem = createImplicationChain(10);
+  problem.addClause({0_Lit, 5_Lit});
+
+  // Without default phases, most variables of the chain are eliminated, and model
+  // reconstruction assigns 0, ..., 4 to false:
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  for (CNFVar::RawVariable var = 0; var <= 10; ++var) {
+    underTest->setDefaultPhase(CNFVar{var}, TBools::TRUE);
+  }
+
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  Model const& model = *(result->getModel());
+  for (CNFVar::RawVariable var = 0; var <= 10; ++var) {
+    EXPECT_EQ(model.getAssignment(CNFVar{var}), TBools::TRUE) << "at variable " << var;
+  }
+}
+
+TEST(DriversIntegration, CDCLSatSolver_eliminatedVariablesCanBeUsedInClausesAndAssumptions)
+{
+  CNFProblem problem = createImplicationChain(10);
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  ASSERT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::TRUE);
+
+  EXPECT_EQ(underTest->solve({0_Lit, ~10_Lit})->isProblemSatisfiable(), TBools::FALSE);
+  auto result = underTest->solve({0_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().getAssignment(CNFVar{10}), TBools::TRUE);
+
+  underTest->addClause({5_Lit});
+  problem.addClause({5_Lit});
+  result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+
+  underTest->addClause({~7_Lit});
+  EXPECT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::FALSE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_certificateRemainsValidWhenRestoringEliminatedVariables)
+{
+  CNFProblem problem = createImplicationChain(10);
+  std::unique_ptr<OnlineDRATChecker> checker = createOnlineDRATChecker(problem);
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setDRATCertificate(*checker);
+  underTest->addProblem(problem);
+  ASSERT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::TRUE);
+
+  // Restores the clauses removed via variable elimination, adding them to the proof:
+  auto result = underTest->solve({0_Lit, 5_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+  result = underTest->solve({~10_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+
+  EXPECT_FALSE(checker->hasDetectedInvalidLemma());
+  EXPECT_FALSE(checker->hasDetectedUnsupportedLemma());
+}
+
+TEST(DriversIntegration, CDCLSatSolver_witnessVariablesCanBeUsedInClausesAndAssumptions)
+{
+  // All clauses are blocked, so blocked clause elimination removes them:
+  CNFProblem problem;
+  problem.addClause({1_Lit, 2_Lit});
+  problem.addClause({1_Lit, 3_Lit});
+  problem.addClause({~1_Lit, 4_Lit});
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+
+  EXPECT_EQ(underTest->solve({~1_Lit, ~2_Lit})->isProblemSatisfiable(), TBools::FALSE);
+
+  underTest->addClause({~4_Lit});
+  problem.addClause({~4_Lit});
+  result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+
+  underTest->addClause({~2_Lit});
+  EXPECT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::FALSE);
+}
+
+namespace {
+/**
+ * Creates two chains of 2-input XOR gates computing the parity of the variables
+ * 0, ..., inputs-1 in opposite orders. The outputs of the chains are the variables
+ * 2*inputs-2 and 3*inputs-3.
+ */
+auto createParityChains(CNFVar::RawVariable inputs) -> CNFProblem
+{
+  CNFProblem result;
+  CNFVar::RawVariable nextVar = inputs;
+  for (bool reversed : {false, true}) {
+    CNFLit chainValue = CNFLit{CNFVar{reversed ? inputs - 1 : 0}, CNFSign::POSITIVE};
+    for (CNFVar::RawVariable i = 1; i < inputs; ++i) {
+      CNFLit const input = CNFLit{CNFVar{reversed ? inputs - 1 - i : i}, CNFSign::POSITIVE};
+      CNFLit const output = CNFLit{CNFVar{nextVar++}, CNFSign::POSITIVE};
+      insertXOR({chainValue, input}, output, result);
+      chainValue = output;
+    }
+  }
+  return result;
+}
+}
+
+TEST(DriversIntegration, CDCLSatSolver_parityChainsWithEqualOutputsAreSatisfiable)
+{
+  CNFProblem problem = createParityChains(24);
+  problem.addClause({CNFLit{CNFVar{46}, CNFSign::POSITIVE}});
+  problem.addClause({CNFLit{CNFVar{69}, CNFSign::POSITIVE}});
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_parityChainsWithDifferentOutputsAreUnsatisfiable)
+{
+  CNFProblem problem = createParityChains(24);
+  problem.addClause({CNFLit{CNFVar{46}, CNFSign::POSITIVE}});
+  problem.addClause({CNFLit{CNFVar{69}, CNFSign::NEGATIVE}});
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  EXPECT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::FALSE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_parityChainsCanBeSolvedIncrementally)
+{
+  CNFProblem problem = createParityChains(24);
+  CNFLit const output1{CNFVar{46}, CNFSign::POSITIVE};
+  CNFLit const output2{CNFVar{69}, CNFSign::POSITIVE};
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  for (int round = 0; round < 3; ++round) {
+    EXPECT_EQ(underTest->solve({output1, ~output2})->isProblemSatisfiable(), TBools::FALSE);
+    EXPECT_EQ(underTest->solve({~output1, output2})->isProblemSatisfiable(), TBools::FALSE);
+
+    auto result = underTest->solve({~output1, ~output2, 3_Lit});
+    ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+    EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+  }
+}
+
+TEST(DriversIntegration, CDCLSatSolver_parityChainsCanBeSolvedRepeatedlyUnderAssumptions)
+{
+  CNFVar::RawVariable const inputs = 16;
+  CNFProblem problem = createParityChains(inputs);
+  CNFLit const output1{CNFVar{2 * inputs - 2}, CNFSign::POSITIVE};
+  CNFLit const output2{CNFVar{3 * inputs - 3}, CNFSign::POSITIVE};
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addProblem(problem);
+  for (CNFVar::RawVariable round = 0; round < 200; ++round) {
+    // Assuming the first half of the inputs and the values of both chain outputs:
+    std::vector<CNFLit> assumptions;
+    for (CNFVar::RawVariable input = 0; input < inputs / 2; ++input) {
+      bool const value = ((round >> input) & 1) != 0;
+      assumptions.push_back(CNFLit{CNFVar{input}, value ? CNFSign::POSITIVE : CNFSign::NEGATIVE});
+    }
+    bool const assumedParity = (round % 3) != 0;
+    assumptions.push_back(assumedParity ? output1 : ~output1);
+    assumptions.push_back(assumedParity == (round % 5 != 0) ? output2 : ~output2);
+
+    auto result = underTest->solve(assumptions);
+    if (round % 5 == 0) {
+      ASSERT_EQ(result->isProblemSatisfiable(), TBools::FALSE);
+    }
+    else {
+      ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+      Model const& model = result->getModel()->get();
+      EXPECT_EQ(model.check(problem), TBools::TRUE);
+      bool modelParity = false;
+      for (CNFVar::RawVariable input = 0; input < inputs; ++input) {
+        modelParity ^= isTrue(model.getAssignment(CNFVar{input}));
+      }
+      EXPECT_EQ(modelParity, assumedParity);
+    }
+  }
+}
+
+TEST(DriversIntegration, CDCLSatSolver_variableAdditionAddsVariablesAboveKnownVariables)
+{
+  // Exactly-one encoding of the variables 0, ..., 9, with a pairwise at-most-one encoding:
+  CNFProblem problem;
+  CNFClause atLeastOne;
+  for (CNFVar::RawVariable i = 0; i < 10; ++i) {
+    atLeastOne.push_back(CNFLit{CNFVar{i}, CNFSign::POSITIVE});
+    for (CNFVar::RawVariable j = i + 1; j < 10; ++j) {
+      problem.addClause({CNFLit{CNFVar{i}, CNFSign::NEGATIVE},
+                         CNFLit{CNFVar{j}, CNFSign::NEGATIVE}});
+    }
+  }
+  problem.addClause(atLeastOne);
+
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setVariableAdditionEnabled(true);
+  underTest->addProblem(problem);
+  for (CNFVar::RawVariable i = 0; i < 10; ++i) {
+    // Keeping the variables from being eliminated:
+    underTest->setDefaultPhase(CNFVar{i}, TBools::FALSE);
+  }
+
+  auto result = underTest->solve({});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+  EXPECT_TRUE(isDeterminate(result->getModel()->get().getAssignment(CNFVar{10})));
+
+  EXPECT_EQ(underTest->solve({3_Lit, 7_Lit})->isProblemSatisfiable(), TBools::FALSE);
+  result = underTest->solve({5_Lit});
+  ASSERT_EQ(result->isProblemSatisfiable(), TBools::TRUE);
+  EXPECT_EQ(result->getModel()->get().check(problem), TBools::TRUE);
+
+  underTest->addClause({~5_Lit, 9_Lit});
+  EXPECT_EQ(underTest->solve({5_Lit})->isProblemSatisfiable(), TBools::FALSE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_newVariablesAreRejectedAfterSolvingWithVariableAddition)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->setVariableAdditionEnabled(true);
+  underTest->addClause({1_Lit, 2_Lit});
+  ASSERT_EQ(underTest->solve({3_Lit})->isProblemSatisfiable(), TBools::TRUE);
+
+  EXPECT_THROW(underTest->addClause({1_Lit, 4_Lit}), std::invalid_argument);
+  EXPECT_THROW(underTest->solve({~4_Lit}), std::invalid_argument);
+  EXPECT_THROW(underTest->setVariableAdditionEnabled(false), std::logic_error);
+
+  underTest->addClause({~1_Lit, ~3_Lit});
+  EXPECT_EQ(underTest->solve({3_Lit, ~2_Lit})->isProblemSatisfiable(), TBools::FALSE);
+}
+
+TEST(DriversIntegration, CDCLSatSolver_newVariablesAreAcceptedAfterSolvingWithoutVariableAddition)
+{
+  std::unique_ptr<CDCLSatSolver> underTest = createCDCLSatSolver();
+  underTest->addClause({1_Lit, 2_Lit});
+  ASSERT_EQ(underTest->solve({})->isProblemSatisfiable(), TBools::TRUE);
+
+  underTest->addClause({~1_Lit, 4_Lit});
+  EXPECT_EQ(underTest->solve({~4_Lit, ~2_Lit})->isProblemSatisfiable(), TBools::FALSE);
+}
 }
@@ -58,6 +58,22 @@
 
 namespace jamsat {
 namespace {
+// Conflict analysis observer performing VSIDS-style variable activity bumping:
+class ActivityBumpingObserver {
+public:
+  explicit ActivityBumpingObserver(VSIDSBranchingHeuristic<Assignment>& branchingHeuristic)
+    : m_branchingHeuristic(branchingHeuristic)
+  {
+  }
+
+  void onSeenVariable(CNFVar seenVar) { m_branchingHeuristic.seenInConflict(seenVar); }
+
+  void onSeenClause(Clause const&) {}
+
+private:
+  VSIDSBranchingHeuristic<Assignment>& m_branchingHeuristic;
+};
+
 class SimpleCDCL {
 public:
   SimpleCDCL();
@@ -65,7 +81,7 @@ public:
   TBool isProblemSatisfiable();
 
 private:
-  using ConflictAnalysisType = FirstUIPLearning<Assignment, Assignment>;
+  using ConflictAnalysisType = FirstUIPLearning<Assignment, Assignment, ActivityBumpingObserver>;
   using ClauseDBType = HeapClauseDB<Clause>;
   using BranchingHeuristicType = VSIDSBranchingHeuristic<Assignment>;
 
@@ -78,9 +94,9 @@ private:
 
   CNFVar m_maxVar;
   Assignment m_assignment;
+  BranchingHeuristicType m_branchingHeuristic;
   ConflictAnalysisType m_conflictAnalyzer;
   ClauseDBType m_clauseDB;
-  BranchingHeuristicType m_branchingHeuristic;
 
   std::vector<CNFLit> m_unitClauses;
 };
@@ -89,9 +105,10 @@ private:
 SimpleCDCL::SimpleCDCL()
   : m_maxVar(CNFVar{1})
   , m_assignment(m_maxVar)
-  , m_conflictAnalyzer(m_maxVar, m_assignment, m_assignment)
-  , m_clauseDB()
   , m_branchingHeuristic(m_maxVar, m_assignment)
+  , m_conflictAnalyzer(
+        m_maxVar, m_assignment, m_assignment, ActivityBumpingObserver{m_branchingHeuristic})
+  , m_clauseDB()
 {
 }
 
@@ -178,10 +195,6 @@ TBool SimpleCDCL::isProblemSatisfiable()
     m_branchingHeuristic.setEligibleForDecisions(v, true);
   }
 
-  // Set up VSIDS-style variable activity bumping:
-  m_conflictAnalyzer.setOnSeenVariableCallback(
-      [this](CNFVar seenVar) { m_branchingHeuristic.seenInConflict(seenVar); });
-
   // Leave the solver with an empty trail:
   OnExitScope backtrackToLevel0{[this]() { this->backtrackAll(); }};
 
@@ -0,0 +1,259 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include <libjamsat/branching/LRBBranchingHeuristic.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/utils/Truth.h>
+#include <toolbox/testutils/FakeAssignmentProvider.h>
+
+namespace jamsat {
+namespace {
+using LRBUnderTest = LRBBranchingHeuristic<FakeAssignmentProvider>;
+
+class FakeReasonProvider {
+public:
+  void setReason(CNFVar variable, std::vector<CNFLit> const& reason)
+  {
+    m_reasons[variable] = reason;
+  }
+
+  auto getReason(CNFVar variable) const noexcept -> std::vector<CNFLit> const*
+  {
+    auto result = m_reasons.find(variable);
+    if (result == m_reasons.end()) {
+      return nullptr;
+    }
+    return &(result->second);
+  }
+
+private:
+  std::unordered_map<CNFVar, std::vector<CNFLit>> m_reasons;
+};
+
+void makeAllEligible(LRBUnderTest& underTest, CNFVar maxVar)
+{
+  for (CNFVar i = CNFVar{0}; i <= maxVar; i = nextCNFVar(i)) {
+    underTest.setEligibleForDecisions(i, true);
+  }
+}
+
+void assignAll(LRBUnderTest& underTest, FakeAssignmentProvider& assignments, CNFVar maxVar)
+{
+  for (CNFVar i = CNFVar{0}; i <= maxVar; i = nextCNFVar(i)) {
+    assignments.setAssignment(i, TBools::TRUE);
+    underTest.assigned(i);
+  }
+}
+
+void unassignAll(LRBUnderTest& underTest, FakeAssignmentProvider& assignments, CNFVar maxVar)
+{
+  for (CNFVar i = CNFVar{0}; i <= maxVar; i = nextCNFVar(i)) {
+    underTest.reset(i);
+    assignments.setAssignment(i, TBools::INDETERMINATE);
+  }
+}
+
+void simulateConflict(LRBUnderTest& underTest, std::vector<CNFVar> const& seenVariables)
+{
+  underTest.beginHandlingConflict();
+  for (CNFVar var : seenVariables) {
+    underTest.seenInConflict(var);
+  }
+  underTest.endHandlingConflict();
+}
+
+// Picks branching literals, assigning their variables like a CDCL solver would
+void expectVariableSequence(LRBUnderTest& underTest,
+                            FakeAssignmentProvider& assignments,
+                            std::vector<CNFVar> const& expectedSequence)
+{
+  for (auto var : expectedSequence) {
+    CNFLit pick = underTest.pickBranchLiteral();
+    ASSERT_NE(pick, CNFLit::getUndefinedLiteral());
+    EXPECT_EQ(pick.getVariable(), var);
+    assignments.setAssignment(pick.getVariable(), TBools::TRUE);
+    underTest.assigned(pick.getVariable());
+  }
+}
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_allAssignedCausesUndefToBePicked)
+{
+  CNFVar maxVar{10};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::TRUE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+  EXPECT_EQ(underTest.pickBranchLiteral(), CNFLit::getUndefinedLiteral());
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_variablesParticipatingInConflictsArePreferred)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  simulateConflict(underTest, {CNFVar{1}, CNFVar{2}});
+  simulateConflict(underTest, {CNFVar{2}});
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{2}, CNFVar{1}});
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_reasonSideVariablesAreRewarded)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  FakeReasonProvider reasons;
+  CNFLit lit0{CNFVar{0}, CNFSign::NEGATIVE};
+  CNFLit lit1{CNFVar{1}, CNFSign::POSITIVE};
+  CNFLit lit3{CNFVar{3}, CNFSign::NEGATIVE};
+  reasons.setReason(CNFVar{0}, {lit0, ~lit1, lit3});
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  underTest.beginHandlingConflict();
+  underTest.registerLemma(std::vector<CNFLit>{~lit0, lit1}, reasons);
+  underTest.endHandlingConflict();
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{3}});
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_activityIsUnchangedWithoutConflictsWhileAssigned)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  simulateConflict(underTest, {CNFVar{1}});
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{1}});
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_activityDecaysWhenNotParticipatingInConflicts)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  simulateConflict(underTest, {CNFVar{1}});
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  simulateConflict(underTest, {CNFVar{2}});
+  simulateConflict(underTest, {CNFVar{2}});
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{2}, CNFVar{1}});
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_activityDoesNotDecayWhenResetWhileUnassigned)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  simulateConflict(underTest, {CNFVar{1}, CNFVar{2}});
+  simulateConflict(underTest, {CNFVar{1}});
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  for (int i = 0; i < 4; ++i) {
+    simulateConflict(underTest, {});
+    underTest.reset(CNFVar{1});
+  }
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{1}, CNFVar{2}});
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_ineligibleVariableDoesNotGetPicked)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+  underTest.setEligibleForDecisions(CNFVar{1}, false);
+
+  assignAll(underTest, fakeAssignmentProvider, maxVar);
+  simulateConflict(underTest, {CNFVar{1}, CNFVar{2}});
+  simulateConflict(underTest, {CNFVar{1}});
+  unassignAll(underTest, fakeAssignmentProvider, maxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{2}});
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_signsAreSelectedByPhase)
+{
+  CNFVar maxVar{1};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  fakeAssignmentProvider.setPhase(CNFVar{0}, TBools::TRUE);
+  fakeAssignmentProvider.setPhase(CNFVar{1}, TBools::TRUE);
+
+  CNFLit pick = underTest.pickBranchLiteral();
+  ASSERT_NE(pick, CNFLit::getUndefinedLiteral());
+  EXPECT_EQ(pick.getSign(), CNFSign::POSITIVE);
+}
+
+TEST(UnitBranching, LRBBranchingHeuristic_addedVariablesAreUsedForDecisions)
+{
+  CNFVar initialMaxVar{2};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  LRBUnderTest underTest{initialMaxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, initialMaxVar);
+
+  CNFVar newMaxVar{4};
+  underTest.increaseMaxVarTo(newMaxVar);
+  underTest.setEligibleForDecisions(CNFVar{3}, true);
+  underTest.setEligibleForDecisions(CNFVar{4}, true);
+
+  assignAll(underTest, fakeAssignmentProvider, newMaxVar);
+  simulateConflict(underTest, {CNFVar{4}});
+  unassignAll(underTest, fakeAssignmentProvider, newMaxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{4}});
+}
+}
@@ -0,0 +1,204 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <libjamsat/branching/VMTFBranchingHeuristic.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/utils/Truth.h>
+#include <toolbox/testutils/FakeAssignmentProvider.h>
+
+namespace jamsat {
+namespace {
+using VMTFUnderTest = VMTFBranchingHeuristic<FakeAssignmentProvider>;
+
+void makeAllEligible(VMTFUnderTest& underTest, CNFVar maxVar)
+{
+  for (CNFVar i = CNFVar{0}; i <= maxVar; i = nextCNFVar(i)) {
+    underTest.setEligibleForDecisions(i, true);
+  }
+}
+
+// Picks branching literals, assigning their variables like a CDCL solver would
+void expectVariableSequence(VMTFUnderTest& underTest,
+                            FakeAssignmentProvider& assignments,
+                            std::vector<CNFVar> const& expectedSequence)
+{
+  for (auto var : expectedSequence) {
+    CNFLit pick = underTest.pickBranchLiteral();
+    ASSERT_NE(pick, CNFLit::getUndefinedLiteral());
+    EXPECT_EQ(pick.getVariable(), var);
+    assignments.setAssignment(pick.getVariable(), TBools::TRUE);
+  }
+}
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_allAssignedCausesUndefToBePicked)
+{
+  CNFVar maxVar{10};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::TRUE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+  EXPECT_EQ(underTest.pickBranchLiteral(), CNFLit::getUndefinedLiteral());
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_variablesArePickedInReverseEnqueueOrder)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  expectVariableSequence(
+      underTest, fakeAssignmentProvider, {CNFVar{3}, CNFVar{2}, CNFVar{1}, CNFVar{0}});
+  EXPECT_EQ(underTest.pickBranchLiteral(), CNFLit::getUndefinedLiteral());
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_variablesSeenInConflictAreMovedToFront)
+{
+  CNFVar maxVar{10};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  underTest.seenInConflict(CNFVar{4});
+  underTest.seenInConflict(CNFVar{2});
+  underTest.seenInConflict(CNFVar{5});
+
+  expectVariableSequence(
+      underTest, fakeAssignmentProvider, {CNFVar{5}, CNFVar{2}, CNFVar{4}, CNFVar{10}, CNFVar{9}});
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_relativeOrderOfVariablesSeenInConflictIsPreserved)
+{
+  CNFVar maxVar{10};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  underTest.beginHandlingConflict();
+  underTest.seenInConflict(CNFVar{7});
+  underTest.seenInConflict(CNFVar{2});
+  underTest.seenInConflict(CNFVar{4});
+  underTest.endHandlingConflict();
+
+  expectVariableSequence(
+      underTest, fakeAssignmentProvider, {CNFVar{7}, CNFVar{4}, CNFVar{2}, CNFVar{10}});
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_ineligibleVariableDoesNotGetPicked)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+  underTest.setEligibleForDecisions(CNFVar{2}, false);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{3}, CNFVar{1}, CNFVar{0}});
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_assignedVariableDoesNotGetPicked)
+{
+  CNFVar maxVar{3};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+  fakeAssignmentProvider.setAssignment(CNFVar{3}, TBools::TRUE);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{2}, CNFVar{1}});
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_resetVariableCanBePickedAgain)
+{
+  CNFVar maxVar{5};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{5}, CNFVar{4}, CNFVar{3}});
+  fakeAssignmentProvider.setAssignment(CNFVar{4}, TBools::INDETERMINATE);
+  underTest.reset(CNFVar{4});
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{4}, CNFVar{2}});
+
+  for (CNFVar i = CNFVar{0}; i <= maxVar; i = nextCNFVar(i)) {
+    fakeAssignmentProvider.setAssignment(i, TBools::INDETERMINATE);
+  }
+  underTest.reset();
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{5}, CNFVar{4}});
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_bumpedAssignedVariableIsPickedAfterReset)
+{
+  CNFVar maxVar{5};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  fakeAssignmentProvider.setAssignment(CNFVar{1}, TBools::FALSE);
+  underTest.beginHandlingConflict();
+  underTest.seenInConflict(CNFVar{1});
+  underTest.endHandlingConflict();
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{5}});
+
+  fakeAssignmentProvider.setAssignment(CNFVar{1}, TBools::INDETERMINATE);
+  underTest.reset(CNFVar{1});
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{1}, CNFVar{4}});
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_signsAreSelectedByPhase)
+{
+  CNFVar maxVar{2};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{maxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, maxVar);
+
+  fakeAssignmentProvider.setPhase(CNFVar{2}, TBools::TRUE);
+  fakeAssignmentProvider.setPhase(CNFVar{1}, TBools::FALSE);
+
+  EXPECT_EQ(underTest.pickBranchLiteral(), 2_Lit);
+  EXPECT_EQ(underTest.pickBranchLiteral(), ~1_Lit);
+}
+
+TEST(UnitBranching, VMTFBranchingHeuristic_addedVariablesAreUsedForDecisions)
+{
+  CNFVar initialMaxVar{2};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VMTFUnderTest underTest{initialMaxVar, fakeAssignmentProvider};
+  makeAllEligible(underTest, initialMaxVar);
+
+  expectVariableSequence(underTest, fakeAssignmentProvider, {CNFVar{2}});
+
+  CNFVar newMaxVar{4};
+  underTest.increaseMaxVarTo(newMaxVar);
+  underTest.setEligibleForDecisions(CNFVar{3}, true);
+  underTest.setEligibleForDecisions(CNFVar{4}, true);
+
+  expectVariableSequence(
+      underTest, fakeAssignmentProvider, {CNFVar{4}, CNFVar{3}, CNFVar{1}, CNFVar{0}});
+}
+}
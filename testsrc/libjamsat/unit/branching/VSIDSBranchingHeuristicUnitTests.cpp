@@ -26,51 +26,14 @@
 
 #include <gtest/gtest.h>
 
-#include <unordered_map>
-
 #include <boost/log/trivial.hpp>
 
 #include <libjamsat/branching/VSIDSBranchingHeuristic.h>
 #include <libjamsat/cnfproblem/CNFLiteral.h>
 #include <libjamsat/utils/Truth.h>
+#include <toolbox/testutils/FakeAssignmentProvider.h>
 
 namespace jamsat {
-class FakeAssignmentProvider {
-public:
-  FakeAssignmentProvider(TBool defaultAssignment) : m_defaultAssignment(defaultAssignment) {}
-
-  TBool getAssignment(CNFVar variable) const noexcept
-  {
-    auto result = m_assignments.find(variable);
-    if (result == m_assignments.end()) {
-      return m_defaultAssignment;
-    }
-    return result->second;
-  }
-
-  void setAssignment(CNFVar variable, TBool assignment)
-  {
-    m_assignments[variable] = assignment;
-    m_phases[variable] = assignment;
-  }
-
-  void setPhase(CNFVar variable, TBool assignment) { m_phases[variable] = assignment; }
-
-  TBool getPhase(CNFVar variable) const noexcept
-  {
-    auto result = m_phases.find(variable);
-    if (result == m_phases.end()) {
-      return TBools::FALSE;
-    }
-    return result->second;
-  }
-
-private:
-  TBool m_defaultAssignment;
-  std::unordered_map<CNFVar, TBool> m_assignments;
-  std::unordered_map<CNFVar, TBool> m_phases;
-};
-
 TEST(UnitBranching, VSIDSBranchingHeuristic_allAssignedCausesUndefToBePicked)
 {
   CNFVar maxVar{10};
@@ -188,7 +151,7 @@ TEST(UnitBranching, VSIDSBranchingHeuristic_variableActivityDecaysWhenTooLarge)
 
   addDefaultConflictSequence(underTest);
 
-  underTest.setActivityBumpDelta(0.5e100);
+  underTest.setActivityBumpDelta(0.5e30);
 
   underTest.seenInConflict(CNFVar{4});
 
@@ -200,6 +163,40 @@ TEST(UnitBranching, VSIDSBranchingHeuristic_variableActivityDecaysWhenTooLarge)
   expectVariableSequence(underTest, {CNFVar{4}, CNFVar{3}, CNFVar{5}});
 }
 
+TEST(UnitBranching, VSIDSBranchingHeuristic_activitiesCanBeSet)
+{
+  CNFVar maxVar{10};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VSIDSBranchingHeuristic<FakeAssignmentProvider> underTest{maxVar, fakeAssignmentProvider};
+  addDefaultConflictSequence(underTest);
+
+  underTest.setActivity(CNFVar{7}, 100.0);
+  underTest.setActivity(CNFVar{2}, 50.0);
+  EXPECT_EQ(underTest.getActivity(CNFVar{7}), 100.0);
+  EXPECT_EQ(underTest.getActivity(CNFVar{2}), 50.0);
+
+  expectVariableSequence(underTest, {CNFVar{7}, CNFVar{2}});
+}
+
+TEST(UnitBranching, VSIDSBranchingHeuristic_decayRateRemainsFixedAfterBeingSet)
+{
+  CNFVar maxVar{10};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VSIDSBranchingHeuristic<FakeAssignmentProvider> underTest{maxVar, fakeAssignmentProvider};
+
+  underTest.setDecayRate(0.5);
+  underTest.beginHandlingConflict();
+  underTest.endHandlingConflict();
+  EXPECT_EQ(underTest.getActivityBumpDelta(), 2.0);
+
+  underTest.setDecayRate(1.0);
+  for (int i = 0; i < 20000; ++i) {
+    underTest.beginHandlingConflict();
+    underTest.endHandlingConflict();
+  }
+  EXPECT_EQ(underTest.getActivityBumpDelta(), 2.0);
+}
+
 TEST(UnitBranching, VSIDSBranchingHeuristic_signsAreSelectedByPhase)
 {
   CNFVar maxVar{10};
@@ -214,6 +211,24 @@ TEST(UnitBranching, VSIDSBranchingHeuristic_signsAreSelectedByPhase)
   expectLiteralSequence(underTest, {5_Lit, 4_Lit, ~3_Lit});
 }
 
+TEST(UnitBranching, VSIDSBranchingHeuristic_signsAreSelectedByTargetPhaseIfEnabled)
+{
+  CNFVar maxVar{10};
+  FakeAssignmentProvider fakeAssignmentProvider{TBools::INDETERMINATE};
+  VSIDSBranchingHeuristic<FakeAssignmentProvider> underTest{maxVar, fakeAssignmentProvider};
+  addDefaultConflictSequence(underTest);
+  underTest.setUseTargetPhases(true);
+
+  fakeAssignmentProvider.setPhase(CNFVar{5}, TBools::FALSE);
+  fakeAssignmentProvider.setPhase(CNFVar{4}, TBools::FALSE);
+  fakeAssignmentProvider.setPhase(CNFVar{3}, TBools::TRUE);
+  fakeAssignmentProvider.setTargetPhase(CNFVar{5}, TBools::TRUE);
+  fakeAssignmentProvider.setTargetPhase(CNFVar{4}, TBools::TRUE);
+  fakeAssignmentProvider.setTargetPhase(CNFVar{3}, TBools::FALSE);
+
+  expectLiteralSequence(underTest, {5_Lit, 4_Lit, ~3_Lit});
+}
+
 TEST(UnitBranching, VSIDSBranchingHeuristic_addedVariablesAreUsedForDecisions)
 {
   CNFVar initialMaxVar{5};
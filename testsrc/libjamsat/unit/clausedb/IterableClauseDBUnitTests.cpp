@@ -31,6 +31,7 @@
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -41,7 +42,7 @@ struct TestClause {
 public:
   using size_type = SizeT;
 
-  enum class Flag { SCHEDULED_FOR_DELETION, REDUNDANT };
+  enum class Flag { SCHEDULED_FOR_DELETION, REDUNDANT, USED_RECENTLY };
 
   static auto constructIn(void* targetMemory, size_type clauseSize) -> TestClause*;
   static auto getAllocationSize(size_type clauseSize) -> std::size_t;
@@ -539,4 +540,120 @@ TEST(UnitClauseDB, IterableClauseDB_compressMultiRegionClauseDBWithDelete)
                    return t.size();
                  })));
 }
+
+namespace {
+template <typename Rng>
+auto getSizes(Rng range) -> std::vector<std::size_t>
+{
+  std::vector<std::size_t> result;
+  for (auto const& clause : range) {
+    result.push_back(clause.size());
+  }
+  return result;
+}
+}
+
+TEST(UnitClauseDB, IterableClauseDB_allClausesAreChangedBeforeClearingChangeLog)
+{
+  std::size_t const regionSize = 128;
+  IterableClauseDB<RegularTestClause> underTest{regionSize};
+
+  std::vector<RegularTestClause*> expectedClauses;
+  for (int i = 0; i < 8; ++i) {
+    auto clause = underTest.createClause(i);
+    ASSERT_TRUE(clause);
+    expectedClauses.push_back(clause);
+  }
+
+  EXPECT_TRUE(refRangeIsEqualToPtrRange(underTest.getChangedClauses(), expectedClauses));
+  auto isUnchanged = underTest.getUnchangedClauseQuery();
+  for (RegularTestClause* clause : expectedClauses) {
+    EXPECT_FALSE(isUnchanged(clause));
+  }
+}
+
+TEST(UnitClauseDB, IterableClauseDB_clausesCreatedAfterClearingChangeLogAreChanged)
+{
+  std::size_t const regionSize = 128;
+  IterableClauseDB<RegularTestClause> underTest{regionSize};
+
+  std::vector<RegularTestClause*> unchangedClauses;
+  for (int i = 0; i < 3; ++i) {
+    auto clause = underTest.createClause(5);
+    ASSERT_TRUE(clause);
+    unchangedClauses.push_back(clause);
+  }
+
+  underTest.clearChangeLog();
+
+  std::vector<RegularTestClause*> changedClauses;
+  for (int i = 0; i < 3; ++i) {
+    auto clause = underTest.createClause(5);
+    ASSERT_TRUE(clause);
+    changedClauses.push_back(clause);
+  }
+
+  EXPECT_TRUE(refRangeIsEqualToPtrRange(underTest.getChangedClauses(), changedClauses));
+  auto isUnchanged = underTest.getUnchangedClauseQuery();
+  for (RegularTestClause* clause : unchangedClauses) {
+    EXPECT_TRUE(isUnchanged(clause));
+  }
+  for (RegularTestClause* clause : changedClauses) {
+    EXPECT_FALSE(isUnchanged(clause));
+  }
+}
+
+TEST(UnitClauseDB, IterableClauseDB_compressDoesNotRelocateRegionsPrecedingDeletedClauses)
+{
+  // Using a region size such that each region contains exactly one clause:
+  std::size_t const regionSize = 64;
+  IterableClauseDB<RegularTestClause> underTest{regionSize};
+
+  std::vector<RegularTestClause*> clauses;
+  for (int i = 1; i <= 6; ++i) {
+    auto clause = underTest.createClause(i);
+    ASSERT_TRUE(clause);
+    clauses.push_back(clause);
+  }
+
+  underTest.clearChangeLog();
+  clauses[3]->setFlag(RegularTestClause::Flag::SCHEDULED_FOR_DELETION);
+  underTest.compress();
+
+  std::vector<RegularTestClause*> const retainedClauses{clauses[0], clauses[1], clauses[2]};
+  std::vector<RegularTestClause*> actualClauses;
+  for (auto& clause : underTest.getClauses()) {
+    actualClauses.push_back(&clause);
+  }
+  ASSERT_EQ(actualClauses.size(), 5ULL);
+  EXPECT_TRUE(std::equal(retainedClauses.begin(), retainedClauses.end(), actualClauses.begin()));
+
+  EXPECT_EQ(getSizes(underTest.getChangedClauses()), (std::vector<std::size_t>{5, 6}));
+  auto isUnchanged = underTest.getUnchangedClauseQuery();
+  for (RegularTestClause* clause : retainedClauses) {
+    EXPECT_TRUE(isUnchanged(clause));
+  }
+  EXPECT_FALSE(isUnchanged(actualClauses[3]));
+  EXPECT_FALSE(isUnchanged(actualClauses[4]));
+}
+
+TEST(UnitClauseDB, IterableClauseDB_compressWithoutDeletedClausesDoesNotChangeClauses)
+{
+  std::size_t const regionSize = 128;
+  IterableClauseDB<RegularTestClause> underTest{regionSize};
+
+  std::vector<RegularTestClause*> clauses;
+  for (int i = 0; i < 8; ++i) {
+    auto clause = underTest.createClause(i);
+    ASSERT_TRUE(clause);
+    clauses.push_back(clause);
+  }
+
+  underTest.clearChangeLog();
+  underTest.compress();
+
+  EXPECT_TRUE(refRangeIsEqualToPtrRange(underTest.getClauses(), clauses));
+  auto changedClauses = underTest.getChangedClauses();
+  EXPECT_EQ(changedClauses.begin(), changedClauses.end());
+}
 }
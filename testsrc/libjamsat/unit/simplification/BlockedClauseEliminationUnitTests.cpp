@@ -0,0 +1,190 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/proof/Model.h>
+#include <libjamsat/simplification/ModelReconstruction.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/optimizers/BlockedClauseElimination.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationBCE : public OptimizerTestFixture {
+protected:
+  auto createState(CNFVar maxVar,
+                   std::vector<CNFVar> const& frozenVars,
+                   bool withCertificate = false) -> SharedOptimizerState
+  {
+    SharedOptimizerState result = OptimizerTestFixture::createState(maxVar, withCertificate);
+    for (CNFVar var : frozenVars) {
+      result.freeze(var);
+    }
+    return result;
+  }
+};
+
+TEST_F(UnitSimplificationBCE, removesBlockedClauses)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, ~2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 2_Lit, 4_Lit});
+
+  auto underTest = createBlockedClauseEliminator();
+  StatisticsEra era;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState state = createState(CNFVar{4}, {CNFVar{2}, CNFVar{3}, CNFVar{4}});
+  SharedOptimizerState result = underTest->optimize(std::move(state), era);
+
+  // (~1 ~2 3) is blocked by ~1, (1 2) and (~1 2 4) have non-tautological resolvents:
+  EXPECT_EQ(getClauses(result), normalized({{1_Lit, 2_Lit}, {~1_Lit, 2_Lit, 4_Lit}}));
+  EXPECT_EQ(result.getStats().amntClausesRemoved, 1ULL);
+  EXPECT_TRUE(m_reconstructionStack.isWitness(CNFVar{1}));
+  EXPECT_FALSE(m_reconstructionStack.isEliminated(CNFVar{1}));
+  EXPECT_FALSE(result.hasBreakingChange());
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+
+TEST_F(UnitSimplificationBCE, reconstructedModelSatisfiesOriginalProblem)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({~2_Lit, ~3_Lit});
+
+  auto underTest = createBlockedClauseEliminator();
+  SharedOptimizerState state = createState(CNFVar{3}, {CNFVar{2}, CNFVar{3}});
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+
+  ASSERT_EQ(getClauses(result), normalized({{~2_Lit, ~3_Lit}}));
+  auto model = createModel(CNFVar{3});
+  for (CNFVar var{0}; var <= CNFVar{3}; var = nextCNFVar(var)) {
+    model->setAssignment(var, TBools::FALSE);
+  }
+  m_reconstructionStack.reconstruct(*model);
+  EXPECT_EQ(model->check(m_problem), TBools::TRUE);
+}
+
+TEST_F(UnitSimplificationBCE, frozenVariablesAreNotUsedAsWitnesses)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({~2_Lit, ~3_Lit});
+
+  auto underTest = createBlockedClauseEliminator();
+  SharedOptimizerState state = createState(CNFVar{3}, {CNFVar{1}, CNFVar{2}, CNFVar{3}});
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+
+  EXPECT_EQ(getClauses(result).size(), 3ULL);
+  EXPECT_TRUE(m_reconstructionStack.empty());
+}
+
+TEST_F(UnitSimplificationBCE, redundantClausesAreNeitherRemovedNorResolved)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 3_Lit});
+  m_lemmas.push_back({1_Lit, 3_Lit});
+  m_lemmas.push_back({~1_Lit, 4_Lit});
+
+  auto underTest = createBlockedClauseEliminator();
+  SharedOptimizerState state = createState(CNFVar{4}, {CNFVar{2}, CNFVar{3}, CNFVar{4}});
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+
+  EXPECT_EQ(getClauses(result),
+            normalized({{~2_Lit, 3_Lit}, {1_Lit, 3_Lit}, {~1_Lit, 4_Lit}}));
+}
+
+TEST_F(UnitSimplificationBCE, literalsWithTooManyResolutionPartnersAreNotWitnesses)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, ~2_Lit, 3_Lit});
+
+  BlockedClauseEliminationOptions options;
+  options.maxOccurrences = 0;
+  auto underTest = createBlockedClauseEliminator(options);
+  SharedOptimizerState state = createState(CNFVar{3}, {CNFVar{2}, CNFVar{3}});
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+
+  EXPECT_EQ(getClauses(result).size(), 2ULL);
+}
+
+TEST_F(UnitSimplificationBCE, resumesPreemptedRound)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({3_Lit, 4_Lit});
+
+  auto underTest = createBlockedClauseEliminator();
+  StatisticsEra era;
+  SharedOptimizerState state = createState(CNFVar{4}, {CNFVar{2}, CNFVar{4}});
+  state.setTickBudget(1);
+  SharedOptimizerState intermediate = underTest->optimize(std::move(state), era);
+  EXPECT_EQ(getClauses(intermediate), normalized({{3_Lit, 4_Lit}}));
+  EXPECT_TRUE(underTest->wantsExecution(era));
+
+  intermediate.setTickBudget(std::numeric_limits<uint64_t>::max());
+  SharedOptimizerState result = underTest->optimize(std::move(intermediate), era);
+  EXPECT_TRUE(getClauses(result).empty());
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+
+TEST_F(UnitSimplificationBCE, noClausesAreRemovedWhenProducingCertificate)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, ~2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 2_Lit, 4_Lit});
+
+  auto underTest = createBlockedClauseEliminator();
+  SharedOptimizerState state = createState(CNFVar{4}, {CNFVar{2}, CNFVar{3}, CNFVar{4}}, true);
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+
+  EXPECT_EQ(getClauses(result).size(), 3ULL);
+  EXPECT_TRUE(m_reconstructionStack.empty());
+}
+
+TEST_F(UnitSimplificationBCE, skippedRoundIsScheduledLikeCompletedRound)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, ~2_Lit, 3_Lit});
+
+  auto underTest = createBlockedClauseEliminator();
+  SharedOptimizerState state = createState(CNFVar{3}, {CNFVar{2}, CNFVar{3}}, true);
+  StatisticsEra era;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState result = underTest->optimize(std::move(state), era);
+
+  EXPECT_EQ(getClauses(result).size(), 2ULL);
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+}
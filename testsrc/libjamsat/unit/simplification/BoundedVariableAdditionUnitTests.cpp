@@ -0,0 +1,164 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/optimizers/BoundedVariableAddition.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationBoundedVariableAddition : public OptimizerTestFixture {
+protected:
+  /**
+   * Checks that each assignment of the variables of m_problem satisfies m_problem iff
+   * it can be extended to an assignment satisfying \p clauses.
+   */
+  void expectEquisatisfiable(std::vector<CNFClause> const& clauses, CNFVar maxVar)
+  {
+    auto isSatisfiedBy = [](std::vector<CNFClause> const& problem, uint64_t assignment) {
+      return std::all_of(problem.begin(), problem.end(), [assignment](CNFClause const& clause) {
+        return std::any_of(clause.begin(), clause.end(), [assignment](CNFLit lit) {
+          bool const value = ((assignment >> lit.getVariable().getRawValue()) & 1) != 0;
+          return value == (lit.getSign() == CNFSign::POSITIVE);
+        });
+      });
+    };
+
+    uint32_t const amntOriginalVars = m_problem.getMaxVar().getRawValue() + 1;
+    uint32_t const amntNewVars = maxVar.getRawValue() + 1 - amntOriginalVars;
+    for (uint64_t original = 0; original < (1ULL << amntOriginalVars); ++original) {
+      bool extensible = false;
+      for (uint64_t extension = 0; extension < (1ULL << amntNewVars); ++extension) {
+        if (isSatisfiedBy(clauses, original | (extension << amntOriginalVars))) {
+          extensible = true;
+          break;
+        }
+      }
+      EXPECT_EQ(isSatisfiedBy(m_problem.getClauses(), original), extensible)
+          << "for assignment " << original;
+    }
+  }
+};
+
+TEST_F(UnitSimplificationBoundedVariableAddition, replacesProductOfLiteralsAndClauses)
+{
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({1_Lit, 4_Lit});
+  m_problem.addClause({1_Lit, 5_Lit});
+  m_problem.addClause({2_Lit, 3_Lit});
+  m_problem.addClause({2_Lit, 4_Lit});
+  m_problem.addClause({2_Lit, 5_Lit});
+
+  auto underTest = createBoundedVariableAdder();
+  StatisticsEra era;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{5}), era);
+
+  ASSERT_EQ(result.getMaxVar(), CNFVar{6});
+  EXPECT_TRUE(result.hasBreakingChange());
+  EXPECT_FALSE(isDeterminate(result.getAssignment().getAssignment(CNFVar{6})));
+
+  // 1 and 2 occur most frequently, so their clauses are factored:
+  std::vector<CNFClause> clauses = getClauses(result, false);
+  EXPECT_EQ(clauses,
+            normalized({{3_Lit, 6_Lit},
+                        {4_Lit, 6_Lit},
+                        {5_Lit, 6_Lit},
+                        {1_Lit, ~6_Lit},
+                        {2_Lit, ~6_Lit}}));
+  expectEquisatisfiable(clauses, CNFVar{6});
+
+  EXPECT_EQ(result.getStats().amntVarsAdded, 1ULL);
+  EXPECT_EQ(result.getStats().amntClausesAdded, 5ULL);
+  EXPECT_EQ(result.getStats().amntClausesRemoved, 6ULL);
+  EXPECT_FALSE(underTest->wantsExecution(era));
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationBoundedVariableAddition, compressesPairwiseAtMostOneEncoding)
+{
+  for (CNFVar::RawVariable i = 0; i < 8; ++i) {
+    for (CNFVar::RawVariable j = i + 1; j < 8; ++j) {
+      m_problem.addClause({CNFLit{CNFVar{i}, CNFSign::NEGATIVE},
+                           CNFLit{CNFVar{j}, CNFSign::NEGATIVE}});
+    }
+  }
+
+  auto underTest = createBoundedVariableAdder();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{7}), StatisticsEra{});
+
+  std::vector<CNFClause> clauses = getClauses(result, false);
+  EXPECT_LT(clauses.size(), m_problem.getClauses().size());
+  EXPECT_GT(result.getMaxVar(), CNFVar{7});
+  EXPECT_EQ(result.getStats().amntVarsAdded, result.getMaxVar().getRawValue() - 7ULL);
+  expectEquisatisfiable(clauses, result.getMaxVar());
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationBoundedVariableAddition, doesNotReplaceClausesWithoutReduction)
+{
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({1_Lit, 4_Lit});
+  m_problem.addClause({2_Lit, 3_Lit});
+  m_problem.addClause({2_Lit, 4_Lit});
+  m_problem.addClause({2_Lit, 5_Lit, 6_Lit});
+
+  auto underTest = createBoundedVariableAdder();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{6}), StatisticsEra{});
+
+  EXPECT_EQ(result.getMaxVar(), CNFVar{6});
+  EXPECT_FALSE(result.hasBreakingChange());
+  EXPECT_EQ(getClauses(result, false), normalized(m_problem.getClauses()));
+  EXPECT_EQ(result.getStats().amntVarsAdded, 0ULL);
+}
+
+TEST_F(UnitSimplificationBoundedVariableAddition, redundantClausesAreNotReplaced)
+{
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({1_Lit, 4_Lit});
+  m_problem.addClause({1_Lit, 5_Lit});
+  m_lemmas.push_back({2_Lit, 3_Lit});
+  m_lemmas.push_back({2_Lit, 4_Lit});
+  m_lemmas.push_back({2_Lit, 5_Lit});
+
+  auto underTest = createBoundedVariableAdder();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{5}), StatisticsEra{});
+
+  EXPECT_EQ(result.getMaxVar(), CNFVar{5});
+  EXPECT_EQ(getClauses(result, false), normalized(m_problem.getClauses()));
+  EXPECT_EQ(getClauses(result, true), normalized(m_lemmas));
+}
+}
@@ -0,0 +1,199 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/clausedb/IterableClauseDB.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/simplification/ModelReconstruction.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/optimizers/BoundedVariableElimination.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationBVE : public OptimizerTestFixture {
+};
+
+TEST_F(UnitSimplificationBVE, eliminatesVariableWithFewResolvents)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 4_Lit, 5_Lit});
+  m_lemmas.push_back({~1_Lit, 4_Lit});
+
+  BoundedVariableEliminationOptions options;
+  options.maxOccurrences = 3;
+  auto underTest = createBoundedVariableEliminator(options);
+  StatisticsEra era;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+
+  SharedOptimizerState state = createState(CNFVar{5});
+  for (CNFVar::RawVariable var = 2; var <= 5; ++var) {
+    // Otherwise, the variables 2, ..., 5 would be eliminated first as pure literals
+    state.freeze(CNFVar{var});
+  }
+  SharedOptimizerState result = underTest->optimize(std::move(state), era);
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  EXPECT_TRUE(result.hasBreakingChange());
+  EXPECT_TRUE(m_reconstructionStack.isEliminated(CNFVar{1}));
+  EXPECT_EQ(result.getStats().amntVarsEliminated, m_reconstructionStack.getAmntEliminatedVars());
+
+  for (CNFClause const& clause : getClauses(result)) {
+    EXPECT_EQ(std::count_if(clause.begin(),
+                            clause.end(),
+                            [](CNFLit lit) { return lit.getVariable() == CNFVar{1}; }),
+              0);
+  }
+
+  EXPECT_FALSE(m_drat->hasDetectedInvalidLemma());
+  EXPECT_FALSE(m_drat->hasDetectedUnsupportedLemma());
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+
+TEST_F(UnitSimplificationBVE, reconstructedModelSatisfiesOriginalProblem)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 4_Lit});
+  m_problem.addClause({~1_Lit, ~2_Lit});
+
+  auto underTest = createBoundedVariableEliminator();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+
+  // All clauses are removed one variable after the other, so any assignment of the
+  // remaining variables can be extended to a model:
+  ASSERT_EQ(getClauses(result).size(), 0ULL);
+  ASSERT_TRUE(result.getFacts().empty());
+  auto model = createModel(CNFVar{4});
+  for (CNFVar var{0}; var <= CNFVar{4}; var = nextCNFVar(var)) {
+    if (!m_reconstructionStack.isEliminated(var)) {
+      model->setAssignment(var, TBools::TRUE);
+    }
+  }
+  m_reconstructionStack.reconstruct(*model);
+  EXPECT_EQ(model->check(m_problem), TBools::TRUE);
+}
+
+TEST_F(UnitSimplificationBVE, doesNotEliminateVariableWhenClauseCountWouldIncrease)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({1_Lit, 3_Lit});
+  m_problem.addClause({1_Lit, 4_Lit});
+  m_problem.addClause({~1_Lit, 5_Lit});
+  m_problem.addClause({~1_Lit, 6_Lit});
+  m_problem.addClause({~1_Lit, 7_Lit});
+  for (CNFVar::RawVariable var = 2; var <= 7; ++var) {
+    // Preventing the elimination of the other variables
+    m_problem.addClause({~CNFLit{CNFVar{var}, CNFSign::POSITIVE}, 8_Lit, 9_Lit});
+    m_problem.addClause({CNFLit{CNFVar{var}, CNFSign::POSITIVE}, ~8_Lit, 9_Lit});
+  }
+
+  auto underTest = createBoundedVariableEliminator();
+  SharedOptimizerState state = createState(CNFVar{9});
+  state.freeze(CNFVar{8});
+  state.freeze(CNFVar{9});
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+  EXPECT_FALSE(m_reconstructionStack.isEliminated(CNFVar{1}));
+}
+
+TEST_F(UnitSimplificationBVE, doesNotEliminateFrozenVariables)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+
+  auto underTest = createBoundedVariableEliminator();
+  SharedOptimizerState state = createState(CNFVar{3});
+  for (CNFVar var{0}; var <= CNFVar{3}; var = nextCNFVar(var)) {
+    state.freeze(var);
+  }
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+  EXPECT_EQ(m_reconstructionStack.getAmntEliminatedVars(), 0ULL);
+  EXPECT_FALSE(result.hasBreakingChange());
+  EXPECT_EQ(getClauses(result).size(), 2ULL);
+}
+
+TEST_F(UnitSimplificationBVE, doesNotEliminateVariablesWithoutReconstructionStack)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+
+  auto underTest = createBoundedVariableEliminator();
+  SharedOptimizerState state{std::vector<CNFLit>{},
+                             PolymorphicClauseDB{IterableClauseDB<Clause>{1024}},
+                             Assignment{CNFVar{3}},
+                             nullptr,
+                             CNFVar{3}};
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+  EXPECT_EQ(result.getStats().amntVarsEliminated, 0ULL);
+}
+
+TEST_F(UnitSimplificationBVE, detectsUnsatisfiabilityViaUnitResolvents)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({3_Lit, ~2_Lit});
+  m_problem.addClause({~3_Lit, ~2_Lit});
+
+  auto underTest = createBoundedVariableEliminator();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{3}), StatisticsEra{});
+  EXPECT_TRUE(result.hasDetectedUnsat());
+
+  // The solver completes the proof by adding the empty clause:
+  m_drat->addATClause(std::vector<CNFLit>{});
+  EXPECT_TRUE(m_drat->hasValidatedUnsat());
+  EXPECT_FALSE(m_drat->hasDetectedInvalidLemma());
+}
+
+TEST_F(UnitSimplificationBVE, isPreemptedWhenTickBudgetIsExhausted)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({4_Lit, 5_Lit});
+  m_problem.addClause({~4_Lit, 6_Lit});
+
+  auto underTest = createBoundedVariableEliminator();
+  StatisticsEra era;
+  era.m_conflictCount = 100;
+  SharedOptimizerState state = createState(CNFVar{6});
+  state.setTickBudget(1);
+  SharedOptimizerState result = underTest->optimize(std::move(state), era);
+  EXPECT_TRUE(underTest->wantsExecution(era));
+  EXPECT_EQ(m_reconstructionStack.getAmntEliminatedVars(), 0ULL);
+
+  result.setTickBudget(100000);
+  result = underTest->optimize(std::move(result), era);
+  EXPECT_GT(m_reconstructionStack.getAmntEliminatedVars(), 0ULL);
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+}
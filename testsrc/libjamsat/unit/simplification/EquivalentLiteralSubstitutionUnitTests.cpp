@@ -0,0 +1,209 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/proof/Model.h>
+#include <libjamsat/simplification/ModelReconstruction.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/optimizers/EquivalentLiteralSubstitution.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationELS : public OptimizerTestFixture {
+};
+
+TEST_F(UnitSimplificationELS, substitutesEquivalentLiterals)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 3_Lit});
+  m_problem.addClause({~3_Lit, 1_Lit});
+  m_problem.addClause({1_Lit, 4_Lit, 5_Lit});
+  m_problem.addClause({~2_Lit, 5_Lit, 6_Lit});
+  m_problem.addClause({3_Lit, ~6_Lit, 7_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  StatisticsEra era;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{7}), era);
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  EXPECT_TRUE(result.hasBreakingChange());
+  EXPECT_TRUE(m_reconstructionStack.isEliminated(CNFVar{2}));
+  EXPECT_TRUE(m_reconstructionStack.isEliminated(CNFVar{3}));
+  EXPECT_EQ(result.getStats().amntVarsEliminated, 2ULL);
+
+  std::vector<CNFClause> expected{
+      {~1_Lit, 5_Lit, 6_Lit}, {1_Lit, 4_Lit, 5_Lit}, {1_Lit, ~6_Lit, 7_Lit}};
+  for (CNFClause& clause : expected) {
+    std::sort(clause.begin(), clause.end());
+  }
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(getClauses(result), expected);
+  expectValidProof();
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+
+TEST_F(UnitSimplificationELS, reconstructedModelSatisfiesOriginalProblem)
+{
+  m_problem.addClause({~1_Lit, ~2_Lit});
+  m_problem.addClause({2_Lit, 1_Lit});
+  m_problem.addClause({2_Lit, 3_Lit, 4_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+  ASSERT_TRUE(m_reconstructionStack.isEliminated(CNFVar{2}));
+  std::vector<CNFClause> const expected{{~1_Lit, 3_Lit, 4_Lit}};
+  ASSERT_EQ(getClauses(result), expected);
+
+  auto model = createModel(CNFVar{4});
+  model->setAssignment(CNFVar{0}, TBools::FALSE);
+  model->setAssignment(CNFVar{1}, TBools::FALSE);
+  model->setAssignment(CNFVar{3}, TBools::FALSE);
+  model->setAssignment(CNFVar{4}, TBools::FALSE);
+  m_reconstructionStack.reconstruct(*model);
+  EXPECT_EQ(model->getAssignment(CNFVar{2}), TBools::TRUE);
+  EXPECT_EQ(model->check(m_problem), TBools::TRUE);
+}
+
+TEST_F(UnitSimplificationELS, removesDuplicateClauses)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 1_Lit});
+  m_problem.addClause({2_Lit, 3_Lit, 4_Lit});
+  m_problem.addClause({1_Lit, 4_Lit, 3_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+
+  std::vector<CNFClause> const expected{{1_Lit, 3_Lit, 4_Lit}};
+  EXPECT_EQ(getClauses(result), expected);
+  EXPECT_EQ(result.getStats().amntClausesAdded, 0ULL);
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationELS, duplicateFactsAreNotAdded)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 1_Lit});
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({2_Lit, 1_Lit, 3_Lit});
+  m_problem.addClause({~3_Lit, 4_Lit});
+  m_problem.addClause({~4_Lit, 3_Lit});
+  m_problem.addClause({3_Lit, 4_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  std::vector<CNFLit> const expectedFacts{1_Lit, 3_Lit};
+  EXPECT_EQ(result.getFacts(), expectedFacts);
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationELS, frozenVariablesAreNotSubstituted)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 1_Lit});
+  m_problem.addClause({2_Lit, 3_Lit, 4_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  SharedOptimizerState state = createState(CNFVar{4});
+  state.freeze(CNFVar{2});
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+
+  EXPECT_FALSE(m_reconstructionStack.isEliminated(CNFVar{2}));
+  EXPECT_TRUE(m_reconstructionStack.isEliminated(CNFVar{1}));
+  std::vector<CNFClause> const expected{{2_Lit, 3_Lit, 4_Lit}};
+  EXPECT_EQ(getClauses(result), expected);
+}
+
+TEST_F(UnitSimplificationELS, detectsLiteralsEquivalentToTheirNegation)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, ~2_Lit});
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({1_Lit, ~2_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{2}), StatisticsEra{});
+
+  EXPECT_TRUE(result.hasDetectedUnsat());
+  m_drat->addATClause(std::vector<CNFLit>{});
+  EXPECT_TRUE(m_drat->hasValidatedUnsat());
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationELS, noBreakingChangeWithoutEquivalentLiterals)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 3_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{3}), StatisticsEra{});
+
+  EXPECT_FALSE(result.hasBreakingChange());
+  EXPECT_EQ(getClauses(result).size(), 2ULL);
+  EXPECT_EQ(m_reconstructionStack.getAmntEliminatedVars(), 0ULL);
+}
+
+TEST_F(UnitSimplificationELS, resumesPreemptedRound)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 1_Lit});
+  m_problem.addClause({~3_Lit, 4_Lit});
+  m_problem.addClause({~4_Lit, 3_Lit});
+
+  auto underTest = createEquivalentLiteralSubstitutor();
+  StatisticsEra era;
+  SharedOptimizerState state = createState(CNFVar{4});
+  // Enough ticks for building the implication graph (19 ticks) and for searching
+  // the component of 1_Lit (4 ticks):
+  state.setTickBudget(20);
+  SharedOptimizerState intermediate = underTest->optimize(std::move(state), era);
+  EXPECT_TRUE(m_reconstructionStack.isEliminated(CNFVar{2}));
+  EXPECT_FALSE(m_reconstructionStack.isEliminated(CNFVar{4}));
+  EXPECT_EQ(getClauses(intermediate), normalized({{~3_Lit, 4_Lit}, {3_Lit, ~4_Lit}}));
+  EXPECT_TRUE(underTest->wantsExecution(era));
+
+  intermediate.setTickBudget(std::numeric_limits<uint64_t>::max());
+  SharedOptimizerState result = underTest->optimize(std::move(intermediate), era);
+  EXPECT_TRUE(m_reconstructionStack.isEliminated(CNFVar{4}));
+  EXPECT_TRUE(getClauses(result).empty());
+  EXPECT_FALSE(underTest->wantsExecution(era));
+  expectValidProof();
+}
+}
@@ -0,0 +1,171 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/optimizers/FailedLiteralProbing.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationProbing : public OptimizerTestFixture {
+};
+
+TEST_F(UnitSimplificationProbing, derivesFailedLiteralsAsFacts)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({~2_Lit, ~3_Lit, 4_Lit});
+  m_problem.addClause({~2_Lit, ~3_Lit, ~4_Lit});
+
+  auto underTest = createFailedLiteralProber();
+  StatisticsEra era;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), era);
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  EXPECT_EQ(result.getFacts(), std::vector<CNFLit>{~1_Lit});
+  EXPECT_EQ(result.getStats().amntFactsDerived, 1ULL);
+  EXPECT_EQ(result.getAssignment().getNumAssignments(), 0ULL);
+  expectValidProof();
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+
+TEST_F(UnitSimplificationProbing, liftsLiteralsImpliedByBothPolarities)
+{
+  // 1 -> 2, and ~1 -> 3 -> 2 (with ~4):
+  m_problem.addClause({~4_Lit});
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({1_Lit, 3_Lit, 4_Lit});
+  m_problem.addClause({~3_Lit, 2_Lit});
+
+  auto underTest = createFailedLiteralProber();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  EXPECT_EQ(result.getFacts(), (std::vector<CNFLit>{~4_Lit, 2_Lit}));
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationProbing, redundantClausesAreNotUsedForProbing)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({~2_Lit, ~3_Lit, 4_Lit, 5_Lit});
+  m_problem.addClause({~2_Lit, ~3_Lit, 4_Lit, ~5_Lit});
+
+  SharedOptimizerState state = createState(CNFVar{5});
+  // Implied by the problem, and sufficient for deriving ~1 via propagation:
+  Clause* lemmas[2] = {state.getClauseDB().createClause(3), state.getClauseDB().createClause(3)};
+  std::vector<CNFLit> const lemmaLits[2] = {{~2_Lit, ~3_Lit, 4_Lit}, {~2_Lit, ~3_Lit, ~4_Lit}};
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_NE(lemmas[i], nullptr);
+    std::copy(lemmaLits[i].begin(), lemmaLits[i].end(), lemmas[i]->begin());
+    lemmas[i]->setFlag(Clause::Flag::REDUNDANT);
+    lemmas[i]->clauseUpdated();
+    state.getAssignment().registerClause(*lemmas[i]);
+  }
+
+  auto underTest = createFailedLiteralProber();
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+  EXPECT_TRUE(result.getFacts().empty());
+}
+
+TEST_F(UnitSimplificationProbing, probingDoesNotAlterSavedPhases)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({~2_Lit, 4_Lit, 5_Lit});
+
+  SharedOptimizerState state = createState(CNFVar{5});
+  state.getAssignment().setPhase(CNFVar{3}, TBools::FALSE);
+  state.getAssignment().setPhase(CNFVar{4}, TBools::TRUE);
+
+  auto underTest = createFailedLiteralProber();
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+  EXPECT_TRUE(result.getFacts().empty());
+  EXPECT_EQ(result.getAssignment().getPhase(CNFVar{2}), TBools::FALSE);
+  EXPECT_EQ(result.getAssignment().getPhase(CNFVar{3}), TBools::FALSE);
+  EXPECT_EQ(result.getAssignment().getPhase(CNFVar{4}), TBools::TRUE);
+}
+
+TEST_F(UnitSimplificationProbing, probingDoesNotAlterTargetAndBestPhases)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({~2_Lit, 4_Lit, 5_Lit});
+
+  SharedOptimizerState state = createState(CNFVar{5});
+  for (CNFVar var{0}; var <= CNFVar{5}; var = nextCNFVar(var)) {
+    state.getAssignment().setPhase(var, TBools::TRUE);
+  }
+  state.getAssignment().resetTargetPhases();
+
+  auto underTest = createFailedLiteralProber();
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+  EXPECT_TRUE(result.getFacts().empty());
+
+  Assignment resultAssignment = std::get<2>(result.release());
+  for (CNFVar var{0}; var <= CNFVar{5}; var = nextCNFVar(var)) {
+    EXPECT_EQ(resultAssignment.getTargetPhase(var), TBools::TRUE) << "at variable " << var;
+    EXPECT_EQ(resultAssignment.getBestPhase(var), TBools::FALSE) << "at variable " << var;
+  }
+}
+
+TEST_F(UnitSimplificationProbing, addsHyperBinaryResolventsAsRedundantClauses)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({~2_Lit, ~3_Lit, 4_Lit});
+
+  auto underTest = createFailedLiteralProber();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+
+  std::vector<CNFClause> resolvents;
+  result.getClauseDB().getClauses([&resolvents](std::vector<Clause*> const& clauses) {
+    for (Clause* clause : clauses) {
+      if (clause->getFlag(Clause::Flag::REDUNDANT)) {
+        resolvents.emplace_back(clause->begin(), clause->end());
+      }
+    }
+  });
+
+  EXPECT_TRUE(result.getFacts().empty());
+  EXPECT_EQ(resolvents, (std::vector<CNFClause>{{~1_Lit, 4_Lit}}));
+  EXPECT_EQ(result.getStats().amntClausesAdded, 1ULL);
+  expectValidProof();
+}
+}
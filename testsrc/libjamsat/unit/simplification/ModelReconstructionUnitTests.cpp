@@ -0,0 +1,89 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/proof/Model.h>
+#include <libjamsat/simplification/ModelReconstruction.h>
+
+namespace jamsat {
+
+TEST(UnitSimplification, ModelReconstructionStackSetsWitnessOfFalsifiedClauses)
+{
+  ModelReconstructionStack underTest;
+  std::vector<CNFLit> const clause1{1_Lit, 2_Lit};
+  std::vector<CNFLit> const clause2{~1_Lit, 3_Lit};
+  underTest.push(clause2, ~1_Lit);
+  underTest.push(clause1, 1_Lit);
+  underTest.setEliminated(CNFVar{1});
+
+  EXPECT_TRUE(underTest.isEliminated(CNFVar{1}));
+  EXPECT_FALSE(underTest.isEliminated(CNFVar{2}));
+  EXPECT_FALSE(underTest.isEliminated(CNFVar{100}));
+  EXPECT_EQ(underTest.getAmntEliminatedVars(), 1ULL);
+  EXPECT_TRUE(underTest.isWitness(CNFVar{1}));
+  EXPECT_FALSE(underTest.isWitness(CNFVar{3}));
+  EXPECT_FALSE(underTest.isWitness(CNFVar{100}));
+
+  auto model = createModel(CNFVar{3});
+  model->setAssignment(CNFVar{2}, TBools::FALSE);
+  model->setAssignment(CNFVar{3}, TBools::TRUE);
+  underTest.reconstruct(*model);
+  EXPECT_EQ(model->getAssignment(CNFVar{1}), TBools::TRUE);
+
+  model->setAssignment(CNFVar{2}, TBools::TRUE);
+  model->setAssignment(CNFVar{3}, TBools::FALSE);
+  underTest.reconstruct(*model);
+  EXPECT_EQ(model->getAssignment(CNFVar{1}), TBools::FALSE);
+}
+
+TEST(UnitSimplification, ModelReconstructionStackRestoresClausesInReverseOrder)
+{
+  ModelReconstructionStack underTest;
+  std::vector<CNFLit> const clause1{1_Lit, 2_Lit};
+  std::vector<CNFLit> const clause2{3_Lit, ~1_Lit, 4_Lit};
+  underTest.push(clause1, 1_Lit);
+  underTest.push(clause2, ~1_Lit);
+  underTest.setEliminated(CNFVar{1});
+
+  std::vector<std::vector<CNFLit>> restoredClauses;
+  std::vector<std::size_t> witnessIndices;
+  underTest.restoreAll([&](gsl::span<CNFLit const> clause, std::size_t witnessIdx) {
+    restoredClauses.emplace_back(clause.begin(), clause.end());
+    witnessIndices.push_back(witnessIdx);
+  });
+
+  EXPECT_EQ(restoredClauses, (std::vector<std::vector<CNFLit>>{clause2, clause1}));
+  EXPECT_EQ(witnessIndices, (std::vector<std::size_t>{1, 0}));
+  EXPECT_TRUE(underTest.empty());
+  EXPECT_FALSE(underTest.isEliminated(CNFVar{1}));
+  EXPECT_FALSE(underTest.isWitness(CNFVar{1}));
+  EXPECT_EQ(underTest.getAmntEliminatedVars(), 0ULL);
+}
+}
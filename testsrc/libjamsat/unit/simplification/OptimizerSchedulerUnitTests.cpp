@@ -0,0 +1,203 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/clausedb/IterableClauseDB.h>
+#include <libjamsat/simplification/OptimizerScheduler.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+namespace jamsat {
+
+namespace {
+auto createTestState() -> SharedOptimizerState
+{
+  PolymorphicClauseDB clauseDB{IterableClauseDB<Clause>{1024}};
+  return SharedOptimizerState{
+      std::vector<CNFLit>{}, std::move(clauseDB), Assignment{CNFVar{10}}, nullptr, CNFVar{10}};
+}
+
+struct FakeOptimizerLog {
+  uint64_t amntRuns = 0;
+};
+
+/**
+ * An optimizer doing `totalTicks` ticks of work, consuming 100 ticks per step
+ * and removing one literal per step.
+ */
+class FakeOptimizer : public ProblemOptimizer {
+public:
+  FakeOptimizer(std::string name, uint64_t totalTicks, FakeOptimizerLog& log, bool findsUnsat)
+    : m_name{std::move(name)}, m_remainingTicks{totalTicks}, m_log{log}, m_findsUnsat{findsUnsat}
+  {
+  }
+
+  auto getName() const -> std::string override { return m_name; }
+
+  auto wantsExecution(StatisticsEra const&) const noexcept -> bool override
+  {
+    return m_remainingTicks > 0;
+  }
+
+  auto optimize(SharedOptimizerState state, StatisticsEra const&) -> SharedOptimizerState override
+  {
+    ++m_log.amntRuns;
+    while (m_remainingTicks > 0 && !state.isTickBudgetExhausted()) {
+      state.consumeTicks(100);
+      m_remainingTicks -= 100;
+      state.getStats().amntLitsRemoved += 1;
+    }
+    if (m_findsUnsat) {
+      state.setDetectedUnsat();
+    }
+    return state;
+  }
+
+private:
+  std::string m_name;
+  uint64_t m_remainingTicks;
+  FakeOptimizerLog& m_log;
+  bool m_findsUnsat;
+};
+
+auto createScheduler(std::vector<std::unique_ptr<ProblemOptimizer>> optimizers)
+    -> std::unique_ptr<ProblemOptimizer>
+{
+  OptimizerSchedulerOptions options;
+  options.ticksPerPropagation = 0.5;
+  options.minTicks = 1000;
+  options.maxTicks = 4000;
+  return createOptimizerScheduler(std::move(optimizers), options);
+}
+}
+
+TEST(UnitSimplification, SharedOptimizerStateTickBudgetIsUnlimitedByDefault)
+{
+  SharedOptimizerState state = createTestState();
+  state.consumeTicks(1000000);
+  EXPECT_FALSE(state.isTickBudgetExhausted());
+  EXPECT_EQ(state.getTicksConsumed(), 1000000ULL);
+}
+
+TEST(UnitSimplification, SharedOptimizerStateTickBudgetIsExhaustedWhenTicksAreConsumed)
+{
+  SharedOptimizerState state = createTestState();
+  state.setTickBudget(10);
+  EXPECT_EQ(state.getTicksConsumed(), 0ULL);
+  state.consumeTicks(9);
+  EXPECT_FALSE(state.isTickBudgetExhausted());
+  state.consumeTicks(1);
+  EXPECT_TRUE(state.isTickBudgetExhausted());
+}
+
+TEST(UnitSimplification, OptimizerSchedulerWantsExecutionIffAnyOptimizerWantsExecution)
+{
+  FakeOptimizerLog log;
+  std::vector<std::unique_ptr<ProblemOptimizer>> optimizers;
+  optimizers.push_back(std::make_unique<FakeOptimizer>("A", 0, log, false));
+  optimizers.push_back(std::make_unique<FakeOptimizer>("B", 500, log, false));
+  auto underTest = createScheduler(std::move(optimizers));
+
+  StatisticsEra era;
+  EXPECT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState result = underTest->optimize(createTestState(), era);
+  EXPECT_FALSE(underTest->wantsExecution(era));
+
+  // A does not want execution and is never run
+  ASSERT_EQ(log.amntRuns, 1ULL);
+  ASSERT_EQ(result.getStats().perOptimizer.size(), 1ULL);
+  OptimizerRunStats const& statsB = result.getStats().perOptimizer[0];
+  EXPECT_EQ(statsB.name, "B");
+  EXPECT_EQ(statsB.amntRuns, 1ULL);
+  EXPECT_EQ(statsB.amntPreemptions, 0ULL);
+  EXPECT_EQ(statsB.amntTicks, 500ULL);
+  EXPECT_EQ(statsB.benefit, 5ULL);
+}
+
+TEST(UnitSimplification, OptimizerSchedulerPreemptsAndResumesOptimizers)
+{
+  FakeOptimizerLog log;
+  std::vector<std::unique_ptr<ProblemOptimizer>> optimizers;
+  optimizers.push_back(std::make_unique<FakeOptimizer>("A", 2500, log, false));
+  auto underTest = createScheduler(std::move(optimizers));
+
+  // No search effort yet: the minimum budget of 1000 ticks is applied
+  StatisticsEra era;
+  SharedOptimizerState result = underTest->optimize(createTestState(), era);
+  ASSERT_EQ(result.getStats().perOptimizer.size(), 1ULL);
+  EXPECT_EQ(result.getStats().perOptimizer[0].amntTicks, 1000ULL);
+  EXPECT_EQ(result.getStats().perOptimizer[0].amntPreemptions, 1ULL);
+  EXPECT_TRUE(underTest->wantsExecution(era));
+
+  // 3000 propagations since the last run yield a budget of 1500 ticks
+  era.m_propagationCount = 3000;
+  result = underTest->optimize(std::move(result), era);
+  EXPECT_EQ(result.getStats().perOptimizer[0].amntRuns, 2ULL);
+  EXPECT_EQ(result.getStats().perOptimizer[0].amntTicks, 2500ULL);
+  EXPECT_EQ(result.getStats().perOptimizer[0].amntPreemptions, 1ULL);
+  EXPECT_EQ(result.getStats().perOptimizer[0].benefit, 25ULL);
+  EXPECT_FALSE(underTest->wantsExecution(era));
+
+  // After scheduling, the budget is unlimited again
+  EXPECT_FALSE(result.isTickBudgetExhausted());
+}
+
+TEST(UnitSimplification, OptimizerSchedulerLimitsBudgetByMaxTicks)
+{
+  FakeOptimizerLog log;
+  std::vector<std::unique_ptr<ProblemOptimizer>> optimizers;
+  optimizers.push_back(std::make_unique<FakeOptimizer>("A", 100000, log, false));
+  auto underTest = createScheduler(std::move(optimizers));
+
+  StatisticsEra era;
+  era.m_propagationCount = 1000000;
+  SharedOptimizerState result = underTest->optimize(createTestState(), era);
+  ASSERT_EQ(result.getStats().perOptimizer.size(), 1ULL);
+  EXPECT_EQ(result.getStats().perOptimizer[0].amntTicks, 4000ULL);
+}
+
+TEST(UnitSimplification, OptimizerSchedulerStopsAfterUnsatHasBeenDetected)
+{
+  FakeOptimizerLog log;
+  std::vector<std::unique_ptr<ProblemOptimizer>> optimizers;
+  optimizers.push_back(std::make_unique<FakeOptimizer>("A", 100, log, true));
+  optimizers.push_back(std::make_unique<FakeOptimizer>("B", 100, log, false));
+  auto underTest = createScheduler(std::move(optimizers));
+
+  StatisticsEra era;
+  SharedOptimizerState result = underTest->optimize(createTestState(), era);
+  EXPECT_TRUE(result.hasDetectedUnsat());
+  EXPECT_EQ(log.amntRuns, 1ULL);
+}
+}
@@ -0,0 +1,129 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/clausedb/IterableClauseDB.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/solver/Assignment.h>
+
+namespace jamsat {
+
+class UnitSimplificationSharedOptimizerState : public ::testing::Test {
+protected:
+  UnitSimplificationSharedOptimizerState()
+    : m_clauseDB{Clause::getAllocationSize(3)}, m_maxVar{CNFVar{4}}
+  {
+  }
+
+  auto addClause(std::vector<CNFLit> const& literals) -> Clause*
+  {
+    Clause* clause = m_clauseDB.createClause(literals.size());
+    std::copy(literals.begin(), literals.end(), clause->begin());
+    clause->clauseUpdated();
+    return clause;
+  }
+
+  auto createState() -> SharedOptimizerState
+  {
+    return SharedOptimizerState{{},
+                                PolymorphicClauseDB{std::move(m_clauseDB)},
+                                Assignment{m_maxVar},
+                                nullptr,
+                                m_maxVar};
+  }
+
+  void releaseState(SharedOptimizerState& state)
+  {
+    PolymorphicClauseDB clauseDB{IterableClauseDB<Clause>{1024}};
+    std::tie(std::ignore, clauseDB, std::ignore) = state.release();
+    m_clauseDB = clauseDB.release<IterableClauseDB<Clause>>();
+  }
+
+  static auto getOccurrences(SharedOptimizerState& state, CNFLit lit)
+      -> std::vector<std::vector<CNFLit>>
+  {
+    std::vector<std::vector<CNFLit>> result;
+    for (Clause const* clause : state.getOccurrenceMap()[lit]) {
+      result.emplace_back(clause->begin(), clause->end());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  // The region size is chosen such that each region contains exactly one
+  // clause, so that compressing the clause database relocates all clauses
+  // following the first deleted one
+  IterableClauseDB<Clause> m_clauseDB;
+  CNFVar m_maxVar;
+};
+
+TEST_F(UnitSimplificationSharedOptimizerState, adoptedOccurrenceMapContainsChangedClauses)
+{
+  addClause({1_Lit, 2_Lit, 3_Lit});
+  Clause* deleted = addClause({~1_Lit, 2_Lit, 3_Lit});
+  addClause({1_Lit, ~2_Lit, 3_Lit});
+
+  std::optional<SharedOptimizerState::OccMap> occMap;
+  {
+    SharedOptimizerState state = createState();
+    state.precomputeOccurrenceMap();
+    occMap = state.releaseOccurrenceMap();
+    releaseState(state);
+  }
+  ASSERT_TRUE(occMap.has_value());
+
+  deleted->setFlag(Clause::Flag::SCHEDULED_FOR_DELETION);
+  m_clauseDB.compress();
+  addClause({1_Lit, 2_Lit, ~4_Lit});
+
+  SharedOptimizerState state = createState();
+  state.adoptOccurrenceMap(std::move(*occMap));
+  ASSERT_TRUE(state.hasPrecomputedOccurrenceMap());
+
+  using Occurrences = std::vector<std::vector<CNFLit>>;
+  EXPECT_EQ(getOccurrences(state, 1_Lit),
+            (Occurrences{{1_Lit, ~2_Lit, 3_Lit}, {1_Lit, 2_Lit, 3_Lit}, {1_Lit, 2_Lit, ~4_Lit}}));
+  EXPECT_EQ(getOccurrences(state, ~1_Lit), Occurrences{});
+  EXPECT_EQ(getOccurrences(state, 2_Lit),
+            (Occurrences{{1_Lit, 2_Lit, 3_Lit}, {1_Lit, 2_Lit, ~4_Lit}}));
+  EXPECT_EQ(getOccurrences(state, ~4_Lit), (Occurrences{{1_Lit, 2_Lit, ~4_Lit}}));
+}
+
+TEST_F(UnitSimplificationSharedOptimizerState, noOccurrenceMapIsReleasedIfNoneHasBeenComputed)
+{
+  addClause({1_Lit, 2_Lit, 3_Lit});
+  SharedOptimizerState state = createState();
+  EXPECT_FALSE(state.releaseOccurrenceMap().has_value());
+}
+}
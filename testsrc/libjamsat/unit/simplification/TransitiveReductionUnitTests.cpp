@@ -0,0 +1,135 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/optimizers/TransitiveReduction.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationTransitiveReduction : public OptimizerTestFixture {
+};
+
+TEST_F(UnitSimplificationTransitiveReduction, removesTransitivelyRedundantBinaryClauses)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({~3_Lit, ~4_Lit, 5_Lit});
+
+  auto underTest = createTransitiveReducer();
+  StatisticsEra era;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{5}), era);
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  EXPECT_EQ(getClauses(result, false),
+            normalized({{~1_Lit, 2_Lit}, {~2_Lit, 3_Lit}, {~3_Lit, ~4_Lit, 5_Lit}}));
+  EXPECT_EQ(result.getStats().amntClausesRemoved, 1ULL);
+  EXPECT_FALSE(underTest->wantsExecution(era));
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationTransitiveReduction, removesDuplicateBinaryClausesKeepingIrredundantOnes)
+{
+  m_problem.addClause({1_Lit, 2_Lit});
+  m_problem.addClause({2_Lit, 1_Lit});
+  m_lemmas.push_back({1_Lit, 2_Lit});
+  m_lemmas.push_back({~1_Lit, 3_Lit});
+  m_lemmas.push_back({3_Lit, ~1_Lit});
+
+  auto underTest = createTransitiveReducer();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{3}), StatisticsEra{});
+
+  EXPECT_EQ(getClauses(result, false), normalized({{1_Lit, 2_Lit}}));
+  EXPECT_EQ(getClauses(result, true), normalized({{~1_Lit, 3_Lit}}));
+  EXPECT_EQ(result.getStats().amntClausesRemoved, 3ULL);
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationTransitiveReduction, irredundantClausesAreOnlyRemovedViaIrredundantPaths)
+{
+  m_problem.addClause({~1_Lit, 3_Lit});
+  m_problem.addClause({~3_Lit, 4_Lit});
+  m_lemmas.push_back({~1_Lit, 2_Lit});
+  m_lemmas.push_back({~2_Lit, 3_Lit});
+  m_lemmas.push_back({~1_Lit, 4_Lit});
+
+  auto underTest = createTransitiveReducer();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+
+  EXPECT_EQ(getClauses(result, false), normalized({{~1_Lit, 3_Lit}, {~3_Lit, 4_Lit}}));
+  EXPECT_EQ(getClauses(result, true), normalized({{~1_Lit, 2_Lit}, {~2_Lit, 3_Lit}}));
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationTransitiveReduction, clausesWithVariablesOfFactsAreNotRemoved)
+{
+  m_problem.addClause({1_Lit});
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+
+  auto underTest = createTransitiveReducer();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{3}), StatisticsEra{});
+
+  EXPECT_EQ(getClauses(result, false),
+            normalized({{~1_Lit, 2_Lit}, {~2_Lit, 3_Lit}, {~1_Lit, 3_Lit}}));
+  EXPECT_EQ(result.getStats().amntClausesRemoved, 0ULL);
+}
+
+TEST_F(UnitSimplificationTransitiveReduction, resumesPreemptedRound)
+{
+  m_problem.addClause({~1_Lit, 2_Lit});
+  m_problem.addClause({~2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 3_Lit});
+
+  auto underTest = createTransitiveReducer();
+  StatisticsEra era;
+  SharedOptimizerState state = createState(CNFVar{3});
+  state.setTickBudget(1);
+  SharedOptimizerState intermediate = underTest->optimize(std::move(state), era);
+  EXPECT_EQ(intermediate.getStats().amntClausesRemoved, 0ULL);
+  EXPECT_TRUE(underTest->wantsExecution(era));
+
+  intermediate.setTickBudget(std::numeric_limits<uint64_t>::max());
+  SharedOptimizerState result = underTest->optimize(std::move(intermediate), era);
+  EXPECT_EQ(getClauses(result, false), normalized({{~1_Lit, 2_Lit}, {~2_Lit, 3_Lit}}));
+  EXPECT_FALSE(underTest->wantsExecution(era));
+  expectValidProof();
+}
+}
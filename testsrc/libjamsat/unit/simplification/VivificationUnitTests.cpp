@@ -0,0 +1,182 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/optimizers/Vivification.h>
+#include <libjamsat/solver/Assignment.h>
+#include <libjamsat/solver/Statistics.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationVivification : public OptimizerTestFixture {
+protected:
+  static void setLBD(SharedOptimizerState& state, CNFClause const& clause, Clause::lbd_type lbd)
+  {
+    state.getClauseDB().getClauses([&clause, lbd](std::vector<Clause*> const& clauses) {
+      for (Clause* dbClause : clauses) {
+        if (std::is_permutation(dbClause->begin(), dbClause->end(), clause.begin(), clause.end())) {
+          dbClause->setLBD(lbd);
+        }
+      }
+    });
+  }
+};
+
+TEST_F(UnitSimplificationVivification, removesLiteralsFalsifiedByPropagation)
+{
+  m_problem.addClause({1_Lit, ~2_Lit});
+  m_problem.addClause({1_Lit, 2_Lit, 3_Lit});
+
+  auto underTest = createVivifier();
+  StatisticsEra era;
+  EXPECT_FALSE(underTest->wantsExecution(era));
+  era.m_conflictCount = VivificationOptions{}.conflictsBetweenRounds;
+  ASSERT_TRUE(underTest->wantsExecution(era));
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{3}), era);
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  std::vector<CNFClause> const expected{{1_Lit, ~2_Lit}, {1_Lit, 3_Lit}};
+  EXPECT_EQ(getClauses(result, false), expected);
+  EXPECT_EQ(result.getStats().amntLitsRemoved, 1ULL);
+  expectValidProof();
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+
+TEST_F(UnitSimplificationVivification, shortensClausesAtConflicts)
+{
+  m_problem.addClause({1_Lit, 5_Lit});
+  m_problem.addClause({2_Lit, ~5_Lit});
+  m_problem.addClause({1_Lit, 2_Lit, 3_Lit, 4_Lit});
+
+  auto underTest = createVivifier();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{5}), StatisticsEra{});
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  std::vector<CNFClause> const expected{{1_Lit, 2_Lit}, {1_Lit, 5_Lit}, {2_Lit, ~5_Lit}};
+  EXPECT_EQ(getClauses(result, false), expected);
+  EXPECT_EQ(result.getStats().amntLitsRemoved, 2ULL);
+  expectValidProof();
+
+  // The shortened clause must be used for propagation:
+  Assignment& assignment = result.getAssignment();
+  assignment.undoAll();
+  EXPECT_EQ(assignment.append(~1_Lit), nullptr);
+  EXPECT_TRUE(isTrue(assignment.getAssignment(2_Lit)));
+}
+
+TEST_F(UnitSimplificationVivification, clausesShortenedToSingleLiteralsBecomeFacts)
+{
+  m_problem.addClause({1_Lit, 4_Lit});
+  m_problem.addClause({1_Lit, ~4_Lit});
+  m_problem.addClause({1_Lit, 2_Lit, 3_Lit});
+
+  auto underTest = createVivifier();
+  SharedOptimizerState result = underTest->optimize(createState(CNFVar{4}), StatisticsEra{});
+
+  EXPECT_FALSE(result.hasDetectedUnsat());
+  EXPECT_EQ(result.getFacts(), std::vector<CNFLit>{1_Lit});
+  EXPECT_EQ(result.getStats().amntFactsDerived, 1ULL);
+  EXPECT_EQ(result.getStats().amntClausesRemoved, 1ULL);
+  std::vector<CNFClause> const expected{{1_Lit, ~4_Lit}, {1_Lit, 4_Lit}};
+  EXPECT_EQ(getClauses(result, false), expected);
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationVivification, vivificationDoesNotAlterTargetPhases)
+{
+  m_problem.addClause({1_Lit, ~2_Lit});
+  m_problem.addClause({1_Lit, 2_Lit, 3_Lit});
+
+  SharedOptimizerState state = createState(CNFVar{3});
+  for (CNFVar var{0}; var <= CNFVar{3}; var = nextCNFVar(var)) {
+    state.getAssignment().setPhase(var, TBools::TRUE);
+  }
+  state.getAssignment().resetTargetPhases();
+
+  auto underTest = createVivifier();
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+  EXPECT_EQ(result.getStats().amntLitsRemoved, 1ULL);
+
+  Assignment resultAssignment = std::get<2>(result.release());
+  for (CNFVar var{0}; var <= CNFVar{3}; var = nextCNFVar(var)) {
+    EXPECT_EQ(resultAssignment.getTargetPhase(var), TBools::TRUE) << "at variable " << var;
+    EXPECT_EQ(resultAssignment.getPhase(var), TBools::TRUE) << "at variable " << var;
+  }
+}
+
+TEST_F(UnitSimplificationVivification, onlyLemmasWithinTier2LBDLimitAreVivified)
+{
+  m_problem.addClause({1_Lit, ~2_Lit});
+  m_lemmas.push_back({1_Lit, 2_Lit, 3_Lit});
+  m_lemmas.push_back({1_Lit, 2_Lit, 4_Lit});
+
+  VivificationOptions options;
+  options.tier2LBDLimit = 6;
+  auto underTest = createVivifier(options);
+  SharedOptimizerState state = createState(CNFVar{4});
+  setLBD(state, {1_Lit, 2_Lit, 3_Lit}, 7);
+  setLBD(state, {1_Lit, 2_Lit, 4_Lit}, 3);
+  SharedOptimizerState result = underTest->optimize(std::move(state), StatisticsEra{});
+
+  std::vector<CNFClause> const expected{{1_Lit, 2_Lit, 3_Lit}, {1_Lit, 4_Lit}};
+  EXPECT_EQ(getClauses(result, true), expected);
+  expectValidProof();
+}
+
+TEST_F(UnitSimplificationVivification, resumesPreemptedRound)
+{
+  m_problem.addClause({1_Lit, ~2_Lit});
+  m_problem.addClause({1_Lit, 2_Lit, 3_Lit});
+
+  auto underTest = createVivifier();
+  StatisticsEra era;
+  era.m_conflictCount = VivificationOptions{}.conflictsBetweenRounds;
+  SharedOptimizerState state = createState(CNFVar{3});
+  state.setTickBudget(1);
+  SharedOptimizerState intermediate = underTest->optimize(std::move(state), era);
+  std::vector<CNFClause> const original{{1_Lit, ~2_Lit}, {1_Lit, 2_Lit, 3_Lit}};
+  EXPECT_EQ(getClauses(intermediate, false), original);
+  EXPECT_TRUE(underTest->wantsExecution(era));
+
+  intermediate.setTickBudget(std::numeric_limits<uint64_t>::max());
+  SharedOptimizerState result = underTest->optimize(std::move(intermediate), era);
+  std::vector<CNFClause> const expected{{1_Lit, ~2_Lit}, {1_Lit, 3_Lit}};
+  EXPECT_EQ(getClauses(result, false), expected);
+  EXPECT_FALSE(underTest->wantsExecution(era));
+}
+}
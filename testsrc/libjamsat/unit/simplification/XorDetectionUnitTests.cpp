@@ -0,0 +1,121 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+#include <libjamsat/simplification/XorDetection.h>
+#include <libjamsat/solver/Assignment.h>
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+namespace jamsat {
+
+class UnitSimplificationXorDetection : public OptimizerTestFixture {
+protected:
+  /** Adds the clauses encoding the given XOR constraint to m_problem */
+  void addXorClauses(std::vector<CNFVar> const& variables, bool parity)
+  {
+    for (uint32_t pattern = 0; pattern < (1U << variables.size()); ++pattern) {
+      CNFClause clause;
+      bool excludedParity = false;
+      for (std::size_t i = 0; i < variables.size(); ++i) {
+        bool const negative = (pattern & (1U << i)) != 0;
+        excludedParity ^= negative;
+        clause.push_back(CNFLit{variables[i], negative ? CNFSign::NEGATIVE : CNFSign::POSITIVE});
+      }
+      if (excludedParity != parity) {
+        m_problem.addClause(clause);
+      }
+    }
+  }
+
+  static auto sorted(std::vector<CNFVar> variables) -> std::vector<CNFVar>
+  {
+    std::sort(variables.begin(), variables.end());
+    return variables;
+  }
+};
+
+TEST_F(UnitSimplificationXorDetection, detectsTwoInputXorGate)
+{
+  // 3 <-> (1 xor 2):
+  m_problem.addClause({~1_Lit, ~2_Lit, ~3_Lit});
+  m_problem.addClause({1_Lit, 2_Lit, ~3_Lit});
+  m_problem.addClause({1_Lit, ~2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 2_Lit, 3_Lit});
+  m_problem.addClause({1_Lit, 4_Lit, 5_Lit});
+  SharedOptimizerState state = createState(CNFVar{5});
+
+  std::vector<XorConstraint> result = detectXorConstraints(state);
+  ASSERT_EQ(result.size(), 1ULL);
+  EXPECT_EQ(sorted(result[0].variables), (std::vector<CNFVar>{CNFVar{1}, CNFVar{2}, CNFVar{3}}));
+  EXPECT_FALSE(result[0].parity);
+}
+
+TEST_F(UnitSimplificationXorDetection, detectsXorConstraintsOfBothParities)
+{
+  addXorClauses({CNFVar{1}, CNFVar{2}, CNFVar{3}, CNFVar{4}}, true);
+  addXorClauses({CNFVar{4}, CNFVar{5}, CNFVar{6}}, false);
+  SharedOptimizerState state = createState(CNFVar{6});
+
+  std::vector<XorConstraint> result = detectXorConstraints(state);
+  std::sort(result.begin(), result.end(), [](XorConstraint const& lhs, XorConstraint const& rhs) {
+    return lhs.variables.size() > rhs.variables.size();
+  });
+  ASSERT_EQ(result.size(), 2ULL);
+  EXPECT_EQ(sorted(result[0].variables),
+            (std::vector<CNFVar>{CNFVar{1}, CNFVar{2}, CNFVar{3}, CNFVar{4}}));
+  EXPECT_TRUE(result[0].parity);
+  EXPECT_EQ(sorted(result[1].variables), (std::vector<CNFVar>{CNFVar{4}, CNFVar{5}, CNFVar{6}}));
+  EXPECT_FALSE(result[1].parity);
+}
+
+TEST_F(UnitSimplificationXorDetection, doesNotDetectIncompleteXorConstraints)
+{
+  m_problem.addClause({1_Lit, 2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, ~2_Lit, 3_Lit});
+  m_problem.addClause({~1_Lit, 2_Lit, ~3_Lit});
+  SharedOptimizerState state = createState(CNFVar{3});
+
+  EXPECT_TRUE(detectXorConstraints(state).empty());
+}
+
+TEST_F(UnitSimplificationXorDetection, doesNotDetectConstraintsExceedingSizeLimit)
+{
+  addXorClauses({CNFVar{1}, CNFVar{2}, CNFVar{3}, CNFVar{4}}, false);
+  SharedOptimizerState state = createState(CNFVar{4});
+
+  XorDetectionOptions options;
+  options.maxSize = 3;
+  EXPECT_TRUE(detectXorConstraints(state, options).empty());
+}
+}
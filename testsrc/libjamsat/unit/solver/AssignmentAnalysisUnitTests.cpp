@@ -53,6 +53,20 @@ TEST(UnitSolver, AssignmentAnalysisProducesUnitaryResultForReasonlessConflict)
   EXPECT_EQ(result, std::vector<CNFLit>{lit});
 }
 
+TEST(UnitSolver, AssignmentAnalysisIncludesComplementOfQueryAssignedWithoutReasonAboveLevel0)
+{
+  TestAssignmentProvider decisionLevelProvider;
+  TestReasonProvider<TrivialClause> reasonProvider;
+  StampMap<int, CNFVar::Index> tempStamps{CNFVar{1024}.getRawValue()};
+  CNFLit lit{CNFVar{3}, CNFSign::POSITIVE};
+  decisionLevelProvider.setCurrentDecisionLevel(2);
+  decisionLevelProvider.append(~lit);
+  decisionLevelProvider.setAssignmentDecisionLevel(lit.getVariable(), 2);
+
+  auto result = analyzeAssignment(reasonProvider, decisionLevelProvider, tempStamps, lit);
+  EXPECT_EQ(result, (std::vector<CNFLit>{lit, ~lit}));
+}
+
 TEST(UnitSolver, AssignmentAnalysisProducesFailingAssumptionsForReasonfulConflict)
 {
   TestAssignmentProvider decisionLevelProvider;
@@ -96,4 +110,49 @@ TEST(UnitSolver, AssignmentAnalysisProducesFailingAssumptionsForReasonfulConflic
       << "Expected a permutation of " << toString(expected.begin(), expected.end()) << " but got "
       << toString(result.begin(), result.end());
 }
+
+TEST(UnitSolver, AssignmentAnalysisCollectsReasonlessLiteralsOnAllLevelsAboveZero)
+{
+  TestAssignmentProvider decisionLevelProvider;
+  TestReasonProvider<TrivialClause> reasonProvider;
+  StampMap<int, CNFVar::Index> tempStamps{CNFVar{1024}.getRawValue()};
+
+  CNFLit fact{CNFVar{1}, CNFSign::POSITIVE}, assumption1{CNFVar{2}, CNFSign::NEGATIVE},
+      assumption2{CNFVar{3}, CNFSign::POSITIVE}, unrelated{CNFVar{4}, CNFSign::POSITIVE},
+      implied{CNFVar{5}, CNFSign::NEGATIVE}, assumption3{CNFVar{6}, CNFSign::POSITIVE},
+      query{CNFVar{7}, CNFSign::NEGATIVE};
+
+  decisionLevelProvider.setCurrentDecisionLevel(0);
+  decisionLevelProvider.append(fact);
+  decisionLevelProvider.setCurrentDecisionLevel(1);
+  decisionLevelProvider.append(assumption1);
+  decisionLevelProvider.setCurrentDecisionLevel(2);
+  decisionLevelProvider.append(assumption2);
+  decisionLevelProvider.append(implied);
+  decisionLevelProvider.setCurrentDecisionLevel(3);
+  decisionLevelProvider.append(unrelated);
+  decisionLevelProvider.setCurrentDecisionLevel(4);
+  decisionLevelProvider.append(assumption3);
+  decisionLevelProvider.append(query);
+
+  decisionLevelProvider.setAssignmentDecisionLevel(fact.getVariable(), 0);
+  decisionLevelProvider.setAssignmentDecisionLevel(assumption1.getVariable(), 1);
+  decisionLevelProvider.setAssignmentDecisionLevel(assumption2.getVariable(), 2);
+  decisionLevelProvider.setAssignmentDecisionLevel(implied.getVariable(), 2);
+  decisionLevelProvider.setAssignmentDecisionLevel(unrelated.getVariable(), 3);
+  decisionLevelProvider.setAssignmentDecisionLevel(assumption3.getVariable(), 4);
+  decisionLevelProvider.setAssignmentDecisionLevel(query.getVariable(), 4);
+
+  TrivialClause reasonForImplied{~assumption1, ~assumption2, implied};
+  TrivialClause reasonForQuery{~fact, ~implied, ~assumption3, query};
+  reasonProvider.set_reason(implied.getVariable(), reasonForImplied);
+  reasonProvider.set_reason(query.getVariable(), reasonForQuery);
+
+  std::vector<CNFLit> expected{query, assumption1, assumption2, assumption3};
+  auto result = analyzeAssignment(reasonProvider, decisionLevelProvider, tempStamps, query);
+  ASSERT_EQ(result.size(), expected.size());
+  EXPECT_TRUE(std::is_permutation(expected.begin(), expected.end(), result.begin()))
+      << "Expected a permutation of " << toString(expected.begin(), expected.end()) << " but got "
+      << toString(result.begin(), result.end());
+}
 }
@@ -253,6 +253,137 @@ TEST(UnitSolver, variablePhaseIsSavedInAssignment)
   EXPECT_EQ(under_test.getPhase(CNFVar{10}), TBools::TRUE);
 }
 
+TEST(UnitSolver, variablePhaseCanBeSetExplicitly)
+{
+  Assignment under_test{CNFVar{10}};
+  under_test.setPhase(CNFVar{3}, TBools::TRUE);
+  EXPECT_EQ(under_test.getPhase(CNFVar{3}), TBools::TRUE);
+  under_test.setPhase(CNFVar{3}, TBools::FALSE);
+  EXPECT_EQ(under_test.getPhase(CNFVar{3}), TBools::FALSE);
+}
+
+TEST(UnitSolver, targetAndBestPhasesAreSavedFromConflictFreeTrailOnBacktrack)
+{
+  Assignment under_test{CNFVar{10}};
+  under_test.newLevel();
+  under_test.append(1_Lit);
+  under_test.append(~2_Lit);
+  under_test.newLevel();
+  under_test.append(3_Lit);
+
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{1}), TBools::FALSE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{3}), TBools::FALSE);
+
+  under_test.undoToLevel(0);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{1}), TBools::TRUE);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{2}), TBools::FALSE);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{3}), TBools::TRUE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{1}), TBools::TRUE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{3}), TBools::TRUE);
+}
+
+TEST(UnitSolver, targetAndBestPhasesAreSavedFromTrailPrefixReplacedAfterSaving)
+{
+  Assignment under_test{CNFVar{10}};
+  under_test.newLevel();
+  under_test.append(1_Lit);
+  under_test.newLevel();
+  under_test.append(2_Lit);
+  under_test.undoToLevel(1);
+
+  // Extending the saved prefix beginning with 1:
+  under_test.newLevel();
+  under_test.append(~3_Lit);
+  under_test.newLevel();
+  under_test.append(4_Lit);
+  under_test.undoToLevel(0);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{1}), TBools::TRUE);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{2}), TBools::TRUE);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{3}), TBools::FALSE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{4}), TBools::TRUE);
+
+  // Replacing the saved prefix:
+  under_test.newLevel();
+  under_test.append(~1_Lit);
+  under_test.append(~2_Lit);
+  under_test.append(3_Lit);
+  under_test.append(~4_Lit);
+  under_test.undoToLevel(0);
+  for (CNFVar var : {CNFVar{1}, CNFVar{2}, CNFVar{4}}) {
+    EXPECT_EQ(under_test.getTargetPhase(var), TBools::FALSE) << "at variable " << var;
+    EXPECT_EQ(under_test.getBestPhase(var), TBools::FALSE) << "at variable " << var;
+  }
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{3}), TBools::TRUE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{3}), TBools::TRUE);
+}
+
+TEST(UnitSolver, targetPhasesAreNotOverwrittenBySmallerConflictFreeTrail)
+{
+  Assignment under_test{CNFVar{10}};
+  under_test.newLevel();
+  under_test.append(1_Lit);
+  under_test.append(2_Lit);
+  under_test.undoToLevel(0);
+
+  under_test.newLevel();
+  under_test.append(~1_Lit);
+  under_test.undoToLevel(0);
+
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{1}), TBools::TRUE);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{2}), TBools::TRUE);
+  EXPECT_EQ(under_test.getPhase(CNFVar{1}), TBools::FALSE);
+}
+
+TEST(UnitSolver, resettingTargetPhasesCopiesPhasesAndKeepsBestPhases)
+{
+  Assignment under_test{CNFVar{10}};
+  under_test.newLevel();
+  under_test.append(1_Lit);
+  under_test.append(2_Lit);
+  under_test.undoToLevel(0);
+
+  under_test.setPhase(CNFVar{1}, TBools::FALSE);
+  under_test.resetTargetPhases();
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{1}), TBools::FALSE);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{2}), TBools::TRUE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{1}), TBools::TRUE);
+
+  // After resetting, smaller conflict-free trails are saved again:
+  under_test.newLevel();
+  under_test.append(~2_Lit);
+  under_test.undoToLevel(0);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{2}), TBools::FALSE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{2}), TBools::TRUE);
+
+  under_test.resetBestPhases();
+  under_test.newLevel();
+  under_test.append(~2_Lit);
+  under_test.undoToLevel(0);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{2}), TBools::FALSE);
+}
+
+TEST(UnitSolver, targetAndBestPhasesAreNotSavedWhileTrackingIsDisabled)
+{
+  Assignment under_test{CNFVar{10}};
+  under_test.setTargetAndBestPhaseTracking(false);
+  under_test.newLevel();
+  under_test.append(1_Lit);
+  under_test.append(2_Lit);
+  under_test.undoToLevel(0);
+
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{1}), TBools::FALSE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{2}), TBools::FALSE);
+  EXPECT_EQ(under_test.getPhase(CNFVar{1}), TBools::TRUE);
+
+  under_test.setTargetAndBestPhaseTracking(true);
+  under_test.newLevel();
+  under_test.append(2_Lit);
+  under_test.undoToLevel(0);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{1}), TBools::FALSE);
+  EXPECT_EQ(under_test.getTargetPhase(CNFVar{2}), TBools::TRUE);
+  EXPECT_EQ(under_test.getBestPhase(CNFVar{2}), TBools::TRUE);
+}
+
 TEST(UnitSolver, sizeOneAssignmentWithoutAssignmentHasNoCompleteAssignment)
 {
   Assignment under_test{CNFVar{0}};
@@ -494,6 +625,30 @@ TEST(UnitSolver, registerClauseWithAssignedLiteralsCausesPropagation)
   EXPECT_EQ(under_test.getAssignment(lit3), TBools::FALSE);
 }
 
+TEST(UnitSolver, appendImpliedAssignsFirstLiteralWithoutRegisteringReason)
+{
+  CNFLit lit1{CNFVar{1}, CNFSign::POSITIVE};
+  CNFLit lit2{CNFVar{2}, CNFSign::NEGATIVE};
+  CNFLit lit3{CNFVar{3}, CNFSign::POSITIVE};
+  auto reason = createClause({lit1, lit2});
+  auto forcedClause = createClause({~lit1, lit3});
+
+  CNFVar max_var{4};
+  Assignment under_test{max_var};
+  under_test.registerClause(*forcedClause);
+  under_test.newLevel();
+  under_test.append(~lit2);
+
+  EXPECT_EQ(under_test.appendImplied(*reason), nullptr);
+  EXPECT_EQ(under_test.getAssignment(lit1), TBools::TRUE);
+  EXPECT_EQ(under_test.getReason(lit1.getVariable()), reason.get());
+  EXPECT_EQ(under_test.getAssignment(lit3), TBools::TRUE);
+
+  under_test.undoToLevel(0);
+  under_test.append(~lit1);
+  EXPECT_EQ(under_test.getAssignment(lit2), TBools::INDETERMINATE);
+}
+
 TEST(UnitSolver, propagateUntilFixpointPropagatesTransitively)
 {
   CNFLit lit1{CNFVar{1}, CNFSign::POSITIVE};
@@ -52,6 +52,11 @@ public:
   }
 
   auto size() const noexcept -> std::size_t { return 2; }
+
+  enum class Flag { SCHEDULED_FOR_DELETION, REDUNDANT, USED_RECENTLY, USED_PREVIOUSLY };
+  auto getFlag(Flag) const noexcept -> bool { return false; }
+  void setFlag(Flag) noexcept {}
+  void clearFlag(Flag) noexcept {}
 };
 
 using TrivialClauseSeq = std::vector<TrivialClause*>;
@@ -133,7 +138,8 @@ namespace {
 void test_GlucoseClauseDBReductionPolicy_markedForDeletion(
     const std::vector<int>& LBDs,
     uint16_t knownGoods,
-    const std::vector<uint16_t>& expectedDeletedIndices)
+    const std::vector<uint16_t>& expectedDeletedIndices,
+    const std::vector<uint16_t>& recentlyUsedIndices = {})
 {
   std::vector<std::unique_ptr<Clause>> clauses;
   for (auto lbd : LBDs) {
@@ -141,6 +147,10 @@ void test_GlucoseClauseDBReductionPolicy_markedForDeletion(
     clauses.back()->setLBD(lbd);
   }
 
+  for (auto idx : recentlyUsedIndices) {
+    clauses[idx]->setFlag(Clause::Flag::USED_RECENTLY);
+  }
+
   std::vector<Clause*> learntClauses;
   for (auto& clause : clauses) {
     learntClauses.push_back(clause.get());
@@ -160,6 +170,12 @@ void test_GlucoseClauseDBReductionPolicy_markedForDeletion(
   ASSERT_TRUE(std::distance(toDeleteBegin, learntClauses.end()) ==
               static_cast<int>(expectedDeletedIndices.size()))
       << "More clauses marked for deletion than expected";
+
+  if (!expectedDeletedIndices.empty()) {
+    for (auto& clause : clauses) {
+      EXPECT_FALSE(clause->getFlag(Clause::Flag::USED_RECENTLY));
+    }
+  }
 }
 }
 
@@ -177,4 +193,174 @@ TEST(UnitSolver, GlucoseClauseDBReductionPolicy_noClausesMarkedForDeletionWhenLB
 {
   test_GlucoseClauseDBReductionPolicy_markedForDeletion({2, 2, 3, 6}, 0, {});
 }
+
+TEST(UnitSolver, GlucoseClauseDBReductionPolicy_recentlyUsedClausesAreNotMarkedForDeletion)
+{
+  test_GlucoseClauseDBReductionPolicy_markedForDeletion({6, 2, 4, 3, 5, 7}, 0, {0, 5}, {4});
+}
+
+TEST(UnitSolver, GlucoseClauseDBReductionPolicy_usedFlagsAreClearedWhenAllClausesAreSpared)
+{
+  std::vector<std::unique_ptr<Clause>> clauses;
+  std::vector<Clause*> learntClauses;
+  for (int lbd : {6, 2, 4, 3}) {
+    clauses.push_back(createHeapClause(3));
+    clauses.back()->setLBD(lbd);
+    learntClauses.push_back(clauses.back().get());
+  }
+  clauses[0]->setFlag(Clause::Flag::USED_RECENTLY);
+  clauses[2]->setFlag(Clause::Flag::USED_RECENTLY);
+
+  GlucoseClauseDBReductionPolicy<Clause, std::vector<Clause*>, int> underTest{10, learntClauses};
+  ASSERT_TRUE(underTest.shouldReduceDB());
+  auto toDeleteBegin = underTest.getClausesMarkedForDeletion(0);
+  EXPECT_EQ(toDeleteBegin, learntClauses.end());
+
+  // The spared clauses are not spared again unless they are used in the meantime:
+  for (auto& clause : clauses) {
+    EXPECT_FALSE(clause->getFlag(Clause::Flag::USED_RECENTLY));
+  }
+}
+
+TEST(UnitSolver, TieredClauseDBReductionPolicy_forbidsReductionWhenNoClauseHasBeenLearned)
+{
+  TrivialClauseSeq emptyClauseList;
+  TieredClauseDBReductionPolicy<TrivialClause, TrivialClauseSeq, int> underTest{10,
+                                                                                emptyClauseList};
+  EXPECT_FALSE(underTest.shouldReduceDB());
+}
+
+TEST(UnitSolver, TieredClauseDBReductionPolicy_reductionIntervalsAreIncreased)
+{
+  TrivialClause l1;
+  TrivialClauseSeq learntClauses{&l1};
+  TieredClauseDBReductionPolicy<TrivialClause, TrivialClauseSeq, int> underTest{5, learntClauses};
+
+  ASSERT_TRUE(underTest.shouldReduceDB());
+  underTest.getClausesMarkedForDeletion();
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_FALSE(underTest.shouldReduceDB());
+    underTest.registerConflict();
+  }
+
+  ASSERT_TRUE(underTest.shouldReduceDB());
+  underTest.getClausesMarkedForDeletion();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_FALSE(underTest.shouldReduceDB());
+    underTest.registerConflict();
+  }
+
+  ASSERT_TRUE(underTest.shouldReduceDB());
+}
+
+namespace {
+class TieredClauseDBReductionPolicyFixture : public ::testing::Test {
+protected:
+  using PolicyT = TieredClauseDBReductionPolicy<Clause, std::vector<Clause*>, int>;
+
+  void createClauses(std::vector<int> const& LBDs)
+  {
+    for (auto lbd : LBDs) {
+      m_clauses.push_back(createHeapClause(3));
+      m_clauses.back()->setLBD(lbd);
+      m_learntClauses.push_back(m_clauses.back().get());
+    }
+  }
+
+  void markUsed(std::vector<std::size_t> const& indices)
+  {
+    for (auto idx : indices) {
+      m_clauses[idx]->setFlag(Clause::Flag::USED_RECENTLY);
+    }
+  }
+
+  auto reduce(PolicyT& policy) -> std::vector<std::size_t>
+  {
+    auto toDeleteBegin = policy.getClausesMarkedForDeletion();
+    std::vector<std::size_t> result;
+    for (auto it = toDeleteBegin; it != m_learntClauses.end(); ++it) {
+      for (std::size_t idx = 0; idx < m_clauses.size(); ++idx) {
+        if (m_clauses[idx].get() == *it) {
+          result.push_back(idx);
+        }
+      }
+    }
+    m_learntClauses.erase(toDeleteBegin, m_learntClauses.end());
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  void reachNextReduction(PolicyT& policy)
+  {
+    while (!policy.shouldReduceDB()) {
+      policy.registerConflict();
+    }
+  }
+
+  std::vector<std::unique_ptr<Clause>> m_clauses;
+  std::vector<Clause*> m_learntClauses;
+};
+}
+
+TEST_F(TieredClauseDBReductionPolicyFixture, worstHalfOfUnusedLocalClausesIsDeleted)
+{
+  createClauses({10, 7, 12, 8, 9, 11});
+  PolicyT underTest{10, m_learntClauses};
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{0, 2, 5}));
+}
+
+TEST_F(TieredClauseDBReductionPolicyFixture, coreClausesAreNeverDeleted)
+{
+  createClauses({2, 1, 2, 2, 9, 11});
+  PolicyT underTest{10, m_learntClauses};
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{5}));
+
+  reachNextReduction(underTest);
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{}));
+  EXPECT_EQ(m_learntClauses.size(), 5ULL);
+}
+
+TEST_F(TieredClauseDBReductionPolicyFixture, recentlyUsedLocalClausesAreKeptForOneInterval)
+{
+  createClauses({15, 14});
+  markUsed({0});
+  PolicyT underTest{10, m_learntClauses};
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{}));
+
+  reachNextReduction(underTest);
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{0}));
+}
+
+TEST_F(TieredClauseDBReductionPolicyFixture, recentlyUsedTier2ClausesAreKeptForTwoIntervals)
+{
+  createClauses({5, 4});
+  markUsed({0});
+  PolicyT underTest{10, m_learntClauses};
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{}));
+
+  reachNextReduction(underTest);
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{}));
+
+  reachNextReduction(underTest);
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{0}));
+}
+
+TEST_F(TieredClauseDBReductionPolicyFixture, clausesArePromotedWhenLBDImproves)
+{
+  createClauses({10, 9, 12, 8});
+  PolicyT underTest{10, m_learntClauses};
+  m_clauses[2]->setLBD(2);
+  EXPECT_EQ(reduce(underTest), (std::vector<std::size_t>{0}));
+}
+
+TEST_F(TieredClauseDBReductionPolicyFixture, tierSizesAreDetermined)
+{
+  createClauses({1, 2, 3, 6, 7, 12, 20});
+  PolicyT underTest{10, m_learntClauses};
+  reduce(underTest);
+  auto const& sizes = underTest.getTierSizes();
+  EXPECT_EQ(sizes.core, 2ULL);
+  EXPECT_EQ(sizes.tier2, 2ULL);
+  EXPECT_EQ(sizes.local, 3ULL);
+}
 }
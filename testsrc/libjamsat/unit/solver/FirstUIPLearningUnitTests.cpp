@@ -70,6 +70,23 @@ bool equalLits(const std::vector<CNFLit>& lhs, const std::vector<CNFLit>& rhs)
 
   return lhsLits == rhsLits;
 }
+
+class CollectingObserver {
+public:
+  CollectingObserver(std::vector<CNFVar>& seenVars, std::vector<TrivialClause const*>& seenClauses)
+    : m_seenVars(seenVars)
+    , m_seenClauses(seenClauses)
+  {
+  }
+
+  void onSeenVariable(CNFVar var) { m_seenVars.push_back(var); }
+
+  void onSeenClause(TrivialClause const& clause) { m_seenClauses.push_back(&clause); }
+
+private:
+  std::vector<CNFVar>& m_seenVars;
+  std::vector<TrivialClause const*>& m_seenClauses;
+};
 }
 
 // TODO: cover the following scenarios:
@@ -128,7 +145,8 @@ TEST(UnitSolver, firstUIPIsFoundWhenConflictingClauseHas2LitsOnCurLevel)
   underTest.test_assertClassInvariantsSatisfied();
 }
 
-TEST(UnitSolver, firstUIPLearningCallsSeenVariableCallback)
+
+TEST(UnitSolver, firstUIPLearningNotifiesObserverOfSeenVariablesAndClauses)
 {
   TestAssignmentProvider assignments;
   DummyReasonProvider reasons;
@@ -154,13 +172,16 @@ TEST(UnitSolver, firstUIPLearningCallsSeenVariableCallback)
   assignments.setCurrentDecisionLevel(4);
 
   CNFVar maxVar{9};
-  FirstUIPLearning<TestAssignmentProvider, DummyReasonProvider> underTest(
-      maxVar, assignments, reasons);
   std::vector<CNFVar> seenVars;
-  underTest.setOnSeenVariableCallback([&seenVars](CNFVar seenVar) { seenVars.push_back(seenVar); });
+  std::vector<TrivialClause const*> seenClauses;
+  FirstUIPLearning<TestAssignmentProvider, DummyReasonProvider, CollectingObserver> underTest(
+      maxVar, assignments, reasons, CollectingObserver{seenVars, seenClauses});
   std::vector<CNFLit> result;
   underTest.computeConflictClause(conflictingClause, result);
 
+  EXPECT_EQ(seenClauses,
+            (std::vector<TrivialClause const*>{&conflictingClause, &dummyReasonClause}));
+
   EXPECT_EQ(seenVars.size(), 5ull);
   EXPECT_NE(std::find(seenVars.begin(), seenVars.end(), CNFVar{1}), seenVars.end());
   EXPECT_NE(std::find(seenVars.begin(), seenVars.end(), CNFVar{3}), seenVars.end());
@@ -220,6 +241,69 @@ TEST(UnitSolver, firstUIPIsFoundWhenAssertingLiteralHasBeenPropagated)
   underTest.test_assertClassInvariantsSatisfied();
 }
 
+TEST(UnitSolver, firstUIPLearningUpdatesLBDsAndFlagsOfUsedClauses)
+{
+  CNFLit decisionLit{CNFVar{0}, CNFSign::POSITIVE};
+  CNFLit assertingLit{CNFVar{1}, CNFSign::NEGATIVE};
+  CNFLit prop1{CNFVar{2}, CNFSign::NEGATIVE};
+  CNFLit prop2{CNFVar{3}, CNFSign::NEGATIVE};
+
+  std::vector<CNFLit> filler = createLiterals(4, 7);
+
+  TrivialClause clause1{~decisionLit, assertingLit, ~filler[0]};
+  TrivialClause clause2{~filler[1], ~assertingLit, prop1};
+  TrivialClause clause3{~filler[2], ~filler[3], ~assertingLit, prop2};
+  TrivialClause conflictingClause{~prop1, ~prop2};
+
+  clause1.setLBD(6);
+  clause2.setLBD(1);
+  clause3.setLBD(5);
+  conflictingClause.setLBD(4);
+
+  TestAssignmentProvider assignments;
+  DummyReasonProvider reasons;
+
+  for (auto lit : filler) {
+    assignments.append(lit);
+    assignments.setAssignmentDecisionLevel(lit.getVariable(), 1);
+  }
+
+  assignments.append(decisionLit);
+  assignments.setAssignmentDecisionLevel(decisionLit.getVariable(), 2);
+  assignments.append(assertingLit);
+  assignments.setAssignmentDecisionLevel(assertingLit.getVariable(), 2);
+  reasons.set_reason(assertingLit.getVariable(), clause1);
+  assignments.append(prop1);
+  assignments.setAssignmentDecisionLevel(prop1.getVariable(), 2);
+  reasons.set_reason(prop1.getVariable(), clause2);
+  assignments.append(prop2);
+  assignments.setAssignmentDecisionLevel(prop2.getVariable(), 2);
+  reasons.set_reason(prop2.getVariable(), clause3);
+
+  assignments.setCurrentDecisionLevel(2);
+
+  CNFVar maxVar{7};
+  FirstUIPLearning<TestAssignmentProvider, DummyReasonProvider> underTest(
+      maxVar, assignments, reasons);
+  std::vector<CNFLit> result;
+  underTest.computeConflictClause(conflictingClause, result);
+
+  // clause1 is not used for resolution, since assertingLit is the UIP:
+  EXPECT_FALSE(clause1.getFlag(TrivialClause::Flag::USED_RECENTLY));
+  EXPECT_EQ(clause1.getLBD<int>(), 6);
+
+  EXPECT_TRUE(clause2.getFlag(TrivialClause::Flag::USED_RECENTLY));
+  EXPECT_EQ(clause2.getLBD<int>(), 1);
+
+  EXPECT_TRUE(clause3.getFlag(TrivialClause::Flag::USED_RECENTLY));
+  EXPECT_EQ(clause3.getLBD<int>(), 2);
+
+  EXPECT_TRUE(conflictingClause.getFlag(TrivialClause::Flag::USED_RECENTLY));
+  EXPECT_EQ(conflictingClause.getLBD<int>(), 1);
+
+  underTest.test_assertClassInvariantsSatisfied();
+}
+
 namespace {
 void test_firstUIPIsFoundWhenAllLiteralsAreOnSameLevel(bool simulateOOM)
 {
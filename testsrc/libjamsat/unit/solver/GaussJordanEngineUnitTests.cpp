@@ -0,0 +1,164 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <libjamsat/solver/GaussJordanEngine.h>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/solver/Assignment.h>
+
+#include <toolbox/testutils/ClauseUtils.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace jamsat {
+
+class UnitSolverGaussJordanEngine : public ::testing::Test {
+protected:
+  UnitSolverGaussJordanEngine() : m_assignment{CNFVar{10}}, m_underTest{CNFVar{10}} {}
+
+  auto propagate() -> Clause* { return m_underTest.propagate(m_assignment); }
+
+  static auto sorted(Clause const& clause) -> std::vector<CNFLit>
+  {
+    std::vector<CNFLit> result{clause.begin(), clause.end()};
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  Assignment m_assignment;
+  GaussJordanEngine m_underTest;
+};
+
+TEST_F(UnitSolverGaussJordanEngine, eliminationDerivesUnits)
+{
+  std::vector<CNFLit> units;
+  std::vector<XorConstraint> constraints{{{CNFVar{1}, CNFVar{2}}, true},
+                                         {{CNFVar{1}, CNFVar{2}, CNFVar{3}}, false}};
+  ASSERT_TRUE(m_underTest.setConstraints(constraints, units));
+  EXPECT_EQ(units, std::vector<CNFLit>{3_Lit});
+  EXPECT_EQ(m_underTest.getAmntRows(), 1ULL);
+}
+
+TEST_F(UnitSolverGaussJordanEngine, eliminationDetectsInconsistency)
+{
+  std::vector<CNFLit> units;
+  std::vector<XorConstraint> constraints{{{CNFVar{1}, CNFVar{2}, CNFVar{4}}, true},
+                                         {{CNFVar{2}, CNFVar{3}}, true},
+                                         {{CNFVar{1}, CNFVar{3}, CNFVar{4}}, true}};
+  EXPECT_FALSE(m_underTest.setConstraints(constraints, units));
+}
+
+TEST_F(UnitSolverGaussJordanEngine, propagationMaterializesReasons)
+{
+  std::vector<CNFLit> units;
+  std::vector<XorConstraint> constraints{{{CNFVar{1}, CNFVar{2}, CNFVar{3}}, true}};
+  ASSERT_TRUE(m_underTest.setConstraints(constraints, units));
+
+  m_assignment.newLevel();
+  ASSERT_EQ(m_assignment.append(~1_Lit), nullptr);
+  ASSERT_EQ(propagate(), nullptr);
+  EXPECT_FALSE(isDeterminate(m_assignment.getAssignment(CNFVar{3})));
+
+  m_assignment.newLevel();
+  ASSERT_EQ(m_assignment.append(2_Lit), nullptr);
+  ASSERT_EQ(propagate(), nullptr);
+  EXPECT_EQ(m_assignment.getAssignment(~3_Lit), TBools::TRUE);
+
+  Clause const* reason = m_assignment.getReason(CNFVar{3});
+  ASSERT_NE(reason, nullptr);
+  EXPECT_EQ((*reason)[0], ~3_Lit);
+  EXPECT_EQ(sorted(*reason), (std::vector<CNFLit>{1_Lit, ~2_Lit, ~3_Lit}));
+}
+
+TEST_F(UnitSolverGaussJordanEngine, fullyAssignedRowWithWrongParityIsConflicting)
+{
+  std::vector<CNFLit> units;
+  std::vector<XorConstraint> constraints{{{CNFVar{1}, CNFVar{2}, CNFVar{3}}, true}};
+  ASSERT_TRUE(m_underTest.setConstraints(constraints, units));
+
+  m_assignment.newLevel();
+  ASSERT_EQ(m_assignment.append(~1_Lit), nullptr);
+  ASSERT_EQ(m_assignment.append(~2_Lit), nullptr);
+  ASSERT_EQ(m_assignment.append(~3_Lit), nullptr);
+
+  Clause* conflict = propagate();
+  ASSERT_NE(conflict, nullptr);
+  EXPECT_EQ(sorted(*conflict), (std::vector<CNFLit>{1_Lit, 2_Lit, 3_Lit}));
+}
+
+TEST_F(UnitSolverGaussJordanEngine, propagationIsRepeatedAfterBacktracking)
+{
+  std::vector<CNFLit> units;
+  std::vector<XorConstraint> constraints{{{CNFVar{1}, CNFVar{2}, CNFVar{3}}, false}};
+  ASSERT_TRUE(m_underTest.setConstraints(constraints, units));
+
+  m_assignment.newLevel();
+  ASSERT_EQ(m_assignment.append(1_Lit), nullptr);
+  ASSERT_EQ(m_assignment.append(2_Lit), nullptr);
+  ASSERT_EQ(propagate(), nullptr);
+  EXPECT_EQ(m_assignment.getAssignment(~3_Lit), TBools::TRUE);
+
+  m_assignment.undoToLevel(0);
+  m_underTest.backtrack(m_assignment.getNumAssignments());
+
+  m_assignment.newLevel();
+  ASSERT_EQ(m_assignment.append(1_Lit), nullptr);
+  ASSERT_EQ(propagate(), nullptr);
+  m_assignment.newLevel();
+  ASSERT_EQ(m_assignment.append(~2_Lit), nullptr);
+  ASSERT_EQ(propagate(), nullptr);
+  EXPECT_EQ(m_assignment.getAssignment(3_Lit), TBools::TRUE);
+}
+
+TEST_F(UnitSolverGaussJordanEngine, reasonsDoNotParticipateInClausePropagation)
+{
+  std::vector<CNFLit> units;
+  std::vector<XorConstraint> constraints{{{CNFVar{1}, CNFVar{2}, CNFVar{3}}, true}};
+  ASSERT_TRUE(m_underTest.setConstraints(constraints, units));
+
+  for (int round = 0; round < 100; ++round) {
+    m_assignment.newLevel();
+    ASSERT_EQ(m_assignment.append(~1_Lit), nullptr);
+    ASSERT_EQ(m_assignment.append(2_Lit), nullptr);
+    ASSERT_EQ(propagate(), nullptr);
+    ASSERT_EQ(m_assignment.getAssignment(~3_Lit), TBools::TRUE);
+
+    m_assignment.undoToLevel(0);
+    m_underTest.backtrack(m_assignment.getNumAssignments());
+  }
+
+  // If the reason (1 ~2 ~3) had been added to the clauses of the assignment,
+  // 1 would be forced here:
+  m_assignment.newLevel();
+  ASSERT_EQ(m_assignment.append(2_Lit), nullptr);
+  ASSERT_EQ(m_assignment.append(3_Lit), nullptr);
+  EXPECT_EQ(m_assignment.getAssignment(CNFVar{1}), TBools::INDETERMINATE);
+}
+}
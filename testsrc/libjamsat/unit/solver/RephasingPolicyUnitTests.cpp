@@ -0,0 +1,78 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <libjamsat/solver/RephasingPolicy.h>
+
+namespace jamsat {
+TEST(UnitSolver, RephasingPolicy_noRephasingBeforeFirstInterval)
+{
+  RephasingPolicy underTest{RephasingPolicy::Options{10}};
+  for (int i = 0; i < 9; ++i) {
+    underTest.registerConflict();
+    EXPECT_FALSE(underTest.shouldRephase());
+  }
+  underTest.registerConflict();
+  EXPECT_TRUE(underTest.shouldRephase());
+}
+
+TEST(UnitSolver, RephasingPolicy_rephasingIntervalsGrowArithmetically)
+{
+  RephasingPolicy underTest{RephasingPolicy::Options{10}};
+  for (int i = 0; i < 10; ++i) {
+    underTest.registerConflict();
+  }
+  ASSERT_TRUE(underTest.shouldRephase());
+  underTest.registerRephase();
+
+  for (int i = 0; i < 19; ++i) {
+    underTest.registerConflict();
+    EXPECT_FALSE(underTest.shouldRephase());
+  }
+  underTest.registerConflict();
+  EXPECT_TRUE(underTest.shouldRephase());
+}
+
+TEST(UnitSolver, RephasingPolicy_phasesAreCycled)
+{
+  using Phases = RephasingPolicy::Phases;
+  RephasingPolicy underTest{RephasingPolicy::Options{10}};
+  std::vector<Phases> const expected = {Phases::ORIGINAL,
+                                        Phases::BEST,
+                                        Phases::INVERTED,
+                                        Phases::BEST,
+                                        Phases::RANDOM,
+                                        Phases::BEST,
+                                        Phases::ORIGINAL};
+  for (Phases phases : expected) {
+    EXPECT_EQ(underTest.getNextPhases(), phases);
+    underTest.registerRephase();
+  }
+}
+}
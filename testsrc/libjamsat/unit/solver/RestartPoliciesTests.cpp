@@ -127,50 +127,201 @@ TEST(UnitSolver, LubyRestartPolicy_scaleFactorScalesSequence)
 TEST(UnitSolver, GlucoseRestartPolicy_noRestartWhenTooFewConflicts)
 {
   GlucoseRestartPolicy::Options options;
-  options.movingAverageWindowSize = 10ull;
+  options.minConflictsBetweenRestarts = 10ull;
+  options.K = 10.0;
   GlucoseRestartPolicy underTest{options};
 
   EXPECT_FALSE(underTest.shouldRestart());
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
   EXPECT_FALSE(underTest.shouldRestart());
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20, 100});
   EXPECT_FALSE(underTest.shouldRestart());
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30, 100});
   EXPECT_FALSE(underTest.shouldRestart());
 }
 
 TEST(UnitSolver, GlucoseRestartPolicy_noRestartWhenTooFewConflictsSinceLastRestart)
 {
   GlucoseRestartPolicy::Options options;
-  options.movingAverageWindowSize = 3ull;
-  options.K = 10.0f;
+  options.minConflictsBetweenRestarts = 3ull;
+  options.K = 10.0;
   GlucoseRestartPolicy underTest{options};
 
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10});
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20});
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30, 100});
   EXPECT_TRUE(underTest.shouldRestart());
   underTest.registerRestart();
   EXPECT_FALSE(underTest.shouldRestart());
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20, 100});
   EXPECT_FALSE(underTest.shouldRestart());
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30, 100});
   EXPECT_FALSE(underTest.shouldRestart());
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30, 100});
+  EXPECT_TRUE(underTest.shouldRestart());
 }
 
 TEST(UnitSolver, GlucoseRestartPolicy_restartWhenAverageLBDTooBad)
 {
   GlucoseRestartPolicy::Options options;
-  options.movingAverageWindowSize = 3ull;
-  options.K = 0.8f;
+  options.minConflictsBetweenRestarts = 3ull;
+  options.fastLBDSmoothingFactor = 0.5;
+  options.slowLBDSmoothingFactor = 0.01;
+  options.K = 0.8;
+  GlucoseRestartPolicy underTest{options};
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{2, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{2, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{2, 100});
+  EXPECT_FALSE(underTest.shouldRestart());
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{40, 100});
+  EXPECT_TRUE(underTest.shouldRestart());
+}
+
+TEST(UnitSolver, GlucoseRestartPolicy_restartIsBlockedWhenTrailIsLarge)
+{
+  GlucoseRestartPolicy::Options options;
+  options.minConflictsBetweenRestarts = 3ull;
+  options.K = 10.0;
+  options.R = 1.4;
+  options.blockingGraceTime = 0;
+  GlucoseRestartPolicy underTest{options};
+
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 130});
+  EXPECT_TRUE(underTest.shouldRestart());
+
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 1000});
+  EXPECT_FALSE(underTest.shouldRestart());
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  EXPECT_FALSE(underTest.shouldRestart());
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  EXPECT_TRUE(underTest.shouldRestart());
+}
+
+TEST(UnitSolver, GlucoseRestartPolicy_restartIsNotBlockedWithinGraceTime)
+{
+  GlucoseRestartPolicy::Options options;
+  options.minConflictsBetweenRestarts = 3ull;
+  options.K = 10.0;
+  options.blockingGraceTime = 5;
   GlucoseRestartPolicy underTest{options};
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{2});
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{2});
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{2});
+
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 100});
+  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{10, 1000});
+  EXPECT_TRUE(underTest.shouldRestart());
+}
+
+namespace {
+using SearchMode = ModeSwitchingRestartPolicy::Mode;
+
+auto createModeSwitchingOptions(uint64_t initialModeLength) -> ModeSwitchingRestartPolicy::Options
+{
+  ModeSwitchingRestartPolicy::Options options;
+  options.focusedModeOptions.minConflictsBetweenRestarts = 10000;
+  options.stableModeOptions = LubyRestartPolicy::Options{0, 20};
+  options.initialModeLength = initialModeLength;
+  options.modeLengthGrowthFactor = 2.0;
+  return options;
+}
+
+void registerConflicts(ModeSwitchingRestartPolicy& underTest, uint64_t amount)
+{
+  for (uint64_t i = 0; i < amount; ++i) {
+    underTest.registerConflict(ModeSwitchingRestartPolicy::RegisterConflictArgs{2, 100});
+  }
+}
+}
+
+TEST(UnitSolver, ModeSwitchingRestartPolicy_switchesToStableModeAfterModeLength)
+{
+  ModeSwitchingRestartPolicy underTest{createModeSwitchingOptions(10)};
+  EXPECT_EQ(underTest.getMode(), SearchMode::FOCUSED);
+
+  registerConflicts(underTest, 9);
+  EXPECT_FALSE(underTest.shouldRestart());
+  registerConflicts(underTest, 1);
+  EXPECT_TRUE(underTest.shouldRestart());
+  EXPECT_EQ(underTest.getMode(), SearchMode::FOCUSED);
+
+  underTest.registerRestart();
+  EXPECT_EQ(underTest.getMode(), SearchMode::STABLE);
+  EXPECT_FALSE(underTest.shouldRestart());
+}
+
+TEST(UnitSolver, ModeSwitchingRestartPolicy_modeLengthGrowsAfterStableMode)
+{
+  ModeSwitchingRestartPolicy underTest{createModeSwitchingOptions(10)};
+
+  registerConflicts(underTest, 10);
+  underTest.registerRestart();
+  registerConflicts(underTest, 10);
+  underTest.registerRestart();
+  EXPECT_EQ(underTest.getMode(), SearchMode::FOCUSED);
+
+  registerConflicts(underTest, 19);
   EXPECT_FALSE(underTest.shouldRestart());
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{20});
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{30});
-  underTest.registerConflict(GlucoseRestartPolicy::RegisterConflictArgs{40});
+  underTest.registerRestart();
+  EXPECT_EQ(underTest.getMode(), SearchMode::FOCUSED);
+
+  registerConflicts(underTest, 1);
   EXPECT_TRUE(underTest.shouldRestart());
+  underTest.registerRestart();
+  EXPECT_EQ(underTest.getMode(), SearchMode::STABLE);
+}
+
+TEST(UnitSolver, ModeSwitchingRestartPolicy_stableModeUsesLubyRestarts)
+{
+  auto options = createModeSwitchingOptions(10);
+  options.stableModeOptions = LubyRestartPolicy::Options{0, 1};
+  ModeSwitchingRestartPolicy underTest{options};
+
+  registerConflicts(underTest, 10);
+  underTest.registerRestart();
+  ASSERT_EQ(underTest.getMode(), SearchMode::STABLE);
+
+  // The second element of the Luby sequence is 1, scaled by 2:
+  registerConflicts(underTest, 1);
+  EXPECT_FALSE(underTest.shouldRestart());
+  registerConflicts(underTest, 1);
+  EXPECT_TRUE(underTest.shouldRestart());
+}
+
+TEST(UnitSolver, ModeSwitchingRestartPolicy_restartsWithinFirstStableModeByDefault)
+{
+  ModeSwitchingRestartPolicy::Options const options;
+  ModeSwitchingRestartPolicy underTest{options};
+
+  registerConflicts(underTest, options.initialModeLength);
+  ASSERT_TRUE(underTest.shouldRestart());
+  underTest.registerRestart();
+  ASSERT_EQ(underTest.getMode(), SearchMode::STABLE);
+
+  uint64_t conflicts = 0;
+  while (!underTest.shouldRestart()) {
+    registerConflicts(underTest, 1);
+    ++conflicts;
+  }
+  EXPECT_LT(conflicts, options.initialModeLength);
+
+  underTest.registerRestart();
+  EXPECT_EQ(underTest.getMode(), SearchMode::STABLE);
+}
+
+TEST(UnitSolver, ModeSwitchingRestartPolicy_remainsInFocusedModeWhenStableModeIsDisabled)
+{
+  auto options = createModeSwitchingOptions(10);
+  options.enableStableMode = false;
+  ModeSwitchingRestartPolicy underTest{options};
+
+  registerConflicts(underTest, 100);
+  EXPECT_FALSE(underTest.shouldRestart());
+  underTest.registerRestart();
+  EXPECT_EQ(underTest.getMode(), SearchMode::FOCUSED);
 }
 }
@@ -79,6 +79,25 @@ TEST(UnitSolver, StatisticsCountsAllItemsInAllEnabledMode)
   EXPECT_EQ(underTest.getCurrentEra().m_optimizationStats.amntFactsDerived, 20ULL);
 }
 
+TEST(UnitSolver, OptimizationStatsMergesPerOptimizerStatsByName)
+{
+  OptimizationStats lhs;
+  lhs.getOptimizerStats("A").amntRuns = 1;
+  lhs.getOptimizerStats("B").amntTicks = 10;
+
+  OptimizationStats rhs;
+  rhs.getOptimizerStats("B").amntTicks = 5;
+  rhs.getOptimizerStats("B").benefit = 3;
+  rhs.getOptimizerStats("C").amntPreemptions = 2;
+
+  lhs += rhs;
+  ASSERT_EQ(lhs.perOptimizer.size(), 3ULL);
+  EXPECT_EQ(lhs.getOptimizerStats("A").amntRuns, 1ULL);
+  EXPECT_EQ(lhs.getOptimizerStats("B").amntTicks, 15ULL);
+  EXPECT_EQ(lhs.getOptimizerStats("B").benefit, 3ULL);
+  EXPECT_EQ(lhs.getOptimizerStats("C").amntPreemptions, 2ULL);
+}
+
 namespace {
 template <typename StatisticsConfiguration>
 void test_expectStatsDisabled(bool conflictsDisabled,
@@ -253,4 +272,18 @@ TEST(UnitSolver, StatisticsPrintsCurrentEra)
   EXPECT_TRUE(static_cast<bool>(std::regex_search(result, std::regex{"#B: 1 "})));
   EXPECT_TRUE(static_cast<bool>(std::regex_search(result, std::regex{"#U: 0 "})));
 }
+
+TEST(UnitSolver, StatisticsKeepsLastLemmaTierSizes)
+{
+  Statistics<AllEnabledStatisticsConfig> underTest;
+  underTest.registerLemmaTierSizes(1, 2, 3);
+  underTest.registerLemmaTierSizes(4, 5, 6);
+  EXPECT_EQ(underTest.getCurrentEra().m_coreLemmas, 4ULL);
+  EXPECT_EQ(underTest.getCurrentEra().m_tier2Lemmas, 5ULL);
+  EXPECT_EQ(underTest.getCurrentEra().m_localLemmas, 6ULL);
+
+  std::stringstream collector;
+  collector << underTest;
+  EXPECT_TRUE(static_cast<bool>(std::regex_search(collector.str(), std::regex{"#T: 4/5/6 "})));
+}
 }
@@ -165,6 +165,28 @@ TEST(UnitUtils, BinaryMaxHeapElementInsertedAfterRemoveCanBeRetrieved)
   EXPECT_EQ(underTest.removeMax(), -5);
 }
 
+TEST(UnitUtils, BinaryMaxHeapElementsCanBeReinsertedAfterClear)
+{
+  BinaryMaxHeap<int, TestIntComparator, IntIndex> underTest{10};
+  std::vector<int> testSeq = std::vector<int>{3, 9, 1, -5};
+  for (auto i : testSeq) {
+    underTest.insert(i);
+  }
+
+  underTest.clear();
+  EXPECT_TRUE(underTest.empty());
+  for (auto i : testSeq) {
+    EXPECT_FALSE(underTest.contains(i)) << "Heap unexpectedly contains element " << i;
+  }
+
+  underTest.insert(1);
+  underTest.insert(3);
+  EXPECT_EQ(underTest.size(), 2ULL);
+  EXPECT_EQ(underTest.removeMax(), 3);
+  EXPECT_EQ(underTest.removeMax(), 1);
+  EXPECT_TRUE(underTest.empty());
+}
+
 TEST(UnitUtils, BinaryMaxHeapCanBeResized)
 {
   BinaryMaxHeap<int, TestIntComparator, IntIndex> underTest{5};
@@ -0,0 +1,180 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/utils/DAryHeap.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace jamsat {
+
+namespace {
+using TestHeap = DAryMaxHeap<CNFVar, float, 4>;
+
+void insertAll(TestHeap& heap, CNFVar maxVar)
+{
+  for (CNFVar i = CNFVar{0}; i <= maxVar; i = nextCNFVar(i)) {
+    heap.insert(i);
+  }
+}
+}
+
+TEST(UnitUtils, EmptyDAryMaxHeapIsMarkedAsEmpty)
+{
+  TestHeap underTest{CNFVar{10}};
+  EXPECT_TRUE(underTest.empty());
+  EXPECT_EQ(underTest.size(), 0ULL);
+  for (CNFVar i = CNFVar{0}; i <= CNFVar{10}; i = nextCNFVar(i)) {
+    EXPECT_FALSE(underTest.contains(i)) << "Heap unexpectedly contains element " << i;
+    EXPECT_EQ(underTest.getKey(i), 0.0f);
+  }
+}
+
+TEST(UnitUtils, DAryMaxHeapDoubleInsertionsDoNotDuplicateElements)
+{
+  TestHeap underTest{CNFVar{10}};
+  underTest.insert(CNFVar{5});
+  underTest.insert(CNFVar{5});
+  EXPECT_EQ(underTest.size(), 1ULL);
+  EXPECT_TRUE(underTest.contains(CNFVar{5}));
+  EXPECT_EQ(underTest.removeMax(), CNFVar{5});
+  EXPECT_TRUE(underTest.empty());
+  EXPECT_FALSE(underTest.contains(CNFVar{5}));
+}
+
+TEST(UnitUtils, DAryMaxHeapHasDescendingRemovalSequence)
+{
+  CNFVar const maxVar{9};
+  std::vector<float> keys{3.0f, 9.0f, 1.0f, -5.0f, -10.0f, -9.0f, 10.0f, 0.5f, -1.0f, 7.0f};
+
+  TestHeap underTest{maxVar};
+  for (CNFVar::RawVariable i = 0; i < keys.size(); ++i) {
+    underTest.setKey(CNFVar{i}, keys[i]);
+  }
+  insertAll(underTest, maxVar);
+  EXPECT_TRUE(underTest.test_satisfiesHeapProperty());
+
+  std::sort(keys.rbegin(), keys.rend());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    CNFVar const removed = underTest.removeMax();
+    EXPECT_EQ(underTest.getKey(removed), keys[i]) << "Differing keys at removal step " << i;
+    EXPECT_TRUE(underTest.test_satisfiesHeapProperty())
+        << "Heap property violated at removal step " << i;
+  }
+  EXPECT_TRUE(underTest.empty());
+}
+
+TEST(UnitUtils, DAryMaxHeapKeyChangesOfContainedElementsRestoreHeapProperty)
+{
+  CNFVar const maxVar{100};
+  TestHeap underTest{maxVar};
+  insertAll(underTest, maxVar);
+
+  std::mt19937 rng{1234};
+  std::uniform_real_distribution<float> keyDistribution{0.0f, 100.0f};
+  std::uniform_int_distribution<CNFVar::RawVariable> varDistribution{0, maxVar.getRawValue()};
+  for (int i = 0; i < 1000; ++i) {
+    underTest.setKey(CNFVar{varDistribution(rng)}, keyDistribution(rng));
+    ASSERT_TRUE(underTest.test_satisfiesHeapProperty()) << "Heap property violated at step " << i;
+  }
+
+  float lastKey = underTest.getKey(underTest.removeMax());
+  while (!underTest.empty()) {
+    float const key = underTest.getKey(underTest.removeMax());
+    EXPECT_LE(key, lastKey);
+    lastKey = key;
+  }
+}
+
+TEST(UnitUtils, DAryMaxHeapKeysOfRemovedElementsAreUsedOnReinsertion)
+{
+  TestHeap underTest{CNFVar{10}};
+  insertAll(underTest, CNFVar{10});
+  underTest.setKey(CNFVar{4}, 2.0f);
+  underTest.setKey(CNFVar{7}, 1.0f);
+
+  EXPECT_EQ(underTest.removeMax(), CNFVar{4});
+  underTest.setKey(CNFVar{4}, 0.5f);
+  EXPECT_EQ(underTest.removeMax(), CNFVar{7});
+
+  underTest.insert(CNFVar{4});
+  EXPECT_EQ(underTest.removeMax(), CNFVar{4});
+}
+
+TEST(UnitUtils, DAryMaxHeapScalingKeysPreservesOrder)
+{
+  TestHeap underTest{CNFVar{10}};
+  underTest.setKey(CNFVar{2}, 1e30f);
+  underTest.setKey(CNFVar{3}, 2e30f);
+  underTest.setKey(CNFVar{8}, 3e30f);
+  underTest.insert(CNFVar{2});
+  underTest.insert(CNFVar{3});
+
+  underTest.scaleKeys(1e-30f);
+  EXPECT_TRUE(underTest.test_satisfiesHeapProperty());
+  EXPECT_FLOAT_EQ(underTest.getKey(CNFVar{2}), 1.0f);
+  EXPECT_FLOAT_EQ(underTest.getKey(CNFVar{3}), 2.0f);
+  EXPECT_FLOAT_EQ(underTest.getKey(CNFVar{8}), 3.0f);
+
+  underTest.insert(CNFVar{8});
+  EXPECT_EQ(underTest.removeMax(), CNFVar{8});
+  EXPECT_EQ(underTest.removeMax(), CNFVar{3});
+  EXPECT_EQ(underTest.removeMax(), CNFVar{2});
+}
+
+TEST(UnitUtils, DAryMaxHeapElementsCanBeReinsertedAfterClear)
+{
+  TestHeap underTest{CNFVar{10}};
+  insertAll(underTest, CNFVar{10});
+  underTest.clear();
+  EXPECT_TRUE(underTest.empty());
+  EXPECT_FALSE(underTest.contains(CNFVar{3}));
+
+  underTest.setKey(CNFVar{3}, 1.0f);
+  underTest.insert(CNFVar{1});
+  underTest.insert(CNFVar{3});
+  EXPECT_EQ(underTest.size(), 2ULL);
+  EXPECT_EQ(underTest.removeMax(), CNFVar{3});
+  EXPECT_EQ(underTest.removeMax(), CNFVar{1});
+}
+
+TEST(UnitUtils, DAryMaxHeapCanBeResized)
+{
+  TestHeap underTest{CNFVar{5}};
+  insertAll(underTest, CNFVar{5});
+
+  underTest.increaseMaxSizeTo(CNFVar{8});
+  EXPECT_EQ(underTest.getKey(CNFVar{8}), 0.0f);
+  underTest.setKey(CNFVar{8}, 1.0f);
+  underTest.insert(CNFVar{8});
+  EXPECT_EQ(underTest.size(), 7ULL);
+  EXPECT_EQ(underTest.removeMax(), CNFVar{8});
+}
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/utils/ExponentialMovingAverage.h>
+
+namespace jamsat {
+TEST(UnitUtils, ExponentialMovingAverage_avgIs0WhenEmpty)
+{
+  ExponentialMovingAverage<int> underTest{0.5};
+  EXPECT_EQ(underTest.getAverage(), 0.0);
+}
+
+TEST(UnitUtils, ExponentialMovingAverage_avgOfSingleValueIsThatValue)
+{
+  ExponentialMovingAverage<int> underTest{0.01};
+  underTest.add(7);
+  EXPECT_NEAR(underTest.getAverage(), 7.0, 1e-9);
+}
+
+TEST(UnitUtils, ExponentialMovingAverage_avgIsBiasCorrected)
+{
+  ExponentialMovingAverage<int> underTest{0.5};
+  underTest.add(1);
+  underTest.add(3);
+  // Biased average: 0.5 * 1 = 0.5, then 0.5 + 0.5 * (3 - 0.5) = 1.75. Bias: 0.25
+  EXPECT_DOUBLE_EQ(underTest.getAverage(), 1.75 / 0.75);
+}
+
+TEST(UnitUtils, ExponentialMovingAverage_avgOfConstantSequenceIsThatConstant)
+{
+  ExponentialMovingAverage<int> underTest{1e-5};
+  for (int i = 0; i < 100000; ++i) {
+    underTest.add(4);
+    ASSERT_NEAR(underTest.getAverage(), 4.0, 1e-6) << "Failed after " << (i + 1) << " values";
+  }
+}
+
+TEST(UnitUtils, ExponentialMovingAverage_avgFollowsRecentValues)
+{
+  ExponentialMovingAverage<int> underTest{0.1};
+  for (int i = 0; i < 1000; ++i) {
+    underTest.add(10);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    underTest.add(2);
+  }
+  EXPECT_NEAR(underTest.getAverage(), 2.0, 1e-6);
+}
+
+TEST(UnitUtils, ExponentialMovingAverage_avgIs0AfterClear)
+{
+  ExponentialMovingAverage<int> underTest{0.5};
+  underTest.add(3);
+  underTest.clear();
+  EXPECT_EQ(underTest.getAverage(), 0.0);
+  underTest.add(5);
+  EXPECT_DOUBLE_EQ(underTest.getAverage(), 5.0);
+}
+}
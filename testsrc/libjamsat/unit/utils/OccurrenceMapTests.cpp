@@ -258,6 +258,61 @@ TEST(UnitUtils, OccurrenceMapDoesNotAddDeletedElements)
   expectAnalogousToOccurrenceMap(expected, underTest, 31);
 }
 
+TEST(UnitUtils, OccurrenceMapModificationsAreResolvableAfterDeletingModifiedContainer)
+{
+  TestOccMap underTest{31};
+  TestUIntVec testData1{9, 10, 15};
+  TestUIntVec testData2{22, 10, 13};
+
+  underTest.insert(testData1);
+  underTest.insert(testData2);
+
+  testData1.pop_back();
+  testData1.setModified();
+  std::array<uint32_t, 0> const noAdditions;
+  std::array<uint32_t, 1> const removals{15};
+  underTest.setModified(testData1, noAdditions, removals);
+
+  testData1.setDeleted();
+  underTest.remove(testData1);
+  EXPECT_EQ(underTest[10].size(), 1ULL);
+
+  underTest.resolveModifications();
+
+  std::vector<std::vector<TestUIntVec*>> expected;
+  expected.resize(32);
+  expected[10].push_back(&testData2);
+  expected[13].push_back(&testData2);
+  expected[22].push_back(&testData2);
+  expectAnalogousToOccurrenceMap(expected, underTest, 31);
+  EXPECT_FALSE(testData1.isModified());
+}
+
+TEST(UnitUtils, OccurrenceMapDoesNotContainElementsRemovedViaPredicate)
+{
+  TestOccMap underTest{31};
+  TestUIntVec testData1{9, 10, 15};
+  TestUIntVec testData2{22, 10, 13};
+  TestUIntVec testData3{22, 10};
+
+  underTest.insert(testData1);
+  underTest.insert(testData2);
+  underTest.insert(testData3);
+
+  std::vector<std::vector<TestUIntVec*>> expected;
+  expected.resize(32);
+  expected[9].push_back(&testData1);
+  expected[10].push_back(&testData1);
+  expected[10].push_back(&testData3);
+  expected[15].push_back(&testData1);
+  expected[22].push_back(&testData3);
+
+  // The removed containers are not marked as deleted, since removeIf() is
+  // intended for removing containers which cannot be accessed anymore:
+  underTest.removeIf([&testData2](TestUIntVec const* vec) { return vec == &testData2; });
+  expectAnalogousToOccurrenceMap(expected, underTest, 31);
+}
+
 namespace {
 template <typename... Ts>
 constexpr auto createUIntArray(Ts&&... ts) -> std::array<uint32_t, sizeof...(Ts)>
@@ -0,0 +1,88 @@
+/* Copyright (c) 2019 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <unordered_map>
+
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/utils/Truth.h>
+
+namespace jamsat {
+/**
+ * \brief Assignment provider with freely settable assignments and phases, for
+ *   testing branching heuristics
+ */
+class FakeAssignmentProvider {
+public:
+  FakeAssignmentProvider(TBool defaultAssignment) : m_defaultAssignment(defaultAssignment) {}
+
+  TBool getAssignment(CNFVar variable) const noexcept
+  {
+    auto result = m_assignments.find(variable);
+    if (result == m_assignments.end()) {
+      return m_defaultAssignment;
+    }
+    return result->second;
+  }
+
+  void setAssignment(CNFVar variable, TBool assignment)
+  {
+    m_assignments[variable] = assignment;
+    if (isDeterminate(assignment)) {
+      m_phases[variable] = assignment;
+    }
+  }
+
+  void setPhase(CNFVar variable, TBool assignment) { m_phases[variable] = assignment; }
+
+  TBool getPhase(CNFVar variable) const noexcept
+  {
+    auto result = m_phases.find(variable);
+    if (result == m_phases.end()) {
+      return TBools::FALSE;
+    }
+    return result->second;
+  }
+
+  void setTargetPhase(CNFVar variable, TBool assignment) { m_targetPhases[variable] = assignment; }
+
+  TBool getTargetPhase(CNFVar variable) const noexcept
+  {
+    auto result = m_targetPhases.find(variable);
+    if (result == m_targetPhases.end()) {
+      return TBools::FALSE;
+    }
+    return result->second;
+  }
+
+private:
+  TBool m_defaultAssignment;
+  std::unordered_map<CNFVar, TBool> m_assignments;
+  std::unordered_map<CNFVar, TBool> m_phases;
+  std::unordered_map<CNFVar, TBool> m_targetPhases;
+};
+}
@@ -64,7 +64,7 @@ private:
   void addClause(gsl::span<CNFLit const> clause);
   void addUnaryClause(gsl::span<CNFLit const> clause);
   void addNonUnaryClause(gsl::span<CNFLit const> clause);
-
+  void increaseMaxVar(gsl::span<CNFLit const> clause);
 
   bool isATClause(gsl::span<CNFLit const> clause);
   bool isRATClause(gsl::span<CNFLit const> clause, std::size_t pivotIdx);
@@ -165,9 +165,7 @@ void OnlineDRATCheckerImpl::addUnaryClause(gsl::span<CNFLit const> clause)
 {
   JAM_ASSERT(clause.size() == 1, "clause must be unary");
   CNFLit newFact = clause[0];
-  if (newFact.getVariable() > m_maxVar) {
-    m_assignment.increaseMaxVar(newFact.getVariable());
-  }
+  increaseMaxVar(clause);
   JAM_ASSERT(m_assignment.getCurrentLevel() == 0, "Adding clauses is only allowed on level 0");
 
   if (TBool curAssign = m_assignment.getAssignment(newFact); isDeterminate(curAssign)) {
@@ -194,14 +192,18 @@ void OnlineDRATCheckerImpl::addNonUnaryClause(gsl::span<CNFLit const> clause)
   std::sort(insertedClause.begin(), insertedClause.end());
   insertedClause.clauseUpdated();
 
+  increaseMaxVar(clause);
+  m_assignment.registerClause(insertedClause);
+}
+
+void OnlineDRATCheckerImpl::increaseMaxVar(gsl::span<CNFLit const> clause)
+{
   for (CNFLit lit : clause) {
     if (lit.getVariable() > m_maxVar) {
       m_maxVar = lit.getVariable();
       m_assignment.increaseMaxVar(m_maxVar);
     }
   }
-
-  m_assignment.registerClause(insertedClause);
 }
 
 void OnlineDRATCheckerImpl::addRATClause(gsl::span<CNFLit const> clause, size_t pivotIdx)
@@ -225,6 +227,7 @@ void OnlineDRATCheckerImpl::addRATClause(gsl::span<CNFLit const> clause, size_t
     return;
   }
 
+  increaseMaxVar(clause);
   bool const hasRATProperty = isRATClause(clause, pivotIdx);
   if (!hasRATProperty) {
     log("Failed to validate RAT property for lemma " + toString(clause.begin(), clause.end()));
@@ -261,6 +264,7 @@ void OnlineDRATCheckerImpl::addATClause(gsl::span<CNFLit const> clause)
     return;
   }
 
+  increaseMaxVar(clause);
   bool const hasATProperty = isATClause(clause);
   if (!hasATProperty) {
     log("Failed to validate AT property for lemma " + toString(clause.begin(), clause.end()));
@@ -298,16 +302,44 @@ bool OnlineDRATCheckerImpl::isATClause(gsl::span<CNFLit const> clause)
   return false;
 }
 
-bool OnlineDRATCheckerImpl::isRATClause(gsl::span<CNFLit const> clause, std::size_t)
+bool OnlineDRATCheckerImpl::isRATClause(gsl::span<CNFLit const> clause, std::size_t pivotIdx)
 {
   // If the clause is AT, then it is also RAT, and AT is way cheaper to check
   if (isATClause(clause)) {
     return true;
   }
 
-  log("RAT clauses not supported yet");
-  m_currentState = State::DETECTED_UNSUPPORTED_LEMMA;
-  return false;
+  CNFLit const pivot = clause[pivotIdx];
+  if (isFalse(m_assignment.getAssignment(pivot))) {
+    // The resolvent with the unary clause (~pivot) is not AT, since clause is not AT
+    return false;
+  }
+
+  // Since clause deletions are not tracked yet, the resolvents are checked against all
+  // clauses containing ~pivot. This can cause valid RAT clauses to be rejected, but not
+  // invalid ones to be accepted.
+  std::vector<CNFLit> resolvent;
+  for (auto const& partner : m_clauses) {
+    if (std::find(partner->begin(), partner->end(), ~pivot) == partner->end()) {
+      continue;
+    }
+
+    resolvent.assign(clause.begin(), clause.end());
+    bool tautological = false;
+    for (CNFLit lit : *partner) {
+      if (lit == ~pivot) {
+        continue;
+      }
+      tautological =
+          tautological || (std::find(clause.begin(), clause.end(), ~lit) != clause.end());
+      resolvent.push_back(lit);
+    }
+
+    if (!tautological && !isATClause(resolvent)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void OnlineDRATCheckerImpl::flush() {}
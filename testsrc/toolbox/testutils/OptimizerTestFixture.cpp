@@ -0,0 +1,128 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#include <toolbox/testutils/OptimizerTestFixture.h>
+
+#include <libjamsat/clausedb/IterableClauseDB.h>
+#include <libjamsat/solver/Assignment.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace jamsat {
+namespace {
+void addClause(IterableClauseDB<Clause>& clauseDB, CNFClause const& clause, bool lemma)
+{
+  Clause* dbClause = clauseDB.createClause(clause.size());
+  ASSERT_NE(dbClause, nullptr);
+  std::copy(clause.begin(), clause.end(), dbClause->begin());
+  if (lemma) {
+    dbClause->setFlag(Clause::Flag::REDUNDANT);
+  }
+  dbClause->clauseUpdated();
+}
+
+auto getClausesIf(SharedOptimizerState& state, std::function<bool(Clause const&)> const& filter)
+    -> std::vector<CNFClause>
+{
+  std::vector<CNFClause> result;
+  state.getClauseDB().getClauses([&result, &filter](std::vector<Clause*> const& clauses) {
+    for (Clause* clause : clauses) {
+      if (!clause->getFlag(Clause::Flag::SCHEDULED_FOR_DELETION) && filter(*clause)) {
+        result.emplace_back(clause->begin(), clause->end());
+      }
+    }
+  });
+  return result;
+}
+}
+
+OptimizerTestFixture::OptimizerTestFixture()
+  : m_problem{}, m_lemmas{}, m_drat{}, m_reconstructionStack{}
+{
+}
+
+auto OptimizerTestFixture::createState(CNFVar maxVar, bool withCertificate)
+    -> SharedOptimizerState
+{
+  CNFProblem checkedProblem = m_problem;
+  std::vector<CNFLit> facts;
+  IterableClauseDB<Clause> clauseDB{1024};
+  for (CNFClause const& clause : m_problem.getClauses()) {
+    if (clause.size() == 1) {
+      facts.push_back(clause[0]);
+      continue;
+    }
+    addClause(clauseDB, clause, false);
+  }
+  for (CNFClause const& clause : m_lemmas) {
+    addClause(clauseDB, clause, true);
+    checkedProblem.addClause(clause);
+  }
+  m_drat = createOnlineDRATChecker(checkedProblem);
+
+  SharedOptimizerState result{std::move(facts),
+                              PolymorphicClauseDB{std::move(clauseDB)},
+                              Assignment{maxVar},
+                              withCertificate ? m_drat.get() : nullptr,
+                              maxVar};
+  result.setModelReconstructionStack(m_reconstructionStack);
+  result.getClauseDB().getClauses([&result](std::vector<Clause*> const& clauses) {
+    for (Clause* clause : clauses) {
+      result.getAssignment().registerClause(*clause);
+    }
+  });
+  return result;
+}
+
+auto OptimizerTestFixture::getClauses(SharedOptimizerState& state) -> std::vector<CNFClause>
+{
+  return normalized(getClausesIf(state, [](Clause const&) { return true; }));
+}
+
+auto OptimizerTestFixture::getClauses(SharedOptimizerState& state, bool redundant)
+    -> std::vector<CNFClause>
+{
+  return normalized(getClausesIf(state, [redundant](Clause const& clause) {
+    return clause.getFlag(Clause::Flag::REDUNDANT) == redundant;
+  }));
+}
+
+auto OptimizerTestFixture::normalized(std::vector<CNFClause> clauses) -> std::vector<CNFClause>
+{
+  for (CNFClause& clause : clauses) {
+    std::sort(clause.begin(), clause.end());
+  }
+  std::sort(clauses.begin(), clauses.end());
+  return clauses;
+}
+
+void OptimizerTestFixture::expectValidProof()
+{
+  EXPECT_FALSE(m_drat->hasDetectedInvalidLemma());
+  EXPECT_FALSE(m_drat->hasDetectedUnsupportedLemma());
+}
+}
@@ -0,0 +1,95 @@
+/* Copyright (c) 2020 Felix Kutzner (github.com/fkutzner)
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+ Except as contained in this notice, the name(s) of the above copyright holders
+ shall not be used in advertising or otherwise to promote the sale, use or
+ other dealings in this Software without prior written authorization.
+
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libjamsat/clausedb/Clause.h>
+#include <libjamsat/cnfproblem/CNFLiteral.h>
+#include <libjamsat/cnfproblem/CNFProblem.h>
+#include <libjamsat/simplification/ModelReconstruction.h>
+#include <libjamsat/simplification/ProblemOptimizer.h>
+
+#include <toolbox/testutils/OnlineDRATChecker.h>
+
+namespace jamsat {
+/**
+ * \brief Base class for test fixtures of problem optimizers
+ *
+ * \ingroup JamSAT_TestInfrastructure
+ *
+ * Test cases fill m_problem and m_lemmas and create the optimizer state via
+ * createState(). The created states use m_reconstructionStack as their model
+ * reconstruction stack and m_drat as their DRAT certificate.
+ */
+class OptimizerTestFixture : public ::testing::Test {
+protected:
+  OptimizerTestFixture();
+
+  /**
+   * \brief Creates an optimizer state for m_problem and m_lemmas.
+   *
+   * The unit clauses of m_problem become facts. The lemmas are added to the clause
+   * database as redundant clauses, and are treated as problem clauses by m_drat.
+   *
+   * \param maxVar            The maximum variable of the state.
+   * \param withCertificate   If false, the state has no DRAT certificate.
+   */
+  auto createState(CNFVar maxVar, bool withCertificate = true) -> SharedOptimizerState;
+
+  /**
+   * \brief Returns the clauses of \p state that are not scheduled for deletion,
+   *   normalized via normalized().
+   */
+  static auto getClauses(SharedOptimizerState& state) -> std::vector<CNFClause>;
+
+  /**
+   * \brief Returns the clauses of \p state that are not scheduled for deletion and
+   *   that are redundant iff \p redundant is true, normalized via normalized().
+   */
+  static auto getClauses(SharedOptimizerState& state, bool redundant) -> std::vector<CNFClause>;
+
+  /**
+   * \brief Sorts the literals of each clause in \p clauses as well as the clauses.
+   */
+  static auto normalized(std::vector<CNFClause> clauses) -> std::vector<CNFClause>;
+
+  /**
+   * \brief Expects (via gtest) that m_drat has neither detected invalid nor
+   *   unsupported lemmas.
+   */
+  void expectValidProof();
+
+  CNFProblem m_problem;
+  std::vector<CNFClause> m_lemmas;
+  std::unique_ptr<OnlineDRATChecker> m_drat;
+  ModelReconstructionStack m_reconstructionStack;
+};
+}
@@ -42,7 +42,7 @@ namespace jamsat {
 
 class TestAssignmentProviderClause : public std::vector<CNFLit> {
 public:
-  enum class Flag : uint32_t { SCHEDULED_FOR_DELETION = 1, REDUNDANT = 2 };
+  enum class Flag : uint32_t { SCHEDULED_FOR_DELETION = 1, REDUNDANT = 2, USED_RECENTLY = 4 };
 
   TestAssignmentProviderClause() : std::vector<CNFLit>{}, m_flags(0), m_lbd(0) {}
   TestAssignmentProviderClause(std::initializer_list<CNFLit> lits)
@@ -49,7 +49,16 @@ public:
     return nullptr;
   }
 
+  ClauseT* getReason(CNFVar variable) noexcept
+  {
+    auto reason = m_reasons.find(variable);
+    if (reason != m_reasons.end()) {
+      return reason->second;
+    }
+    return nullptr;
+  }
+
 private:
-  std::unordered_map<CNFVar, const ClauseT*> m_reasons;
+  std::unordered_map<CNFVar, ClauseT*> m_reasons;
 };
 }